@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "texture_fuzz.hpp"
+
+// Loads a dds or ktx texture with gli
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	pragma::material::fuzz::load_texture<pragma::material::TextureFormatHandlerGli>(data, size);
+	return 0;
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "texture_fuzz.hpp"
+
+// Rasterizes an svg image, including the mipmap levels
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	// The size is fixed, otherwise the fuzzer mostly explores the dimensions declared in the image, which only affect the allocation size
+	static auto textureData = []() {
+		auto prop = udm::Property::Create<udm::Element>();
+		udm::LinkedPropertyWrapper wrapper {*prop};
+		wrapper["width"] = static_cast<uint32_t>(64);
+		wrapper["height"] = static_cast<uint32_t>(64);
+		wrapper["styleSheet"] = std::string {"path { stroke-width: 2; }"};
+		return prop;
+	}();
+	pragma::material::fuzz::load_texture<pragma::material::TextureFormatHandlerSvg>(data, size, textureData);
+	return 0;
+}
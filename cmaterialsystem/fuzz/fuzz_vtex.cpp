@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "texture_fuzz.hpp"
+
+// Loads a compiled Source 2 texture (vtex_c)
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+#ifndef DISABLE_VTEX_SUPPORT
+	pragma::material::fuzz::load_texture<pragma::material::TextureFormatHandlerVtex>(data, size);
+#endif
+	return 0;
+}
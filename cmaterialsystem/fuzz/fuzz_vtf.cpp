@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "texture_fuzz.hpp"
+
+// Loads a vtf texture with VTFLib
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+#ifndef DISABLE_VTF_SUPPORT
+	pragma::material::fuzz::load_texture<pragma::material::TextureFormatHandlerVtf>(data, size);
+#endif
+	return 0;
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Has to be included after the module imports, which provide the standard library.
+
+#pragma once
+
+#include "fuzz.hpp"
+
+namespace pragma::material::fuzz {
+	// The texture format handlers only use the asset manager for imports, so a material manager can stand in for the texture manager,
+	// which would require a render context
+	inline pragma::util::IAssetManager &get_texture_asset_manager()
+	{
+		static auto manager = MaterialManager::Create();
+		return *manager;
+	}
+
+	// Loads the texture and reads every layer and mipmap level the handler reports, so reads beyond the decoded data are detected
+	template<class THandler>
+	void load_texture(const uint8_t *data, size_t size, const std::shared_ptr<udm::Property> &textureData = nullptr)
+	{
+		InMemoryHandler<THandler> handler {get_texture_asset_manager(), data, size};
+		if(textureData)
+			handler.SetTextureData(textureData);
+		if(!handler.LoadData())
+			return;
+		auto &texInfo = handler.GetInputTextureInfo();
+		for(uint32_t layer = 0; layer < texInfo.layerCount; ++layer) {
+			for(uint32_t mipmap = 0; mipmap < texInfo.mipmapCount; ++mipmap) {
+				void *ptr;
+				size_t dataSize;
+				if(!handler.GetDataPtr(layer, mipmap, &ptr, dataSize))
+					continue;
+				volatile uint8_t sum = 0;
+				for(size_t i = 0; i < dataSize; ++i)
+					sum = static_cast<uint8_t>(sum + static_cast<const uint8_t *>(ptr)[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.cmaterialsystem;
+
+import :format_handlers.import_conversion_cache;
+
+pragma::material::ImportConversionCache &pragma::material::ImportConversionCache::Get()
+{
+	static ImportConversionCache cache {};
+	return cache;
+}
+
+std::string pragma::material::ImportConversionCache::CreateKey(const std::string &type, const std::vector<std::string> &inputs, const std::string &parameters)
+{
+	std::string key = type;
+	for(auto &input : inputs) {
+		key += '|';
+		key += normalize_cache_path(input);
+	}
+	key += '|';
+	key += parameters;
+	return key;
+}
+
+std::shared_ptr<std::mutex> pragma::material::ImportConversionCache::GetFileMutex(const std::string &outputFile)
+{
+	std::scoped_lock lock {m_mutex};
+	auto &fileMutex = m_fileMutexes[outputFile];
+	if(!fileMutex)
+		fileMutex = std::make_shared<std::mutex>();
+	return fileMutex;
+}
+
+bool pragma::material::ImportConversionCache::TextureFileExists(const std::string &path)
+{
+	if(fs::exists(path))
+		return true;
+	for(auto &format : ::MaterialManager::get_supported_image_formats()) {
+		if(fs::exists(path + '.' + format.extension))
+			return true;
+	}
+	return false;
+}
+
+bool pragma::material::ImportConversionCache::Convert(const std::string &key, const std::vector<std::string> &outputFiles, const std::function<bool()> &convert, const std::function<bool(const std::string &)> &outputExists)
+{
+	{
+		std::unique_lock lock {m_mutex};
+		for(;;) {
+			auto it = m_entries.find(key);
+			if(it == m_entries.end()) {
+				m_entries[key] = {};
+				break;
+			}
+			if(it->second.state == State::Complete) {
+				auto &entryOutputFiles = it->second.outputFiles;
+				if(!outputExists || std::all_of(entryOutputFiles.begin(), entryOutputFiles.end(), outputExists)) {
+					++m_cacheHitCount;
+					return true;
+				}
+				// The output files have been removed since the conversion was performed, so it has to be executed again
+				it->second = {};
+				break;
+			}
+			// The same conversion is currently being executed on another thread
+			m_condition.wait(lock);
+		}
+	}
+
+	std::vector<std::string> normalizedOutputFiles;
+	normalizedOutputFiles.reserve(outputFiles.size());
+	for(auto &outputFile : outputFiles)
+		normalizedOutputFiles.push_back(normalize_cache_path(outputFile));
+	// Locks are always acquired in the same order to avoid dead-locks between conversions that share multiple output files
+	std::sort(normalizedOutputFiles.begin(), normalizedOutputFiles.end());
+	normalizedOutputFiles.erase(std::unique(normalizedOutputFiles.begin(), normalizedOutputFiles.end()), normalizedOutputFiles.end());
+
+	auto success = false;
+	{
+		std::vector<std::shared_ptr<std::mutex>> fileMutexes;
+		std::vector<std::unique_lock<std::mutex>> fileLocks;
+		fileMutexes.reserve(normalizedOutputFiles.size());
+		fileLocks.reserve(normalizedOutputFiles.size());
+		for(auto &outputFile : normalizedOutputFiles) {
+			fileMutexes.push_back(GetFileMutex(outputFile));
+			fileLocks.emplace_back(*fileMutexes.back());
+		}
+		++m_conversionCount;
+		try {
+			success = convert();
+		}
+		catch(...) {
+			// Threads waiting for this conversion must not be left blocked
+			FinishConversion(key, false, outputFiles, normalizedOutputFiles);
+			throw;
+		}
+	}
+	FinishConversion(key, success, outputFiles, normalizedOutputFiles);
+	return success;
+}
+
+void pragma::material::ImportConversionCache::FinishConversion(const std::string &key, bool success, const std::vector<std::string> &outputFiles, const std::vector<std::string> &normalizedOutputFiles)
+{
+	{
+		std::scoped_lock lock {m_mutex};
+		if(success) {
+			for(auto &outputFile : normalizedOutputFiles) {
+				auto it = m_outputOwners.find(outputFile);
+				if(it != m_outputOwners.end() && it->second != key) {
+					// The output file has been overwritten by a different conversion, so the previous result is no longer valid
+					auto itPrev = m_entries.find(it->second);
+					if(itPrev != m_entries.end() && itPrev->second.state == State::Complete)
+						m_entries.erase(itPrev);
+				}
+				m_outputOwners[outputFile] = key;
+			}
+			auto &entry = m_entries[key];
+			entry.state = State::Complete;
+			entry.outputFiles = outputFiles;
+		}
+		else
+			m_entries.erase(key);
+	}
+	m_condition.notify_all();
+}
+
+bool pragma::material::ImportConversionCache::IsCached(const std::string &key) const
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_entries.find(key);
+	return it != m_entries.end() && it->second.state == State::Complete;
+}
+
+void pragma::material::ImportConversionCache::Clear()
+{
+	std::scoped_lock lock {m_mutex};
+	// Conversions that are currently in progress are kept, so that threads waiting for them are still notified
+	for(auto it = m_entries.begin(); it != m_entries.end();) {
+		if(it->second.state == State::Complete)
+			it = m_entries.erase(it);
+		else
+			++it;
+	}
+	m_outputOwners.clear();
+}
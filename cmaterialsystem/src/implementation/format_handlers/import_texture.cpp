@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.cmaterialsystem;
+
+import :format_handlers.import_texture;
+
+static std::atomic<bool> g_importTextureHighQuality = false;
+static std::atomic<bool> g_importNormalMapsBc5 = false;
+static std::atomic<pragma::material::TextureQualityTier> g_importTextureQualityTier = pragma::material::TextureQualityTier::High;
+void pragma::material::set_import_texture_high_quality(bool highQuality) { g_importTextureHighQuality = highQuality; }
+bool pragma::material::is_import_texture_high_quality() { return g_importTextureHighQuality; }
+void pragma::material::set_import_normal_maps_bc5(bool bc5) { g_importNormalMapsBc5 = bc5; }
+bool pragma::material::are_import_normal_maps_bc5() { return g_importNormalMapsBc5; }
+void pragma::material::set_import_texture_quality_tier(TextureQualityTier tier) { g_importTextureQualityTier = tier; }
+pragma::material::TextureQualityTier pragma::material::get_import_texture_quality_tier() { return g_importTextureQualityTier; }
+
+image::TextureInfo pragma::material::get_import_texture_info(ImportTextureUsage usage, image::TextureInfo::InputFormat inputFormat)
+{
+	image::TextureInfo texInfo {};
+	texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
+	texInfo.flags = image::TextureInfo::Flags::GenerateMipmaps;
+	texInfo.inputFormat = inputFormat;
+	texInfo.alphaMode = image::TextureInfo::AlphaMode::None;
+	switch(usage) {
+	case ImportTextureUsage::Albedo:
+		texInfo.outputFormat = is_import_texture_high_quality() ? image::TextureInfo::OutputFormat::BC7 : image::TextureInfo::OutputFormat::ColorMap;
+		break;
+	case ImportTextureUsage::AlbedoWithAlpha:
+		texInfo.alphaMode = image::TextureInfo::AlphaMode::Transparency;
+		texInfo.outputFormat = is_import_texture_high_quality() ? image::TextureInfo::OutputFormat::BC7 : image::TextureInfo::OutputFormat::ColorMapSmoothAlpha;
+		break;
+	case ImportTextureUsage::NormalMap:
+		texInfo.outputFormat = are_import_normal_maps_bc5() ? image::TextureInfo::OutputFormat::BC5 : image::TextureInfo::OutputFormat::NormalMap;
+		texInfo.SetNormalMap();
+		break;
+	case ImportTextureUsage::Rma:
+		texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMap;
+		break;
+	case ImportTextureUsage::SingleChannel:
+		texInfo.outputFormat = image::TextureInfo::OutputFormat::GradientMap;
+		break;
+	}
+	return texInfo;
+}
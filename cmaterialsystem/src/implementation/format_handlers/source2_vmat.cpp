@@ -4,13 +4,15 @@
 module pragma.cmaterialsystem;
 
 import :format_handlers.source2_vmat;
+import :format_handlers.import_texture;
+import :format_handlers.import_conversion_cache;
+import :texture_manager.texture_quality;
 
 import :material_manager2;
 
 #ifndef DISABLE_VMAT_SUPPORT
 import source2;
 
-static bool g_downScaleRMATextures = true;
 static std::shared_ptr<prosper::Texture> load_texture(pragma::material::CMaterialManager &matManager, const std::string &texPath, bool reload = false)
 {
 	auto &textureManager = matManager.GetTextureManager();
@@ -31,13 +33,73 @@ static std::shared_ptr<prosper::Texture> get_texture(pragma::material::CMaterial
 	return load_texture(matManager, dsMap->GetString());
 }
 
+// Import settings that affect the textures generated by the conversions below
+static std::string get_import_conversion_parameters()
+{
+	return "hq=" + std::to_string(pragma::material::is_import_texture_high_quality()) + ";bc5=" + std::to_string(pragma::material::are_import_normal_maps_bc5())
+	  + ";tier=" + std::to_string(pragma::math::to_integral(pragma::material::get_import_texture_quality_tier()));
+}
+
+std::optional<std::string> pragma::material::convert_dota2_masks_to_rma(prosper::IPrContext &context, const std::string &masksPath, const std::string &rootPath,
+  const std::function<std::shared_ptr<prosper::Texture>(const std::string &)> &loadTexture)
+{
+	// Dota 2 stores the metalness in the blue channel of the first mask texture. The specular exponent (alpha channel of the second mask texture)
+	// has no direct equivalent, so the roughness is left to the roughness factor.
+	auto *shaderExtractImageChannel = static_cast<ShaderExtractImageChannel *>(context.GetShader("extract_image_channel").get());
+	if(!shaderExtractImageChannel)
+		return {};
+	auto pathNoExt = masksPath;
+	ufile::remove_extension_from_filename(pathNoExt);
+	auto rmaPath = pathNoExt + "_rma";
+
+	auto key = ImportConversionCache::CreateKey("dota2_masks_rma", {masksPath}, get_import_conversion_parameters());
+	auto converted = ImportConversionCache::Get().Convert(
+	  key, {rmaPath},
+	  [&]() {
+		  auto masksTex = loadTexture(masksPath);
+		  if(masksTex == nullptr)
+			  return false;
+		  auto imgRma = shaderExtractImageChannel->ExtractImageChannel(context, *masksTex,
+		    std::array<ShaderExtractImageChannel::Channel, 4> {
+		      ShaderExtractImageChannel::Channel::One,  /* Ao */
+		      ShaderExtractImageChannel::Channel::One,  /* Roughness */
+		      ShaderExtractImageChannel::Channel::Blue, /* Metalness */
+		      ShaderExtractImageChannel::Channel::One,
+		    },
+		    ShaderExtractImageChannel::Pipeline::RGBA8);
+		  if(imgRma == nullptr)
+			  return false;
+		  auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+		  prosper::util::save_texture(rootPath + '/' + rmaPath, *imgRma, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save RMA image as DDS: " << err << std::endl; });
+		  return true;
+	  },
+	  [&rootPath](const std::string &texPath) { return ImportConversionCache::TextureFileExists(rootPath + '/' + texPath); });
+	if(!converted)
+		return {};
+	return rmaPath;
+}
+
 pragma::material::CSource2VmatFormatHandler::CSource2VmatFormatHandler(pragma::util::IAssetManager &assetManager) : Source2VmatFormatHandler {assetManager} {}
 bool pragma::material::CSource2VmatFormatHandler::ImportTexture(const std::string &fpath, const std::string &outputPath)
 {
-	auto importHandler = static_cast<CMaterialManager &>(GetAssetManager()).GetExternalSourceFileImportHandler();
+	auto &matManager = static_cast<CMaterialManager &>(GetAssetManager());
+	auto importHandler = matManager.GetExternalSourceFileImportHandler();
 	if(!importHandler)
 		return false;
-	return importHandler(fpath, outputPath).has_value();
+	// The texture is imported by an external handler, so the result is recorded without source hash and excluded from the failure cache
+	ImportRecord record {};
+	record.sourceFile = fpath;
+	record.outputPath = outputPath;
+	record.handler = "vtex_c";
+	auto t = std::chrono::steady_clock::now();
+	auto success = importHandler(fpath, outputPath).has_value();
+	record.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t);
+	if(!success) {
+		record.errorClass = ImportErrorClass::ConversionError;
+		record.message = "Texture import has failed!";
+	}
+	matManager.GetImportDiagnostics().AddRecord(record);
+	return success;
 }
 bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::resource::Resource &resource, ::source2::resource::Material &vmat, datasystem::Block &rootData, datasystem::Settings &settings, const std::string &shader, VMatOrigin origin)
 {
@@ -52,6 +114,7 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 
 	auto &matManager = static_cast<CMaterialManager &>(GetAssetManager());
 	auto rootPath = matManager.GetImportDirectory();
+	auto convertedTextureExists = [&rootPath](const std::string &texPath) { return ImportConversionCache::TextureFileExists((rootPath + ('/' + texPath)).GetString()); };
 	auto &context = matManager.GetContext();
 
 	auto *shaderExtractImageChannel = static_cast<ShaderExtractImageChannel *>(context.GetShader("extract_image_channel").get());
@@ -63,10 +126,17 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 			if(shaderDecomposeMetalnessReflectance) {
 				auto &textureManager = matManager.GetTextureManager();
 
-				std::shared_ptr<void> normalMap = nullptr;
 				auto metalnessReflectancePath = vmat::get_vmat_texture_path(*metalnessMap).GetString();
-				auto pMetalnessReflectanceMap = textureManager.LoadAsset(metalnessReflectancePath);
-				if(pMetalnessReflectanceMap && pMetalnessReflectanceMap->HasValidVkTexture()) {
+				auto pathNoExt = metalnessReflectancePath;
+				ufile::remove_extension_from_filename(pathNoExt);
+				auto rmaPath = pathNoExt + "_rma";
+
+				// Materials sharing the same metalness-reflectance map only need to decompose it once
+				auto key = ImportConversionCache::CreateKey("source2_decompose_metalness_reflectance", {metalnessReflectancePath});
+				auto converted = ImportConversionCache::Get().Convert(key, {rmaPath}, [&]() {
+					auto pMetalnessReflectanceMap = textureManager.LoadAsset(metalnessReflectancePath);
+					if(pMetalnessReflectanceMap == nullptr || pMetalnessReflectanceMap->HasValidVkTexture() == false)
+						return false;
 					prosper::util::ImageCreateInfo imgCreateInfo {};
 					//imgCreateInfo.flags |= prosper::util::ImageCreateInfo::Flags::FullMipmapChain;
 					imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
@@ -99,20 +169,14 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 					}
 					context.FlushSetupCommandBuffer();
 
-					auto pathNoExt = metalnessReflectancePath;
-					ufile::remove_extension_from_filename(pathNoExt);
-
 					auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save map image as DDS: " << err << std::endl; };
 
 					// TODO: Change width/height
-					image::TextureInfo texInfo {};
-					texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
-					texInfo.alphaMode = image::TextureInfo::AlphaMode::Auto;
-					texInfo.inputFormat = image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-					texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMap;
-					auto rmaPath = pathNoExt + "_rma";
+					auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
 					prosper::util::save_texture((rootPath + ('/' + rmaPath)).GetString(), texRMA->GetImage(), texInfo, errHandler);
-
+					return true;
+				}, convertedTextureExists);
+				if(converted) {
 					rootData.AddData("rma_map", std::make_shared<datasystem::Texture>(settings, rmaPath));
 
 					auto rmaInfo = rootData.AddBlock("rma_info");
@@ -122,15 +186,27 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 		}
 	}
 	else if(isDota2Mat) {
-		std::cout << "TODO" << std::endl;
+		auto *masks1 = vmat.FindTextureParam("g_tMasks1");
+		if(masks1) {
+			auto rmaPath = convert_dota2_masks_to_rma(context, vmat::get_vmat_texture_path(*masks1).GetString(), rootPath.GetString(), [&matManager](const std::string &texPath) { return load_texture(matManager, texPath); });
+			if(rmaPath) {
+				rootData.AddData("rma_map", std::make_shared<datasystem::Texture>(settings, *rmaPath));
+
+				auto rmaInfo = rootData.AddBlock("rma_info");
+				rmaInfo->AddValue("bool", "requires_ao_update", "1");
+			}
+		}
 	}
 	else {
 		auto *shaderDecomposePbr = static_cast<source2::ShaderDecomposePBR *>(context.GetShader("source2_decompose_pbr").get());
 		std::string texPath;
+		std::string normalMapPath;
 		auto albedoTex = get_texture(matManager, rootData, "albedo_map", &texPath);
-		auto normalTex = get_texture(matManager, rootData, "normal_map");
-		if(normalTex == nullptr)
+		auto normalTex = get_texture(matManager, rootData, "normal_map", &normalMapPath);
+		if(normalTex == nullptr) {
 			normalTex = load_texture(matManager, "white");
+			normalMapPath = "white";
+		}
 		if(albedoTex && normalTex) {
 			auto &textureManager = matManager.GetTextureManager();
 
@@ -138,6 +214,7 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 			ufile::remove_extension_from_filename(pathNoExt);
 
 			prosper::Texture *anisoGlossMap = nullptr;
+			std::string anisoGlossMapPath;
 
 			// Decompose Source 2 textures into albedo and metalness-roughness
 			auto *alphaTest = vmat.FindIntParam("F_ALPHA_TEST");
@@ -159,9 +236,13 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 					anisoGlossMap = load_texture(matManager, path.GetString()).get();
 					if(anisoGlossMap == nullptr)
 						pragma::math::set_flag(flags, source2::ShaderDecomposePBR::Flags::SpecularWorkflow, false);
+					else
+						anisoGlossMapPath = path.GetString();
 				}
-				else
+				else {
 					anisoGlossMap = normalTex.get();
+					anisoGlossMapPath = normalMapPath;
+				}
 			}
 
 			// Note: While the original roughness and metalness maps have the
@@ -171,17 +252,20 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 			prosper::Extent2D metallicRoughnessResolution {};
 			auto *s2AoMap = vmat.FindTextureParam("g_tAmbientOcclusion");
 			prosper::Texture *aoTex = nullptr;
+			std::string aoMapPath;
 			if(s2AoMap) {
 				pragma::util::Path path {*s2AoMap};
 				path.RemoveFileExtension();
 				path += ".vtex_c";
 
-				aoTex = load_texture(matManager, path.GetString()).get();
+				aoMapPath = path.GetString();
+				aoTex = load_texture(matManager, aoMapPath).get();
 			}
 
 			auto hasAoMap = true;
 			if(aoTex == nullptr) {
 				aoTex = load_texture(matManager, "white").get();
+				aoMapPath = "white";
 				hasAoMap = false;
 
 				auto &albedoImg = albedoTex->GetImage();
@@ -198,55 +282,54 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 				metallicRoughnessResolution = {static_cast<uint32_t>(extents.width), static_cast<uint32_t>(extents.height)};
 			}
 
-			auto pbrSet = shaderDecomposePbr->DecomposePBR(context, *albedoTex, *normalTex, *aoTex, flags, anisoGlossMap);
+			// The RMA map is baked at the resolution limit of the import quality tier
+			auto maxRmaResolution = pragma::material::get_texture_max_resolution(pragma::material::get_import_texture_quality_tier(), pragma::material::TextureUsage::Rma);
+			if(maxRmaResolution > 0) {
+				metallicRoughnessResolution.width = std::min(metallicRoughnessResolution.width, maxRmaResolution);
+				metallicRoughnessResolution.height = std::min(metallicRoughnessResolution.height, maxRmaResolution);
+			}
 
 			auto albedoPath = pathNoExt + "_albedo";
-			image::TextureInfo texInfo {};
-			texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
-			texInfo.alphaMode = image::TextureInfo::AlphaMode::None;
-			texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMap;
+			auto metalnessRoughnessPath = pathNoExt + "_rma";
 			auto useAlpha = pragma::math::is_flag_set(flags, source2::ShaderDecomposePBR::Flags::TreatAlphaAsTransparency);
-			if(useAlpha) {
-				texInfo.alphaMode = image::TextureInfo::AlphaMode::Transparency;
-				texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMapSmoothAlpha;
-			}
-			texInfo.flags = image::TextureInfo::Flags::GenerateMipmaps;
-			texInfo.inputFormat = image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-			prosper::util::save_texture((rootPath + ('/' + albedoPath)).GetString(), *pbrSet.albedoMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
-
-			// TODO
-			if(metallicRoughnessResolution.width > 1'024)
-				metallicRoughnessResolution.width = 1'024;
-			if(metallicRoughnessResolution.height > 1'024)
-				metallicRoughnessResolution.height = 1'024;
-
-			auto mrExtents = pbrSet.rmaMap->GetExtents();
-			if(g_downScaleRMATextures && mrExtents.width > metallicRoughnessResolution.width && mrExtents.height > metallicRoughnessResolution.height) {
-				std::cout << "Downscaling RMA map from " << mrExtents.width << "x" << mrExtents.height << " to " << metallicRoughnessResolution.width << "x" << metallicRoughnessResolution.height << std::endl;
-				prosper::util::ImageCreateInfo imgCreateInfo {};
-				imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
-				imgCreateInfo.memoryFeatures = prosper::MemoryFeatureFlags::GPUBulk;
-				imgCreateInfo.postCreateLayout = prosper::ImageLayout::TransferDstOptimal;
-				imgCreateInfo.tiling = prosper::ImageTiling::Optimal;
-				imgCreateInfo.usage = prosper::ImageUsageFlags::TransferDstBit;
-
-				imgCreateInfo.width = metallicRoughnessResolution.width;
-				imgCreateInfo.height = metallicRoughnessResolution.height;
-				auto imgRescaled = context.CreateImage(imgCreateInfo);
-				auto &setupCmd = context.GetSetupCommandBuffer();
-				prosper::util::BlitInfo blitInfo {};
-				blitInfo.extentsSrc = mrExtents;
-				blitInfo.extentsDst = metallicRoughnessResolution;
-				setupCmd->RecordImageBarrier(*pbrSet.rmaMap, prosper::ImageLayout::ShaderReadOnlyOptimal, prosper::ImageLayout::TransferSrcOptimal);
-				setupCmd->RecordBlitImage(blitInfo, *pbrSet.rmaMap, *imgRescaled);
-				context.FlushSetupCommandBuffer();
-
-				pbrSet.rmaMap = imgRescaled;
-			}
 
-			auto metalnessRoughnessPath = pathNoExt + "_rma";
-			texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMap;
-			prosper::util::save_texture((rootPath + ('/' + metalnessRoughnessPath)).GetString(), *pbrSet.rmaMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save RMA image as DDS: " << err << std::endl; });
+			// Many materials share the same Source 2 textures, in which case the decomposition only has to be performed once
+			auto params = get_import_conversion_parameters() + ";flags=" + std::to_string(pragma::math::to_integral(flags)) + ";rma=" + std::to_string(metallicRoughnessResolution.width) + "x" + std::to_string(metallicRoughnessResolution.height);
+			auto key = ImportConversionCache::CreateKey("source2_decompose_pbr", {texPath, normalMapPath, aoMapPath, anisoGlossMapPath}, params);
+			ImportConversionCache::Get().Convert(key, {albedoPath, metalnessRoughnessPath}, [&]() {
+				auto pbrSet = shaderDecomposePbr->DecomposePBR(context, *albedoTex, *normalTex, *aoTex, flags, anisoGlossMap);
+
+				auto texInfo = pragma::material::get_import_texture_info(useAlpha ? pragma::material::ImportTextureUsage::AlbedoWithAlpha : pragma::material::ImportTextureUsage::Albedo, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				prosper::util::save_texture((rootPath + ('/' + albedoPath)).GetString(), *pbrSet.albedoMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+
+				auto mrExtents = pbrSet.rmaMap->GetExtents();
+				if(mrExtents.width > metallicRoughnessResolution.width && mrExtents.height > metallicRoughnessResolution.height) {
+					std::cout << "Downscaling RMA map from " << mrExtents.width << "x" << mrExtents.height << " to " << metallicRoughnessResolution.width << "x" << metallicRoughnessResolution.height << std::endl;
+					prosper::util::ImageCreateInfo imgCreateInfo {};
+					imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
+					imgCreateInfo.memoryFeatures = prosper::MemoryFeatureFlags::GPUBulk;
+					imgCreateInfo.postCreateLayout = prosper::ImageLayout::TransferDstOptimal;
+					imgCreateInfo.tiling = prosper::ImageTiling::Optimal;
+					imgCreateInfo.usage = prosper::ImageUsageFlags::TransferDstBit;
+
+					imgCreateInfo.width = metallicRoughnessResolution.width;
+					imgCreateInfo.height = metallicRoughnessResolution.height;
+					auto imgRescaled = context.CreateImage(imgCreateInfo);
+					auto &setupCmd = context.GetSetupCommandBuffer();
+					prosper::util::BlitInfo blitInfo {};
+					blitInfo.extentsSrc = mrExtents;
+					blitInfo.extentsDst = metallicRoughnessResolution;
+					setupCmd->RecordImageBarrier(*pbrSet.rmaMap, prosper::ImageLayout::ShaderReadOnlyOptimal, prosper::ImageLayout::TransferSrcOptimal);
+					setupCmd->RecordBlitImage(blitInfo, *pbrSet.rmaMap, *imgRescaled);
+					context.FlushSetupCommandBuffer();
+
+					pbrSet.rmaMap = imgRescaled;
+				}
+
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				prosper::util::save_texture((rootPath + ('/' + metalnessRoughnessPath)).GetString(), *pbrSet.rmaMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save RMA image as DDS: " << err << std::endl; });
+				return true;
+			}, convertedTextureExists);
 
 			rootData.AddData("albedo_map", std::make_shared<datasystem::Texture>(settings, albedoPath));
 			rootData.AddData("rma_map", std::make_shared<datasystem::Texture>(settings, metalnessRoughnessPath));
@@ -286,25 +369,32 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 					ufile::remove_extension_from_filename(pathNoExt);
 
 					auto albedoPath = pathNoExt;
-					image::TextureInfo texInfo {};
-					texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
-					texInfo.alphaMode = image::TextureInfo::AlphaMode::None;
-					texInfo.outputFormat = image::TextureInfo::OutputFormat::ColorMap;
-					texInfo.flags = image::TextureInfo::Flags::GenerateMipmaps;
-					texInfo.inputFormat = image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-					prosper::util::save_texture((rootPath + ('/' + albedoPath)).GetString(), albedoTex->GetImage(), texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+					auto key = ImportConversionCache::CreateKey("source2_albedo", {texPath}, get_import_conversion_parameters());
+					ImportConversionCache::Get().Convert(key, {albedoPath}, [&]() {
+						auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Albedo, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+						prosper::util::save_texture((rootPath + ('/' + albedoPath)).GetString(), albedoTex->GetImage(), texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+						return true;
+					}, convertedTextureExists);
 				}
 
 				source2::ShaderGenerateTangentSpaceNormalMap *shaderGenerateTangentSpaceNormalMap = nullptr;
-				if(isSteamVrMat || isDota2Mat)
-					shaderGenerateTangentSpaceNormalMap = static_cast<source2::ShaderGenerateTangentSpaceNormalMapProto *>(context.GetShader("source2_generate_tangent_space_normal_map_proto").get());
+				auto useProtoShader = (isSteamVrMat || isDota2Mat);
+				std::string shaderName = useProtoShader ? "source2_generate_tangent_space_normal_map_proto" : "source2_generate_tangent_space_normal_map";
+				if(useProtoShader)
+					shaderGenerateTangentSpaceNormalMap = static_cast<source2::ShaderGenerateTangentSpaceNormalMapProto *>(context.GetShader(shaderName).get());
 				else
-					shaderGenerateTangentSpaceNormalMap = static_cast<source2::ShaderGenerateTangentSpaceNormalMap *>(context.GetShader("source2_generate_tangent_space_normal_map").get());
+					shaderGenerateTangentSpaceNormalMap = static_cast<source2::ShaderGenerateTangentSpaceNormalMap *>(context.GetShader(shaderName).get());
 				if(shaderGenerateTangentSpaceNormalMap) {
 					auto &textureManager = matManager.GetTextureManager();
 
-					auto pNormalMap = textureManager.LoadAsset(normalMapPath);
-					if(pNormalMap && pNormalMap->HasValidVkTexture()) {
+					auto normalMapPathNoExt = normalMapPath;
+					ufile::remove_extension_from_filename(normalMapPathNoExt);
+
+					auto key = ImportConversionCache::CreateKey("source2_tangent_space_normal_map", {normalMapPath}, get_import_conversion_parameters() + ";shader=" + shaderName);
+					auto converted = ImportConversionCache::Get().Convert(key, {normalMapPathNoExt}, [&]() {
+						auto pNormalMap = textureManager.LoadAsset(normalMapPath);
+						if(pNormalMap == nullptr || pNormalMap->HasValidVkTexture() == false)
+							return false;
 						prosper::util::ImageCreateInfo imgCreateInfo {};
 						//imgCreateInfo.flags |= prosper::util::ImageCreateInfo::Flags::FullMipmapChain;
 						imgCreateInfo.format = prosper::Format::R16G16B16A16_SFloat;
@@ -337,23 +427,18 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 						}
 						context.FlushSetupCommandBuffer();
 
-						auto normalMapPathNoExt = normalMapPath;
-						ufile::remove_extension_from_filename(normalMapPathNoExt);
-
 						auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save normal map image as DDS: " << err << std::endl; };
 
 						// TODO: Change width/height
-						image::TextureInfo texInfo {};
-						texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
-						texInfo.alphaMode = image::TextureInfo::AlphaMode::Auto;
-						texInfo.inputFormat = image::TextureInfo::InputFormat::R16G16B16A16_Float;
-						texInfo.outputFormat = image::TextureInfo::OutputFormat::NormalMap;
-						texInfo.SetNormalMap();
+						auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, image::TextureInfo::InputFormat::R16G16B16A16_Float);
 						prosper::util::save_texture((rootPath + ('/' + normalMapPathNoExt)).GetString(), texNormal->GetImage(), texInfo, errHandler);
 
+						// Only needs to be reloaded once, materials that re-use the result will find the converted texture
 						load_texture(matManager, normalMapPathNoExt, true);
+						return true;
+					}, convertedTextureExists);
+					if(converted)
 						rootData.AddData("normal_map", std::make_shared<datasystem::Texture>(settings, normalMapPathNoExt));
-					}
 				}
 			}
 #if 0
@@ -454,7 +539,8 @@ bool pragma::material::CSource2VmatFormatHandler::InitializeVMatData(::source2::
 #endif
 		}
 	}
-	matManager.GetTextureManager().ClearUnused();
+	if(!matManager.IsImportBatchActive())
+		matManager.GetTextureManager().ClearUnused();
 	return true;
 }
 #endif
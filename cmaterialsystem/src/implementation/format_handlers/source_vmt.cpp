@@ -12,6 +12,8 @@ module;
 module pragma.cmaterialsystem;
 
 import :format_handlers.source_vmt;
+import :format_handlers.import_texture;
+import :format_handlers.import_conversion_cache;
 import :material_manager2;
 
 #undef max
@@ -36,9 +38,10 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 {
 	auto &fh = formatHandler;
 	//TODO: These do not work if the textures haven't been imported yet!!
-	auto settings = datasystem::create_data_settings({});
+	auto &settings = get_shared_data_settings();
 	auto &matManager = static_cast<CMaterialManager &>(fh.GetAssetManager());
 	auto rootPath = matManager.GetImportDirectory();
+	auto convertedTextureExists = [&rootPath](const std::string &texPath) { return ImportConversionCache::TextureFileExists((rootPath + ('/' + texPath)).GetString()); };
 	if(pragma::string::compare<std::string>(vmtShader, "eyes", false)) {
 		matShader = "eye_legacy";
 		fh.AssignTextureValue(rootData, *fh.m_rootNode, "$iris", "iris_map");
@@ -53,18 +56,34 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 		// Some conversions are required for the iris and cornea textures for usage in Pragma
 		auto &context = matManager.GetContext();
 		auto *shaderDecomposeCornea = static_cast<ShaderDecomposeCornea *>(context.GetShader("decompose_cornea").get());
-		if(shaderDecomposeCornea) {
+		if(shaderDecomposeCornea && (irisTexture || corneaTexture)) {
 			auto &textureManager = matManager.GetTextureManager();
 
-			auto irisMap = irisTexture ? textureManager.LoadAsset(*irisTexture) : nullptr;
-			if(irisMap == nullptr)
-				irisMap = textureManager.GetErrorTexture();
+			// A missing iris or cornea texture is replaced with the error texture, the outputs are named after the texture that does exist
+			auto irisTextureNoExt = irisTexture ? *irisTexture : *corneaTexture;
+			ufile::remove_extension_from_filename(irisTextureNoExt);
+			auto corneaTextureNoExt = corneaTexture ? *corneaTexture : *irisTexture;
+			ufile::remove_extension_from_filename(corneaTextureNoExt);
 
-			auto corneaMap = corneaTexture ? textureManager.LoadAsset(*corneaTexture) : nullptr;
-			if(corneaMap == nullptr)
-				corneaMap = textureManager.GetErrorTexture();
+			auto albedoTexName = irisTextureNoExt + "_albedo";
+			auto normalTexName = corneaTextureNoExt + "_normal";
+			auto parallaxTexName = corneaTextureNoExt + "_parallax";
+			auto noiseTexName = corneaTextureNoExt + "_noise";
+
+			// Eye materials usually share the same iris and cornea textures
+			auto key = ImportConversionCache::CreateKey("source_decompose_cornea", {irisTexture ? *irisTexture : "error", corneaTexture ? *corneaTexture : "error"});
+			auto converted = ImportConversionCache::Get().Convert(key, {albedoTexName, normalTexName, parallaxTexName, noiseTexName}, [&]() {
+				auto irisMap = irisTexture ? textureManager.LoadAsset(*irisTexture) : nullptr;
+				if(irisMap == nullptr)
+					irisMap = textureManager.GetErrorTexture();
+
+				auto corneaMap = corneaTexture ? textureManager.LoadAsset(*corneaTexture) : nullptr;
+				if(corneaMap == nullptr)
+					corneaMap = textureManager.GetErrorTexture();
+
+				if(!irisMap || !irisMap->HasValidVkTexture() || !corneaMap || !corneaMap->HasValidVkTexture())
+					return false;
 
-			if(irisMap && irisMap->HasValidVkTexture() && corneaMap && corneaMap->HasValidVkTexture()) {
 				// Prepare output textures (albedo, normal, parallax)
 				using namespace pragma::math::scoped_enum::bitwise;
 				prosper::util::ImageCreateInfo imgCreateInfo {};
@@ -112,35 +131,23 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 				}
 				context.FlushSetupCommandBuffer();
 
-				auto irisTextureNoExt = *irisTexture;
-				ufile::remove_extension_from_filename(irisTextureNoExt);
-				auto corneaTextureNoExt = *corneaTexture;
-				ufile::remove_extension_from_filename(corneaTextureNoExt);
-
-				auto albedoTexName = irisTextureNoExt + "_albedo";
-				auto normalTexName = corneaTextureNoExt + "_normal";
-				auto parallaxTexName = corneaTextureNoExt + "_parallax";
-				auto noiseTexName = corneaTextureNoExt + "_noise";
-
 				auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save eyeball image(s) as DDS: " << err << std::endl; };
 
 				// TODO: Change width/height
-				image::TextureInfo texInfo {};
-				texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
+				auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Albedo, image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				// The iris albedo may or may not have an alpha channel
 				texInfo.alphaMode = image::TextureInfo::AlphaMode::Auto;
-				texInfo.flags = image::TextureInfo::Flags::GenerateMipmaps;
-				texInfo.inputFormat = image::TextureInfo::InputFormat::R8G8B8A8_UInt;
 				prosper::util::save_texture((rootPath + ('/' + albedoTexName)).GetString(), texAlbedo->GetImage(), texInfo, errHandler);
 
-				texInfo.outputFormat = image::TextureInfo::OutputFormat::GradientMap;
-				texInfo.inputFormat = image::TextureInfo::InputFormat::R32G32B32A32_Float;
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::SingleChannel, image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture((rootPath + ('/' + parallaxTexName)).GetString(), texParallax->GetImage(), texInfo, errHandler);
 				prosper::util::save_texture((rootPath + ('/' + noiseTexName)).GetString(), texNoise->GetImage(), texInfo, errHandler);
 
-				texInfo.outputFormat = image::TextureInfo::OutputFormat::NormalMap;
-				texInfo.SetNormalMap();
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture((rootPath + ('/' + normalTexName)).GetString(), texNormal->GetImage(), texInfo, errHandler);
-
+				return true;
+			}, convertedTextureExists);
+			if(converted) {
 				// TODO: These should be ematerial::ALBEDO_MAP_IDENTIFIER/ematerial::NORMAL_MAP_IDENTIFIER/ematerial::PARALLAX_MAP_IDENTIFIER, but
 				// for some reason the linker complains about unresolved symbols?
 				rootData.AddData("albedo_map", std::make_shared<datasystem::Texture>(*settings, albedoTexName));
@@ -156,10 +163,9 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 				rootData.AddValue("int", "subsurface_method", "5");
 				rootData.AddValue("vector", "subsurface_radius", "112 52.8 1.6");
 			}
-
-			fh.AssignFloatValue(rootData, *fh.m_rootNode, "$eyeballradius", "eyeball_radius");
-			fh.AssignFloatValue(rootData, *fh.m_rootNode, "$dilation", "pupil_dilation");
 		}
+		fh.AssignFloatValue(rootData, *fh.m_rootNode, "$eyeballradius", "eyeball_radius");
+		fh.AssignFloatValue(rootData, *fh.m_rootNode, "$dilation", "pupil_dilation");
 	}
 	else if(pragma::string::compare<std::string>(vmtShader, "spritecard", false)) {
 		// Some Source Engine textures contain embedded animation sheet data.
@@ -183,57 +189,8 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 					if(fVtf.Load(&f, false)) {
 						vlUInt resSize;
 						auto *ptr = fVtf.GetResourceData(VTF_RSRC_SHEET, resSize);
-						if(ptr) {
-							pragma::util::DataStream ds {ptr, resSize};
-							ds->SetOffset(0);
-							auto version = ds->Read<int32_t>();
-							assert(version == 0 || version == 1);
-							auto numSequences = ds->Read<int32_t>();
-
-							SpriteSheetAnimation anim {};
-							auto &sequences = anim.sequences;
-							sequences.reserve(numSequences);
-							for(auto i = decltype(numSequences) {0}; i < numSequences; ++i) {
-								auto seqIdx = ds->Read<int32_t>();
-								if(seqIdx >= sequences.size())
-									sequences.resize(seqIdx + 1);
-								auto &seq = sequences.at(seqIdx);
-								seq.loop = !static_cast<bool>(ds->Read<int32_t>());
-								auto numFrames = ds->Read<int32_t>();
-								seq.frames.resize(numFrames);
-								auto sequenceLength = ds->Read<float>();
-								for(auto j = decltype(numFrames) {0}; j < numFrames; ++j) {
-									auto &frame = seq.frames.at(j);
-									frame.duration = ds->Read<float>();
-
-									auto constexpr MAX_IMAGES_PER_FRAME = 4u;
-									frame.uvStart = ds->Read<Vector2>();
-									frame.uvEnd = ds->Read<Vector2>();
-
-									// Animation data can contain multiple images per frame.
-									// I'm not sure what the purpose of that is (multi-texture?), but we'll ignore it for
-									// the time being.
-									if(version > 0)
-										ds->SetOffset(ds->GetOffset() + sizeof(Vector2) * 2 * (MAX_IMAGES_PER_FRAME - 1));
-#if 0
-										for(auto t=decltype(MAX_IMAGES_PER_FRAME){0u};t<MAX_IMAGES_PER_FRAME;++t)
-										{
-											auto &img = frame.images.at(t);
-											img.xMin = ds->Read<float>();
-											img.yMin = ds->Read<float>();
-											img.xMax = ds->Read<float>();
-											img.yMax = ds->Read<float>();
-
-											if(version == 0)
-											{
-												for(uint8_t i=1;i<MAX_IMAGES_PER_FRAME;++i)
-													frame.images.at(i) = img;
-												break;
-											}
-										}
-#endif
-								}
-							}
+						SpriteSheetAnimation anim {};
+						if(ptr && anim.LoadVtfSheetData(ptr, resSize)) {
 							auto sequenceFilePath = rootPath + pragma::util::Path::CreateFile(baseTexName + ".psd");
 							fs::create_path(sequenceFilePath.GetPath().data());
 							auto fSeq = fs::open_file<fs::VFilePtrReal>(sequenceFilePath.GetString().c_str(), fs::FileMode::Write | fs::FileMode::Binary);
@@ -283,11 +240,20 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 		auto &context = matManager.GetContext();
 		auto *shaderSSBumpMapToNormalMap = static_cast<ShaderSSBumpMapToNormalMap *>(context.GetShader("ssbumpmap_to_normalmap").get());
 		context.GetShaderManager().GetShader("copy_image"); // Make sure copy_image shader has been initialized
-		if(shaderSSBumpMapToNormalMap) {
+		if(shaderSSBumpMapToNormalMap && bumpMapTexture) {
 			auto &textureManager = matManager.GetTextureManager();
 
-			auto bumpMap = bumpMapTexture ? textureManager.LoadAsset(*bumpMapTexture) : nullptr;
-			if(bumpMap && bumpMap->HasValidVkTexture()) {
+			auto bumpMapTextureNoExt = *bumpMapTexture;
+			ufile::remove_extension_from_filename(bumpMapTextureNoExt);
+
+			auto normalTexName = bumpMapTextureNoExt + "_normal";
+
+			auto key = ImportConversionCache::CreateKey("source_ssbump_to_normal", {*bumpMapTexture});
+			auto converted = ImportConversionCache::Get().Convert(key, {normalTexName}, [&]() {
+				auto bumpMap = textureManager.LoadAsset(*bumpMapTexture);
+				if(!bumpMap || !bumpMap->HasValidVkTexture())
+					return false;
+
 				// Prepare output texture (normal map)
 				prosper::util::ImageCreateInfo imgCreateInfo {};
 				//imgCreateInfo.flags |= prosper::util::ImageCreateInfo::Flags::FullMipmapChain;
@@ -321,29 +287,22 @@ bool pragma::material::load_vmt_data(T &formatHandler, const std::string &vmtSha
 				}
 				context.FlushSetupCommandBuffer();
 
-				auto bumpMapTextureNoExt = *bumpMapTexture;
-				ufile::remove_extension_from_filename(bumpMapTextureNoExt);
-
-				auto normalTexName = bumpMapTextureNoExt + "_normal";
-
 				auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save converted ss bumpmap as DDS: " << err << std::endl; };
 
-				image::TextureInfo texInfo {};
-				texInfo.containerFormat = image::TextureInfo::ContainerFormat::DDS;
-				texInfo.alphaMode = image::TextureInfo::AlphaMode::None;
-				texInfo.flags = bor<image::TextureInfo::Flags>(texInfo.flags, image::TextureInfo::Flags::GenerateMipmaps);
-				texInfo.inputFormat = image::TextureInfo::InputFormat::R32G32B32A32_Float;
-				texInfo.outputFormat = image::TextureInfo::OutputFormat::NormalMap;
-				texInfo.SetNormalMap();
+				auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture((rootPath + ('/' + normalTexName)).GetString(), texNormal->GetImage(), texInfo, errHandler);
-
+				return true;
+			}, convertedTextureExists);
+			if(converted) {
 				// TODO: This should be ematerial::NORMAL_MAP_IDENTIFIER, but
 				// for some reason the linker complains about unresolved symbols?
 				rootData.AddData("normal_map", std::make_shared<datasystem::Texture>(*settings, normalTexName));
 			}
 		}
 	}
-	matManager.GetTextureManager().ClearUnused();
+	// During batch imports the textures are kept until the end of the batch, since they are likely to be shared between the materials
+	if(!matManager.IsImportBatchActive())
+		matManager.GetTextureManager().ClearUnused();
 	return true;
 }
 
@@ -71,8 +71,11 @@ std::shared_ptr<pragma::material::Material> pragma::material::CMaterial::Copy(bo
 	auto *ccpy = static_cast<CMaterial *>(cpy.get());
 	ccpy->m_primaryShader = m_primaryShader;
 	ccpy->m_sampler = m_sampler;
-	if(copyData)
+	if(copyData) {
 		ccpy->m_spriteSheetAnimation = m_spriteSheetAnimation;
+		ccpy->m_isSpriteSheetAnimationShared = m_spriteSheetAnimation.valid();
+		m_isSpriteSheetAnimationShared = ccpy->m_isSpriteSheetAnimationShared;
+	}
 	ccpy->m_stateFlags = m_stateFlags;
 	if(!copyData)
 		pragma::math::set_flag(ccpy->m_stateFlags, StateFlags::TexturesLoaded, false);
@@ -162,6 +165,7 @@ void pragma::material::CMaterial::Reset()
 	Material::Reset();
 	m_primaryShader = nullptr;
 	ResetRenderResources();
+	ClearSpriteSheetAnimation();
 	m_stateFlags = StateFlags::None;
 	// UpdatePrimaryShader();
 }
@@ -169,6 +173,7 @@ void pragma::material::CMaterial::Assign(const Material &other)
 {
 	Material::Assign(other);
 	UpdatePrimaryShader();
+	PreloadSpriteSheetAnimation();
 }
 void pragma::material::CMaterial::SetPrimaryShader(prosper::Shader &shader)
 {
@@ -208,24 +213,51 @@ void pragma::material::CMaterial::SetDescriptorSetGroup(prosper::Shader &shader,
 }
 uint32_t pragma::material::CMaterial::GetMipmapMode(const datasystem::Block &block) const { return pragma::math::to_integral(GetProperty<TextureMipmapMode>(block, "mipmap_load_mode", TextureMipmapMode::Load)); }
 void pragma::material::CMaterial::SetLoaded(bool b) { Material::SetLoaded(b); }
-void pragma::material::CMaterial::SetSpriteSheetAnimation(const SpriteSheetAnimation &animInfo) { m_spriteSheetAnimation = animInfo; }
-void pragma::material::CMaterial::ClearSpriteSheetAnimation() { m_spriteSheetAnimation = {}; }
-const pragma::material::SpriteSheetAnimation *pragma::material::CMaterial::GetSpriteSheetAnimation() const { return const_cast<CMaterial *>(this)->GetSpriteSheetAnimation(); }
-pragma::material::SpriteSheetAnimation *pragma::material::CMaterial::GetSpriteSheetAnimation()
+void pragma::material::CMaterial::SetSpriteSheetAnimation(const SpriteSheetAnimation &animInfo)
+{
+	std::promise<std::shared_ptr<SpriteSheetAnimation>> promise {};
+	promise.set_value(std::make_shared<SpriteSheetAnimation>(animInfo));
+	m_spriteSheetAnimation = promise.get_future().share();
+	m_isSpriteSheetAnimationShared = false;
+}
+void pragma::material::CMaterial::ClearSpriteSheetAnimation()
+{
+	m_spriteSheetAnimation = {};
+	m_isSpriteSheetAnimationShared = false;
+}
+void pragma::material::CMaterial::PreloadSpriteSheetAnimation()
+{
+	if(m_spriteSheetAnimation.valid())
+		return;
+	std::string animFilePath;
+	if(!GetProperty<std::string>("animation", &animFilePath))
+		return;
+	m_spriteSheetAnimation = static_cast<CMaterialManager &>(m_manager).GetSpriteSheetAnimationCache().Load("materials/" + animFilePath + ".psd");
+	m_isSpriteSheetAnimationShared = true;
+}
+bool pragma::material::CMaterial::IsSpriteSheetAnimationReady() const { return m_spriteSheetAnimation.valid() && m_spriteSheetAnimation.wait_for(std::chrono::seconds {0}) == std::future_status::ready; }
+const pragma::material::SpriteSheetAnimation *pragma::material::CMaterial::FindSpriteSheetAnimation() const { return IsSpriteSheetAnimationReady() ? m_spriteSheetAnimation.get().get() : nullptr; }
+const pragma::material::SpriteSheetAnimation *pragma::material::CMaterial::GetSpriteSheetAnimation() const
 {
-	if(m_spriteSheetAnimation.has_value() == false) {
+	if(!m_spriteSheetAnimation.valid()) {
 		// Lazy initialization
-		std::string animFilePath;
-		if(GetProperty<std::string>("animation", &animFilePath)) {
-			auto f = fs::open_file("materials/" + animFilePath + ".psd", fs::FileMode::Read | fs::FileMode::Binary);
-			m_spriteSheetAnimation = SpriteSheetAnimation {};
-			if(f == nullptr || m_spriteSheetAnimation->Load(f) == false)
-				m_spriteSheetAnimation = {};
-		}
+		const_cast<CMaterial *>(this)->PreloadSpriteSheetAnimation();
+		if(!m_spriteSheetAnimation.valid())
+			return nullptr;
+	}
+	return m_spriteSheetAnimation.get().get();
+}
+pragma::material::SpriteSheetAnimation *pragma::material::CMaterial::GetSpriteSheetAnimation()
+{
+	auto *anim = static_cast<const CMaterial *>(this)->GetSpriteSheetAnimation();
+	if(anim && m_isSpriteSheetAnimationShared) {
+		// The caller may modify the animation, so we need our own copy
+		SetSpriteSheetAnimation(*anim);
+		anim = m_spriteSheetAnimation.get().get();
 	}
-	return m_spriteSheetAnimation.has_value() ? &*m_spriteSheetAnimation : nullptr;
+	return const_cast<SpriteSheetAnimation *>(anim);
 }
-void pragma::material::CMaterial::LoadTexture(TextureMipmapMode mipmapMode, TextureInfo &texInfo, TextureLoadFlags loadFlags, const std::shared_ptr<CallbackInfo> &callbackInfo)
+void pragma::material::CMaterial::LoadTexture(TextureMipmapMode mipmapMode, TextureInfo &texInfo, TextureLoadFlags loadFlags, const std::shared_ptr<CallbackInfo> &callbackInfo, std::string_view identifier)
 {
 	if(texInfo.texture == nullptr) // Texture hasn't been initialized yet
 	{
@@ -235,6 +267,8 @@ void pragma::material::CMaterial::LoadTexture(TextureMipmapMode mipmapMode, Text
 		texInfo.texture = nullptr;
 		auto loadInfo = std::make_unique<TextureLoadInfo>();
 		loadInfo->mipmapMode = mipmapMode;
+		ApplyTextureResolutionLimit(*loadInfo, identifier);
+		textureManager.CheckCachedResolutionLimit(texInfo.name, *loadInfo);
 		if(!pragma::math::is_flag_set(loadFlags, TextureLoadFlags::LoadInstantly)) {
 			textureManager.PreloadAsset(texInfo.name, std::move(loadInfo));
 			return;
@@ -285,10 +319,10 @@ void pragma::material::CMaterial::SetTexture(const std::string &identifier, Text
 	auto dataTex = std::make_shared<datasystem::Texture>(*dsSettingsTmp, ""); // Data settings will be overwrriten by AddData-call below
 	auto &v = dataTex->GetValue();
 	v.texture = texture->shared_from_this();
-	v.width = texture->GetWidth();
-	v.height = texture->GetHeight();
+	v.SetSize(texture->GetWidth(), texture->GetHeight());
 	v.name = texture->GetName();
 	m_data->AddData(identifier, dataTex);
+	m_manager.UpdateDependencies(*this);
 
 	pragma::math::set_flag(Material::m_stateFlags, Material::StateFlags::TexturesUpdated, false);
 	UpdateTextures();
@@ -321,6 +355,19 @@ void pragma::material::CMaterial::OnTexturesUpdated()
 		// they may no longer be valid.
 		auto cb = tex.CallOnVkTextureChanged([this]() { ClearDescriptorSets(); });
 		m_onVkTexturesChanged.push_back(cb);
+
+		if(!texInfo.IsSizeResolved()) {
+			// Fill in the texture size once the image has been decoded, so we don't have to read the image header
+			std::weak_ptr<datasystem::Value> wpDsTex = pair.second;
+			tex.CallOnLoaded([wpDsTex](std::shared_ptr<Texture> tex) {
+				auto dsTex = wpDsTex.lock();
+				if(!dsTex || !tex)
+					return;
+				auto &texInfo = std::static_pointer_cast<datasystem::Texture>(dsTex)->GetValue();
+				if(!texInfo.IsSizeResolved())
+					texInfo.SetSize(tex->GetWidth(), tex->GetHeight());
+			});
+		}
 	}
 }
 
@@ -329,6 +376,7 @@ void pragma::material::CMaterial::SetTexture(const std::string &identifier, cons
 	auto dsSettingsTmp = datasystem::create_data_settings({});
 	auto dataTex = std::make_shared<datasystem::Texture>(*dsSettingsTmp, texture); // Data settings will be overwrriten by AddData-call below
 	m_data->AddData(identifier, dataTex);
+	m_manager.UpdateDependencies(*this);
 	pragma::math::set_flag(Material::m_stateFlags, Material::StateFlags::TexturesUpdated, false);
 	UpdateTextures();
 
@@ -360,20 +408,35 @@ void pragma::material::CMaterial::SetTexture(const std::string &identifier, pros
 
 bool pragma::material::CMaterial::HaveTexturesBeenInitialized() const { return pragma::math::is_flag_set(m_stateFlags, StateFlags::TexturesInitialized); }
 
-void pragma::material::CMaterial::LoadTexture(TextureInfo &texInfo, bool precache)
+void pragma::material::CMaterial::ApplyTextureResolutionLimit(TextureLoadInfo &loadInfo, std::string_view identifier) const
+{
+	loadInfo.usage = get_texture_usage(identifier);
+	auto maxResolution = get_texture_max_resolution(get_texture_quality_tier(), loadInfo.usage);
+	auto materialMaxResolution = m_data ? GetProperty<int32_t>(*m_data, "max_texture_resolution", 0) : 0;
+	if(materialMaxResolution > 0)
+		maxResolution = (maxResolution == 0) ? static_cast<uint32_t>(materialMaxResolution) : std::min(maxResolution, static_cast<uint32_t>(materialMaxResolution));
+	loadInfo.maxResolution = maxResolution;
+}
+std::unique_ptr<pragma::material::TextureLoadInfo> pragma::material::CMaterial::CreateTextureLoadInfo(const TextureInfo &texInfo, std::string_view identifier) const
 {
-	if(texInfo.name.empty() || texInfo.texture != nullptr)
-		return;
-	auto mipmapMode = static_cast<TextureMipmapMode>(GetMipmapMode(*m_data));
-	auto &textureManager = GetTextureManager();
 	auto loadInfo = std::make_unique<TextureLoadInfo>();
 	loadInfo->textureData = std::static_pointer_cast<udm::Property>(texInfo.userData);
-	loadInfo->mipmapMode = mipmapMode;
+	loadInfo->mipmapMode = static_cast<TextureMipmapMode>(GetMipmapMode(*m_data));
+	ApplyTextureResolutionLimit(*loadInfo, identifier);
 	if(loadInfo->textureData) {
 		auto cache = true;
 		if((*loadInfo->textureData)["cache"](cache) && !cache)
 			loadInfo->flags = pragma::util::AssetLoadFlags::IgnoreCache | pragma::util::AssetLoadFlags ::DontCache;
 	}
+	return loadInfo;
+}
+void pragma::material::CMaterial::LoadTexture(TextureInfo &texInfo, bool precache, std::string_view identifier)
+{
+	if(texInfo.name.empty() || texInfo.texture != nullptr)
+		return;
+	auto &textureManager = GetTextureManager();
+	auto loadInfo = CreateTextureLoadInfo(texInfo, identifier);
+	textureManager.CheckCachedResolutionLimit(texInfo.name, *loadInfo);
 	if(!precache)
 		texInfo.texture = textureManager.LoadAsset(texInfo.name, std::move(loadInfo));
 	else
@@ -430,7 +493,7 @@ void pragma::material::CMaterial::LoadTextures(datasystem::Block &data, bool pre
 		if(!value->IsBlock()) {
 			auto &type = typeid(*value);
 			if(type == typeTexture)
-				LoadTexture(std::static_pointer_cast<datasystem::Texture>(value)->GetValue(), precache);
+				LoadTexture(std::static_pointer_cast<datasystem::Texture>(value)->GetValue(), precache, it.first);
 			else
 				continue;
 		}
@@ -447,10 +510,38 @@ void pragma::material::CMaterial::LoadTextures(datasystem::Block &data, bool pre
 		std::static_pointer_cast<Texture>(texNormalMap->texture)->AddFlags(Texture::Flags::NormalMap);
 }
 
+static void collect_texture_infos(pragma::datasystem::Block &data, std::vector<std::pair<std::string_view, TextureInfo *>> &outTextures)
+{
+	const auto &typeTexture = typeid(pragma::datasystem::Texture);
+	for(auto &[key, value] : *data.GetData()) {
+		if(value->IsBlock())
+			collect_texture_infos(static_cast<pragma::datasystem::Block &>(*value), outTextures);
+		else if(typeid(*value) == typeTexture)
+			outTextures.push_back({key, &static_cast<pragma::datasystem::Texture &>(*value).GetValue()});
+	}
+}
+pragma::material::LoadHandle pragma::material::CMaterial::LoadTexturesAsync()
+{
+	if(!m_data)
+		return LoadHandle::CreateCompleted(true);
+	std::vector<std::pair<std::string_view, TextureInfo *>> textures;
+	collect_texture_infos(*m_data, textures);
+	auto &textureManager = GetTextureManager();
+	std::vector<LoadHandle> handles;
+	handles.reserve(textures.size());
+	for(auto &[identifier, texInfo] : textures) {
+		if(texInfo->name.empty() || texInfo->texture != nullptr)
+			continue;
+		handles.push_back(textureManager.LoadAssetAsync(texInfo->name, CreateTextureLoadInfo(*texInfo, identifier)));
+	}
+	return when_all(handles);
+}
+
 void pragma::material::CMaterial::Initialize(const std::shared_ptr<datasystem::Block> &data)
 {
 	Material::Initialize(data);
 	LoadTextures(true);
+	PreloadSpriteSheetAnimation();
 }
 
 void pragma::material::CMaterial::InitializeTextures(const std::shared_ptr<datasystem::Block> &data, const std::shared_ptr<CallbackInfo> &info, TextureLoadFlags loadFlags)
@@ -480,7 +571,7 @@ void pragma::material::CMaterial::InitializeTextures(const std::shared_ptr<datas
 						continue;
 					++info->count;
 
-					LoadTexture(mipmapMode, *texInfo, loadFlags, info);
+					LoadTexture(mipmapMode, *texInfo, loadFlags, info, name);
 					break;
 				}
 			}
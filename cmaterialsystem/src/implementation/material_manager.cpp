@@ -12,6 +12,8 @@ module;
 module pragma.cmaterialsystem;
 
 import :material_manager;
+import :format_handlers.import_texture;
+import :texture_manager.texture_quality;
 
 #undef max
 
@@ -103,6 +105,8 @@ void CMaterialManager::ReloadMaterialShaders()
 	}
 }
 
+void CMaterialManager::SetDownscaleImportedRMATextures(bool downscale) { pragma::material::set_texture_max_resolution(pragma::material::get_import_texture_quality_tier(), pragma::material::TextureUsage::Rma, downscale ? 1024 : 0); }
+
 bool CMaterialManager::InitializeVMTData(VTFLib::CVMTFile &vmt, LoadInfo &info, pragma::datasystem::Block &rootData, pragma::datasystem::Settings &settings, const std::string &shader)
 {
 	//TODO: These do not work if the textures haven't been imported yet!!
@@ -219,20 +223,16 @@ bool CMaterialManager::InitializeVMTData(VTFLib::CVMTFile &vmt, LoadInfo &info,
 
 				// TODO: Change width/height
 				auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-				pragma::image::TextureInfo texInfo {};
-				texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
+				auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Albedo, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				// The iris albedo may or may not have an alpha channel
 				texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::Auto;
-				texInfo.flags = pragma::image::TextureInfo::Flags::GenerateMipmaps;
-				texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt;
 				prosper::util::save_texture(rootPath + '/' + albedoTexName, texAlbedo->GetImage(), texInfo, errHandler);
 
-				texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::GradientMap;
-				texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R32G32B32A32_Float;
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::SingleChannel, pragma::image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture(rootPath + '/' + parallaxTexName, texParallax->GetImage(), texInfo, errHandler);
 				prosper::util::save_texture(rootPath + '/' + noiseTexName, texNoise->GetImage(), texInfo, errHandler);
 
-				texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::NormalMap;
-				texInfo.SetNormalMap();
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, pragma::image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture(rootPath + '/' + normalTexName, texNormal->GetImage(), texInfo, errHandler);
 
 				// TODO: These should be ematerial::ALBEDO_MAP_IDENTIFIER/ematerial::NORMAL_MAP_IDENTIFIER/ematerial::PARALLAX_MAP_IDENTIFIER, but
@@ -280,57 +280,8 @@ bool CMaterialManager::InitializeVMTData(VTFLib::CVMTFile &vmt, LoadInfo &info,
 						if(fVtf.Load(&f, false)) {
 							vlUInt resSize;
 							auto *ptr = fVtf.GetResourceData(VTF_RSRC_SHEET, resSize);
-							if(ptr) {
-								pragma::util::DataStream ds {ptr, resSize};
-								ds->SetOffset(0);
-								auto version = ds->Read<int32_t>();
-								assert(version == 0 || version == 1);
-								auto numSequences = ds->Read<int32_t>();
-
-								pragma::material::SpriteSheetAnimation anim {};
-								auto &sequences = anim.sequences;
-								sequences.reserve(numSequences);
-								for(auto i = decltype(numSequences) {0}; i < numSequences; ++i) {
-									auto seqIdx = ds->Read<int32_t>();
-									if(seqIdx >= sequences.size())
-										sequences.resize(seqIdx + 1);
-									auto &seq = sequences.at(seqIdx);
-									seq.loop = !static_cast<bool>(ds->Read<int32_t>());
-									auto numFrames = ds->Read<int32_t>();
-									seq.frames.resize(numFrames);
-									auto sequenceLength = ds->Read<float>();
-									for(auto j = decltype(numFrames) {0}; j < numFrames; ++j) {
-										auto &frame = seq.frames.at(j);
-										frame.duration = ds->Read<float>();
-
-										auto constexpr MAX_IMAGES_PER_FRAME = 4u;
-										frame.uvStart = ds->Read<Vector2>();
-										frame.uvEnd = ds->Read<Vector2>();
-
-										// Animation data can contain multiple images per frame.
-										// I'm not sure what the purpose of that is (multi-texture?), but we'll ignore it for
-										// the time being.
-										if(version > 0)
-											ds->SetOffset(ds->GetOffset() + sizeof(Vector2) * 2 * (MAX_IMAGES_PER_FRAME - 1));
-#if 0
-										for(auto t=decltype(MAX_IMAGES_PER_FRAME){0u};t<MAX_IMAGES_PER_FRAME;++t)
-										{
-											auto &img = frame.images.at(t);
-											img.xMin = ds->Read<float>();
-											img.yMin = ds->Read<float>();
-											img.xMax = ds->Read<float>();
-											img.yMax = ds->Read<float>();
-
-											if(version == 0)
-											{
-												for(uint8_t i=1;i<MAX_IMAGES_PER_FRAME;++i)
-													frame.images.at(i) = img;
-												break;
-											}
-										}
-#endif
-									}
-								}
+							pragma::material::SpriteSheetAnimation anim {};
+							if(ptr && anim.LoadVtfSheetData(ptr, resSize)) {
 								auto sequenceFilePath = pragma::util::Path {"addons/converted/" + MaterialManager::GetRootMaterialLocation() + '/' + baseTexName + ".psd"};
 								pragma::fs::create_path(sequenceFilePath.GetPath().data());
 								auto fSeq = pragma::fs::open_file<pragma::fs::VFilePtrReal>(sequenceFilePath.GetString().c_str(), pragma::fs::FileMode::Write | pragma::fs::FileMode::Binary);
@@ -437,13 +388,7 @@ bool CMaterialManager::InitializeVMTData(VTFLib::CVMTFile &vmt, LoadInfo &info,
 				auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save converted ss bumpmap as DDS: " << err << std::endl; };
 
 				auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-				pragma::image::TextureInfo texInfo {};
-				texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-				texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::None;
-				texInfo.flags |= pragma::image::TextureInfo::Flags::GenerateMipmaps;
-				texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R32G32B32A32_Float;
-				texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::NormalMap;
-				texInfo.SetNormalMap();
+				auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, pragma::image::TextureInfo::InputFormat::R32G32B32A32_Float);
 				prosper::util::save_texture(rootPath + '/' + normalTexName, texNormal->GetImage(), texInfo, errHandler);
 
 				// TODO: This should be ematerial::NORMAL_MAP_IDENTIFIER, but
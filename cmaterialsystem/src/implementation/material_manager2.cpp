@@ -50,6 +50,127 @@ void pragma::material::CMaterialManager::InitializeImportHandlers()
 	RegisterImportHandler<CSource2VmatFormatHandler>("vmat_c");
 #endif
 }
+void pragma::material::CMaterialManager::InitializeFileWatcher(AssetFileWatcher &watcher)
+{
+	MaterialManager::InitializeFileWatcher(watcher);
+	std::vector<std::string> extensions;
+	auto &formats = ::MaterialManager::get_supported_image_formats();
+	extensions.reserve(formats.size() + 1);
+	for(auto &format : formats)
+		extensions.push_back(format.extension);
+	extensions.push_back("svg");
+	watcher.AddHandler(extensions, [this](const std::string &identifier, const std::string &ext) {
+		auto path = m_textureManager->GetRootDirectory().GetString() + '/' + identifier + '.' + ext;
+		invalidate_image_header_cache(path);
+		if(ext == "psd")
+			m_spriteSheetAnimationCache.Invalidate(path); // May be a sprite sheet animation file
+
+		// Materials using the texture will be notified through Texture::CallOnVkTextureChanged
+		if(m_textureManager->FindCachedAsset(identifier)) {
+			m_textureManager->ReloadAsset(identifier);
+			return;
+		}
+		// The texture may not have existed when the materials using it were loaded
+		ReloadDependents({AssetDependencyGraph::AssetType::Texture, identifier});
+	});
+}
+bool pragma::material::CMaterialManager::IsAssetInUse(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Texture)
+		return MaterialManager::IsAssetInUse(id);
+	auto *asset = m_textureManager->FindCachedAsset(id.name);
+	if(!asset)
+		return false;
+	// One reference is held by the cache, one by us
+	auto tex = m_textureManager->GetAssetObject(*asset);
+	return tex && tex.use_count() > 2;
+}
+void pragma::material::CMaterialManager::EvictAsset(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Texture) {
+		MaterialManager::EvictAsset(id);
+		return;
+	}
+	m_textureManager->RemoveFromCache(id.name);
+}
+std::optional<std::string> pragma::material::CMaterialManager::ResolveAssetFilePath(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Texture)
+		return MaterialManager::ResolveAssetFilePath(id);
+	auto path = m_textureManager->FindAssetFilePath(id.name);
+	if(!path)
+		return {};
+	return m_textureManager->GetRootDirectory().GetString() + '/' + *path;
+}
+pragma::material::LoadHandle pragma::material::CMaterialManager::PrefetchAsset(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Texture)
+		return MaterialManager::PrefetchAsset(id);
+	return m_textureManager->LoadAssetAsync(id.name);
+}
+pragma::material::LoadHandle pragma::material::CMaterialManager::LoadMaterialWithTexturesAsync(const std::string &path)
+{
+	auto hMaterial = LoadAssetAsync(path);
+	LoadPromise promise {};
+	promise.AddDependency(hMaterial);
+	auto identifier = ToCacheIdentifier(path);
+	hMaterial.Then(
+	  [this, promise, identifier](bool success) mutable {
+		  auto *asset = success ? FindCachedAsset(identifier) : nullptr;
+		  auto mat = asset ? GetAssetObject(*asset) : nullptr;
+		  if(!mat) {
+			  promise.Complete(false);
+			  return;
+		  }
+		  auto hTextures = static_cast<CMaterial &>(*mat).LoadTexturesAsync();
+		  promise.AddDependency(hTextures);
+		  hTextures.Then([promise](bool success) mutable { promise.Complete(success); });
+	  },
+	  CallbackThread::Main);
+	return promise.GetHandle();
+}
+void pragma::material::CMaterialManager::BeginImportBatch() { ++m_importBatchDepth; }
+void pragma::material::CMaterialManager::EndImportBatch()
+{
+	if(m_importBatchDepth == 0 || --m_importBatchDepth > 0)
+		return;
+	// Loaders of a timed out batch are still running and may be about to use the textures that are currently unused
+	if(m_importBatchTimedOut.exchange(false))
+		return;
+	m_textureManager->ClearUnused();
+}
+uint32_t pragma::material::CMaterialManager::ImportMaterialBatch(const std::vector<std::string> &materials, std::chrono::milliseconds timeout)
+{
+	BeginImportBatch();
+	auto timedOut = false;
+	auto numSuccessful = LoadAssetBatch(materials, timeout, &timedOut);
+	if(timedOut)
+		m_importBatchTimedOut = true;
+	EndImportBatch();
+	if(timedOut)
+		std::cout << "WARNING: Import batch of " << materials.size() << " materials has timed out, " << numSuccessful << " have been imported successfully." << std::endl;
+	return numSuccessful;
+}
+uint32_t pragma::material::CMaterialManager::ImportVmtDirectory(const std::string &rootPath, const std::string &materialRoot, uint32_t *optOutFileCount, std::chrono::milliseconds timeout)
+{
+	std::vector<std::string> materials;
+	std::error_code ec;
+	for(auto it = std::filesystem::recursive_directory_iterator {rootPath, ec}; !ec && it != std::filesystem::recursive_directory_iterator {}; it.increment(ec)) {
+		if(!it->is_regular_file(ec))
+			continue;
+		auto ext = it->path().extension().generic_string();
+		pragma::string::to_lower(ext);
+		if(ext != ".vmt")
+			continue;
+		auto relPath = std::filesystem::relative(it->path(), rootPath, ec).replace_extension().generic_string();
+		if(ec)
+			break;
+		materials.push_back(materialRoot.empty() ? relPath : (materialRoot + '/' + relPath));
+	}
+	if(optOutFileCount)
+		*optOutFileCount = materials.size();
+	return ImportMaterialBatch(materials, timeout);
+}
 void pragma::material::CMaterialManager::SetShaderHandler(const std::function<void(Material *)> &handler) { m_shaderHandler = handler; }
 void pragma::material::CMaterialManager::ReloadMaterialShaders()
 {
@@ -69,6 +190,8 @@ void pragma::material::CMaterialManager::Poll()
 {
 	MaterialManager::Poll();
 	m_textureManager->Poll();
+	// Texture load callbacks may have queued main thread callbacks
+	dispatch_main_thread_callbacks();
 	if(!m_reloadShaderQueue.empty()) {
 		std::unordered_set<Material *> traversed;
 		while(!m_reloadShaderQueue.empty()) {
@@ -4,6 +4,10 @@
 module pragma.cmaterialsystem;
 
 import :material_manager;
+import :format_handlers.import_conversion_cache;
+import :format_handlers.import_texture;
+import :format_handlers.source2_vmat;
+import :texture_manager.texture_quality;
 
 #ifndef DISABLE_VMAT_SUPPORT
 
@@ -29,9 +33,6 @@ static std::shared_ptr<prosper::Texture> get_texture(CMaterialManager &matManage
 	return load_texture(matManager, dsMap->GetString());
 }
 
-static bool g_downScaleRMATextures = true;
-void CMaterialManager::SetDownscaleImportedRMATextures(bool downscale) { g_downScaleRMATextures = downscale; }
-
 bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource, source2::resource::Material &vmat, LoadInfo &info, pragma::datasystem::Block &rootData, pragma::datasystem::Settings &settings, const std::string &shader, VMatOrigin origin)
 {
 	//TODO: These do not work if the textures haven't been imported yet!!
@@ -44,6 +45,7 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 	auto isSource2Mat = (origin == VMatOrigin::Source2);
 
 	auto &context = GetContext();
+	auto convertedTextureExists = [](const std::string &texPath) { return pragma::material::ImportConversionCache::TextureFileExists("addons/converted/" + MaterialManager::GetRootMaterialLocation() + '/' + texPath); };
 
 	auto *shaderExtractImageChannel = static_cast<pragma::material::ShaderExtractImageChannel *>(context.GetShader("extract_image_channel").get());
 	if(isSteamVrMat) {
@@ -54,10 +56,16 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 			if(shaderDecomposeMetalnessReflectance) {
 				auto &textureManager = GetTextureManager();
 
-				std::shared_ptr<void> normalMap = nullptr;
 				auto metalnessReflectancePath = vmat::get_vmat_texture_path(*metalnessMap).GetString();
-				auto pMetalnessReflectanceMap = textureManager.LoadAsset(metalnessReflectancePath);
-				if(pMetalnessReflectanceMap && pMetalnessReflectanceMap->HasValidVkTexture()) {
+				auto pathNoExt = metalnessReflectancePath;
+				ufile::remove_extension_from_filename(pathNoExt);
+				auto rmaPath = pathNoExt + "_rma";
+
+				auto key = pragma::material::ImportConversionCache::CreateKey("source2_decompose_metalness_reflectance", {metalnessReflectancePath});
+				auto converted = pragma::material::ImportConversionCache::Get().Convert(key, {rmaPath}, [&]() {
+					auto pMetalnessReflectanceMap = textureManager.LoadAsset(metalnessReflectancePath);
+					if(pMetalnessReflectanceMap == nullptr || pMetalnessReflectanceMap->HasValidVkTexture() == false)
+						return false;
 					prosper::util::ImageCreateInfo imgCreateInfo {};
 					//imgCreateInfo.flags |= prosper::util::ImageCreateInfo::Flags::FullMipmapChain;
 					imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
@@ -90,21 +98,15 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 					}
 					context.FlushSetupCommandBuffer();
 
-					auto pathNoExt = metalnessReflectancePath;
-					ufile::remove_extension_from_filename(pathNoExt);
-
 					auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save map image as DDS: " << err << std::endl; };
 
 					// TODO: Change width/height
 					auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-					pragma::image::TextureInfo texInfo {};
-					texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-					texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::Auto;
-					texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-					texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMap;
-					auto rmaPath = pathNoExt + "_rma";
+					auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
 					prosper::util::save_texture(rootPath + '/' + rmaPath, texRMA->GetImage(), texInfo, errHandler);
-
+					return true;
+				}, convertedTextureExists);
+				if(converted) {
 					rootData.AddData("rma_map", std::make_shared<pragma::datasystem::Texture>(settings, rmaPath));
 
 					auto rmaInfo = rootData.AddBlock("rma_info");
@@ -114,15 +116,28 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 		}
 	}
 	else if(isDota2Mat) {
-		std::cout << "TODO" << std::endl;
+		auto *masks1 = vmat.FindTextureParam("g_tMasks1");
+		if(masks1) {
+			auto rmaPath = pragma::material::convert_dota2_masks_to_rma(context, vmat::get_vmat_texture_path(*masks1).GetString(), "addons/converted/" + MaterialManager::GetRootMaterialLocation(),
+			  [this](const std::string &texPath) { return load_texture(*this, texPath); });
+			if(rmaPath) {
+				rootData.AddData("rma_map", std::make_shared<pragma::datasystem::Texture>(settings, *rmaPath));
+
+				auto rmaInfo = rootData.AddBlock("rma_info");
+				rmaInfo->AddValue("bool", "requires_ao_update", "1");
+			}
+		}
 	}
 	else {
 		auto *shaderDecomposePbr = static_cast<pragma::material::source2::ShaderDecomposePBR *>(context.GetShader("source2_decompose_pbr").get());
 		std::string texPath;
+		std::string normalMapPath;
 		auto albedoTex = get_texture(*this, rootData, "albedo_map", &texPath);
-		auto normalTex = get_texture(*this, rootData, "normal_map");
-		if(normalTex == nullptr)
+		auto normalTex = get_texture(*this, rootData, "normal_map", &normalMapPath);
+		if(normalTex == nullptr) {
 			normalTex = load_texture(*this, "white");
+			normalMapPath = "white";
+		}
 		if(albedoTex && normalTex) {
 			auto &textureManager = GetTextureManager();
 
@@ -130,6 +145,7 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 			ufile::remove_extension_from_filename(pathNoExt);
 
 			prosper::Texture *anisoGlossMap = nullptr;
+			std::string anisoGlossMapPath;
 
 			// Decompose Source 2 textures into albedo and metalness-roughness
 			auto *alphaTest = vmat.FindIntParam("F_ALPHA_TEST");
@@ -151,9 +167,13 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 					anisoGlossMap = load_texture(*this, path.GetString()).get();
 					if(anisoGlossMap == nullptr)
 						pragma::math::set_flag(flags, pragma::material::source2::ShaderDecomposePBR::Flags::SpecularWorkflow, false);
+					else
+						anisoGlossMapPath = path.GetString();
 				}
-				else
+				else {
 					anisoGlossMap = normalTex.get();
+					anisoGlossMapPath = normalMapPath;
+				}
 			}
 
 			// Note: While the original roughness and metalness maps have the
@@ -163,17 +183,20 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 			prosper::Extent2D metallicRoughnessResolution {};
 			auto *s2AoMap = vmat.FindTextureParam("g_tAmbientOcclusion");
 			prosper::Texture *aoTex = nullptr;
+			std::string aoMapPath;
 			if(s2AoMap) {
 				pragma::util::Path path {*s2AoMap};
 				path.RemoveFileExtension();
 				path += ".vtex_c";
 
-				aoTex = load_texture(*this, path.GetString()).get();
+				aoMapPath = path.GetString();
+				aoTex = load_texture(*this, aoMapPath).get();
 			}
 
 			auto hasAoMap = true;
 			if(aoTex == nullptr) {
 				aoTex = load_texture(*this, "white").get();
+				aoMapPath = "white";
 				hasAoMap = false;
 
 				auto &albedoImg = albedoTex->GetImage();
@@ -190,56 +213,54 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 				metallicRoughnessResolution = {static_cast<uint32_t>(extents.width), static_cast<uint32_t>(extents.height)};
 			}
 
-			auto pbrSet = shaderDecomposePbr->DecomposePBR(context, *albedoTex, *normalTex, *aoTex, flags, anisoGlossMap);
+			// The RMA map is baked at the resolution limit of the import quality tier
+			auto maxRmaResolution = pragma::material::get_texture_max_resolution(pragma::material::get_import_texture_quality_tier(), pragma::material::TextureUsage::Rma);
+			if(maxRmaResolution > 0) {
+				metallicRoughnessResolution.width = std::min(metallicRoughnessResolution.width, maxRmaResolution);
+				metallicRoughnessResolution.height = std::min(metallicRoughnessResolution.height, maxRmaResolution);
+			}
 
 			auto albedoPath = pathNoExt + "_albedo";
-			auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-			pragma::image::TextureInfo texInfo {};
-			texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-			texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::None;
-			texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMap;
+			auto metalnessRoughnessPath = pathNoExt + "_rma";
 			auto useAlpha = pragma::math::is_flag_set(flags, pragma::material::source2::ShaderDecomposePBR::Flags::TreatAlphaAsTransparency);
-			if(useAlpha) {
-				texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::Transparency;
-				texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMapSmoothAlpha;
-			}
-			texInfo.flags = pragma::image::TextureInfo::Flags::GenerateMipmaps;
-			texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-			prosper::util::save_texture(rootPath + '/' + albedoPath, *pbrSet.albedoMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
-
-			// TODO
-			if(metallicRoughnessResolution.width > 1'024)
-				metallicRoughnessResolution.width = 1'024;
-			if(metallicRoughnessResolution.height > 1'024)
-				metallicRoughnessResolution.height = 1'024;
-
-			auto mrExtents = pbrSet.rmaMap->GetExtents();
-			if(g_downScaleRMATextures && mrExtents.width > metallicRoughnessResolution.width && mrExtents.height > metallicRoughnessResolution.height) {
-				std::cout << "Downscaling RMA map for '" << info.identifier << "' from " << mrExtents.width << "x" << mrExtents.height << " to " << metallicRoughnessResolution.width << "x" << metallicRoughnessResolution.height << std::endl;
-				prosper::util::ImageCreateInfo imgCreateInfo {};
-				imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
-				imgCreateInfo.memoryFeatures = prosper::MemoryFeatureFlags::GPUBulk;
-				imgCreateInfo.postCreateLayout = prosper::ImageLayout::TransferDstOptimal;
-				imgCreateInfo.tiling = prosper::ImageTiling::Optimal;
-				imgCreateInfo.usage = prosper::ImageUsageFlags::TransferDstBit;
-
-				imgCreateInfo.width = metallicRoughnessResolution.width;
-				imgCreateInfo.height = metallicRoughnessResolution.height;
-				auto imgRescaled = context.CreateImage(imgCreateInfo);
-				auto &setupCmd = context.GetSetupCommandBuffer();
-				prosper::util::BlitInfo blitInfo {};
-				blitInfo.extentsSrc = mrExtents;
-				blitInfo.extentsDst = metallicRoughnessResolution;
-				setupCmd->RecordImageBarrier(*pbrSet.rmaMap, prosper::ImageLayout::ShaderReadOnlyOptimal, prosper::ImageLayout::TransferSrcOptimal);
-				setupCmd->RecordBlitImage(blitInfo, *pbrSet.rmaMap, *imgRescaled);
-				context.FlushSetupCommandBuffer();
-
-				pbrSet.rmaMap = imgRescaled;
-			}
 
-			auto metalnessRoughnessPath = pathNoExt + "_rma";
-			texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMap;
-			prosper::util::save_texture(rootPath + '/' + metalnessRoughnessPath, *pbrSet.rmaMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save RMA image as DDS: " << err << std::endl; });
+			auto params = "flags=" + std::to_string(pragma::math::to_integral(flags)) + ";rma=" + std::to_string(metallicRoughnessResolution.width) + "x" + std::to_string(metallicRoughnessResolution.height);
+			auto key = pragma::material::ImportConversionCache::CreateKey("source2_decompose_pbr", {texPath, normalMapPath, aoMapPath, anisoGlossMapPath}, params);
+			pragma::material::ImportConversionCache::Get().Convert(key, {albedoPath, metalnessRoughnessPath}, [&]() {
+				auto pbrSet = shaderDecomposePbr->DecomposePBR(context, *albedoTex, *normalTex, *aoTex, flags, anisoGlossMap);
+
+				auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
+				auto texInfo = pragma::material::get_import_texture_info(useAlpha ? pragma::material::ImportTextureUsage::AlbedoWithAlpha : pragma::material::ImportTextureUsage::Albedo, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				prosper::util::save_texture(rootPath + '/' + albedoPath, *pbrSet.albedoMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+
+				auto mrExtents = pbrSet.rmaMap->GetExtents();
+				if(mrExtents.width > metallicRoughnessResolution.width && mrExtents.height > metallicRoughnessResolution.height) {
+					std::cout << "Downscaling RMA map for '" << info.identifier << "' from " << mrExtents.width << "x" << mrExtents.height << " to " << metallicRoughnessResolution.width << "x" << metallicRoughnessResolution.height << std::endl;
+					prosper::util::ImageCreateInfo imgCreateInfo {};
+					imgCreateInfo.format = prosper::Format::R8G8B8A8_UNorm;
+					imgCreateInfo.memoryFeatures = prosper::MemoryFeatureFlags::GPUBulk;
+					imgCreateInfo.postCreateLayout = prosper::ImageLayout::TransferDstOptimal;
+					imgCreateInfo.tiling = prosper::ImageTiling::Optimal;
+					imgCreateInfo.usage = prosper::ImageUsageFlags::TransferDstBit;
+
+					imgCreateInfo.width = metallicRoughnessResolution.width;
+					imgCreateInfo.height = metallicRoughnessResolution.height;
+					auto imgRescaled = context.CreateImage(imgCreateInfo);
+					auto &setupCmd = context.GetSetupCommandBuffer();
+					prosper::util::BlitInfo blitInfo {};
+					blitInfo.extentsSrc = mrExtents;
+					blitInfo.extentsDst = metallicRoughnessResolution;
+					setupCmd->RecordImageBarrier(*pbrSet.rmaMap, prosper::ImageLayout::ShaderReadOnlyOptimal, prosper::ImageLayout::TransferSrcOptimal);
+					setupCmd->RecordBlitImage(blitInfo, *pbrSet.rmaMap, *imgRescaled);
+					context.FlushSetupCommandBuffer();
+
+					pbrSet.rmaMap = imgRescaled;
+				}
+
+				texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+				prosper::util::save_texture(rootPath + '/' + metalnessRoughnessPath, *pbrSet.rmaMap, texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save RMA image as DDS: " << err << std::endl; });
+				return true;
+			}, convertedTextureExists);
 
 			rootData.AddData("albedo_map", std::make_shared<pragma::datasystem::Texture>(settings, albedoPath));
 			rootData.AddData("rma_map", std::make_shared<pragma::datasystem::Texture>(settings, metalnessRoughnessPath));
@@ -275,26 +296,33 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 					ufile::remove_extension_from_filename(pathNoExt);
 
 					auto albedoPath = pathNoExt;
-					auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-					pragma::image::TextureInfo texInfo {};
-					texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-					texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::None;
-					texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMap;
-					texInfo.flags = pragma::image::TextureInfo::Flags::GenerateMipmaps;
-					texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt;
-					prosper::util::save_texture(rootPath + '/' + albedoPath, albedoTex->GetImage(), texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+					auto key = pragma::material::ImportConversionCache::CreateKey("source2_albedo", {texPath});
+					pragma::material::ImportConversionCache::Get().Convert(key, {albedoPath}, [&]() {
+						auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
+						auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Albedo, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
+						prosper::util::save_texture(rootPath + '/' + albedoPath, albedoTex->GetImage(), texInfo, [](const std::string &err) { std::cout << "WARNING: Unable to save albedo image as DDS: " << err << std::endl; });
+						return true;
+					}, convertedTextureExists);
 				}
 
 				pragma::material::source2::ShaderGenerateTangentSpaceNormalMap *shaderGenerateTangentSpaceNormalMap = nullptr;
-				if(isSteamVrMat || isDota2Mat)
-					shaderGenerateTangentSpaceNormalMap = static_cast<pragma::material::source2::ShaderGenerateTangentSpaceNormalMapProto *>(context.GetShader("source2_generate_tangent_space_normal_map_proto").get());
+				auto useProtoShader = (isSteamVrMat || isDota2Mat);
+				std::string shaderName = useProtoShader ? "source2_generate_tangent_space_normal_map_proto" : "source2_generate_tangent_space_normal_map";
+				if(useProtoShader)
+					shaderGenerateTangentSpaceNormalMap = static_cast<pragma::material::source2::ShaderGenerateTangentSpaceNormalMapProto *>(context.GetShader(shaderName).get());
 				else
-					shaderGenerateTangentSpaceNormalMap = static_cast<pragma::material::source2::ShaderGenerateTangentSpaceNormalMap *>(context.GetShader("source2_generate_tangent_space_normal_map").get());
+					shaderGenerateTangentSpaceNormalMap = static_cast<pragma::material::source2::ShaderGenerateTangentSpaceNormalMap *>(context.GetShader(shaderName).get());
 				if(shaderGenerateTangentSpaceNormalMap) {
 					auto &textureManager = GetTextureManager();
 
-					auto pNormalMap = textureManager.LoadAsset(normalMapPath);
-					if(pNormalMap && pNormalMap->HasValidVkTexture()) {
+					auto normalMapPathNoExt = normalMapPath;
+					ufile::remove_extension_from_filename(normalMapPathNoExt);
+
+					auto key = pragma::material::ImportConversionCache::CreateKey("source2_tangent_space_normal_map", {normalMapPath}, "shader=" + shaderName);
+					auto converted = pragma::material::ImportConversionCache::Get().Convert(key, {normalMapPathNoExt}, [&]() {
+						auto pNormalMap = textureManager.LoadAsset(normalMapPath);
+						if(pNormalMap == nullptr || pNormalMap->HasValidVkTexture() == false)
+							return false;
 						prosper::util::ImageCreateInfo imgCreateInfo {};
 						//imgCreateInfo.flags |= prosper::util::ImageCreateInfo::Flags::FullMipmapChain;
 						imgCreateInfo.format = prosper::Format::R16G16B16A16_SFloat;
@@ -327,24 +355,18 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 						}
 						context.FlushSetupCommandBuffer();
 
-						auto normalMapPathNoExt = normalMapPath;
-						ufile::remove_extension_from_filename(normalMapPathNoExt);
-
 						auto errHandler = [](const std::string &err) { std::cout << "WARNING: Unable to save normal map image as DDS: " << err << std::endl; };
 
 						// TODO: Change width/height
 						auto rootPath = "addons/converted/" + MaterialManager::GetRootMaterialLocation();
-						pragma::image::TextureInfo texInfo {};
-						texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-						texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::Auto;
-						texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R16G16B16A16_Float;
-						texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::NormalMap;
-						texInfo.SetNormalMap();
+						auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, pragma::image::TextureInfo::InputFormat::R16G16B16A16_Float);
 						prosper::util::save_texture(rootPath + '/' + normalMapPathNoExt, texNormal->GetImage(), texInfo, errHandler);
 
 						load_texture(*this, normalMapPathNoExt, true);
+						return true;
+					}, convertedTextureExists);
+					if(converted)
 						rootData.AddData("normal_map", std::make_shared<pragma::datasystem::Texture>(settings, normalMapPathNoExt));
-					}
 				}
 			}
 #if 0
@@ -407,14 +429,7 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 						};
 
 						auto rootPath = "addons/converted/" +MaterialManager::GetRootMaterialLocation();
-						pragma::image::TextureInfo texInfo {};
-						texInfo.containerFormat = pragma::image::TextureInfo::ContainerFormat::DDS;
-						texInfo.alphaMode = pragma::image::TextureInfo::AlphaMode::None;
-						texInfo.flags = pragma::image::TextureInfo::Flags::GenerateMipmaps;
-						texInfo.inputFormat = pragma::image::TextureInfo::InputFormat::R16G16B16A16_Float;
-						texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::NormalMap;
-						auto nmapTexInfo = texInfo;
-						nmapTexInfo.SetNormalMap();
+						auto nmapTexInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::NormalMap, pragma::image::TextureInfo::InputFormat::R16G16B16A16_Float);
 						prosper::util::save_texture(rootPath +'/' +bumpMapTextureNoExt,*texNormal->GetImage(),nmapTexInfo,errHandler);
 
 						// Reload the normal map
@@ -432,7 +447,7 @@ bool CMaterialManager::InitializeVMatData(source2::resource::Resource &resource,
 								pragma::material::ShaderExtractImageChannel::Channel::One /* Alpha */
 							},pragma::material::ShaderExtractImageChannel::Pipeline::RGBA8
 						);
-						texInfo.outputFormat = pragma::image::TextureInfo::OutputFormat::ColorMap;
+						auto texInfo = pragma::material::get_import_texture_info(pragma::material::ImportTextureUsage::Rma, pragma::image::TextureInfo::InputFormat::R8G8B8A8_UInt);
 						prosper::util::save_texture(rootPath +'/' +rmaPath,*imgRma,texInfo,errHandler);
 
 						rootData.AddData("rma_map",std::make_shared<pragma::datasystem::Texture>(settings,rmaPath));
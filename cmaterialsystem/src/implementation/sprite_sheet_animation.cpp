@@ -47,27 +47,92 @@ void pragma::material::SpriteSheetAnimation::UpdateLookupData()
 	}
 }
 bool pragma::material::SpriteSheetAnimation::Load(std::shared_ptr<fs::VFilePtrInternal> &f)
+{
+	fs::File file {f};
+	return Load(file);
+}
+bool pragma::material::SpriteSheetAnimation::Load(ufile::IFile &f)
 {
 	// TODO: Transition to UDM
-	auto header = f->Read<std::array<char, 3>>();
-	if(header != PSD_HEADER)
+	auto read = [&f](auto &out) -> bool { return f.Read(&out, sizeof(out)) == sizeof(out); };
+	std::array<char, 3> header;
+	uint32_t version;
+	if(!read(header) || header != PSD_HEADER || !read(version) || version != 0)
 		return false;
-	auto version = f->Read<uint32_t>();
-	if(version != 0)
+	// The counts are validated against the remaining file size, so that a corrupt file can't trigger huge allocations
+	constexpr size_t SEQUENCE_HEADER_SIZE = sizeof(bool) + sizeof(uint32_t);
+	constexpr size_t FRAME_SIZE = sizeof(Vector2) * 2 + sizeof(float);
+	auto size = f.GetSize();
+	auto getRemainingSize = [&f, size]() -> size_t {
+		auto offset = f.Tell();
+		return (offset < size) ? (size - offset) : 0;
+	};
+	uint32_t numSequences;
+	if(!read(numSequences) || numSequences > getRemainingSize() / SEQUENCE_HEADER_SIZE)
 		return false;
-	auto numSequences = f->Read<uint32_t>();
-	sequences.resize(numSequences);
-	for(auto &seq : sequences) {
-		seq.loop = f->Read<bool>();
-		auto numFrames = f->Read<uint32_t>();
+	std::vector<Sequence> newSequences;
+	newSequences.resize(numSequences);
+	for(auto &seq : newSequences) {
+		uint32_t numFrames;
+		if(!read(seq.loop) || !read(numFrames) || numFrames > getRemainingSize() / FRAME_SIZE)
+			return false;
 		auto &frames = seq.frames;
 		frames.resize(numFrames);
 		for(auto &frame : frames) {
-			frame.uvStart = f->Read<Vector2>();
-			frame.uvEnd = f->Read<Vector2>();
-			frame.duration = f->Read<float>();
+			if(!read(frame.uvStart) || !read(frame.uvEnd) || !read(frame.duration))
+				return false;
+		}
+	}
+	sequences = std::move(newSequences);
+	UpdateLookupData();
+	return true;
+}
+bool pragma::material::SpriteSheetAnimation::LoadVtfSheetData(const void *data, size_t size)
+{
+	// Source Engine limits
+	constexpr int32_t MAX_SEQUENCES = 64;
+	constexpr uint32_t MAX_IMAGES_PER_FRAME = 4;
+	auto *bytes = static_cast<const uint8_t *>(data);
+	size_t offset = 0;
+	auto read = [bytes, size, &offset](auto &out) -> bool {
+		if(size - offset < sizeof(out))
+			return false;
+		std::memcpy(&out, bytes + offset, sizeof(out));
+		offset += sizeof(out);
+		return true;
+	};
+	int32_t version, numSequences;
+	if(!read(version) || !read(numSequences) || (version != 0 && version != 1) || numSequences < 0 || numSequences > MAX_SEQUENCES)
+		return false;
+	// Animation data can contain multiple images per frame.
+	// I'm not sure what the purpose of that is (multi-texture?), but we'll ignore it for
+	// the time being.
+	auto frameSize = sizeof(float) + sizeof(Vector2) * 2 * ((version > 0) ? MAX_IMAGES_PER_FRAME : 1);
+
+	std::vector<Sequence> newSequences;
+	newSequences.reserve(numSequences);
+	for(auto i = decltype(numSequences) {0}; i < numSequences; ++i) {
+		int32_t seqIdx, clamp, numFrames;
+		float sequenceLength;
+		if(!read(seqIdx) || !read(clamp) || !read(numFrames) || !read(sequenceLength))
+			return false;
+		if(seqIdx < 0 || seqIdx >= MAX_SEQUENCES || numFrames < 0 || static_cast<size_t>(numFrames) > (size - offset) / frameSize)
+			return false;
+		auto idx = static_cast<size_t>(seqIdx);
+		if(idx >= newSequences.size())
+			newSequences.resize(idx + 1);
+		auto &seq = newSequences[idx];
+		seq.loop = !static_cast<bool>(clamp);
+		seq.frames.resize(numFrames);
+		for(auto &frame : seq.frames) {
+			auto frameOffset = offset;
+			read(frame.duration);
+			read(frame.uvStart);
+			read(frame.uvEnd);
+			offset = frameOffset + frameSize;
 		}
 	}
+	sequences = std::move(newSequences);
 	UpdateLookupData();
 	return true;
 }
@@ -103,3 +168,76 @@ bool pragma::material::SpriteSheetAnimation::Sequence::GetInterpolatedFrameData(
 	}
 	return true;
 }
+
+pragma::material::SpriteSheetAnimationCache::SpriteSheetAnimationCache(const FileOpener &fileOpener) : m_fileOpener {fileOpener} {}
+std::unique_ptr<ufile::IFile> pragma::material::SpriteSheetAnimationCache::OpenFile(const FileOpener &fileOpener, const std::string &fileName)
+{
+	if(fileOpener)
+		return fileOpener(fileName);
+	auto fp = fs::open_file(fileName, fs::FileMode::Read | fs::FileMode::Binary);
+	if(!fp)
+		return nullptr;
+	return std::make_unique<fs::File>(fp);
+}
+pragma::material::SpriteSheetAnimationCache::SourceStamp pragma::material::SpriteSheetAnimationCache::GetSourceStamp(const FileOpener &fileOpener, const std::string &fileName, ufile::IFile *f)
+{
+	SourceStamp stamp {};
+	if(f == nullptr)
+		return stamp;
+	stamp.exists = true;
+	stamp.size = f->GetSize();
+	std::string absPath;
+	if(!fileOpener && fs::find_absolute_path(fileName, absPath)) {
+		std::error_code ec;
+		auto t = std::filesystem::last_write_time(absPath, ec);
+		if(!ec)
+			stamp.modificationTime = t.time_since_epoch().count();
+	}
+	return stamp;
+}
+pragma::material::SpriteSheetAnimationCache::Handle pragma::material::SpriteSheetAnimationCache::Load(const std::string &fileName)
+{
+	auto key = normalize_cache_path(fileName);
+	std::unique_lock lock {m_cacheMutex};
+	auto it = m_cache.find(key);
+	if(it != m_cache.end()) {
+		auto entry = it->second;
+		if(entry.handle.wait_for(std::chrono::seconds {0}) != std::future_status::ready || entry.handle.get() != nullptr)
+			return entry.handle;
+		// The previous load has failed, we'll only try again if the file has changed since then
+		lock.unlock();
+		auto f = OpenFile(m_fileOpener, fileName);
+		auto stamp = GetSourceStamp(m_fileOpener, fileName, f.get());
+		lock.lock();
+		it = m_cache.find(key);
+		// Another thread may have replaced the entry in the meantime
+		if(it != m_cache.end() && (it->second.stamp != entry.stamp || stamp == *entry.stamp))
+			return it->second.handle;
+	}
+	auto stamp = std::make_shared<SourceStamp>();
+	Handle handle = get_worker_pool().Submit([fileOpener = m_fileOpener, fileName, stamp]() -> std::shared_ptr<SpriteSheetAnimation> {
+		auto f = OpenFile(fileOpener, fileName);
+		*stamp = GetSourceStamp(fileOpener, fileName, f.get());
+		if(!f)
+			return nullptr;
+		std::vector<uint8_t> data(f->GetSize());
+		data.resize(f->Read(data.data(), data.size()));
+		ufile::VectorFile vf {std::move(data)};
+		auto anim = std::make_shared<SpriteSheetAnimation>();
+		if(anim->Load(vf) == false)
+			return nullptr;
+		return anim;
+	}).share();
+	m_cache[key] = {handle, stamp};
+	return handle;
+}
+void pragma::material::SpriteSheetAnimationCache::Invalidate(const std::string &fileName)
+{
+	std::unique_lock lock {m_cacheMutex};
+	m_cache.erase(normalize_cache_path(fileName));
+}
+void pragma::material::SpriteSheetAnimationCache::Clear()
+{
+	std::unique_lock lock {m_cacheMutex};
+	m_cache.clear();
+}
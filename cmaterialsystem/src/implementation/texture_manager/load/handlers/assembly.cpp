@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.cmaterialsystem;
+
+import :texture_manager.format_handlers.assembly;
+import :texture_manager.manager2;
+
+bool pragma::material::TextureFormatHandlerAssembly::GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize)
+{
+	if(layer >= m_layers.size() || mipmapIdx != 0)
+		return false;
+	auto &imgBuf = m_layers[layer];
+	*outPtr = imgBuf->GetData();
+	outSize = imgBuf->GetSize();
+	return true;
+}
+
+std::vector<std::shared_ptr<pragma::image::ImageBuffer>> pragma::material::TextureFormatHandlerAssembly::DecodeLayers(const std::vector<std::string> &layerPaths, bool flipVertically)
+{
+	std::vector<std::shared_ptr<image::ImageBuffer>> layers(layerPaths.size());
+	// The calling thread takes part in the work, so this is safe to call from a worker thread as well
+	get_worker_pool().ParallelFor(layerPaths.size(), [&layerPaths, &layers, flipVertically](size_t idx) {
+		auto f = open_archived_asset_file(layerPaths[idx]);
+		if(!f) {
+			auto fp = fs::open_file(layerPaths[idx], fs::FileMode::Read | fs::FileMode::Binary);
+			if(!fp)
+				return;
+			f = std::make_unique<fs::File>(fp);
+		}
+		layers[idx] = image::load_image(*f, image::PixelFormat::LDR, flipVertically);
+	});
+	return layers;
+}
+bool pragma::material::TextureFormatHandlerAssembly::ValidateLayers(const std::vector<std::shared_ptr<image::ImageBuffer>> &layers, bool cubemap)
+{
+	if(layers.empty() || !layers.front())
+		return false;
+	auto &firstLayer = layers.front();
+	for(auto &layer : layers) {
+		if(!layer || layer->GetWidth() != firstLayer->GetWidth() || layer->GetHeight() != firstLayer->GetHeight() || layer->GetFormat() != firstLayer->GetFormat())
+			return false;
+	}
+	return !cubemap || (layers.size() == 6 && firstLayer->GetWidth() == firstLayer->GetHeight());
+}
+
+bool pragma::material::TextureFormatHandlerAssembly::LoadData(InputTextureInfo &texInfo)
+{
+	std::shared_ptr<udm::Data> udmData = nullptr;
+	try {
+		udmData = udm::Data::Load(std::move(m_file));
+	}
+	catch(const udm::Exception &e) {
+		return false;
+	}
+	if(udmData == nullptr)
+		return false;
+	auto assetData = udmData->GetAssetData();
+	if(assetData.GetAssetType() != PTXA_IDENTIFIER || assetData.GetAssetVersion() < 1 || assetData.GetAssetVersion() > PTXA_VERSION)
+		return false;
+	auto udm = *assetData;
+	std::string type;
+	udm["type"](type);
+	auto cubemap = (type == "cubemap");
+	if(!cubemap && type != "array")
+		return false;
+	auto udmLayers = udm["layers"];
+	auto numLayers = udmLayers.GetSize();
+	if(numLayers == 0 || numLayers > MAX_LAYER_COUNT || (cubemap && numLayers != 6))
+		return false;
+
+	auto &texManager = static_cast<TextureManager &>(GetAssetManager());
+	std::vector<std::string> layerPaths;
+	layerPaths.reserve(numLayers);
+	for(auto i = decltype(numLayers) {0u}; i < numLayers; ++i) {
+		std::string layerName;
+		if(!(udmLayers[i] >> layerName))
+			return false;
+		auto path = texManager.FindAssetFilePath(layerName);
+		if(!path)
+			return false;
+		layerPaths.push_back(texManager.GetRootDirectory().GetString() + '/' + *path);
+	}
+
+	auto layers = DecodeLayers(layerPaths, ShouldFlipTextureVertically());
+	if(!ValidateLayers(layers, cubemap))
+		return false;
+	auto firstLayer = layers.front();
+	m_layers = std::move(layers);
+	texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
+	if(cubemap)
+		texInfo.flags |= InputTextureInfo::Flags::CubemapBit;
+	texInfo.width = firstLayer->GetWidth();
+	texInfo.height = firstLayer->GetHeight();
+	texInfo.layerCount = static_cast<uint32_t>(numLayers);
+	texInfo.format = prosper::util::get_vk_format(firstLayer->GetFormat());
+	return true;
+}
@@ -23,7 +23,8 @@ bool pragma::material::TextureFormatHandlerGli::LoadData(InputTextureInfo &texIn
 	if(sz == 0)
 		return false;
 	std::vector<uint8_t> data(sz);
-	m_file->Read(data.data(), sz);
+	if(m_file->Read(data.data(), sz) != sz)
+		return false;
 	m_texture = gli::load(static_cast<char *>(static_cast<void *>(data.data())), data.size());
 	if(m_texture.empty())
 		return false;
@@ -36,6 +37,8 @@ bool pragma::material::TextureFormatHandlerGli::LoadData(InputTextureInfo &texIn
 	auto isCubemap = m_texture.faces() == 6;
 	pragma::math::set_flag(texInfo.flags, InputTextureInfo::Flags::CubemapBit, isCubemap);
 	auto extents = m_texture.extent();
+	if(extents.x <= 0 || extents.y <= 0)
+		return false;
 	texInfo.width = extents.x;
 	texInfo.height = extents.y;
 	texInfo.layerCount = isCubemap ? 6 : 1;
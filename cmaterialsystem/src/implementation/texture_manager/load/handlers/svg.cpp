@@ -4,48 +4,95 @@
 module pragma.cmaterialsystem;
 
 import :texture_manager.format_handlers.svg;
+import :texture_manager.svg_raster_cache;
+
+static std::atomic<bool> g_rasterizeMipmaps = true;
+void pragma::material::TextureFormatHandlerSvg::SetRasterizeMipmaps(bool rasterize) { g_rasterizeMipmaps = rasterize; }
+bool pragma::material::TextureFormatHandlerSvg::ShouldRasterizeMipmaps() { return g_rasterizeMipmaps; }
 
 bool pragma::material::TextureFormatHandlerSvg::GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize)
 {
-	if(layer != 0 || mipmapIdx != 0)
+	if(layer != 0 || mipmapIdx >= m_mipmaps.size())
 		return false;
-	*outPtr = m_imgBuf->GetData();
-	outSize = m_imgBuf->GetSize();
+	auto &imgBuf = m_mipmaps[mipmapIdx];
+	*outPtr = imgBuf->GetData();
+	outSize = imgBuf->GetSize();
 	return true;
 }
+std::string pragma::material::TextureFormatHandlerSvg::GetMipmapStyleSheet(const std::vector<std::string> &mipmapStyleSheets, uint32_t level)
+{
+	for(auto i = std::min<size_t>(level + 1, mipmapStyleSheets.size()); i > 0; --i) {
+		auto &styleSheet = mipmapStyleSheets[i - 1];
+		if(!styleSheet.empty())
+			return styleSheet;
+	}
+	return {};
+}
+std::vector<std::shared_ptr<pragma::image::ImageBuffer>> pragma::material::TextureFormatHandlerSvg::RasterizeMipmaps(const std::vector<uint8_t> &svgData, uint64_t contentHash, const image::SvgImageInfo &svgInfo,
+  const std::vector<std::string> &mipmapStyleSheets, const std::shared_ptr<image::ImageBuffer> &baseLevel)
+{
+	auto width = static_cast<uint32_t>(baseLevel->GetWidth());
+	auto height = static_cast<uint32_t>(baseLevel->GetHeight());
+	auto mipmapCount = prosper::util::calculate_mipmap_count(width, height);
+	std::vector<std::shared_ptr<image::ImageBuffer>> mipmaps(std::max<uint32_t>(mipmapCount, 1));
+	mipmaps.front() = baseLevel;
+	// The calling thread takes part in the work, so this is safe to call from a worker thread as well
+	get_worker_pool().ParallelFor(mipmaps.size() - 1, [&](size_t i) {
+		auto level = static_cast<uint32_t>(i + 1);
+		uint32_t w, h;
+		prosper::util::calculate_mipmap_size(width, height, &w, &h, level);
+		auto levelInfo = svgInfo;
+		levelInfo.width = w;
+		levelInfo.height = h;
+		levelInfo.styleSheet += GetMipmapStyleSheet(mipmapStyleSheets, level);
+		mipmaps[level] = SvgRasterCache::Get().Rasterize(svgData, contentHash, levelInfo);
+	});
+
+	for(auto level = 1u; level < mipmaps.size(); ++level) {
+		auto &mipmap = mipmaps[level];
+		uint32_t w, h;
+		prosper::util::calculate_mipmap_size(width, height, &w, &h, level);
+		if(!mipmap || mipmap->GetWidth() != w || mipmap->GetHeight() != h || mipmap->GetFormat() != baseLevel->GetFormat())
+			return {};
+	}
+	return mipmaps;
+}
 bool pragma::material::TextureFormatHandlerSvg::LoadData(InputTextureInfo &texInfo)
 {
 	image::SvgImageInfo svgInfo {};
+	std::vector<std::string> mipmapStyleSheets;
 	if(texInfo.textureData) {
 		udm::LinkedPropertyWrapper prop {*texInfo.textureData};
 		prop["width"] >> svgInfo.width;
 		prop["height"] >> svgInfo.height;
+		svgInfo.styleSheet = SvgRasterCache::GetStyleSheet(prop["styleSheet"]);
 
-		if(!(prop["styleSheet"] >> svgInfo.styleSheet)) {
-			std::stringstream ss;
-			auto styleSheet = prop["styleSheet"];
-			for(auto &pair : styleSheet.ElIt()) {
-				auto &className = pair.key;
-				ss << className << "{";
-				for(auto &kvPair : pair.property.ElIt()) {
-					auto &key = kvPair.key;
-					std::string value;
-					if(!(kvPair.property >> value))
-						continue;
-					ss << key << ":" << value << ";";
-				}
-				ss << "}";
-			}
-			svgInfo.styleSheet = ss.str();
-		}
+		auto udmMipmapStyleSheets = prop["mipmapStyleSheets"];
+		auto n = udmMipmapStyleSheets.GetSize();
+		mipmapStyleSheets.reserve(n);
+		for(auto i = decltype(n) {0u}; i < n; ++i)
+			mipmapStyleSheets.push_back(SvgRasterCache::GetStyleSheet(udmMipmapStyleSheets[i]));
 	}
-	auto imgBuf = image::load_svg(*m_file, svgInfo);
-	if(!imgBuf)
+	std::vector<uint8_t> svgData(m_file->GetSize());
+	if(m_file->Read(svgData.data(), svgData.size()) != svgData.size())
 		return false;
-	m_imgBuf = imgBuf;
+	auto contentHash = calc_fnv1a_hash(svgData.data(), svgData.size());
+	auto levelInfo = svgInfo;
+	levelInfo.styleSheet += GetMipmapStyleSheet(mipmapStyleSheets, 0);
+	auto imgBuf = SvgRasterCache::Get().Rasterize(svgData, contentHash, levelInfo);
+	if(!imgBuf || imgBuf->GetWidth() == 0 || imgBuf->GetHeight() == 0)
+		return false;
+	m_mipmaps = {imgBuf};
+	if(ShouldRasterizeMipmaps()) {
+		// If any of the levels could not be rasterized at the expected size, the mipmaps will be generated from the base level instead
+		auto mipmaps = RasterizeMipmaps(svgData, contentHash, svgInfo, mipmapStyleSheets, imgBuf);
+		if(!mipmaps.empty())
+			m_mipmaps = std::move(mipmaps);
+	}
 	texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
 	texInfo.width = imgBuf->GetWidth();
 	texInfo.height = imgBuf->GetHeight();
+	texInfo.mipmapCount = static_cast<uint32_t>(m_mipmaps.size());
 	texInfo.format = prosper::util::get_vk_format(imgBuf->GetFormat());
 	return true;
 }
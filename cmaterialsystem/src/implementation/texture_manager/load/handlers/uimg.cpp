@@ -4,25 +4,178 @@
 module pragma.cmaterialsystem;
 
 import :texture_manager.format_handlers.uimg;
+import :texture_manager.pixel_conversion;
+
+static std::atomic<pragma::material::TextureFormatHandlerUimg::HdrPacking> g_hdrPacking = pragma::material::TextureFormatHandlerUimg::HdrPacking::Half;
+static std::atomic<bool> g_generateHdrMipmapsOnCpu = false;
+void pragma::material::TextureFormatHandlerUimg::SetHdrPacking(HdrPacking packing) { g_hdrPacking = packing; }
+pragma::material::TextureFormatHandlerUimg::HdrPacking pragma::material::TextureFormatHandlerUimg::GetHdrPacking() { return g_hdrPacking; }
+void pragma::material::TextureFormatHandlerUimg::SetGenerateHdrMipmapsOnCpu(bool cpu) { g_generateHdrMipmapsOnCpu = cpu; }
+bool pragma::material::TextureFormatHandlerUimg::ShouldGenerateHdrMipmapsOnCpu() { return g_generateHdrMipmapsOnCpu; }
+
+// Radiance hdr files and 32-bit psd files are loaded as float, 16-bit png and psd files as 16-bit integer, everything else as 8-bit.
+pragma::image::PixelFormat pragma::material::TextureFormatHandlerUimg::GetPixelFormat(ufile::IFile &f)
+{
+	std::array<uint8_t, 26> header {};
+	auto n = f.Read(header.data(), header.size());
+	f.Seek(0, ufile::IFile::Whence::Set);
+	if((n >= 10 && std::memcmp(header.data(), "#?RADIANCE", 10) == 0) || (n >= 6 && std::memcmp(header.data(), "#?RGBE", 6) == 0))
+		return pragma::image::PixelFormat::Float;
+	if(n < header.size())
+		return pragma::image::PixelFormat::LDR;
+	constexpr std::array<uint8_t, 4> PNG_SIGNATURE = {0x89, 'P', 'N', 'G'};
+	if(std::memcmp(header.data(), PNG_SIGNATURE.data(), PNG_SIGNATURE.size()) == 0)
+		return (header[24] == 16) ? pragma::image::PixelFormat::HDR : pragma::image::PixelFormat::LDR;
+	if(std::memcmp(header.data(), "8BPS", 4) == 0) {
+		auto depth = static_cast<uint16_t>((header[22] << 8) | header[23]);
+		if(depth == 32)
+			return pragma::image::PixelFormat::Float;
+		if(depth == 16)
+			return pragma::image::PixelFormat::HDR;
+	}
+	return pragma::image::PixelFormat::LDR;
+}
+
+// 2x2 box filter for four-channel images. Odd dimensions are handled by clamping to the last row/column.
+template<typename T>
+static void downsample_box(const T *src, uint32_t srcWidth, uint32_t srcHeight, T *dst, uint32_t dstWidth, uint32_t dstHeight)
+{
+	constexpr uint32_t NUM_CHANNELS = 4;
+	for(uint32_t y = 0; y < dstHeight; ++y) {
+		auto y0 = std::min(y * 2, srcHeight - 1);
+		auto y1 = std::min(y * 2 + 1, srcHeight - 1);
+		for(uint32_t x = 0; x < dstWidth; ++x) {
+			auto x0 = std::min(x * 2, srcWidth - 1);
+			auto x1 = std::min(x * 2 + 1, srcWidth - 1);
+			auto *p00 = src + (static_cast<size_t>(y0) * srcWidth + x0) * NUM_CHANNELS;
+			auto *p01 = src + (static_cast<size_t>(y0) * srcWidth + x1) * NUM_CHANNELS;
+			auto *p10 = src + (static_cast<size_t>(y1) * srcWidth + x0) * NUM_CHANNELS;
+			auto *p11 = src + (static_cast<size_t>(y1) * srcWidth + x1) * NUM_CHANNELS;
+			auto *d = dst + (static_cast<size_t>(y) * dstWidth + x) * NUM_CHANNELS;
+			for(uint32_t c = 0; c < NUM_CHANNELS; ++c) {
+				auto sum = static_cast<float>(p00[c]) + static_cast<float>(p01[c]) + static_cast<float>(p10[c]) + static_cast<float>(p11[c]);
+				if constexpr(std::is_floating_point_v<T>)
+					d[c] = sum * 0.25f;
+				else
+					d[c] = static_cast<T>(sum * 0.25f + 0.5f);
+			}
+		}
+	}
+}
+template<typename T>
+static std::vector<std::vector<uint8_t>> generate_mipmaps(const T *data, uint32_t width, uint32_t height, bool baseLevelOnly)
+{
+	auto mipmapCount = baseLevelOnly ? 1 : prosper::util::calculate_mipmap_count(width, height);
+	std::vector<std::vector<uint8_t>> mipmaps(mipmapCount);
+	auto &baseLevel = mipmaps.front();
+	baseLevel.resize(static_cast<size_t>(width) * height * 4 * sizeof(T));
+	std::memcpy(baseLevel.data(), data, baseLevel.size());
+	for(uint32_t level = 1; level < mipmapCount; ++level) {
+		uint32_t srcWidth, srcHeight, dstWidth, dstHeight;
+		prosper::util::calculate_mipmap_size(width, height, &srcWidth, &srcHeight, level - 1);
+		prosper::util::calculate_mipmap_size(width, height, &dstWidth, &dstHeight, level);
+		mipmaps[level].resize(static_cast<size_t>(dstWidth) * dstHeight * 4 * sizeof(T));
+		downsample_box(reinterpret_cast<const T *>(mipmaps[level - 1].data()), srcWidth, srcHeight, reinterpret_cast<T *>(mipmaps[level].data()), dstWidth, dstHeight);
+	}
+	return mipmaps;
+}
 
 bool pragma::material::TextureFormatHandlerUimg::GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize)
 {
-	if(layer != 0 || mipmapIdx != 0)
+	if(layer != 0)
 		return false;
-	*outPtr = m_imgBuf->GetData();
-	outSize = m_imgBuf->GetSize();
+	if(!m_image.mipmapData.empty()) {
+		if(mipmapIdx >= m_image.mipmapData.size())
+			return false;
+		auto &data = m_image.mipmapData[mipmapIdx];
+		*outPtr = data.data();
+		outSize = data.size();
+		return true;
+	}
+	if(mipmapIdx != 0 || !m_image.imgBuf)
+		return false;
+	*outPtr = m_image.imgBuf->GetData();
+	outSize = m_image.imgBuf->GetSize();
 	return true;
 }
 
 bool pragma::material::TextureFormatHandlerUimg::LoadData(InputTextureInfo &texInfo)
 {
-	auto imgBuf = image::load_image(*m_file, image::PixelFormat::LDR, ShouldFlipTextureVertically());
-	if(!imgBuf)
+	auto image = Decode(*m_file, texInfo, ShouldFlipTextureVertically());
+	if(!image)
 		return false;
-	m_imgBuf = imgBuf;
-	texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
+	m_image = std::move(*image);
+	return true;
+}
+
+std::optional<pragma::material::TextureFormatHandlerUimg::DecodedImage> pragma::material::TextureFormatHandlerUimg::Decode(ufile::IFile &f, InputTextureInfo &texInfo, bool flipVertically)
+{
+	auto pixelFormat = GetPixelFormat(f);
+	auto imgBuf = image::load_image(f, pixelFormat, flipVertically);
+	if(!imgBuf)
+		return {};
+	if(imgBuf->GetWidth() == 0 || imgBuf->GetHeight() == 0)
+		return {};
+	DecodedImage result {};
+	result.imgBuf = imgBuf;
 	texInfo.width = imgBuf->GetWidth();
 	texInfo.height = imgBuf->GetHeight();
-	texInfo.format = prosper::util::get_vk_format(imgBuf->GetFormat());
-	return true;
+	switch(pixelFormat) {
+	case image::PixelFormat::LDR:
+		texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
+		texInfo.format = prosper::util::get_vk_format(imgBuf->GetFormat());
+		return result;
+	case image::PixelFormat::HDR:
+		{
+			// 16-bit integer data has the same color space as 8-bit data
+			texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
+			imgBuf->Convert(image::Format::RGBA16);
+			texInfo.format = prosper::util::get_vk_format(imgBuf->GetFormat());
+			if(ShouldGenerateHdrMipmapsOnCpu()) {
+				result.mipmapData = generate_mipmaps(static_cast<const uint16_t *>(imgBuf->GetData()), texInfo.width, texInfo.height, false);
+				texInfo.mipmapCount = static_cast<uint32_t>(result.mipmapData.size());
+				result.imgBuf = nullptr;
+			}
+			return result;
+		}
+	default:
+		break;
+	}
+
+	// Float data is linear
+	imgBuf->Convert(image::Format::RGBA32);
+	auto packing = GetHdrPacking();
+	auto generateMipmaps = ShouldGenerateHdrMipmapsOnCpu() || packing == HdrPacking::SharedExponent;
+	if(!generateMipmaps && packing == HdrPacking::None) {
+		texInfo.format = prosper::util::get_vk_format(imgBuf->GetFormat());
+		return result;
+	}
+	result.mipmapData = generate_mipmaps(static_cast<const float *>(imgBuf->GetData()), texInfo.width, texInfo.height, !generateMipmaps);
+	texInfo.mipmapCount = static_cast<uint32_t>(result.mipmapData.size());
+	std::optional<PixelConversion> conversion {};
+	switch(packing) {
+	case HdrPacking::None:
+		texInfo.format = prosper::Format::R32G32B32A32_SFloat;
+		break;
+	case HdrPacking::Half:
+		texInfo.format = prosper::Format::R16G16B16A16_SFloat;
+		conversion = PixelConversion::Rgba32fToRgba16f;
+		break;
+	case HdrPacking::SharedExponent:
+		texInfo.format = prosper::Format::E5B9G9R9_UFloat_Pack32;
+		conversion = PixelConversion::Rgba32fToRgb9e5;
+		break;
+	}
+	if(conversion) {
+		auto srcSize = get_pixel_conversion_source_size(*conversion);
+		auto dstSize = get_pixel_conversion_target_size(*conversion);
+		for(auto &data : result.mipmapData) {
+			auto pixelCount = data.size() / srcSize;
+			std::vector<uint8_t> packed(pixelCount * dstSize);
+			convert_pixels(*conversion, data.data(), packed.data(), pixelCount);
+			data = std::move(packed);
+		}
+	}
+	result.imgBuf = nullptr;
+	return result;
 }
@@ -4,62 +4,12 @@
 module pragma.cmaterialsystem;
 
 import :texture_manager.format_handlers.vtex;
-import :texture_manager.format_handlers.vtf;
+import :texture_manager.texture_formats;
 
 #ifndef DISABLE_VTEX_SUPPORT
 
 import source2;
 
-static pragma::material::detail::VulkanImageData vtex_format_to_vulkan_format(source2::VTexFormat format)
-{
-	pragma::material::detail::VulkanImageData vkImgData {};
-	switch(format) {
-	case source2::VTexFormat::DXT1:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	case source2::VTexFormat::DXT5:
-		vkImgData.format = prosper::Format::BC3_UNorm_Block;
-		break;
-	case source2::VTexFormat::RGBA8888:
-		vkImgData.format = prosper::Format::R8G8B8A8_UNorm;
-		break;
-	case source2::VTexFormat::RGBA16161616:
-		vkImgData.format = prosper::Format::R16G16B16A16_SNorm;
-		break;
-	case source2::VTexFormat::RGBA16161616F:
-		vkImgData.format = prosper::Format::R16G16B16A16_SFloat;
-		break;
-	case source2::VTexFormat::RGB323232F: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::R32G32B32A32_SFloat;
-		vkImgData.format = prosper::Format::R32G32B32_SFloat;
-		break;
-	case source2::VTexFormat::RGBA32323232F:
-		vkImgData.format = prosper::Format::R32G32B32A32_SFloat;
-		break;
-	case source2::VTexFormat::BC6H:
-		vkImgData.format = prosper::Format::BC6H_SFloat_Block;
-		break;
-	case source2::VTexFormat::BC7:
-		vkImgData.format = prosper::Format::BC7_UNorm_Block;
-		break;
-	case source2::VTexFormat::BGRA8888:
-		vkImgData.swizzle = {prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::A};
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	case source2::VTexFormat::ATI1N:
-		vkImgData.format = prosper::Format::BC4_UNorm_Block;
-		break;
-	case source2::VTexFormat::ATI2N:
-		vkImgData.format = prosper::Format::BC5_UNorm_Block;
-		break;
-	default:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	}
-	// Note: When adding a new format, make sure to also add it to TextureManager::InitializeTextureData
-	return vkImgData;
-}
-
 bool pragma::material::TextureFormatHandlerVtex::GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize)
 {
 	if(layer > 0)
@@ -81,34 +31,20 @@ bool pragma::material::TextureFormatHandlerVtex::LoadData(InputTextureInfo &texI
 		return false;
 	auto texture = std::static_pointer_cast<::source2::resource::Texture>(texBlock->shared_from_this());
 
-	auto format = texture->GetFormat();
-	switch(format) {
-	case ::source2::VTexFormat::DXT1:
-	case ::source2::VTexFormat::DXT5:
-	case ::source2::VTexFormat::RGBA8888:
-	case ::source2::VTexFormat::RGBA16161616:
-	case ::source2::VTexFormat::RGBA16161616F:
-	case ::source2::VTexFormat::RGB323232F:
-	case ::source2::VTexFormat::RGBA32323232F:
-	case ::source2::VTexFormat::BC6H:
-	case ::source2::VTexFormat::BC7:
-	case ::source2::VTexFormat::BGRA8888:
-	case ::source2::VTexFormat::ATI1N:
-	case ::source2::VTexFormat::ATI2N:
-		break; // Note: When adding new formats, make sure to also add them to texture_initialize.cpp:vtex_format_to_vulkan_format
-	default:
+	auto formatInfo = find_vtex_format_info(texture->GetFormat());
+	if(!formatInfo.has_value())
 		return false; // Unsupported format
-	}
 
 	texInfo.width = texture->GetWidth();
 	texInfo.height = texture->GetHeight();
+	if(texInfo.width == 0 || texInfo.height == 0)
+		return false;
 	texInfo.layerCount = 1;
-	texInfo.mipmapCount = texture->GetMipMapCount();
+	texInfo.mipmapCount = std::max<uint32_t>(texture->GetMipMapCount(), 1u);
 
-	auto vkFormat = vtex_format_to_vulkan_format(texture->GetFormat());
-	texInfo.format = vkFormat.format;
-	texInfo.swizzle = vkFormat.swizzle;
-	texInfo.conversionFormat = vkFormat.conversionFormat;
+	texInfo.format = formatInfo->format;
+	texInfo.swizzle = formatInfo->swizzle;
+	texInfo.conversionFormat = formatInfo->conversionFormat;
 	m_texture = texture;
 
 	if(ShouldFlipTextureVertically())
@@ -11,59 +11,9 @@ module;
 module pragma.cmaterialsystem;
 
 import :texture_manager.format_handlers.vtf;
+import :texture_manager.texture_formats;
 
 #ifndef DISABLE_VTF_SUPPORT
-static pragma::material::detail::VulkanImageData vtf_format_to_vulkan_format(VTFImageFormat format)
-{
-	pragma::material::detail::VulkanImageData vkImgData {};
-	switch(format) {
-	case IMAGE_FORMAT_DXT1:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_DXT3:
-		vkImgData.format = prosper::Format::BC2_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_DXT5:
-		vkImgData.format = prosper::Format::BC3_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_RGBA8888:
-		vkImgData.format = prosper::Format::R8G8B8A8_UNorm;
-		break;
-	case IMAGE_FORMAT_RGB888: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::R8G8B8A8_UNorm;
-		vkImgData.format = prosper::Format::R8G8B8_UNorm_PoorCoverage;
-		break;
-	case IMAGE_FORMAT_BGRA8888:
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	case IMAGE_FORMAT_BGR888: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::B8G8R8A8_UNorm;
-		vkImgData.format = prosper::Format::B8G8R8_UNorm_PoorCoverage;
-		break;
-	case IMAGE_FORMAT_UV88:
-		vkImgData.format = prosper::Format::R8G8_UNorm;
-		break;
-	case IMAGE_FORMAT_RGBA16161616F:
-		vkImgData.format = prosper::Format::R16G16B16A16_SFloat;
-		break;
-	case IMAGE_FORMAT_RGBA32323232F:
-		vkImgData.format = prosper::Format::R32G32B32A32_SFloat;
-		break;
-	case IMAGE_FORMAT_ABGR8888:
-		vkImgData.swizzle = {prosper::ComponentSwizzle::A, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R};
-		vkImgData.format = prosper::Format::A8B8G8R8_UNorm_Pack32;
-		break;
-	case IMAGE_FORMAT_BGRX8888:
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	default:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	}
-	// Note: When adding a new format, make sure to also add it to TextureManager::InitializeTextureData
-	return vkImgData;
-}
-
 static vlVoid vtf_read_close() {}
 static vlBool vtf_read_open() { return true; }
 static vlUInt vtf_read_read(vlVoid *buf, vlUInt bytes, vlVoid *handle)
@@ -123,24 +73,12 @@ bool pragma::material::TextureFormatHandlerVtf::LoadData(InputTextureInfo &texIn
 	auto valid = texture->Load(m_file.get(), false);
 	if(valid == false)
 		return false;
-	auto format = texture->GetFormat();
-	switch(format) {
-	case IMAGE_FORMAT_DXT1:
-	case IMAGE_FORMAT_DXT3:
-	case IMAGE_FORMAT_DXT5:
-	case IMAGE_FORMAT_RGB888:
-	case IMAGE_FORMAT_RGBA8888:
-	case IMAGE_FORMAT_BGR888:
-	case IMAGE_FORMAT_BGRA8888:
-	case IMAGE_FORMAT_UV88:
-	case IMAGE_FORMAT_RGBA16161616F:
-	case IMAGE_FORMAT_RGBA32323232F:
-	case IMAGE_FORMAT_ABGR8888:
-	case IMAGE_FORMAT_BGRX8888:
-		break; // Note: When adding new formats, make sure to also add them to texture_initialize.cpp:vtf_format_to_vulkan_format
-	default:
+	auto formatInfo = find_vtf_format_info(texture->GetFormat());
+	if(!formatInfo.has_value())
 		return false; // Unsupported format
-	}
+
+	if(texture->GetWidth() == 0 || texture->GetHeight() == 0)
+		return false;
 
 	auto cubemap = texture->GetFaceCount() == 6;
 	texInfo.flags |= InputTextureInfo::Flags::SrgbBit;
@@ -148,12 +86,11 @@ bool pragma::material::TextureFormatHandlerVtf::LoadData(InputTextureInfo &texIn
 	texInfo.width = texture->GetWidth();
 	texInfo.height = texture->GetHeight();
 	texInfo.layerCount = cubemap ? 6 : 1;
-	texInfo.mipmapCount = texture->GetMipmapCount();
+	texInfo.mipmapCount = std::max<uint32_t>(texture->GetMipmapCount(), 1u);
 
-	auto vkFormat = vtf_format_to_vulkan_format(texture->GetFormat());
-	texInfo.format = vkFormat.format;
-	texInfo.swizzle = vkFormat.swizzle;
-	texInfo.conversionFormat = vkFormat.conversionFormat;
+	texInfo.format = formatInfo->format;
+	texInfo.swizzle = formatInfo->swizzle;
+	texInfo.conversionFormat = formatInfo->conversionFormat;
 
 	if(texture->GetFlag(TEXTUREFLAGS_NOMIP))
 		texInfo.mipmapCount = 1u;
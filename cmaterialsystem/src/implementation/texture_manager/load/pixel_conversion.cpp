@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+// The SSSE3 kernels are compiled for the SSSE3 target regardless of the compiler flags and are only used if the CPU supports them
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PIXEL_CONVERSION_ENABLE_SSSE3
+#define PIXEL_CONVERSION_SSSE3_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#define PIXEL_CONVERSION_ENABLE_SSSE3
+#define PIXEL_CONVERSION_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+
+module pragma.cmaterialsystem;
+
+import :texture_manager.pixel_conversion;
+
+// Images smaller than this (in pixels) are converted on the calling thread
+static constexpr size_t MIN_PIXELS_PER_TASK = 256 * 256;
+
+uint32_t pragma::material::get_pixel_conversion_source_size(PixelConversion conversion)
+{
+	switch(conversion) {
+	case PixelConversion::Rgb8ToRgba8:
+		return 3;
+	case PixelConversion::Rg8ToRgba8:
+		return 2;
+	case PixelConversion::Rgb32fToRgba32f:
+		return 3 * sizeof(float);
+	case PixelConversion::Rgba32fToRgba16f:
+	case PixelConversion::Rgba32fToRgb9e5:
+		return 4 * sizeof(float);
+	}
+	return 0;
+}
+uint32_t pragma::material::get_pixel_conversion_target_size(PixelConversion conversion)
+{
+	switch(conversion) {
+	case PixelConversion::Rgb8ToRgba8:
+	case PixelConversion::Rg8ToRgba8:
+		return 4;
+	case PixelConversion::Rgb32fToRgba32f:
+		return 4 * sizeof(float);
+	case PixelConversion::Rgba32fToRgba16f:
+		return 4 * sizeof(uint16_t);
+	case PixelConversion::Rgba32fToRgb9e5:
+		return sizeof(uint32_t);
+	}
+	return 0;
+}
+
+std::optional<pragma::material::PixelConversion> pragma::material::find_pixel_conversion(prosper::Format format, prosper::Format &outTargetFormat)
+{
+	switch(format) {
+	case prosper::Format::R8G8B8_UNorm_PoorCoverage:
+		outTargetFormat = prosper::Format::R8G8B8A8_UNorm;
+		return PixelConversion::Rgb8ToRgba8;
+	case prosper::Format::B8G8R8_UNorm_PoorCoverage:
+		outTargetFormat = prosper::Format::B8G8R8A8_UNorm;
+		return PixelConversion::Rgb8ToRgba8;
+	case prosper::Format::R8G8_UNorm:
+		outTargetFormat = prosper::Format::R8G8B8A8_UNorm;
+		return PixelConversion::Rg8ToRgba8;
+	case prosper::Format::R32G32B32_SFloat:
+		outTargetFormat = prosper::Format::R32G32B32A32_SFloat;
+		return PixelConversion::Rgb32fToRgba32f;
+	case prosper::Format::R32G32B32A32_SFloat:
+		outTargetFormat = prosper::Format::R16G16B16A16_SFloat;
+		return PixelConversion::Rgba32fToRgba16f;
+	default:
+		break;
+	}
+	return {};
+}
+
+// Round-to-nearest-even conversion of a 32-bit float to a 16-bit float
+static uint16_t float_to_half(float f)
+{
+	uint32_t x;
+	std::memcpy(&x, &f, sizeof(x));
+	uint32_t sign = (x >> 16) & 0x8000;
+	uint32_t rawExp = (x >> 23) & 0xff;
+	uint32_t mant = x & 0x7fffff;
+	if(rawExp == 0xff)
+		return static_cast<uint16_t>(sign | 0x7c00 | (mant ? 0x200 : 0)); // Inf / NaN
+	int32_t exp = static_cast<int32_t>(rawExp) - 127 + 15;
+	if(exp >= 0x1f)
+		return static_cast<uint16_t>(sign | 0x7c00); // Overflow
+	if(exp <= 0) {
+		// Subnormal
+		if(exp < -10)
+			return static_cast<uint16_t>(sign);
+		mant |= 0x800000;
+		uint32_t shift = 14 - exp;
+		uint32_t half = mant >> shift;
+		uint32_t rem = mant & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if(rem > halfway || (rem == halfway && (half & 1)))
+			++half;
+		return static_cast<uint16_t>(sign | half);
+	}
+	uint32_t half = sign | (static_cast<uint32_t>(exp) << 10) | (mant >> 13);
+	uint32_t rem = mant & 0x1fff;
+	if(rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+		++half; // May carry into the exponent, which is the correct result
+	return static_cast<uint16_t>(half);
+}
+
+#ifdef PIXEL_CONVERSION_ENABLE_SSSE3
+static bool is_ssse3_supported()
+{
+	static auto supported = []() {
+#ifdef _MSC_VER
+		std::array<int, 4> info;
+		__cpuid(info.data(), 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		return __builtin_cpu_supports("ssse3") != 0;
+#endif
+	}();
+	return supported;
+}
+// Converts four pixels per iteration with a byte shuffle and returns the number of pixels that were processed
+PIXEL_CONVERSION_SSSE3_TARGET static size_t convert_rgb8_to_rgba8_ssse3(const uint8_t *src, uint8_t *dst, size_t pixelCount)
+{
+	auto shuffleMask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	auto alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+	size_t i = 0;
+	// Every iteration reads 16 bytes (5 1/3 pixels), make sure we don't read past the end of the source buffer
+	for(; i + 6 <= pixelCount; i += 4) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+		v = _mm_or_si128(_mm_shuffle_epi8(v, shuffleMask), alphaMask);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), v);
+	}
+	return i;
+}
+#endif
+
+static void convert_rgb8_to_rgba8(const uint8_t *src, uint8_t *dst, size_t pixelCount)
+{
+	size_t i = 0;
+#ifdef PIXEL_CONVERSION_ENABLE_SSSE3
+	if(is_ssse3_supported())
+		i = convert_rgb8_to_rgba8_ssse3(src, dst, pixelCount);
+#endif
+	for(; i < pixelCount; ++i) {
+		auto *s = src + i * 3;
+		auto *d = dst + i * 4;
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = std::numeric_limits<uint8_t>::max();
+	}
+}
+static void convert_rg8_to_rgba8(const uint8_t *src, uint8_t *dst, size_t pixelCount)
+{
+	for(auto i = decltype(pixelCount) {0u}; i < pixelCount; ++i) {
+		auto *s = src + i * 2;
+		auto *d = dst + i * 4;
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = 0;
+		d[3] = std::numeric_limits<uint8_t>::max();
+	}
+}
+static void convert_rgb32f_to_rgba32f(const float *src, float *dst, size_t pixelCount)
+{
+	for(auto i = decltype(pixelCount) {0u}; i < pixelCount; ++i) {
+		auto *s = src + i * 3;
+		auto *d = dst + i * 4;
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = 1.f;
+	}
+}
+static void convert_rgba32f_to_rgba16f(const float *src, uint16_t *dst, size_t pixelCount)
+{
+	auto n = pixelCount * 4;
+	for(auto i = decltype(n) {0u}; i < n; ++i)
+		dst[i] = float_to_half(src[i]);
+}
+// See EXT_texture_shared_exponent
+static uint32_t float_to_rgb9e5(const float *rgb)
+{
+	constexpr int32_t MANTISSA_BITS = 9;
+	constexpr int32_t EXP_BIAS = 15;
+	constexpr int32_t MAX_EXP = 31;
+	constexpr float MAX_VALUE = static_cast<float>((1 << MANTISSA_BITS) - 1) / static_cast<float>(1 << MANTISSA_BITS) * static_cast<float>(1 << (MAX_EXP - EXP_BIAS));
+	std::array<float, 3> c;
+	for(size_t i = 0; i < c.size(); ++i)
+		c[i] = std::isnan(rgb[i]) ? 0.f : std::clamp(rgb[i], 0.f, MAX_VALUE);
+	auto maxc = std::max({c[0], c[1], c[2]});
+	auto exp = std::max(-EXP_BIAS - 1, (maxc > 0.f) ? static_cast<int32_t>(std::floor(std::log2(maxc))) : -EXP_BIAS - 1) + 1 + EXP_BIAS;
+	auto scale = std::exp2(static_cast<float>(exp - EXP_BIAS - MANTISSA_BITS));
+	if(static_cast<int32_t>(std::floor(maxc / scale + 0.5f)) == (1 << MANTISSA_BITS)) {
+		++exp;
+		scale *= 2.f;
+	}
+	uint32_t packed = static_cast<uint32_t>(exp) << 27;
+	for(size_t i = 0; i < c.size(); ++i)
+		packed |= std::min(static_cast<uint32_t>(std::floor(c[i] / scale + 0.5f)), (1u << MANTISSA_BITS) - 1) << (i * MANTISSA_BITS);
+	return packed;
+}
+static void convert_rgba32f_to_rgb9e5(const float *src, uint32_t *dst, size_t pixelCount)
+{
+	for(auto i = decltype(pixelCount) {0u}; i < pixelCount; ++i)
+		dst[i] = float_to_rgb9e5(src + i * 4);
+}
+
+void pragma::material::detail::convert_pixels_single_threaded(PixelConversion conversion, const void *src, void *dst, size_t pixelCount)
+{
+	switch(conversion) {
+	case PixelConversion::Rgb8ToRgba8:
+		convert_rgb8_to_rgba8(static_cast<const uint8_t *>(src), static_cast<uint8_t *>(dst), pixelCount);
+		break;
+	case PixelConversion::Rg8ToRgba8:
+		convert_rg8_to_rgba8(static_cast<const uint8_t *>(src), static_cast<uint8_t *>(dst), pixelCount);
+		break;
+	case PixelConversion::Rgb32fToRgba32f:
+		convert_rgb32f_to_rgba32f(static_cast<const float *>(src), static_cast<float *>(dst), pixelCount);
+		break;
+	case PixelConversion::Rgba32fToRgba16f:
+		convert_rgba32f_to_rgba16f(static_cast<const float *>(src), static_cast<uint16_t *>(dst), pixelCount);
+		break;
+	case PixelConversion::Rgba32fToRgb9e5:
+		convert_rgba32f_to_rgb9e5(static_cast<const float *>(src), static_cast<uint32_t *>(dst), pixelCount);
+		break;
+	}
+}
+
+void pragma::material::convert_pixels(PixelConversion conversion, const void *src, void *dst, size_t pixelCount)
+{
+	auto &pool = get_worker_pool();
+	// The calling thread takes part in the conversion as well
+	auto numTasks = std::min<size_t>(pool.GetThreadCount() + 1, pixelCount / MIN_PIXELS_PER_TASK);
+	if(numTasks <= 1) {
+		detail::convert_pixels_single_threaded(conversion, src, dst, pixelCount);
+		return;
+	}
+	auto srcSize = get_pixel_conversion_source_size(conversion);
+	auto dstSize = get_pixel_conversion_target_size(conversion);
+	auto pixelsPerTask = (pixelCount + numTasks - 1) / numTasks;
+	pool.ParallelFor(numTasks, [conversion, src, dst, srcSize, dstSize, pixelCount, pixelsPerTask](size_t idx) {
+		auto start = idx * pixelsPerTask;
+		if(start >= pixelCount)
+			return;
+		auto count = std::min(pixelsPerTask, pixelCount - start);
+		detail::convert_pixels_single_threaded(conversion, static_cast<const uint8_t *>(src) + start * srcSize, static_cast<uint8_t *>(dst) + start * dstSize, count);
+	});
+}
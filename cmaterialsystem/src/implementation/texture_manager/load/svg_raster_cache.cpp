@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.cmaterialsystem;
+
+import :texture_manager.svg_raster_cache;
+
+pragma::material::SvgRasterCache &pragma::material::SvgRasterCache::Get()
+{
+	static SvgRasterCache cache {};
+	return cache;
+}
+
+uint64_t pragma::material::SvgRasterCache::Hash(const Key &key)
+{
+	auto hash = calc_fnv1a_hash(&key.contentHash, sizeof(key.contentHash));
+	hash = calc_fnv1a_hash(&key.width, sizeof(key.width), hash);
+	hash = calc_fnv1a_hash(&key.height, sizeof(key.height), hash);
+	return calc_fnv1a_hash(key.styleSheet.data(), key.styleSheet.size(), hash);
+}
+size_t pragma::material::SvgRasterCache::KeyHash::operator()(const Key &key) const { return static_cast<size_t>(Hash(key)); }
+
+std::string pragma::material::SvgRasterCache::NormalizeStyleSheet(const std::string &styleSheet)
+{
+	auto isSeparator = [](char c) { return c == '{' || c == '}' || c == ':' || c == ';' || c == ','; };
+	std::string normalized;
+	normalized.reserve(styleSheet.size());
+	auto pendingSpace = false;
+	for(auto c : styleSheet) {
+		if(std::isspace(static_cast<unsigned char>(c))) {
+			pendingSpace = true;
+			continue;
+		}
+		// Whitespace is only kept between two values (e.g. "1px solid"), not next to separators
+		if(pendingSpace && !normalized.empty() && !isSeparator(normalized.back()) && !isSeparator(c))
+			normalized += ' ';
+		pendingSpace = false;
+		normalized += c;
+	}
+	return normalized;
+}
+std::string pragma::material::SvgRasterCache::GetStyleSheet(udm::LinkedPropertyWrapper prop)
+{
+	std::string styleSheet;
+	if(prop >> styleSheet)
+		return NormalizeStyleSheet(styleSheet);
+	std::stringstream ss;
+	for(auto &pair : prop.ElIt()) {
+		auto &className = pair.key;
+		ss << className << "{";
+		for(auto &kvPair : pair.property.ElIt()) {
+			auto &key = kvPair.key;
+			std::string value;
+			if(!(kvPair.property >> value))
+				continue;
+			ss << key << ":" << value << ";";
+		}
+		ss << "}";
+	}
+	return NormalizeStyleSheet(ss.str());
+}
+
+std::shared_ptr<pragma::image::ImageBuffer> pragma::material::SvgRasterCache::Rasterize(const std::vector<uint8_t> &svgData, uint64_t contentHash, const image::SvgImageInfo &svgInfo)
+{
+	Key key {contentHash, static_cast<uint32_t>(svgInfo.width), static_cast<uint32_t>(svgInfo.height), NormalizeStyleSheet(svgInfo.styleSheet)};
+	{
+		std::scoped_lock lock {m_mutex};
+		auto it = m_entries.find(key);
+		if(it != m_entries.end()) {
+			m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+			return it->second.imgBuf;
+		}
+	}
+	auto imgBuf = LoadFromDisk(key);
+	if(!imgBuf) {
+		ufile::VectorFile f {std::vector<uint8_t> {svgData}};
+		auto rasterInfo = svgInfo;
+		rasterInfo.styleSheet = key.styleSheet;
+		imgBuf = image::load_svg(f, rasterInfo);
+		if(!imgBuf)
+			return nullptr;
+		SaveToDisk(key, *imgBuf);
+	}
+	AddToMemoryCache(key, imgBuf);
+	return imgBuf;
+}
+
+void pragma::material::SvgRasterCache::AddToMemoryCache(const Key &key, const std::shared_ptr<image::ImageBuffer> &imgBuf)
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_entries.find(key);
+	if(it != m_entries.end())
+		return; // Has been rasterized by another thread in the meantime
+	m_lru.push_front(key);
+	m_entries[key] = {imgBuf, m_lru.begin()};
+	m_memoryUsage += imgBuf->GetSize();
+	EvictEntries();
+}
+void pragma::material::SvgRasterCache::EvictEntries()
+{
+	// The most recently used entry is always kept, even if it exceeds the budget on its own
+	while(m_memoryUsage > m_memoryBudget && m_lru.size() > 1) {
+		auto it = m_entries.find(m_lru.back());
+		m_memoryUsage -= it->second.imgBuf->GetSize();
+		m_entries.erase(it);
+		m_lru.pop_back();
+	}
+}
+
+void pragma::material::SvgRasterCache::SetMemoryBudget(size_t budget)
+{
+	std::scoped_lock lock {m_mutex};
+	m_memoryBudget = budget;
+	EvictEntries();
+}
+size_t pragma::material::SvgRasterCache::GetMemoryBudget() const
+{
+	std::scoped_lock lock {m_mutex};
+	return m_memoryBudget;
+}
+size_t pragma::material::SvgRasterCache::GetMemoryUsage() const
+{
+	std::scoped_lock lock {m_mutex};
+	return m_memoryUsage;
+}
+void pragma::material::SvgRasterCache::SetDiskCachePath(const std::string &path)
+{
+	std::scoped_lock lock {m_mutex};
+	m_diskCachePath = path;
+	if(!m_diskCachePath.empty() && m_diskCachePath.back() != '/' && m_diskCachePath.back() != '\\')
+		m_diskCachePath += '/';
+}
+std::string pragma::material::SvgRasterCache::GetDiskCachePath() const
+{
+	std::scoped_lock lock {m_mutex};
+	return m_diskCachePath;
+}
+void pragma::material::SvgRasterCache::Clear()
+{
+	std::scoped_lock lock {m_mutex};
+	m_entries.clear();
+	m_lru.clear();
+	m_memoryUsage = 0;
+}
+
+std::string pragma::material::SvgRasterCache::GetDiskCacheFileName(const Key &key) const
+{
+	auto path = GetDiskCachePath();
+	if(path.empty())
+		return {};
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << Hash(key);
+	return path + ss.str() + ".psvc";
+}
+std::shared_ptr<pragma::image::ImageBuffer> pragma::material::SvgRasterCache::LoadFromDisk(const Key &key) const
+{
+	auto fileName = GetDiskCacheFileName(key);
+	if(fileName.empty())
+		return nullptr;
+	auto f = fs::open_file(fileName, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr)
+		return nullptr;
+	std::array<char, 4> identifier;
+	uint32_t version;
+	Key fileKey {};
+	uint32_t styleSheetLength;
+	if(f->Read(identifier.data(), identifier.size()) != identifier.size() || identifier != PSVC_IDENTIFIER || f->Read(&version, sizeof(version)) != sizeof(version) || version != PSVC_VERSION)
+		return nullptr;
+	if(f->Read(&fileKey.contentHash, sizeof(fileKey.contentHash)) != sizeof(fileKey.contentHash) || f->Read(&fileKey.width, sizeof(fileKey.width)) != sizeof(fileKey.width) || f->Read(&fileKey.height, sizeof(fileKey.height)) != sizeof(fileKey.height)
+	  || f->Read(&styleSheetLength, sizeof(styleSheetLength)) != sizeof(styleSheetLength) || styleSheetLength != key.styleSheet.size())
+		return nullptr;
+	fileKey.styleSheet.resize(styleSheetLength);
+	if(f->Read(fileKey.styleSheet.data(), styleSheetLength) != styleSheetLength || !(fileKey == key))
+		return nullptr; // Hash collision
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint64_t size;
+	if(f->Read(&format, sizeof(format)) != sizeof(format) || f->Read(&width, sizeof(width)) != sizeof(width) || f->Read(&height, sizeof(height)) != sizeof(height) || f->Read(&size, sizeof(size)) != sizeof(size))
+		return nullptr;
+	if(format >= pragma::math::to_integral(image::Format::Count) || width == 0 || height == 0 || width > MAX_DISK_CACHE_IMAGE_DIMENSION || height > MAX_DISK_CACHE_IMAGE_DIMENSION)
+		return nullptr;
+	// The dimensions are limited, so this can't overflow
+	auto expectedSize = static_cast<uint64_t>(width) * height * image::ImageBuffer::GetPixelSize(static_cast<image::Format>(format));
+	if(expectedSize == 0 || size != expectedSize || size > f->GetSize() - f->Tell())
+		return nullptr;
+	std::vector<uint8_t> data(size);
+	if(f->Read(data.data(), size) != size)
+		return nullptr;
+	return image::ImageBuffer::Create(data.data(), width, height, static_cast<image::Format>(format));
+}
+void pragma::material::SvgRasterCache::SaveToDisk(const Key &key, image::ImageBuffer &imgBuf) const
+{
+	auto fileName = GetDiskCacheFileName(key);
+	if(fileName.empty())
+		return;
+	fs::create_path(ufile::get_path_from_filename(fileName));
+	// The file is written under a temporary name first and renamed afterwards, so that other threads or processes never read
+	// a partially written file. The name is unique per thread, since the same image may be rasterized by several threads at once.
+	auto tmpFileName = fileName + '.' + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id())) + ".tmp";
+	auto f = fs::open_file<fs::VFilePtrReal>(tmpFileName, fs::FileMode::Write | fs::FileMode::Binary);
+	if(f == nullptr)
+		return;
+	auto styleSheetLength = static_cast<uint32_t>(key.styleSheet.size());
+	auto format = static_cast<uint32_t>(imgBuf.GetFormat());
+	auto width = static_cast<uint32_t>(imgBuf.GetWidth());
+	auto height = static_cast<uint32_t>(imgBuf.GetHeight());
+	auto size = static_cast<uint64_t>(imgBuf.GetSize());
+	auto success = true;
+	auto write = [&f, &success](const void *data, size_t size) {
+		if(success && f->Write(data, size) != size)
+			success = false;
+	};
+	write(PSVC_IDENTIFIER.data(), PSVC_IDENTIFIER.size());
+	write(&PSVC_VERSION, sizeof(PSVC_VERSION));
+	write(&key.contentHash, sizeof(key.contentHash));
+	write(&key.width, sizeof(key.width));
+	write(&key.height, sizeof(key.height));
+	write(&styleSheetLength, sizeof(styleSheetLength));
+	write(key.styleSheet.data(), key.styleSheet.size());
+	write(&format, sizeof(format));
+	write(&width, sizeof(width));
+	write(&height, sizeof(height));
+	write(&size, sizeof(size));
+	write(imgBuf.GetData(), size);
+	f = nullptr;
+
+	std::string absTmpFileName;
+	if(!fs::find_absolute_path(tmpFileName, absTmpFileName))
+		return;
+	std::error_code ec;
+	std::filesystem::path tmpPath {absTmpFileName};
+	if(success) {
+		auto path = tmpPath.parent_path() / std::filesystem::path {fileName}.filename();
+		std::filesystem::rename(tmpPath, path, ec);
+		if(!ec)
+			return;
+	}
+	std::filesystem::remove(tmpPath, ec);
+}
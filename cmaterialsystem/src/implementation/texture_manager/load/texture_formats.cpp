@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#ifndef DISABLE_VTF_SUPPORT
+#include <VTFFile.h>
+#endif
+
+module pragma.cmaterialsystem;
+
+import :texture_manager.texture_formats;
+
+#ifndef DISABLE_VTEX_SUPPORT
+import source2;
+#endif
+
+template<typename TSourceFormat>
+struct FormatTableEntry {
+	TSourceFormat sourceFormat;
+	pragma::material::TextureFormatInfo info;
+};
+
+template<typename TSourceFormat, size_t N>
+static std::optional<pragma::material::TextureFormatInfo> find_format_info(const std::array<FormatTableEntry<TSourceFormat>, N> &table, TSourceFormat format)
+{
+	auto it = std::find_if(table.begin(), table.end(), [format](const FormatTableEntry<TSourceFormat> &entry) { return entry.sourceFormat == format; });
+	if(it == table.end())
+		return {};
+	return it->info;
+}
+
+static constexpr std::array<prosper::ComponentSwizzle, 4> SWIZZLE_RGBA = {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::A};
+
+#ifndef DISABLE_VTF_SUPPORT
+// Formats that are not listed here are not supported
+static const std::array<FormatTableEntry<VTFImageFormat>, 12> g_vtfFormats = {{
+  {IMAGE_FORMAT_DXT1, {prosper::Format::BC1_RGBA_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_DXT3, {prosper::Format::BC2_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_DXT5, {prosper::Format::BC3_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_RGBA8888, {prosper::Format::R8G8B8A8_UNorm, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_RGB888, {prosper::Format::R8G8B8_UNorm_PoorCoverage, prosper::Format::R8G8B8A8_UNorm, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_BGRA8888, {prosper::Format::B8G8R8A8_UNorm, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_BGR888, {prosper::Format::B8G8R8_UNorm_PoorCoverage, prosper::Format::B8G8R8A8_UNorm, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_UV88, {prosper::Format::R8G8_UNorm, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_RGBA16161616F, {prosper::Format::R16G16B16A16_SFloat, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_RGBA32323232F, {prosper::Format::R32G32B32A32_SFloat, {}, SWIZZLE_RGBA}},
+  {IMAGE_FORMAT_ABGR8888, {prosper::Format::A8B8G8R8_UNorm_Pack32, {}, {prosper::ComponentSwizzle::A, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R}}},
+  // The fourth channel is unused and may contain arbitrary values
+  {IMAGE_FORMAT_BGRX8888, {prosper::Format::B8G8R8A8_UNorm, {}, {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::One}}},
+}};
+std::optional<pragma::material::TextureFormatInfo> pragma::material::find_vtf_format_info(VTFImageFormat format) { return find_format_info(g_vtfFormats, format); }
+#endif
+
+#ifndef DISABLE_VTEX_SUPPORT
+// Formats that are not listed here are not supported
+static const std::array<FormatTableEntry<source2::VTexFormat>, 12> g_vtexFormats = {{
+  {source2::VTexFormat::DXT1, {prosper::Format::BC1_RGBA_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::DXT5, {prosper::Format::BC3_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::RGBA8888, {prosper::Format::R8G8B8A8_UNorm, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::RGBA16161616, {prosper::Format::R16G16B16A16_SNorm, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::RGBA16161616F, {prosper::Format::R16G16B16A16_SFloat, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::RGB323232F, {prosper::Format::R32G32B32_SFloat, prosper::Format::R32G32B32A32_SFloat, SWIZZLE_RGBA}},
+  {source2::VTexFormat::RGBA32323232F, {prosper::Format::R32G32B32A32_SFloat, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::BC6H, {prosper::Format::BC6H_SFloat_Block, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::BC7, {prosper::Format::BC7_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::BGRA8888, {prosper::Format::B8G8R8A8_UNorm, {}, {prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::A}}},
+  {source2::VTexFormat::ATI1N, {prosper::Format::BC4_UNorm_Block, {}, SWIZZLE_RGBA}},
+  {source2::VTexFormat::ATI2N, {prosper::Format::BC5_UNorm_Block, {}, SWIZZLE_RGBA}},
+}};
+std::optional<pragma::material::TextureFormatInfo> pragma::material::find_vtex_format_info(::source2::VTexFormat format) { return find_format_info(g_vtexFormats, format); }
+#endif
+
+prosper::ImageUsageFlags pragma::material::get_texture_image_usage() { return prosper::ImageUsageFlags::TransferSrcBit | prosper::ImageUsageFlags::TransferDstBit | prosper::ImageUsageFlags::SampledBit; }
+
+std::optional<pragma::material::PixelConversion> pragma::material::find_required_cpu_conversion(prosper::IPrContext &context, prosper::Format &inOutFormat)
+{
+	if(context.IsImageFormatSupported(inOutFormat, get_texture_image_usage(), prosper::ImageType::e2D, prosper::ImageTiling::Optimal))
+		return {};
+	prosper::Format targetFormat;
+	auto conversion = find_pixel_conversion(inOutFormat, targetFormat);
+	if(conversion.has_value())
+		inOutFormat = targetFormat;
+	return conversion;
+}
+std::optional<pragma::material::PixelConversion> pragma::material::find_required_cpu_conversion(prosper::IPrContext &context, prosper::Format &inOutFormat, std::optional<prosper::Format> &inOutGpuConversionFormat)
+{
+	auto conversion = find_required_cpu_conversion(context, inOutFormat);
+	if(conversion.has_value())
+		inOutGpuConversionFormat = {};
+	return conversion;
+}
@@ -37,3 +37,9 @@ pragma::material::TextureLoader::TextureLoader(pragma::util::IAssetManager &asse
 	setup_sampler_mipmap_mode(samplerCreateInfo, TextureMipmapMode::Ignore);
 	m_textureSamplerNoMipmap = context.CreateSampler(samplerCreateInfo);
 }
+std::unique_ptr<pragma::util::IAssetProcessor> pragma::material::TextureLoader::CreateAssetProcessor(const std::string &identifier, const std::string &ext, std::unique_ptr<pragma::util::IAssetFormatHandler> &&formatHandler)
+{
+	auto processor = TAssetFormatLoader<TextureProcessor>::CreateAssetProcessor(identifier, ext, std::move(formatHandler));
+	static_cast<TextureProcessor &>(*processor).identifier = identifier;
+	return processor;
+}
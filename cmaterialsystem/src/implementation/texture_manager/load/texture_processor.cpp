@@ -3,9 +3,11 @@
 
 module pragma.cmaterialsystem;
 
+import :texture_manager.manager2;
 import :texture_manager.texture_format_handler;
 import :texture_manager.texture_loader;
 import :texture_manager.texture_processor;
+import :texture_manager.texture_formats;
 
 // If enabled, images and textures will be initialized on a separate thread.
 // Should not be enabled at the moment, as some parts of the memory allocation in Anvil do
@@ -56,13 +58,27 @@ bool pragma::material::TextureProcessor::FinalizeImage(prosper::IPrContext &cont
 
 pragma::material::TextureProcessor::TextureProcessor(pragma::util::AssetFormatLoader &loader, std::unique_ptr<pragma::util::IAssetFormatHandler> &&handler) : FileAssetProcessor {loader, std::move(handler)} {}
 
+bool pragma::material::TextureProcessor::ReportResult(bool success)
+{
+	// Successful loads are reported by the texture manager once the texture has been initialized
+	if(!success) {
+		auto &manager = static_cast<TextureManager &>(handler->GetAssetManager());
+		manager.m_pendingLoads.Complete(manager.ToCacheIdentifier(identifier), false);
+	}
+	return success;
+}
 bool pragma::material::TextureProcessor::Load()
 {
 	if(!static_cast<ITextureFormatHandler &>(*handler).LoadData())
-		return false;
+		return ReportResult(false);
+	// Mipmap levels that exceed the resolution limit are neither converted nor uploaded
+	auto &inputTextureInfo = GetHandler().GetInputTextureInfo();
+	m_baseMipmap = calculate_skipped_mipmap_count(inputTextureInfo.width, inputTextureInfo.height, inputTextureInfo.mipmapCount, maxResolution);
 	auto &loader = GetLoader();
+	if(!ConvertImageData(loader.GetContext()))
+		return ReportResult(false);
 #if ENABLE_MT_IMAGE_INITIALIZATION == 1
-	return !loader.DoesAllowMultiThreadedGpuResourceAllocation() || PrepareImage(loader.GetContext());
+	return ReportResult(!loader.DoesAllowMultiThreadedGpuResourceAllocation() || PrepareImage(loader.GetContext()));
 #else
 	return true;
 #endif
@@ -71,9 +87,9 @@ bool pragma::material::TextureProcessor::Finalize()
 {
 	auto &loader = GetLoader();
 #if ENABLE_MT_IMAGE_INITIALIZATION == 1
-	return (loader.DoesAllowMultiThreadedGpuResourceAllocation() || PrepareImage(loader.GetContext())) && FinalizeImage(loader.GetContext());
+	return ReportResult((loader.DoesAllowMultiThreadedGpuResourceAllocation() || PrepareImage(loader.GetContext())) && FinalizeImage(loader.GetContext()));
 #else
-	return PrepareImage(loader.GetContext()) && FinalizeImage(loader.GetContext());
+	return ReportResult(PrepareImage(loader.GetContext()) && FinalizeImage(loader.GetContext()));
 #endif
 }
 
@@ -82,32 +98,17 @@ bool pragma::material::TextureProcessor::InitializeProsperImage(prosper::IPrCont
 	auto &handler = GetHandler();
 	auto &inputTextureInfo = handler.GetInputTextureInfo();
 	imageFormat = inputTextureInfo.format;
-	const auto width = inputTextureInfo.width;
-	const auto height = inputTextureInfo.height;
-
-	// In some cases the format may not be supported by the GPU altogether. We may still be able to convert it to a compatible format by hand.
-	std::function<void(const void *, std::shared_ptr<image::ImageBuffer> &, uint32_t, uint32_t)> manualConverter = nullptr;
-	const auto usage = prosper::ImageUsageFlags::TransferSrcBit | prosper::ImageUsageFlags::TransferDstBit | prosper::ImageUsageFlags::SampledBit;
-	if(imageFormat == prosper::Format::B8G8R8_UNorm_PoorCoverage && context.IsImageFormatSupported(imageFormat, usage, prosper::ImageType::e2D, prosper::ImageTiling::Optimal) == false) {
-		cpuImageConverter = [](const void *imgData, std::shared_ptr<image::ImageBuffer> &outImg, uint32_t width, uint32_t height) {
-			outImg = image::ImageBuffer::Create(imgData, width, height, image::Format::RGB8);
-			outImg->Convert(image::Format::RGBA8);
-		};
-
-		imageFormat = prosper::Format::B8G8R8A8_UNorm;
-	}
-	else if(imageFormat == prosper::Format::R8G8B8_UNorm_PoorCoverage && context.IsImageFormatSupported(imageFormat, usage, prosper::ImageType::e2D, prosper::ImageTiling::Optimal) == false) {
-		cpuImageConverter = [](const void *imgData, std::shared_ptr<image::ImageBuffer> &outImg, uint32_t width, uint32_t height) {
-			outImg = image::ImageBuffer::Create(imgData, width, height, image::Format::RGB8);
-			outImg->Convert(image::Format::RGBA8);
-		};
+	uint32_t width, height;
+	prosper::util::calculate_mipmap_size(inputTextureInfo.width, inputTextureInfo.height, &width, &height, m_baseMipmap);
 
-		imageFormat = prosper::Format::R8G8B8A8_UNorm;
-	}
+	// Formats that are not supported by the GPU have already been converted on the loader thread (see ConvertImageData)
+	if(m_cpuConversion.has_value())
+		imageFormat = m_cpuConversionFormat;
+	const auto usage = get_texture_image_usage();
 	if(context.IsImageFormatSupported(imageFormat, usage) == false || (targetGpuConversionFormat.has_value() && context.IsImageFormatSupported(*targetGpuConversionFormat, usage) == false))
 		return false;
 
-	mipmapCount = inputTextureInfo.mipmapCount;
+	mipmapCount = inputTextureInfo.mipmapCount - m_baseMipmap;
 	m_generateMipmaps = (mipmapMode == TextureMipmapMode::Generate || (mipmapMode == TextureMipmapMode::LoadOrGenerate && mipmapCount <= 1)) ? true : false;
 	if(m_generateMipmaps == true) {
 		auto targetFormat = targetGpuConversionFormat.has_value() ? *targetGpuConversionFormat : imageFormat;
@@ -131,7 +132,7 @@ bool pragma::material::TextureProcessor::InitializeProsperImage(prosper::IPrCont
 	createInfo.memoryFeatures = prosper::MemoryFeatureFlags::DeviceLocal;
 	createInfo.tiling = prosper::ImageTiling::Optimal;
 	createInfo.usage = usage;
-	createInfo.layers = cubemap ? 6 : 1;
+	createInfo.layers = cubemap ? 6 : std::max(inputTextureInfo.layerCount, 1u);
 	createInfo.postCreateLayout = prosper::ImageLayout::TransferDstOptimal;
 	if(cubemap)
 		createInfo.flags |= prosper::util::ImageCreateInfo::Flags::Cubemap;
@@ -157,6 +158,45 @@ bool pragma::material::TextureProcessor::InitializeProsperImage(prosper::IPrCont
 	return true;
 }
 
+bool pragma::material::TextureProcessor::ConvertImageData(prosper::IPrContext &context)
+{
+	// Executed on the loader thread, so the conversion doesn't stall the main thread during Finalize
+	auto &handler = GetHandler();
+	auto &inputTextureInfo = handler.GetInputTextureInfo();
+	if(cpuImageConverter)
+		return true;
+	auto targetFormat = inputTextureInfo.format;
+	auto gpuConversionFormat = targetGpuConversionFormat;
+	auto conversion = find_required_cpu_conversion(context, targetFormat, gpuConversionFormat);
+	if(!conversion.has_value())
+		return true; // Either no conversion is required, or the format is not supported at all, in which case it will be rejected by InitializeProsperImage
+	auto srcPixelSize = get_pixel_conversion_source_size(*conversion);
+	auto dstPixelSize = get_pixel_conversion_target_size(*conversion);
+	auto numLayers = inputTextureInfo.layerCount;
+	auto mipmapCount = inputTextureInfo.mipmapCount;
+	m_convertedData.resize(numLayers * mipmapCount);
+	for(auto iLayer = decltype(numLayers) {0u}; iLayer < numLayers; ++iLayer) {
+		for(auto iMipmap = m_baseMipmap; iMipmap < mipmapCount; ++iMipmap) {
+			size_t dataSize;
+			void *data;
+			if(handler.GetDataPtr(iLayer, iMipmap, &data, dataSize) == false || data == nullptr)
+				continue;
+			uint32_t wMipmap, hMipmap;
+			prosper::util::calculate_mipmap_size(inputTextureInfo.width, inputTextureInfo.height, &wMipmap, &hMipmap, iMipmap);
+			auto pixelCount = static_cast<size_t>(wMipmap) * hMipmap;
+			if(dataSize < pixelCount * srcPixelSize)
+				return false;
+			auto &convertedData = m_convertedData[iLayer * mipmapCount + iMipmap];
+			convertedData.resize(pixelCount * dstPixelSize);
+			convert_pixels(*conversion, data, convertedData.data(), pixelCount);
+		}
+	}
+	m_cpuConversion = conversion;
+	m_cpuConversionFormat = targetFormat;
+	targetGpuConversionFormat = gpuConversionFormat;
+	return true;
+}
+
 bool pragma::material::TextureProcessor::InitializeImageBuffers(prosper::IPrContext &context)
 {
 	// Initialize image data as buffers, then copy to output image
@@ -169,14 +209,21 @@ bool pragma::material::TextureProcessor::InitializeImageBuffers(prosper::IPrCont
 	imgBuffers.reserve(numLayers * mipmapCount);
 	auto bufAlignment = prosper::util::is_compressed_format(inputTextureInfo.format) ? prosper::util::get_block_size(inputTextureInfo.format) : 0;
 	for(auto iLayer = decltype(numLayers) {0u}; iLayer < numLayers; ++iLayer) {
-		for(auto iMipmap = decltype(mipmapCount) {0u}; iMipmap < mipmapCount; ++iMipmap) {
+		for(auto iMipmap = m_baseMipmap; iMipmap < mipmapCount; ++iMipmap) {
 			size_t dataSize;
 			void *data;
 
 			if(handler.GetDataPtr(iLayer, iMipmap, &data, dataSize) == false || data == nullptr)
 				continue;
 
-			if(cpuImageConverter) {
+			if(!m_convertedData.empty()) {
+				auto &convertedData = m_convertedData[iLayer * mipmapCount + iMipmap];
+				if(convertedData.empty())
+					continue;
+				data = convertedData.data();
+				dataSize = convertedData.size();
+			}
+			else if(cpuImageConverter) {
 				uint32_t wMipmap, hMipmap;
 				prosper::util::calculate_mipmap_size(inputTextureInfo.width, inputTextureInfo.height, &wMipmap, &hMipmap, iMipmap);
 				std::shared_ptr<image::ImageBuffer> imgBuffer = nullptr;
@@ -189,7 +236,7 @@ bool pragma::material::TextureProcessor::InitializeImageBuffers(prosper::IPrCont
 
 			// Initialize buffer with source image data
 			auto buf = context.AllocateTemporaryBuffer(dataSize, bufAlignment, data);
-			buffers.push_back({buf, iLayer, iMipmap}); // We need to keep the buffers alive until the copy has completed
+			buffers.push_back({buf, iLayer, iMipmap - m_baseMipmap}); // We need to keep the buffers alive until the copy has completed
 		}
 	}
 	return true;
@@ -217,6 +264,7 @@ bool pragma::material::TextureProcessor::CopyBuffersToImage(prosper::IPrContext
 	// Don't need these anymore
 	buffers.clear();
 	m_tmpImgBuffers.clear();
+	m_convertedData.clear();
 	return true;
 }
 
@@ -9,6 +9,7 @@ module pragma.cmaterialsystem;
 
 import :texture_manager.load_image_data;
 import :texture_manager.manager;
+import :texture_manager.texture_formats;
 #ifndef DISABLE_VTEX_SUPPORT
 import source2;
 #endif
@@ -81,24 +82,8 @@ void TextureManager::InitializeTextureData(pragma::material::TextureQueueItem &i
 						vtf->texture = std::make_unique<VTFLib::CVTFFile>();
 						vtf->valid = vtf->texture->Load(&f, false);
 						if(vtf->valid == true) {
-							auto format = vtf->texture->GetFormat();
-							switch(format) {
-							case IMAGE_FORMAT_DXT1:
-							case IMAGE_FORMAT_DXT3:
-							case IMAGE_FORMAT_DXT5:
-							case IMAGE_FORMAT_RGB888:
-							case IMAGE_FORMAT_RGBA8888:
-							case IMAGE_FORMAT_BGR888:
-							case IMAGE_FORMAT_BGRA8888:
-							case IMAGE_FORMAT_UV88:
-							case IMAGE_FORMAT_RGBA16161616F:
-							case IMAGE_FORMAT_RGBA32323232F:
-							case IMAGE_FORMAT_ABGR8888:
-							case IMAGE_FORMAT_BGRX8888:
-								break; // Note: When adding new formats, make sure to also add them to texture_initialize.cpp:vtf_format_to_vulkan_format
-							default:
+							if(!pragma::material::find_vtf_format_info(vtf->texture->GetFormat()).has_value())
 								vtf->valid = false; // Unsupported format
-							}
 						}
 					}
 				}
@@ -120,24 +105,8 @@ void TextureManager::InitializeTextureData(pragma::material::TextureQueueItem &i
 							if(texBlock) {
 								vtex->texture = std::static_pointer_cast<source2::resource::Texture>(texBlock->shared_from_this());
 								vtex->valid = true;
-								auto format = vtex->texture->GetFormat();
-								switch(format) {
-								case source2::VTexFormat::DXT1:
-								case source2::VTexFormat::DXT5:
-								case source2::VTexFormat::RGBA8888:
-								case source2::VTexFormat::RGBA16161616:
-								case source2::VTexFormat::RGBA16161616F:
-								case source2::VTexFormat::RGB323232F:
-								case source2::VTexFormat::RGBA32323232F:
-								case source2::VTexFormat::BC6H:
-								case source2::VTexFormat::BC7:
-								case source2::VTexFormat::BGRA8888:
-								case source2::VTexFormat::ATI1N:
-								case source2::VTexFormat::ATI2N:
-									break; // Note: When adding new formats, make sure to also add them to texture_initialize.cpp:vtex_format_to_vulkan_format
-								default:
+								if(!pragma::material::find_vtex_format_info(vtex->texture->GetFormat()).has_value())
 									vtex->valid = false; // Unsupported format
-								}
 							}
 						}
 					}
@@ -15,6 +15,9 @@ pragma::material::TextureManager::TextureManager(prosper::IPrContext &context) :
 {
 	auto fileHandler = std::make_unique<pragma::util::AssetFileHandler>();
 	fileHandler->open = [](const std::string &path, pragma::util::AssetFormatType formatType) -> std::unique_ptr<ufile::IFile> {
+		auto fArchived = open_archived_asset_file(path);
+		if(fArchived)
+			return fArchived;
 		auto openMode = fs::FileMode::Read;
 		if(formatType == pragma::util::AssetFormatType::Binary)
 			openMode |= fs::FileMode::Binary;
@@ -23,7 +26,7 @@ pragma::material::TextureManager::TextureManager(prosper::IPrContext &context) :
 			return nullptr;
 		return std::make_unique<fs::File>(fp);
 	};
-	fileHandler->exists = [](const std::string &path) -> bool { return fs::exists(path); };
+	fileHandler->exists = [](const std::string &path) -> bool { return archived_asset_file_exists(path) || fs::exists(path); };
 	SetFileHandler(std::move(fileHandler));
 
 	m_loader = std::make_unique<TextureLoader>(*this, context);
@@ -48,16 +51,81 @@ pragma::material::TextureManager::TextureManager(prosper::IPrContext &context) :
 
 	RegisterFormatHandler("svg", [](IAssetManager &assetManager) -> std::unique_ptr<ITextureFormatHandler> { return std::make_unique<TextureFormatHandlerSvg>(assetManager); });
 
+	auto assemblyHandler = [](IAssetManager &assetManager) -> std::unique_ptr<ITextureFormatHandler> { return std::make_unique<TextureFormatHandlerAssembly>(assetManager); };
+	RegisterFormatHandler(TextureFormatHandlerAssembly::FORMAT_ASSEMBLY_BINARY, assemblyHandler);
+	RegisterFormatHandler(TextureFormatHandlerAssembly::FORMAT_ASSEMBLY_ASCII, assemblyHandler, pragma::util::AssetFormatType::Text);
+
 	static_cast<TextureLoader &>(GetLoader()).SetAllowMultiThreadedGpuResourceAllocation(context.SupportsMultiThreadedResourceAllocation());
 }
 
 pragma::material::TextureManager::~TextureManager() { m_error = nullptr; }
 
+std::shared_ptr<pragma::material::Texture> pragma::material::TextureManager::ReloadAsset(const std::string &path, std::unique_ptr<TextureLoadInfo> &&loadInfo, PreloadResult *optOutResult)
+{
+	auto *asset = FindCachedAsset(path);
+	if(!asset) {
+		ClearCachedResult(GetIdentifierHash(path));
+		return LoadAsset(path, std::move(loadInfo), optOutResult);
+	}
+	if(!loadInfo)
+		loadInfo = std::make_unique<TextureLoadInfo>();
+	loadInfo->flags |= pragma::util::AssetLoadFlags::IgnoreCache | pragma::util::AssetLoadFlags::DontCache;
+	auto texNew = LoadAsset(path, std::move(loadInfo), optOutResult);
+	if(!texNew || !texNew->HasValidVkTexture())
+		return nullptr;
+	auto texOld = GetAssetObject(*asset);
+	// Old image will be kept alive until rendering has completed, so we don't need to wait for the device here
+	texOld->SetVkTexture(texNew->GetVkTexture());
+	OnAssetReloaded(path);
+	return texOld;
+}
+pragma::util::AssetObject pragma::material::TextureManager::ReloadAsset(const std::string &path, std::unique_ptr<pragma::util::AssetLoadInfo> &&loadInfo, PreloadResult *optOutResult)
+{
+	return ReloadAsset(path, pragma::util::static_unique_pointer_cast<pragma::util::AssetLoadInfo, TextureLoadInfo>(std::move(loadInfo)), optOutResult);
+}
+
 void pragma::material::TextureManager::InitializeProcessor(pragma::util::IAssetProcessor &processor)
 {
 	auto &txProcessor = static_cast<TextureProcessor &>(processor);
-	txProcessor.mipmapMode = static_cast<TextureLoadInfo &>(*txProcessor.loadInfo).mipmapMode;
-	txProcessor.SetTextureData(static_cast<TextureLoadInfo &>(*txProcessor.loadInfo).textureData);
+	auto &loadInfo = static_cast<TextureLoadInfo &>(*txProcessor.loadInfo);
+	txProcessor.mipmapMode = loadInfo.mipmapMode;
+	txProcessor.maxResolution = GetEffectiveMaxResolution(loadInfo);
+	txProcessor.SetTextureData(loadInfo.textureData);
+	auto identifier = ToCacheIdentifier(txProcessor.identifier);
+	std::scoped_lock lock {m_loadedMaxResolutionMutex};
+	m_loadedMaxResolutions[identifier] = txProcessor.maxResolution;
+	m_resolutionLimitWarnings.erase(identifier);
+}
+
+bool pragma::material::is_resolution_limit_exceeded(uint32_t loadedMaxResolution, uint32_t requestedMaxResolution)
+{
+	if(loadedMaxResolution == 0)
+		return false;
+	return requestedMaxResolution == 0 || requestedMaxResolution > loadedMaxResolution;
+}
+uint32_t pragma::material::TextureManager::GetEffectiveMaxResolution(const TextureLoadInfo &loadInfo) { return loadInfo.maxResolution.has_value() ? *loadInfo.maxResolution : get_texture_max_resolution(get_texture_quality_tier(), loadInfo.usage); }
+std::optional<uint32_t> pragma::material::TextureManager::GetLoadedMaxResolution(const std::string &path) const
+{
+	std::scoped_lock lock {m_loadedMaxResolutionMutex};
+	auto it = m_loadedMaxResolutions.find(ToCacheIdentifier(path));
+	if(it == m_loadedMaxResolutions.end())
+		return {};
+	return it->second;
+}
+bool pragma::material::TextureManager::CheckCachedResolutionLimit(const std::string &path, const TextureLoadInfo &loadInfo)
+{
+	if(pragma::math::is_flag_set(loadInfo.flags, pragma::util::AssetLoadFlags::IgnoreCache))
+		return true;
+	auto identifier = ToCacheIdentifier(path);
+	auto requestedMaxResolution = GetEffectiveMaxResolution(loadInfo);
+	std::scoped_lock lock {m_loadedMaxResolutionMutex};
+	auto it = m_loadedMaxResolutions.find(identifier);
+	if(it == m_loadedMaxResolutions.end() || !is_resolution_limit_exceeded(it->second, requestedMaxResolution))
+		return true;
+	// Only reported once per texture, since it is usually requested by many materials
+	if(m_resolutionLimitWarnings.insert(identifier).second)
+		std::cout << "WARNING: Texture '" << identifier << "' has already been loaded with a resolution limit of " << it->second << ", but is requested with " << ((requestedMaxResolution == 0) ? std::string {"no limit"} : "a limit of " + std::to_string(requestedMaxResolution)) << ". The cached texture will be used. Reload the texture to apply the new limit." << std::endl;
+	return false;
 }
 
 pragma::util::AssetObject pragma::material::TextureManager::InitializeAsset(const pragma::util::Asset &asset, const pragma::util::AssetLoadJob &job)
@@ -74,10 +142,52 @@ pragma::util::AssetObject pragma::material::TextureManager::InitializeAsset(cons
 	flags &= ~Texture::Flags::Error;
 	texWrapper->SetFlags(flags);
 	texWrapper->SetName(job.identifier);
+	texWrapper->RunOnLoadedCallbacks();
+	m_completedLoads.push_back(ToCacheIdentifier(job.identifier));
 
 	return texWrapper;
 }
 
+pragma::material::LoadHandle pragma::material::TextureManager::LoadAssetAsync(const std::string &path, std::unique_ptr<TextureLoadInfo> &&loadInfo)
+{
+	auto identifier = ToCacheIdentifier(path);
+	auto *asset = FindCachedAsset(identifier);
+	if(asset && GetAssetObject(*asset)) {
+		if(loadInfo)
+			CheckCachedResolutionLimit(path, *loadInfo);
+		return LoadHandle::CreateCompleted(true);
+	}
+	auto [handle, isNewLoad] = m_pendingLoads.Add(identifier);
+	if(isNewLoad) {
+		auto result = PreloadAsset(path, std::move(loadInfo));
+		// No load job has been queued (e.g. the file doesn't exist), so the load would never be completed otherwise
+		if(!result.success)
+			m_pendingLoads.Complete(identifier, false);
+	}
+	return handle;
+}
+bool pragma::material::TextureManager::WaitForLoad(const LoadHandle &handle, std::chrono::milliseconds timeout)
+{
+	auto tEnd = std::chrono::steady_clock::now() + timeout;
+	for(;;) {
+		Poll();
+		if(handle.IsReady())
+			return true;
+		auto t = std::chrono::steady_clock::now();
+		if(t >= tEnd)
+			return false;
+		handle.Wait(std::min(std::chrono::duration_cast<std::chrono::milliseconds>(tEnd - t), std::chrono::milliseconds {1}));
+	}
+}
+void pragma::material::TextureManager::Poll()
+{
+	TFileAssetManager<Texture, TextureLoadInfo>::Poll();
+	auto completedLoads = std::move(m_completedLoads);
+	m_completedLoads.clear();
+	for(auto &identifier : completedLoads)
+		m_pendingLoads.Complete(identifier, true);
+}
+
 std::shared_ptr<pragma::material::Texture> pragma::material::TextureManager::GetErrorTexture() { return m_error; }
 
 void pragma::material::TextureManager::SetErrorTexture(const std::shared_ptr<Texture> &tex)
@@ -36,16 +36,8 @@ static void initialize_image(pragma::material::TextureQueueItem &item, const pra
 	imgLoader.get_image_info(imgLoader.userData, item, width, height, format, item.cubemap, numLayers, numMipMaps, conversionFormat);
 
 	// In some cases the format may not be supported by the GPU altogether. We may still be able to convert it to a compatible format by hand.
-	std::function<void(const void *, std::shared_ptr<pragma::image::ImageBuffer> &, uint32_t, uint32_t)> manualConverter = nullptr;
-	const auto usage = prosper::ImageUsageFlags::TransferSrcBit | prosper::ImageUsageFlags::TransferDstBit | prosper::ImageUsageFlags::SampledBit;
-	if(format == prosper::Format::B8G8R8_UNorm_PoorCoverage && context.IsImageFormatSupported(format, usage, prosper::ImageType::e2D, prosper::ImageTiling::Optimal) == false) {
-		manualConverter = [](const void *imgData, std::shared_ptr<pragma::image::ImageBuffer> &outImg, uint32_t width, uint32_t height) {
-			outImg = pragma::image::ImageBuffer::Create(imgData, width, height, pragma::image::Format::RGB8);
-			outImg->Convert(pragma::image::Format::RGBA8);
-		};
-		format = prosper::Format::B8G8R8A8_UNorm;
-		conversionFormat = {};
-	}
+	const auto usage = pragma::material::get_texture_image_usage();
+	auto cpuConversion = pragma::material::find_required_cpu_conversion(context, format, conversionFormat);
 	if(context.IsImageFormatSupported(format, usage) == false || (conversionFormat.has_value() && context.IsImageFormatSupported(*conversionFormat, usage) == false))
 		return;
 
@@ -91,8 +83,8 @@ static void initialize_image(pragma::material::TextureQueueItem &item, const pra
 	};
 	std::vector<BufferInfo> buffers {};
 	buffers.reserve(numLayers * numMipMapsLoad);
-	std::vector<std::shared_ptr<pragma::image::ImageBuffer>> imgBuffers {};
-	imgBuffers.reserve(numLayers * numMipMapsLoad);
+	std::vector<std::vector<uint8_t>> convertedData {};
+	convertedData.reserve(numLayers * numMipMapsLoad);
 	auto &setupCmd = context.GetSetupCommandBuffer();
 	for(auto iLayer = decltype(numLayers) {0u}; iLayer < numLayers; ++iLayer) {
 		for(auto iMipmap = decltype(numMipMapsLoad) {0u}; iMipmap < numMipMapsLoad; ++iMipmap) {
@@ -102,15 +94,17 @@ static void initialize_image(pragma::material::TextureQueueItem &item, const pra
 			if(data == nullptr)
 				continue;
 
-			if(manualConverter) {
+			if(cpuConversion.has_value()) {
 				uint32_t wMipmap, hMipmap;
 				prosper::util::calculate_mipmap_size(width, height, &wMipmap, &hMipmap, iMipmap);
-				std::shared_ptr<pragma::image::ImageBuffer> imgBuffer = nullptr;
-				manualConverter(data, imgBuffer, wMipmap, hMipmap);
-				data = imgBuffer->GetData();
-				dataSize = imgBuffer->GetSize();
-
-				imgBuffers.push_back(imgBuffer);
+				auto pixelCount = static_cast<size_t>(wMipmap) * hMipmap;
+				if(dataSize < pixelCount * pragma::material::get_pixel_conversion_source_size(*cpuConversion))
+					continue;
+				auto &converted = convertedData.emplace_back();
+				converted.resize(pixelCount * pragma::material::get_pixel_conversion_target_size(*cpuConversion));
+				pragma::material::convert_pixels(*cpuConversion, data, converted.data(), pixelCount);
+				data = converted.data();
+				dataSize = converted.size();
 			}
 
 			// Initialize buffer with source image data
@@ -137,7 +131,7 @@ static void initialize_image(pragma::material::TextureQueueItem &item, const pra
 
 	// Don't need these anymore
 	buffers.clear();
-	imgBuffers.clear();
+	convertedData.clear();
 
 	if(conversionFormat.has_value()) {
 		auto &setupCmd = context.GetSetupCommandBuffer();
@@ -164,122 +158,6 @@ static void initialize_image(pragma::material::TextureQueueItem &item, const pra
 	}
 }
 
-struct VulkanImageData {
-	// Original image format
-	prosper::Format format = prosper::Format::R8G8B8A8_UNorm;
-
-	// Some formats may not be supported in optimal layout by common GPUs, in which case we need to convert it
-	std::optional<prosper::Format> conversionFormat = {};
-
-	std::array<prosper::ComponentSwizzle, 4> swizzle = {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::A};
-};
-#ifndef DISABLE_VTF_SUPPORT
-static VulkanImageData vtf_format_to_vulkan_format(VTFImageFormat format)
-{
-	VulkanImageData vkImgData {};
-	switch(format) {
-	case IMAGE_FORMAT_DXT1:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_DXT3:
-		vkImgData.format = prosper::Format::BC2_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_DXT5:
-		vkImgData.format = prosper::Format::BC3_UNorm_Block;
-		break;
-	case IMAGE_FORMAT_RGBA8888:
-		vkImgData.format = prosper::Format::R8G8B8A8_UNorm;
-		break;
-	case IMAGE_FORMAT_RGB888: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::R8G8B8A8_UNorm;
-		vkImgData.format = prosper::Format::R8G8B8_UNorm_PoorCoverage;
-		break;
-	case IMAGE_FORMAT_BGRA8888:
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	case IMAGE_FORMAT_BGR888: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::B8G8R8A8_UNorm;
-		vkImgData.format = prosper::Format::B8G8R8_UNorm_PoorCoverage;
-		break;
-	case IMAGE_FORMAT_UV88:
-		vkImgData.format = prosper::Format::R8G8_UNorm;
-		break;
-	case IMAGE_FORMAT_RGBA16161616F:
-		vkImgData.format = prosper::Format::R16G16B16A16_SFloat;
-		break;
-	case IMAGE_FORMAT_RGBA32323232F:
-		vkImgData.format = prosper::Format::R32G32B32A32_SFloat;
-		break;
-	case IMAGE_FORMAT_ABGR8888:
-		vkImgData.swizzle = {prosper::ComponentSwizzle::A, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R};
-		vkImgData.format = prosper::Format::A8B8G8R8_UNorm_Pack32;
-		break;
-	case IMAGE_FORMAT_BGRX8888:
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	default:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	}
-	// Note: When adding a new format, make sure to also add it to TextureManager::InitializeTextureData
-	return vkImgData;
-}
-
-#endif
-
-#ifndef DISABLE_VTEX_SUPPORT
-static VulkanImageData vtex_format_to_vulkan_format(source2::VTexFormat format)
-{
-	VulkanImageData vkImgData {};
-	switch(format) {
-	case source2::VTexFormat::DXT1:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	case source2::VTexFormat::DXT5:
-		vkImgData.format = prosper::Format::BC3_UNorm_Block;
-		break;
-	case source2::VTexFormat::RGBA8888:
-		vkImgData.format = prosper::Format::R8G8B8A8_UNorm;
-		break;
-	case source2::VTexFormat::RGBA16161616:
-		vkImgData.format = prosper::Format::R16G16B16A16_SNorm;
-		break;
-	case source2::VTexFormat::RGBA16161616F:
-		vkImgData.format = prosper::Format::R16G16B16A16_SFloat;
-		break;
-	case source2::VTexFormat::RGB323232F: // Needs to be converted
-		vkImgData.conversionFormat = prosper::Format::R32G32B32A32_SFloat;
-		vkImgData.format = prosper::Format::R32G32B32_SFloat;
-		break;
-	case source2::VTexFormat::RGBA32323232F:
-		vkImgData.format = prosper::Format::R32G32B32A32_SFloat;
-		break;
-	case source2::VTexFormat::BC6H:
-		vkImgData.format = prosper::Format::BC6H_SFloat_Block;
-		break;
-	case source2::VTexFormat::BC7:
-		vkImgData.format = prosper::Format::BC7_UNorm_Block;
-		break;
-	case source2::VTexFormat::BGRA8888:
-		vkImgData.swizzle = {prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::A};
-		vkImgData.format = prosper::Format::B8G8R8A8_UNorm;
-		break;
-	case source2::VTexFormat::ATI1N:
-		vkImgData.format = prosper::Format::BC4_UNorm_Block;
-		break;
-	case source2::VTexFormat::ATI2N:
-		vkImgData.format = prosper::Format::BC5_UNorm_Block;
-		break;
-	default:
-		vkImgData.format = prosper::Format::BC1_RGBA_UNorm_Block;
-		break;
-	}
-	// Note: When adding a new format, make sure to also add it to TextureManager::InitializeTextureData
-	return vkImgData;
-}
-
-#endif
-
 void TextureManager::InitializeImage(pragma::material::TextureQueueItem &item)
 {
 	item.initialized = true;
@@ -389,7 +267,7 @@ void TextureManager::InitializeImage(pragma::material::TextureQueueItem &item)
 						vtfLoader.get_image_info
 						  = [&swizzle](void *userData, const pragma::material::TextureQueueItem &item, uint32_t &outWidth, uint32_t &outHeight, prosper::Format &outFormat, bool &outCubemap, uint32_t &outLayerCount, uint32_t &outMipmapCount, std::optional<prosper::Format> &outConversionFormat) -> void {
 							auto &vtfFile = *static_cast<VTFLib::CVTFFile *>(userData);
-							auto vkFormat = vtf_format_to_vulkan_format(vtfFile.GetFormat());
+							auto vkFormat = pragma::material::find_vtf_format_info(vtfFile.GetFormat()).value_or(pragma::material::TextureFormatInfo {});
 							outWidth = vtfFile.GetWidth();
 							outHeight = vtfFile.GetHeight();
 							outFormat = vkFormat.format;
@@ -420,7 +298,7 @@ void TextureManager::InitializeImage(pragma::material::TextureQueueItem &item)
 						vtexLoader.get_image_info
 						  = [&swizzle](void *userData, const pragma::material::TextureQueueItem &item, uint32_t &outWidth, uint32_t &outHeight, prosper::Format &outFormat, bool &outCubemap, uint32_t &outLayerCount, uint32_t &outMipmapCount, std::optional<prosper::Format> &outConversionFormat) -> void {
 							auto &vtexFile = *static_cast<source2::resource::Texture *>(userData);
-							auto vkFormat = vtex_format_to_vulkan_format(vtexFile.GetFormat());
+							auto vkFormat = pragma::material::find_vtex_format_info(vtexFile.GetFormat()).value_or(pragma::material::TextureFormatInfo {});
 							outWidth = vtexFile.GetWidth();
 							outHeight = vtexFile.GetHeight();
 							outFormat = vkFormat.format;
@@ -9,13 +9,8 @@ pragma::material::Texture::Texture(prosper::IPrContext &context, std::shared_ptr
 
 pragma::material::Texture::~Texture()
 {
-	m_onLoadCallbacks = {};
-	while(m_onRemoveCallbacks.empty() == false) {
-		auto &cb = m_onRemoveCallbacks.front();
-		if(cb.IsValid())
-			cb();
-		m_onRemoveCallbacks.pop();
-	}
+	m_onLoaded.Clear();
+	m_onRemove.Complete();
 	ClearVkTexture();
 }
 
@@ -49,56 +44,76 @@ void pragma::material::Texture::SetVkTexture(std::shared_ptr<prosper::Texture> t
 	++m_updateCount;
 	if(pragma::math::is_flag_set(m_flags, Flags::Loaded))
 		RunOnLoadedCallbacks();
-	for(auto it = m_onVkTextureChanged.begin(); it != m_onVkTextureChanged.end();) {
-		auto &cb = *it;
-		if(!cb.IsValid()) {
-			it = m_onVkTextureChanged.erase(it);
-			continue;
-		}
-		cb();
-		++it;
-	}
+	m_onVkTextureChanged.Invoke();
 }
 bool pragma::material::Texture::HasValidVkTexture() const { return m_texture != nullptr; }
 
 pragma::material::Texture::Flags pragma::material::Texture::GetFlags() const { return m_flags; }
-void pragma::material::Texture::SetFlags(Flags flags) { m_flags = flags; }
+void pragma::material::Texture::SetFlags(Flags flags)
+{
+	if(pragma::math::is_flag_set(m_flags, Flags::Loaded) && !pragma::math::is_flag_set(flags, Flags::Loaded))
+		m_onLoaded.Reset();
+	m_flags = flags;
+}
 void pragma::material::Texture::AddFlags(Flags flags) { m_flags |= flags; }
 
 CallbackHandle pragma::material::Texture::CallOnLoaded(const CallbackHandle &callback)
 {
-	if(IsLoaded()) {
-		const_cast<CallbackHandle &>(callback)(shared_from_this());
-		return {};
-	}
-	m_onLoadCallbacks.push(callback);
+	std::weak_ptr<Texture> wpThis = weak_from_this();
+	// The wrapper is removed from the list once the handle has been removed
+	m_onLoaded.Add(
+	  [wpThis, callback]() mutable {
+		  auto tex = wpThis.lock();
+		  if(tex && callback.IsValid())
+			  callback(tex);
+	  },
+	  CallbackThread::Any, [callback]() { return !callback.IsValid(); });
 	return callback;
 }
+pragma::material::ContinuationHandle pragma::material::Texture::CallOnLoaded(const std::function<void(std::shared_ptr<Texture>)> &callback, CallbackThread thread)
+{
+	std::weak_ptr<Texture> wpThis = weak_from_this();
+	return m_onLoaded.Add(
+	  [wpThis, callback]() {
+		  auto tex = wpThis.lock();
+		  if(tex)
+			  callback(tex);
+	  },
+	  thread);
+}
 CallbackHandle pragma::material::Texture::CallOnVkTextureChanged(const std::function<void()> &callback)
 {
 	auto cb = FunctionCallback<void>::Create(callback);
-	m_onVkTextureChanged.push_back(cb);
+	m_onVkTextureChanged.Add(
+	  [cb]() mutable {
+		  if(cb.IsValid())
+			  cb();
+	  },
+	  CallbackThread::Any, [cb]() { return !cb.IsValid(); });
 	return cb;
 }
+pragma::material::ContinuationHandle pragma::material::Texture::CallOnVkTextureChanged(const std::function<void()> &callback, CallbackThread thread)
+{
+	std::weak_ptr<Texture> wpThis = weak_from_this();
+	return m_onVkTextureChanged.Add(
+	  [wpThis, callback]() {
+		  if(!wpThis.expired())
+			  callback();
+	  },
+	  thread);
+}
 CallbackHandle pragma::material::Texture::CallOnLoaded(const std::function<void(std::shared_ptr<Texture>)> &callback) { return CallOnLoaded(FunctionCallback<void, std::shared_ptr<Texture>>::Create(callback)); }
 CallbackHandle pragma::material::Texture::CallOnRemove(const std::function<void()> &callback)
 {
 	auto cb = FunctionCallback<void>::Create(callback);
-	m_onRemoveCallbacks.push(cb);
+	m_onRemove.Add([cb]() mutable {
+		if(cb.IsValid())
+			cb();
+	});
 	return cb;
 }
 
-void pragma::material::Texture::RunOnLoadedCallbacks()
-{
-	if(m_onLoadCallbacks.empty())
-		return;
-	auto ptr = shared_from_this();
-	while(!m_onLoadCallbacks.empty()) {
-		auto callback = m_onLoadCallbacks.front();
-		m_onLoadCallbacks.pop();
-		callback(ptr);
-	}
-}
+void pragma::material::Texture::RunOnLoadedCallbacks() { m_onLoaded.Complete(); }
 
 void pragma::material::Texture::Reset()
 {
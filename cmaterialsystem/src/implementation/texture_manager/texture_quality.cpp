@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.cmaterialsystem;
+
+import :texture_manager.texture_quality;
+
+static constexpr auto NUM_TIERS = pragma::math::to_integral(pragma::material::TextureQualityTier::Count);
+static constexpr auto NUM_USAGES = pragma::math::to_integral(pragma::material::TextureUsage::Count);
+// Generic, Albedo, Normal, Rma, Emission
+static std::array<std::array<std::atomic<uint32_t>, NUM_USAGES>, NUM_TIERS> g_maxResolutions = {{
+  {512, 512, 512, 256, 256},           // Low
+  {1'024, 1'024, 1'024, 512, 512},     // Medium
+  {2'048, 2'048, 2'048, 1'024, 1'024}, // High
+  {0, 0, 0, 0, 0},                     // Ultra
+}};
+static std::atomic<pragma::material::TextureQualityTier> g_qualityTier = pragma::material::TextureQualityTier::Ultra;
+
+void pragma::material::set_texture_quality_tier(TextureQualityTier tier) { g_qualityTier = tier; }
+pragma::material::TextureQualityTier pragma::material::get_texture_quality_tier() { return g_qualityTier; }
+void pragma::material::set_texture_max_resolution(TextureQualityTier tier, TextureUsage usage, uint32_t maxResolution)
+{
+	if(tier >= TextureQualityTier::Count || usage >= TextureUsage::Count)
+		return;
+	g_maxResolutions[pragma::math::to_integral(tier)][pragma::math::to_integral(usage)] = maxResolution;
+}
+uint32_t pragma::material::get_texture_max_resolution(TextureQualityTier tier, TextureUsage usage)
+{
+	if(tier >= TextureQualityTier::Count || usage >= TextureUsage::Count)
+		return 0;
+	return g_maxResolutions[pragma::math::to_integral(tier)][pragma::math::to_integral(usage)];
+}
+pragma::material::TextureUsage pragma::material::get_texture_usage(std::string_view identifier)
+{
+	if(identifier.find("normal") != std::string_view::npos)
+		return TextureUsage::Normal;
+	if(identifier.find("rma") != std::string_view::npos || identifier.find("metal") != std::string_view::npos || identifier.find("rough") != std::string_view::npos || identifier.find("ao_map") != std::string_view::npos)
+		return TextureUsage::Rma;
+	if(identifier.find("emission") != std::string_view::npos || identifier.find("glow") != std::string_view::npos)
+		return TextureUsage::Emission;
+	if(identifier.find("albedo") != std::string_view::npos || identifier.find("diffuse") != std::string_view::npos)
+		return TextureUsage::Albedo;
+	return TextureUsage::Generic;
+}
+
+uint32_t pragma::material::calculate_skipped_mipmap_count(uint32_t width, uint32_t height, uint32_t mipmapCount, uint32_t maxResolution)
+{
+	if(maxResolution == 0)
+		return 0;
+	uint32_t skipped = 0;
+	while(skipped + 1 < mipmapCount && std::max(width, height) > maxResolution) {
+		width = std::max(width / 2, 1u);
+		height = std::max(height / 2, 1u);
+		++skipped;
+	}
+	return skipped;
+}
@@ -4,5 +4,7 @@
 module;
 
 export module pragma.cmaterialsystem:format_handlers;
+export import :format_handlers.import_texture;
 export import :format_handlers.source_vmt;
 export import :format_handlers.source2_vmat;
+export import :format_handlers.import_conversion_cache;
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:format_handlers.import_conversion_cache;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Keeps track of the texture conversions (e.g. decomposing Source 2 textures into albedo and RMA maps) that have been performed
+	// during material imports, so that materials which share the same input textures only run the conversion once.
+	// Concurrent requests for the same conversion are collapsed into a single job, and conversions writing to the same output file are
+	// serialized. Thread-safe.
+	class DLLCMATSYS ImportConversionCache {
+	  public:
+		static ImportConversionCache &Get();
+		// 'inputs' are the texture paths the conversion reads from, 'parameters' should contain everything else that affects the result (flags, resolution, etc.)
+		static std::string CreateKey(const std::string &type, const std::vector<std::string> &inputs, const std::string &parameters = {});
+		// Checks whether the image file exists, with or without one of the supported image file extensions
+		static bool TextureFileExists(const std::string &path);
+
+		// Executes 'convert' unless the conversion with the specified key has already been performed successfully, in which case the previous
+		// output files are re-used. If another thread is currently executing the same conversion, this waits for its result instead.
+		// Failed conversions (including conversions that throw) are not cached. If 'outputExists' is specified, a previous conversion is only
+		// re-used if all of its output files still exist. Returns true if the output files are available.
+		bool Convert(const std::string &key, const std::vector<std::string> &outputFiles, const std::function<bool()> &convert, const std::function<bool(const std::string &)> &outputExists = nullptr);
+		bool IsCached(const std::string &key) const;
+		// Forgets all previous conversions, i.e. the next import re-generates all output files
+		void Clear();
+
+		// Number of conversions that have actually been executed, and number of requests that were served from the cache
+		uint32_t GetConversionCount() const { return m_conversionCount; }
+		uint32_t GetCacheHitCount() const { return m_cacheHitCount; }
+	  private:
+		enum class State : uint8_t { Pending = 0, Complete };
+		struct Entry {
+			State state = State::Pending;
+			std::vector<std::string> outputFiles;
+		};
+		ImportConversionCache() = default;
+		std::shared_ptr<std::mutex> GetFileMutex(const std::string &outputFile);
+		void FinishConversion(const std::string &key, bool success, const std::vector<std::string> &outputFiles, const std::vector<std::string> &normalizedOutputFiles);
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::unordered_map<std::string, Entry> m_entries;
+		// Output file -> key of the conversion that has written it last
+		std::unordered_map<std::string, std::string> m_outputOwners;
+		std::unordered_map<std::string, std::shared_ptr<std::mutex>> m_fileMutexes;
+		std::atomic<uint32_t> m_conversionCount = 0;
+		std::atomic<uint32_t> m_cacheHitCount = 0;
+	};
+#pragma warning(pop)
+}
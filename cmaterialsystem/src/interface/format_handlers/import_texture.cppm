@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:format_handlers.import_texture;
+
+export import :texture_manager.texture_quality;
+export import pragma.image;
+export import pragma.prosper;
+
+export namespace pragma::material {
+	// Describes what the channels of a texture generated during a material import are used for, which
+	// determines the block compression format it is saved with.
+	enum class ImportTextureUsage : uint8_t {
+		Albedo = 0,          // BC1 (BC7 in high quality mode)
+		AlbedoWithAlpha,     // BC3 (BC7 in high quality mode)
+		NormalMap,           // BC5 if enabled via set_import_normal_maps_bc5, otherwise the image library's default normal map format
+		Rma,                 // BC1, all three channels are used
+		SingleChannel,       // BC4, e.g. parallax or noise maps
+	};
+	DLLCMATSYS void set_import_texture_high_quality(bool highQuality);
+	DLLCMATSYS bool is_import_texture_high_quality();
+	// BC5 only stores the red and green channels, so this should only be enabled if the shaders reconstruct the blue channel
+	DLLCMATSYS void set_import_normal_maps_bc5(bool bc5);
+	DLLCMATSYS bool are_import_normal_maps_bc5();
+	// Quality tier whose resolution limits are applied to textures that are generated during a material import (default: High)
+	DLLCMATSYS void set_import_texture_quality_tier(TextureQualityTier tier);
+	DLLCMATSYS TextureQualityTier get_import_texture_quality_tier();
+
+	// Returns the DDS settings for a texture generated during a material import. The block compression itself
+	// is performed (multi-threaded) by the image library when the texture is saved via prosper::util::save_texture.
+	DLLCMATSYS image::TextureInfo get_import_texture_info(ImportTextureUsage usage, image::TextureInfo::InputFormat inputFormat);
+}
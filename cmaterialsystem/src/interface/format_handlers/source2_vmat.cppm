@@ -4,6 +4,7 @@
 export module pragma.cmaterialsystem:format_handlers.source2_vmat;
 
 export import pragma.materialsystem;
+export import pragma.prosper;
 import source2;
 
 #ifndef DISABLE_VMAT_SUPPORT
@@ -15,6 +16,11 @@ export namespace pragma::material {
 		virtual bool ImportTexture(const std::string &fpath, const std::string &outputPath) override;
 		virtual bool InitializeVMatData(source2::resource::Resource &resource, source2::resource::Material &vmat, datasystem::Block &rootData, datasystem::Settings &settings, const std::string &shader, VMatOrigin origin) override;
 	};
+
+	// Generates the rma map of a Dota 2 material from its first mask texture and saves it in rootPath. Shared by the vmat format handler
+	// and the legacy material manager. Returns the path of the rma map (without extension), or an empty optional if the conversion has failed.
+	DLLCMATSYS std::optional<std::string> convert_dota2_masks_to_rma(prosper::IPrContext &context, const std::string &masksPath, const std::string &rootPath,
+	  const std::function<std::shared_ptr<prosper::Texture>(const std::string &)> &loadTexture);
 };
 
 #endif
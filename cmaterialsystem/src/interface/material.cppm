@@ -52,10 +52,18 @@ export {
 
 			void SetSpriteSheetAnimation(const SpriteSheetAnimation &animInfo);
 			void ClearSpriteSheetAnimation();
+			// Starts loading the sprite sheet animation referenced by the "animation" property in the background (if it hasn't been started yet)
+			void PreloadSpriteSheetAnimation();
+			bool IsSpriteSheetAnimationReady() const;
+			// Non-blocking, returns nullptr if the animation hasn't finished loading yet or if there is none
+			const SpriteSheetAnimation *FindSpriteSheetAnimation() const;
+			// Waits for the animation to finish loading if it is still in progress
 			const SpriteSheetAnimation *GetSpriteSheetAnimation() const;
 			SpriteSheetAnimation *GetSpriteSheetAnimation();
 
 			void LoadTextures(bool precache, bool force = false);
+			// Loads all textures of this material in the background
+			LoadHandle LoadTexturesAsync();
 		  protected:
 			CMaterial(MaterialManager &manager);
 			CMaterial(MaterialManager &manager, const pragma::util::WeakHandle<pragma::util::ShaderInfo> &shader, const std::shared_ptr<datasystem::Block> &data);
@@ -65,13 +73,13 @@ export {
 			virtual void Initialize(const std::shared_ptr<datasystem::Block> &data) override;
 			virtual void OnTexturesUpdated() override;
 			void LoadTexture(const std::shared_ptr<datasystem::Block> &data, TextureInfo &texInfo, TextureLoadFlags flags = TextureLoadFlags::None, const std::shared_ptr<CallbackInfo> &callbackInfo = nullptr);
-			void LoadTexture(TextureMipmapMode mipmapMode, TextureInfo &texInfo, TextureLoadFlags flags = TextureLoadFlags::None, const std::shared_ptr<CallbackInfo> &callbackInfo = nullptr);
+			void LoadTexture(TextureMipmapMode mipmapMode, TextureInfo &texInfo, TextureLoadFlags flags = TextureLoadFlags::None, const std::shared_ptr<CallbackInfo> &callbackInfo = nullptr, std::string_view identifier = {});
 			void InitializeTextures(const std::shared_ptr<datasystem::Block> &data, const std::function<void(void)> &onAllTexturesLoaded = nullptr, const std::function<void(std::shared_ptr<Texture>)> &onTextureLoaded = nullptr, TextureLoadFlags loadFlags = TextureLoadFlags::None);
 			friend CMaterialManager;
 			TextureManager &GetTextureManager();
 
 			void LoadTextures(datasystem::Block &data, bool precache, bool force);
-			void LoadTexture(TextureInfo &texInfo, bool precache);
+			void LoadTexture(TextureInfo &texInfo, bool precache, std::string_view identifier = {});
 
 			bool HaveTexturesBeenInitialized() const;
 		  private:
@@ -90,13 +98,19 @@ export {
 			std::shared_ptr<prosper::ISampler> m_sampler = nullptr;
 			std::shared_ptr<prosper::IBuffer> m_settingsBuffer = nullptr;
 			std::shared_ptr<CallbackInfo> m_callbackInfo;
-			std::optional<SpriteSheetAnimation> m_spriteSheetAnimation {};
+			SpriteSheetAnimationCache::Handle m_spriteSheetAnimation {};
+			// Animation data is shared with other materials using the same sprite sheet until it is modified
+			mutable bool m_isSpriteSheetAnimationShared = false;
 			StateFlags m_stateFlags = StateFlags::None;
 			std::unordered_map<pragma::util::WeakHandle<prosper::Shader>, std::shared_ptr<prosper::IDescriptorSetGroup>, ShaderHash, ShaderEqualFn>::iterator FindShaderDescriptorSetGroup(prosper::Shader &shader);
 			std::unordered_map<pragma::util::WeakHandle<prosper::Shader>, std::shared_ptr<prosper::IDescriptorSetGroup>, ShaderHash, ShaderEqualFn>::const_iterator FindShaderDescriptorSetGroup(prosper::Shader &shader) const;
 			std::shared_ptr<CallbackInfo> InitializeCallbackInfo(const std::function<void(void)> &onAllTexturesLoaded, const std::function<void(std::shared_ptr<Texture>)> &onTextureLoaded);
 
 			uint32_t GetMipmapMode(const datasystem::Block &block) const;
+			std::unique_ptr<TextureLoadInfo> CreateTextureLoadInfo(const TextureInfo &texInfo, std::string_view identifier = {}) const;
+			// Applies the resolution limit of the active quality tier for the texture with the specified identifier (e.g. "normal_map"),
+			// as well as the "max_texture_resolution" property of the material, if set
+			void ApplyTextureResolutionLimit(TextureLoadInfo &loadInfo, std::string_view identifier) const;
 			prosper::IPrContext &GetContext();
 			void LoadTexture(const std::shared_ptr<datasystem::Block> &data, const std::shared_ptr<datasystem::Texture> &texture, TextureLoadFlags flags = TextureLoadFlags::None, const std::shared_ptr<CallbackInfo> &callbackInfo = nullptr);
 			void InitializeSampler();
@@ -43,7 +43,8 @@ export {
 		void ReloadMaterialShaders();
 		void MarkForReload(pragma::material::CMaterial &mat);
 
-		void SetDownscaleImportedRMATextures(bool downscale);
+		// Sets the RMA resolution limit of the import quality tier to 1024 (or removes it)
+		[[deprecated("Use pragma::material::set_texture_max_resolution with TextureUsage::Rma instead.")]] void SetDownscaleImportedRMATextures(bool downscale);
 	};
 #pragma warning(pop)
 }
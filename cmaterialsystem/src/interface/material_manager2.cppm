@@ -24,13 +24,38 @@ export namespace pragma::material {
 
 		prosper::IPrContext &GetContext() { return m_context; }
 		TextureManager &GetTextureManager() { return *m_textureManager; }
+		SpriteSheetAnimationCache &GetSpriteSheetAnimationCache() { return m_spriteSheetAnimationCache; }
+		// Loads the material and all of its textures in the background. The handle completes once all of them have finished loading.
+		LoadHandle LoadMaterialWithTexturesAsync(const std::string &path);
+
+		// While an import batch is active, the textures that have been loaded or generated by material imports are kept until the
+		// batch has ended (instead of being released after every material), so the other materials of the batch can re-use them. Batches can be nested.
+		void BeginImportBatch();
+		void EndImportBatch();
+		bool IsImportBatchActive() const { return m_importBatchDepth > 0; }
+		static constexpr std::chrono::minutes DEFAULT_IMPORT_BATCH_TIMEOUT {10};
+		// Loads (and imports, if necessary) all of the specified materials concurrently within one import batch and waits for them to complete,
+		// or until the timeout has expired. Has to be called from the main thread. Returns the number of materials that have been loaded successfully.
+		// If the batch times out, the unused textures are kept until the next batch has ended, since the remaining imports may still be using them.
+		uint32_t ImportMaterialBatch(const std::vector<std::string> &materials, std::chrono::milliseconds timeout = DEFAULT_IMPORT_BATCH_TIMEOUT);
+		// Imports all vmt files in the specified absolute directory, see ImportMaterialBatch. 'materialRoot' is the path of the directory relative
+		// to the materials directory.
+		uint32_t ImportVmtDirectory(const std::string &rootPath, const std::string &materialRoot, uint32_t *optOutFileCount = nullptr, std::chrono::milliseconds timeout = DEFAULT_IMPORT_BATCH_TIMEOUT);
 		virtual void Poll() override;
 	  private:
 		CMaterialManager(prosper::IPrContext &context);
 		virtual void InitializeImportHandlers() override;
+		virtual void InitializeFileWatcher(AssetFileWatcher &watcher) override;
+		virtual bool IsAssetInUse(const AssetDependencyGraph::AssetId &id) override;
+		virtual void EvictAsset(const AssetDependencyGraph::AssetId &id) override;
+		virtual std::optional<std::string> ResolveAssetFilePath(const AssetDependencyGraph::AssetId &id) override;
+		virtual LoadHandle PrefetchAsset(const AssetDependencyGraph::AssetId &id) override;
 		std::function<void(Material *)> m_shaderHandler;
 		prosper::IPrContext &m_context;
 		std::unique_ptr<TextureManager> m_textureManager;
+		SpriteSheetAnimationCache m_spriteSheetAnimationCache;
 		std::queue<WeakMaterialHandle> m_reloadShaderQueue;
+		std::atomic<uint32_t> m_importBatchDepth = 0;
+		std::atomic<bool> m_importBatchTimedOut = false;
 	};
 };
@@ -48,7 +48,45 @@ export namespace pragma::material {
 		uint32_t GetAbsoluteFrameIndex(uint32_t sequenceIdx, uint32_t localFrameIdx) const;
 		void Save(std::shared_ptr<fs::VFilePtrInternalReal> &f) const;
 		bool Load(std::shared_ptr<fs::VFilePtrInternal> &f);
+		bool Load(ufile::IFile &f);
+		// Parses the sheet resource (VTF_RSRC_SHEET) that is embedded in some Source Engine vtf files. The data is untrusted, returns false if it is malformed.
+		bool LoadVtfSheetData(const void *data, size_t size);
 
 		void UpdateLookupData();
 	};
+
+	// Loads sprite sheet animation files asynchronously on the shared worker pool and shares the result between all materials referencing the same file.
+	class DLLCMATSYS SpriteSheetAnimationCache {
+	  public:
+		using Handle = std::shared_future<std::shared_ptr<SpriteSheetAnimation>>;
+		// Opens the specified file, or returns nullptr if it doesn't exist. Defaults to the virtual file system.
+		using FileOpener = std::function<std::unique_ptr<ufile::IFile>(const std::string &fileName)>;
+		SpriteSheetAnimationCache(const FileOpener &fileOpener = nullptr);
+		// Returns a handle to the animation data, starting a background load if the file hasn't been requested before.
+		// The animation will be nullptr if the file could not be loaded. A failed load is retried once the contents of the file have changed.
+		Handle Load(const std::string &fileName);
+		void Invalidate(const std::string &fileName);
+		void Clear();
+	  private:
+		// Identifies the version of a file, so we can tell whether a failed load should be retried. Only uses information that
+		// is available without reading the file, since it is checked on the calling thread.
+		struct SourceStamp {
+			bool exists = false;
+			uint64_t size = 0;
+			// Only available for files on disk that are accessed through the virtual file system
+			int64_t modificationTime = 0;
+			bool operator==(const SourceStamp &other) const = default;
+		};
+		struct Entry {
+			Handle handle;
+			// Written by the load task before the handle becomes ready
+			std::shared_ptr<SourceStamp> stamp;
+		};
+		static std::unique_ptr<ufile::IFile> OpenFile(const FileOpener &fileOpener, const std::string &fileName);
+		// 'f' is the opened file, or nullptr if it doesn't exist
+		static SourceStamp GetSourceStamp(const FileOpener &fileOpener, const std::string &fileName, ufile::IFile *f);
+		FileOpener m_fileOpener;
+		std::mutex m_cacheMutex;
+		std::unordered_map<std::string, Entry> m_cache;
+	};
 }
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:texture_manager.format_handlers.assembly;
+
+export import :texture_manager.texture_format_handler;
+export import pragma.image;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Assembles a cubemap or a 2D texture array from separate image files, as listed by a descriptor:
+	// $string assetType "PTXA"
+	// $u32 assetVersion 1
+	// assetData {
+	//     $string type "cubemap" // or "array"
+	//     $arr layers [string;6] ["skybox/day_px", "skybox/day_nx", "skybox/day_py", "skybox/day_ny", "skybox/day_pz", "skybox/day_nz"]
+	// }
+	// Layer paths are relative to the texture root directory and may omit the extension. Cubemap faces are expected in the order +X, -X, +Y, -Y, +Z, -Z.
+	// The layers are decoded in parallel and must all have the same size and format.
+	class DLLCMATSYS TextureFormatHandlerAssembly : public ITextureFormatHandler {
+	  public:
+		static constexpr auto PTXA_IDENTIFIER = "PTXA";
+		static constexpr uint32_t PTXA_VERSION = 1;
+		static constexpr auto FORMAT_ASSEMBLY_BINARY = "ptexa_b";
+		static constexpr auto FORMAT_ASSEMBLY_ASCII = "ptexa";
+		static constexpr uint32_t MAX_LAYER_COUNT = 2048;
+		// Decodes the layers in parallel on the shared worker pool. The result has the same order as the paths, layers which could not be loaded are nullptr.
+		static std::vector<std::shared_ptr<image::ImageBuffer>> DecodeLayers(const std::vector<std::string> &layerPaths, bool flipVertically = false);
+		// Checks that all layers have been loaded and have the same size and format, and that cubemap faces are square
+		static bool ValidateLayers(const std::vector<std::shared_ptr<image::ImageBuffer>> &layers, bool cubemap);
+		TextureFormatHandlerAssembly(pragma::util::IAssetManager &assetManager) : ITextureFormatHandler {assetManager} {}
+		virtual bool GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize) override;
+	  protected:
+		virtual bool LoadData(InputTextureInfo &texInfo) override;
+	  private:
+		std::vector<std::shared_ptr<image::ImageBuffer>> m_layers;
+	};
+#pragma warning(pop)
+};
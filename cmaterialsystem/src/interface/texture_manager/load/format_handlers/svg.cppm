@@ -9,11 +9,22 @@ export import pragma.image;
 export namespace pragma::material {
 	class DLLCMATSYS TextureFormatHandlerSvg : public ITextureFormatHandler {
 	  public:
+		// If enabled (default), every mipmap level is rasterized at its own resolution instead of being generated by downsampling on the GPU.
+		// The style sheet of a level can be overridden with the "mipmapStyleSheets" array of the texture data (e.g. to increase stroke widths
+		// for smaller levels). An override applies to its level and all smaller levels, up to the next override, and is appended to the base style sheet.
+		static void SetRasterizeMipmaps(bool rasterize);
+		static bool ShouldRasterizeMipmaps();
+		// Rasterizes the levels below the base level at their own resolution, in parallel on the shared worker pool. The result includes the base level.
+		// Returns an empty vector if any of the levels could not be rasterized at the expected size.
+		static std::vector<std::shared_ptr<image::ImageBuffer>> RasterizeMipmaps(const std::vector<uint8_t> &svgData, uint64_t contentHash, const image::SvgImageInfo &svgInfo, const std::vector<std::string> &mipmapStyleSheets,
+		  const std::shared_ptr<image::ImageBuffer> &baseLevel);
+		// Returns the style sheet override that applies to the mipmap level, or an empty string if there is none
+		static std::string GetMipmapStyleSheet(const std::vector<std::string> &mipmapStyleSheets, uint32_t level);
 		TextureFormatHandlerSvg(pragma::util::IAssetManager &assetManager) : ITextureFormatHandler {assetManager} {}
 		virtual bool GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize) override;
 	  protected:
 		virtual bool LoadData(InputTextureInfo &texInfo) override;
 	  private:
-		std::shared_ptr<image::ImageBuffer> m_imgBuf = nullptr;
+		std::vector<std::shared_ptr<image::ImageBuffer>> m_mipmaps;
 	};
 };
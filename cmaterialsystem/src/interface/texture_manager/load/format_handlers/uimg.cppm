@@ -7,13 +7,39 @@ export import :texture_manager.texture_format_handler;
 export import pragma.image;
 
 export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
 	class DLLCMATSYS TextureFormatHandlerUimg : public ITextureFormatHandler {
 	  public:
+		// Determines how floating point images (i.e. hdr) are stored on the GPU
+		enum class HdrPacking : uint8_t {
+			None = 0,       // 32-bit float per channel
+			Half,           // 16-bit float per channel (default)
+			SharedExponent, // E5B9G9R9, alpha is discarded
+		};
+		static void SetHdrPacking(HdrPacking packing);
+		static HdrPacking GetHdrPacking();
+		// If enabled, mipmaps for high-precision images are generated on the loader thread (box filter) instead of on the GPU.
+		// Mipmaps are always generated on the CPU for the shared exponent packing, since that format usually can't be blitted.
+		static void SetGenerateHdrMipmapsOnCpu(bool cpu);
+		static bool ShouldGenerateHdrMipmapsOnCpu();
+
+		struct DecodedImage {
+			std::shared_ptr<image::ImageBuffer> imgBuf = nullptr;
+			// Mipmaps (including the base level) of high-precision images if they were generated or packed on the CPU, in which case imgBuf is not set
+			std::vector<std::vector<uint8_t>> mipmapData;
+		};
+		// Determines the precision of the image data from the file header
+		static image::PixelFormat GetPixelFormat(ufile::IFile &f);
+		// Decodes the image with the current hdr settings and writes its dimensions, format and mipmap count to texInfo
+		static std::optional<DecodedImage> Decode(ufile::IFile &f, InputTextureInfo &texInfo, bool flipVertically = false);
+
 		TextureFormatHandlerUimg(pragma::util::IAssetManager &assetManager) : ITextureFormatHandler {assetManager} {}
 		virtual bool GetDataPtr(uint32_t layer, uint32_t mipmapIdx, void **outPtr, size_t &outSize) override;
 	  protected:
 		virtual bool LoadData(InputTextureInfo &texInfo) override;
 	  private:
-		std::shared_ptr<image::ImageBuffer> m_imgBuf = nullptr;
+		DecodedImage m_image;
 	};
+#pragma warning(pop)
 };
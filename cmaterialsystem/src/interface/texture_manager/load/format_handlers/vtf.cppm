@@ -11,17 +11,6 @@ export import :texture_manager.texture_format_handler;
 
 #ifndef DISABLE_VTF_SUPPORT
 export namespace pragma::material {
-	namespace detail {
-		struct VulkanImageData {
-			// Original image format
-			prosper::Format format = prosper::Format::R8G8B8A8_UNorm;
-
-			// Some formats may not be supported in optimal layout by common GPUs, in which case we need to convert it
-			std::optional<prosper::Format> conversionFormat = {};
-
-			std::array<prosper::ComponentSwizzle, 4> swizzle = {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::A};
-		};
-	};
 	class DLLCMATSYS TextureFormatHandlerVtf : public ITextureFormatHandler {
 	  public:
 		TextureFormatHandlerVtf(pragma::util::IAssetManager &assetManager);
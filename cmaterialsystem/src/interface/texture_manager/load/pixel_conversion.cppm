@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:texture_manager.pixel_conversion;
+
+export import pragma.prosper;
+
+export namespace pragma::material {
+	// CPU conversions for image data that is not in a format that can be uploaded to the GPU directly.
+	enum class PixelConversion : uint8_t {
+		Rgb8ToRgba8 = 0, // Adds an opaque alpha channel, the order of the color channels is preserved (i.e. also used for BGR -> BGRA)
+		Rg8ToRgba8,      // e.g. UV88, blue is set to 0 and alpha to 1
+		Rgb32fToRgba32f,
+		Rgba32fToRgba16f,
+		Rgba32fToRgb9e5, // Shared exponent (E5B9G9R9), alpha is discarded. Only used if requested explicitly, never returned by find_pixel_conversion.
+
+		Count,
+	};
+	// Size of a single pixel in bytes
+	DLLCMATSYS uint32_t get_pixel_conversion_source_size(PixelConversion conversion);
+	DLLCMATSYS uint32_t get_pixel_conversion_target_size(PixelConversion conversion);
+	// Returns the conversion to use if 'format' is not supported by the GPU, as well as the format of the converted data
+	DLLCMATSYS std::optional<PixelConversion> find_pixel_conversion(prosper::Format format, prosper::Format &outTargetFormat);
+
+	// Converts 'pixelCount' pixels from 'src' to 'dst'. 'dst' must have space for pixelCount *get_pixel_conversion_target_size(conversion) bytes.
+	// Large images are split into contiguous ranges, which are converted in parallel on the shared worker pool (see get_worker_pool).
+	DLLCMATSYS void convert_pixels(PixelConversion conversion, const void *src, void *dst, size_t pixelCount);
+	namespace detail {
+		// Converts the pixels on the calling thread only
+		DLLCMATSYS void convert_pixels_single_threaded(PixelConversion conversion, const void *src, void *dst, size_t pixelCount);
+	};
+};
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:texture_manager.svg_raster_cache;
+
+export import pragma.image;
+export import pragma.udm;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Cache for rasterized svg images, keyed by the svg file contents, the target resolution and the style sheet.
+	// Images are kept in memory up to a budget (least recently used images are evicted first) and, if a disk cache path has been set,
+	// are also written to disk so they can be re-used the next time the program is started. Thread-safe.
+	// Cached image buffers are shared and must not be modified.
+	class DLLCMATSYS SvgRasterCache {
+	  public:
+		static constexpr std::array<char, 4> PSVC_IDENTIFIER = {'P', 'S', 'V', 'C'};
+		static constexpr uint32_t PSVC_VERSION = 1;
+		static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+		// Images in the disk cache with larger dimensions are considered to be corrupt
+		static constexpr uint32_t MAX_DISK_CACHE_IMAGE_DIMENSION = 16'384;
+		struct DLLCMATSYS Key {
+			uint64_t contentHash = 0;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			std::string styleSheet;
+			bool operator==(const Key &other) const = default;
+		};
+		struct DLLCMATSYS KeyHash {
+			size_t operator()(const Key &key) const;
+		};
+		static SvgRasterCache &Get();
+		// Stable across program runs and platforms, the content hash has to be calculated with calc_fnv1a_hash
+		static uint64_t Hash(const Key &key);
+		// Collapses whitespace, so that equivalent style sheets map to the same key
+		static std::string NormalizeStyleSheet(const std::string &styleSheet);
+		// Returns the style sheet as css. The style sheet can either be a string, or a set of elements ({<className> = {<key> = <value>}}).
+		static std::string GetStyleSheet(udm::LinkedPropertyWrapper prop);
+
+		// Returns the cached image for the svg contents if there is one, otherwise rasterizes it and adds it to the cache.
+		// The width and height of svgInfo may be 0 to rasterize at the size specified in the svg.
+		std::shared_ptr<image::ImageBuffer> Rasterize(const std::vector<uint8_t> &svgData, uint64_t contentHash, const image::SvgImageInfo &svgInfo);
+
+		void SetMemoryBudget(size_t budget);
+		size_t GetMemoryBudget() const;
+		size_t GetMemoryUsage() const;
+		// An empty path disables the disk cache (default)
+		void SetDiskCachePath(const std::string &path);
+		std::string GetDiskCachePath() const;
+		// Clears the memory cache, files in the disk cache are kept
+		void Clear();
+	  private:
+		struct Entry {
+			std::shared_ptr<image::ImageBuffer> imgBuf;
+			std::list<Key>::iterator lruIt;
+		};
+		SvgRasterCache() = default;
+		std::string GetDiskCacheFileName(const Key &key) const;
+		std::shared_ptr<image::ImageBuffer> LoadFromDisk(const Key &key) const;
+		void SaveToDisk(const Key &key, image::ImageBuffer &imgBuf) const;
+		void AddToMemoryCache(const Key &key, const std::shared_ptr<image::ImageBuffer> &imgBuf);
+		void EvictEntries();
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<Key, Entry, KeyHash> m_entries;
+		std::list<Key> m_lru;
+		size_t m_memoryUsage = 0;
+		size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+		std::string m_diskCachePath;
+	};
+#pragma warning(pop)
+}
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#ifndef DISABLE_VTF_SUPPORT
+#include <VTFFile.h>
+#endif
+
+export module pragma.cmaterialsystem:texture_manager.texture_formats;
+
+export import :texture_manager.pixel_conversion;
+export import pragma.prosper;
+
+#ifndef DISABLE_VTEX_SUPPORT
+import source2;
+#endif
+
+// Format capability tables and image preparation shared by the texture format handlers (pragma::material::TextureManager)
+// and the legacy texture manager (::TextureManager).
+export namespace pragma::material {
+	struct TextureFormatInfo {
+		// Original image format
+		prosper::Format format = prosper::Format::R8G8B8A8_UNorm;
+
+		// Some formats may not be supported in optimal layout by common GPUs, in which case we need to convert it
+		std::optional<prosper::Format> conversionFormat = {};
+
+		std::array<prosper::ComponentSwizzle, 4> swizzle = {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::A};
+	};
+#ifndef DISABLE_VTF_SUPPORT
+	// Returns an empty optional if the format is not supported
+	DLLCMATSYS std::optional<TextureFormatInfo> find_vtf_format_info(VTFImageFormat format);
+#endif
+#ifndef DISABLE_VTEX_SUPPORT
+	// Returns an empty optional if the format is not supported
+	DLLCMATSYS std::optional<TextureFormatInfo> find_vtex_format_info(::source2::VTexFormat format);
+#endif
+
+	// Usage flags of images created for texture assets
+	DLLCMATSYS prosper::ImageUsageFlags get_texture_image_usage();
+	// If image data of the specified format can't be used by the GPU, returns the CPU conversion that needs to be applied to the data and
+	// changes 'inOutFormat' to the format of the converted data.
+	DLLCMATSYS std::optional<PixelConversion> find_required_cpu_conversion(prosper::IPrContext &context, prosper::Format &inOutFormat);
+	// Same as above, but also clears 'inOutGpuConversionFormat' if a CPU conversion is required. The converted data is already in a format
+	// that can be sampled, and the GPU conversion would expect the data in the original format.
+	DLLCMATSYS std::optional<PixelConversion> find_required_cpu_conversion(prosper::IPrContext &context, prosper::Format &inOutFormat, std::optional<prosper::Format> &inOutGpuConversionFormat);
+};
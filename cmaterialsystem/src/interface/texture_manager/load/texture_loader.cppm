@@ -18,6 +18,8 @@ export namespace pragma::material {
 
 		const std::shared_ptr<prosper::ISampler> &GetTextureSampler() const { return m_textureSampler; }
 		const std::shared_ptr<prosper::ISampler> &GetTextureSamplerNoMipmap() const { return m_textureSamplerNoMipmap; }
+	  protected:
+		virtual std::unique_ptr<pragma::util::IAssetProcessor> CreateAssetProcessor(const std::string &identifier, const std::string &ext, std::unique_ptr<pragma::util::IAssetFormatHandler> &&formatHandler) override;
 	  private:
 		bool m_allowMultiThreadedGpuResourceAllocation = true;
 		prosper::IPrContext &m_context;
@@ -3,6 +3,7 @@
 
 export module pragma.cmaterialsystem:texture_manager.texture_processor;
 
+export import :texture_manager.pixel_conversion;
 export import pragma.image;
 export import pragma.materialsystem;
 export import pragma.prosper;
@@ -21,6 +22,8 @@ export namespace pragma::material {
 		TextureProcessor(pragma::util::AssetFormatLoader &loader, std::unique_ptr<pragma::util::IAssetFormatHandler> &&handler);
 		virtual bool Load() override;
 		virtual bool Finalize() override;
+		// Converts the image data on the CPU if its format is not supported by the GPU
+		bool ConvertImageData(prosper::IPrContext &context);
 		bool InitializeProsperImage(prosper::IPrContext &context);
 		bool InitializeImageBuffers(prosper::IPrContext &context);
 		bool InitializeTexture(prosper::IPrContext &context);
@@ -33,6 +36,8 @@ export namespace pragma::material {
 		bool FinalizeImage(prosper::IPrContext &context);
 
 		TextureMipmapMode mipmapMode = TextureMipmapMode::LoadOrGenerate;
+		// Mipmap levels larger than this are not uploaded if the texture contains mipmaps (0 = no limit)
+		uint32_t maxResolution = 0;
 		std::shared_ptr<prosper::IImage> image;
 		std::shared_ptr<prosper::IImage> convertedImage;
 		std::shared_ptr<prosper::Texture> texture;
@@ -41,11 +46,18 @@ export namespace pragma::material {
 		std::optional<prosper::Format> targetGpuConversionFormat {};
 		std::function<void(const void *, std::shared_ptr<image::ImageBuffer> &, uint32_t, uint32_t)> cpuImageConverter = nullptr;
 		std::vector<BufferInfo> buffers {};
+		std::string identifier;
 	  private:
 		TextureLoader &GetLoader();
 		ITextureFormatHandler &GetHandler();
+		bool ReportResult(bool success);
 
 		bool m_generateMipmaps = false;
+		// Number of top mipmap levels of the input data that are skipped due to maxResolution
+		uint32_t m_baseMipmap = 0;
 		std::vector<std::shared_ptr<image::ImageBuffer>> m_tmpImgBuffers {};
+		std::optional<PixelConversion> m_cpuConversion {};
+		prosper::Format m_cpuConversionFormat = prosper::Format::Unknown;
+		std::vector<std::vector<uint8_t>> m_convertedData {};
 	};
 };
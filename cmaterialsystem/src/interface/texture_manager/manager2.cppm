@@ -4,13 +4,21 @@
 export module pragma.cmaterialsystem:texture_manager.manager2;
 
 export import :texture_manager.texture;
+export import :texture_manager.texture_processor;
+export import :texture_manager.texture_quality;
 
 export namespace pragma::material {
 	struct DLLCMATSYS TextureLoadInfo : public util::AssetLoadInfo {
 		TextureLoadInfo(util::AssetLoadFlags flags = util::AssetLoadFlags::None);
 		TextureMipmapMode mipmapMode;
 		std::shared_ptr<udm::Property> textureData;
+		// Determines the resolution limit for the active quality tier, unless maxResolution is set
+		TextureUsage usage = TextureUsage::Generic;
+		std::optional<uint32_t> maxResolution {};
 	};
+	// Returns true if a texture that has been loaded with the resolution limit loadedMaxResolution is smaller than it would be with
+	// requestedMaxResolution. A limit of 0 means there is no limit.
+	DLLCMATSYS bool is_resolution_limit_exceeded(uint32_t loadedMaxResolution, uint32_t requestedMaxResolution);
 	class DLLCMATSYS TextureManager : public util::TFileAssetManager<Texture, TextureLoadInfo> {
 	  public:
 		using AssetType = Texture;
@@ -21,12 +29,35 @@ export namespace pragma::material {
 		std::shared_ptr<Texture> GetErrorTexture();
 		void SetErrorTexture(const std::shared_ptr<Texture> &tex);
 
+		// Reloads the texture in-place, i.e. existing references to the texture will receive the new image
+		std::shared_ptr<Texture> ReloadAsset(const std::string &path, std::unique_ptr<TextureLoadInfo> &&loadInfo = nullptr, PreloadResult *optOutResult = nullptr);
+		// See MaterialManager::LoadAssetAsync
+		LoadHandle LoadAssetAsync(const std::string &path, std::unique_ptr<TextureLoadInfo> &&loadInfo = nullptr);
+		bool WaitForLoad(const LoadHandle &handle, std::chrono::milliseconds timeout);
+		virtual void Poll() override;
+
+		// Resolution limit that applies to the load, i.e. the explicit limit or the limit of the active quality tier for the usage (0 if there is none)
+		static uint32_t GetEffectiveMaxResolution(const TextureLoadInfo &loadInfo);
+		// Resolution limit the texture has been loaded with, if it has been loaded
+		std::optional<uint32_t> GetLoadedMaxResolution(const std::string &path) const;
+		// Textures are cached by their path only, so a texture that has already been loaded with a lower resolution limit (e.g. for a
+		// different usage, or before the quality tier was changed) is re-used at that resolution. This prints a warning in that case.
+		// Returns false if the cached texture is smaller than requested.
+		bool CheckCachedResolutionLimit(const std::string &path, const TextureLoadInfo &loadInfo);
+
 		void Test();
 	  protected:
+		friend TextureProcessor;
 		virtual void InitializeProcessor(util::IAssetProcessor &processor) override;
 		virtual util::AssetObject InitializeAsset(const util::Asset &asset, const util::AssetLoadJob &job) override;
+		virtual util::AssetObject ReloadAsset(const std::string &path, std::unique_ptr<util::AssetLoadInfo> &&loadInfo, PreloadResult *optOutResult = nullptr) override;
 
 		prosper::IPrContext &m_context;
 		std::shared_ptr<Texture> m_error;
+		PendingLoadRegistry m_pendingLoads;
+		std::vector<std::string> m_completedLoads;
+		mutable std::mutex m_loadedMaxResolutionMutex;
+		std::unordered_map<std::string, uint32_t> m_loadedMaxResolutions;
+		std::unordered_set<std::string> m_resolutionLimitWarnings;
 	};
 };
@@ -26,6 +26,9 @@ export {
 			CallbackHandle CallOnLoaded(const CallbackHandle &callback);
 			CallbackHandle CallOnVkTextureChanged(const std::function<void()> &callback);
 			CallbackHandle CallOnRemove(const std::function<void()> &callback);
+			// Thread-safe variants. The callbacks will not be executed if the texture has been destroyed in the meantime.
+			ContinuationHandle CallOnLoaded(const std::function<void(std::shared_ptr<Texture>)> &callback, CallbackThread thread);
+			ContinuationHandle CallOnVkTextureChanged(const std::function<void()> &callback, CallbackThread thread);
 			void RunOnLoadedCallbacks();
 
 			void SetName(const std::string &name);
@@ -52,9 +55,9 @@ export {
 			Flags GetFlags() const;
 			void SetFlags(Flags flags);
 		  private:
-			std::vector<CallbackHandle> m_onVkTextureChanged;
-			std::queue<CallbackHandle> m_onLoadCallbacks;
-			std::queue<CallbackHandle> m_onRemoveCallbacks;
+			CallbackList<> m_onVkTextureChanged;
+			ContinuationList<> m_onLoaded;
+			ContinuationList<> m_onRemove;
 			Flags m_flags = Flags::Error;
 			TextureType m_fileFormatType;
 			std::optional<pragma::util::Path> m_filePath {};
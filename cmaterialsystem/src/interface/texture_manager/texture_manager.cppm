@@ -12,6 +12,11 @@ export import :texture_manager.texture_queue;
 export import :texture_manager.texture_format_handler;
 export import :texture_manager.texture_loader;
 export import :texture_manager.texture_processor;
+export import :texture_manager.pixel_conversion;
+export import :texture_manager.texture_formats;
+export import :texture_manager.texture_quality;
+export import :texture_manager.svg_raster_cache;
+export import :texture_manager.format_handlers.assembly;
 export import :texture_manager.format_handlers.gli;
 export import :texture_manager.format_handlers.svg;
 export import :texture_manager.format_handlers.uimg;
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.cmaterialsystem:texture_manager.texture_quality;
+
+export namespace pragma::material {
+	// What a texture is used for within a material, which determines its resolution limit for a quality tier
+	enum class TextureUsage : uint8_t {
+		Generic = 0,
+		Albedo,
+		Normal,
+		Rma,
+		Emission,
+
+		Count,
+	};
+	enum class TextureQualityTier : uint8_t {
+		Low = 0,
+		Medium,
+		High,
+		Ultra, // No resolution limit (default)
+
+		Count,
+	};
+	DLLCMATSYS void set_texture_quality_tier(TextureQualityTier tier);
+	DLLCMATSYS TextureQualityTier get_texture_quality_tier();
+	// Maximum width/height of a texture with the specified usage for the tier, or 0 if there is no limit
+	DLLCMATSYS void set_texture_max_resolution(TextureQualityTier tier, TextureUsage usage, uint32_t maxResolution);
+	DLLCMATSYS uint32_t get_texture_max_resolution(TextureQualityTier tier, TextureUsage usage);
+	// Determines the usage from a material texture identifier, e.g. "normal_map" -> TextureUsage::Normal
+	DLLCMATSYS TextureUsage get_texture_usage(std::string_view identifier);
+
+	// Returns the number of top mipmap levels that have to be skipped for the texture to fit within maxResolution.
+	// At least one mipmap level is always kept.
+	DLLCMATSYS uint32_t calculate_skipped_mipmap_count(uint32_t width, uint32_t height, uint32_t mipmapCount, uint32_t maxResolution);
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+using pragma::material::ImportConversionCache;
+
+namespace {
+	// The cache is a singleton, so all counts are measured relative to the state before the test
+	struct CountDelta {
+		uint32_t conversions = ImportConversionCache::Get().GetConversionCount();
+		uint32_t cacheHits = ImportConversionCache::Get().GetCacheHitCount();
+		uint32_t GetConversions() const { return ImportConversionCache::Get().GetConversionCount() - conversions; }
+		uint32_t GetCacheHits() const { return ImportConversionCache::Get().GetCacheHitCount() - cacheHits; }
+	};
+}
+
+MATSYS_TEST(repeated_conversions_are_cached)
+{
+	auto &cache = ImportConversionCache::Get();
+	cache.Clear();
+	CountDelta delta {};
+	auto key = ImportConversionCache::CreateKey("test_repeated", {"Materials\\Input.vtf"});
+	MATSYS_CHECK(key == ImportConversionCache::CreateKey("test_repeated", {"materials/input.vtf"}));
+	for(auto i = 0; i < 3; ++i)
+		MATSYS_CHECK(cache.Convert(key, {"output"}, []() { return true; }));
+	MATSYS_CHECK(delta.GetConversions() == 1);
+	MATSYS_CHECK(delta.GetCacheHits() == 2);
+	MATSYS_CHECK(cache.IsCached(key));
+
+	// Failed conversions are not cached
+	auto failedKey = ImportConversionCache::CreateKey("test_repeated_failure", {"input"});
+	MATSYS_CHECK(!cache.Convert(failedKey, {"output_failed"}, []() { return false; }));
+	MATSYS_CHECK(!cache.IsCached(failedKey));
+	MATSYS_CHECK(cache.Convert(failedKey, {"output_failed"}, []() { return true; }));
+	MATSYS_CHECK(delta.GetConversions() == 3);
+
+	cache.Clear();
+	MATSYS_CHECK(!cache.IsCached(key));
+}
+
+MATSYS_TEST(concurrent_requests_collapse)
+{
+	auto &cache = ImportConversionCache::Get();
+	cache.Clear();
+	CountDelta delta {};
+	auto key = ImportConversionCache::CreateKey("test_concurrent", {"input"});
+	std::atomic<uint32_t> numExecuted = 0;
+	std::vector<std::future<bool>> results;
+	for(auto i = 0; i < 8; ++i) {
+		results.push_back(std::async(std::launch::async, [&]() {
+			return cache.Convert(key, {"output"}, [&]() {
+				++numExecuted;
+				std::this_thread::sleep_for(std::chrono::milliseconds {50});
+				return true;
+			});
+		}));
+	}
+	for(auto &result : results)
+		MATSYS_CHECK(result.get());
+	MATSYS_CHECK(numExecuted == 1);
+	MATSYS_CHECK(delta.GetConversions() == 1);
+	MATSYS_CHECK(delta.GetCacheHits() == 7);
+}
+
+// A conversion that throws must not leave threads waiting for it blocked, and must not be cached
+MATSYS_TEST(throwing_conversion_releases_waiters)
+{
+	auto &cache = ImportConversionCache::Get();
+	cache.Clear();
+	CountDelta delta {};
+	auto key = ImportConversionCache::CreateKey("test_throwing", {"input"});
+	std::atomic<bool> started = false;
+	auto throwing = std::async(std::launch::async, [&]() {
+		try {
+			cache.Convert(key, {"output"}, [&]() -> bool {
+				started = true;
+				std::this_thread::sleep_for(std::chrono::milliseconds {100});
+				throw std::runtime_error {"conversion failed"};
+			});
+		}
+		catch(const std::runtime_error &) {
+			return true;
+		}
+		return false;
+	});
+	while(!started)
+		std::this_thread::yield();
+	auto waiting = std::async(std::launch::async, [&]() { return cache.Convert(key, {"output"}, []() { return true; }); });
+
+	MATSYS_REQUIRE(throwing.wait_for(std::chrono::seconds {10}) == std::future_status::ready);
+	MATSYS_CHECK(throwing.get());
+	MATSYS_REQUIRE(waiting.wait_for(std::chrono::seconds {10}) == std::future_status::ready);
+	// The waiting thread re-executes the conversion instead of re-using the failed result
+	MATSYS_CHECK(waiting.get());
+	MATSYS_CHECK(delta.GetConversions() == 2);
+	MATSYS_CHECK(cache.IsCached(key));
+}
+
+// Output files that have been deleted since the conversion was performed are re-generated
+MATSYS_TEST(missing_outputs_are_reconverted)
+{
+	test::TempDirectory dir {"import_conversion_cache", pragma::util::get_program_path()};
+	auto &cache = ImportConversionCache::Get();
+	cache.Clear();
+	CountDelta delta {};
+	auto key = ImportConversionCache::CreateKey("test_missing_outputs", {"input"});
+	auto albedoPath = dir.GetName() + "/input_albedo";
+	auto rmaPath = dir.GetName() + "/input_rma";
+	auto convert = [&]() {
+		dir.WriteFile("input_albedo.dds", "albedo");
+		dir.WriteFile("input_rma.dds", "rma");
+		return true;
+	};
+	MATSYS_CHECK(!ImportConversionCache::TextureFileExists(albedoPath));
+	MATSYS_CHECK(cache.Convert(key, {albedoPath, rmaPath}, convert, ImportConversionCache::TextureFileExists));
+	MATSYS_CHECK(ImportConversionCache::TextureFileExists(albedoPath));
+	MATSYS_CHECK(ImportConversionCache::TextureFileExists(dir.GetName() + "/input_rma.dds"));
+	MATSYS_CHECK(cache.Convert(key, {albedoPath, rmaPath}, convert, ImportConversionCache::TextureFileExists));
+	MATSYS_CHECK(delta.GetConversions() == 1);
+	MATSYS_CHECK(delta.GetCacheHits() == 1);
+
+	std::filesystem::remove(dir.GetPath() / "input_rma.dds");
+	MATSYS_CHECK(cache.Convert(key, {albedoPath, rmaPath}, convert, ImportConversionCache::TextureFileExists));
+	MATSYS_CHECK(delta.GetConversions() == 2);
+	MATSYS_CHECK(ImportConversionCache::TextureFileExists(rmaPath));
+
+	// Without an existence check the previous result is always re-used
+	std::filesystem::remove(dir.GetPath() / "input_rma.dds");
+	MATSYS_CHECK(cache.Convert(key, {albedoPath, rmaPath}, convert));
+	MATSYS_CHECK(delta.GetConversions() == 2);
+	MATSYS_CHECK(delta.GetCacheHits() == 2);
+}
+
+MATSYS_TEST_MAIN()
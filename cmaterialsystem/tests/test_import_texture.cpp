@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+using pragma::image::TextureInfo;
+using pragma::material::ImportTextureUsage;
+
+static TextureInfo get_info(ImportTextureUsage usage) { return pragma::material::get_import_texture_info(usage, TextureInfo::InputFormat::R8G8B8A8_UInt); }
+
+MATSYS_TEST(default_formats)
+{
+	MATSYS_CHECK(!pragma::material::is_import_texture_high_quality());
+	MATSYS_CHECK(!pragma::material::are_import_normal_maps_bc5());
+	for(auto usage : {ImportTextureUsage::Albedo, ImportTextureUsage::AlbedoWithAlpha, ImportTextureUsage::NormalMap, ImportTextureUsage::Rma, ImportTextureUsage::SingleChannel}) {
+		auto texInfo = get_info(usage);
+		MATSYS_CHECK(texInfo.containerFormat == TextureInfo::ContainerFormat::DDS);
+		MATSYS_CHECK(pragma::math::is_flag_set(texInfo.flags, TextureInfo::Flags::GenerateMipmaps));
+		MATSYS_CHECK(texInfo.inputFormat == TextureInfo::InputFormat::R8G8B8A8_UInt);
+	}
+	MATSYS_CHECK(get_info(ImportTextureUsage::Albedo).outputFormat == TextureInfo::OutputFormat::ColorMap);
+	MATSYS_CHECK(get_info(ImportTextureUsage::Albedo).alphaMode == TextureInfo::AlphaMode::None);
+	MATSYS_CHECK(get_info(ImportTextureUsage::AlbedoWithAlpha).outputFormat == TextureInfo::OutputFormat::ColorMapSmoothAlpha);
+	MATSYS_CHECK(get_info(ImportTextureUsage::AlbedoWithAlpha).alphaMode == TextureInfo::AlphaMode::Transparency);
+	MATSYS_CHECK(get_info(ImportTextureUsage::NormalMap).outputFormat == TextureInfo::OutputFormat::NormalMap);
+	MATSYS_CHECK(get_info(ImportTextureUsage::Rma).outputFormat == TextureInfo::OutputFormat::ColorMap);
+	MATSYS_CHECK(get_info(ImportTextureUsage::SingleChannel).outputFormat == TextureInfo::OutputFormat::GradientMap);
+}
+
+MATSYS_TEST(opt_in_formats)
+{
+	pragma::material::set_import_texture_high_quality(true);
+	pragma::material::set_import_normal_maps_bc5(true);
+	MATSYS_CHECK(get_info(ImportTextureUsage::Albedo).outputFormat == TextureInfo::OutputFormat::BC7);
+	MATSYS_CHECK(get_info(ImportTextureUsage::AlbedoWithAlpha).outputFormat == TextureInfo::OutputFormat::BC7);
+	MATSYS_CHECK(get_info(ImportTextureUsage::AlbedoWithAlpha).alphaMode == TextureInfo::AlphaMode::Transparency);
+	MATSYS_CHECK(get_info(ImportTextureUsage::NormalMap).outputFormat == TextureInfo::OutputFormat::BC5);
+	// Maps that don't benefit from the higher quality formats are unaffected
+	MATSYS_CHECK(get_info(ImportTextureUsage::Rma).outputFormat == TextureInfo::OutputFormat::ColorMap);
+	MATSYS_CHECK(get_info(ImportTextureUsage::SingleChannel).outputFormat == TextureInfo::OutputFormat::GradientMap);
+
+	pragma::material::set_import_texture_high_quality(false);
+	pragma::material::set_import_normal_maps_bc5(false);
+	MATSYS_CHECK(get_info(ImportTextureUsage::Albedo).outputFormat == TextureInfo::OutputFormat::ColorMap);
+	MATSYS_CHECK(get_info(ImportTextureUsage::NormalMap).outputFormat == TextureInfo::OutputFormat::NormalMap);
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+using pragma::material::PixelConversion;
+
+namespace {
+	std::vector<uint8_t> create_data(size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		std::mt19937 rng {static_cast<uint32_t>(size)};
+		for(auto &v : data)
+			v = static_cast<uint8_t>(rng());
+		return data;
+	}
+	std::vector<uint8_t> convert(PixelConversion conversion, const std::vector<uint8_t> &src, bool singleThreaded = false)
+	{
+		auto pixelCount = src.size() / pragma::material::get_pixel_conversion_source_size(conversion);
+		std::vector<uint8_t> dst(pixelCount * pragma::material::get_pixel_conversion_target_size(conversion));
+		if(singleThreaded)
+			pragma::material::detail::convert_pixels_single_threaded(conversion, src.data(), dst.data(), pixelCount);
+		else
+			pragma::material::convert_pixels(conversion, src.data(), dst.data(), pixelCount);
+		return dst;
+	}
+	// Straightforward per-pixel implementations to compare the optimized kernels against
+	std::vector<uint8_t> convert_reference_8bit(const std::vector<uint8_t> &src, uint32_t srcSize)
+	{
+		auto pixelCount = src.size() / srcSize;
+		std::vector<uint8_t> dst(pixelCount * 4);
+		for(size_t i = 0; i < pixelCount; ++i) {
+			for(uint32_t c = 0; c < 3; ++c)
+				dst[i * 4 + c] = (c < srcSize) ? src[i * srcSize + c] : 0;
+			dst[i * 4 + 3] = 255;
+		}
+		return dst;
+	}
+	std::vector<uint8_t> to_bytes(const std::vector<float> &values)
+	{
+		std::vector<uint8_t> data(values.size() * sizeof(float));
+		std::memcpy(data.data(), values.data(), data.size());
+		return data;
+	}
+	uint16_t get_half(const std::vector<uint8_t> &data, size_t idx)
+	{
+		uint16_t v;
+		std::memcpy(&v, data.data() + idx * sizeof(v), sizeof(v));
+		return v;
+	}
+	std::array<float, 3> decode_rgb9e5(uint32_t v)
+	{
+		auto scale = std::exp2(static_cast<float>(static_cast<int32_t>(v >> 27) - 15 - 9));
+		return {(v & 0x1ff) * scale, ((v >> 9) & 0x1ff) * scale, ((v >> 18) & 0x1ff) * scale};
+	}
+}
+
+MATSYS_TEST(conversion_sizes)
+{
+	for(auto i = 0u; i < pragma::math::to_integral(PixelConversion::Count); ++i) {
+		auto conversion = static_cast<PixelConversion>(i);
+		MATSYS_CHECK(pragma::material::get_pixel_conversion_source_size(conversion) > 0);
+		MATSYS_CHECK(pragma::material::get_pixel_conversion_target_size(conversion) > 0);
+	}
+	prosper::Format targetFormat;
+	MATSYS_CHECK(pragma::material::find_pixel_conversion(prosper::Format::R8G8B8_UNorm_PoorCoverage, targetFormat) == PixelConversion::Rgb8ToRgba8 && targetFormat == prosper::Format::R8G8B8A8_UNorm);
+	MATSYS_CHECK(pragma::material::find_pixel_conversion(prosper::Format::B8G8R8_UNorm_PoorCoverage, targetFormat) == PixelConversion::Rgb8ToRgba8 && targetFormat == prosper::Format::B8G8R8A8_UNorm);
+	MATSYS_CHECK(pragma::material::find_pixel_conversion(prosper::Format::R8G8_UNorm, targetFormat) == PixelConversion::Rg8ToRgba8);
+	MATSYS_CHECK(!pragma::material::find_pixel_conversion(prosper::Format::R8G8B8A8_UNorm, targetFormat).has_value());
+}
+
+// Pixel counts around the vector width of the SSSE3 kernel, so both the vectorized and the scalar tail are covered
+MATSYS_TEST(kernels_8bit_match_reference)
+{
+	for(size_t pixelCount : {0, 1, 3, 4, 5, 6, 7, 8, 9, 17, 1'023}) {
+		auto rgb = create_data(pixelCount * 3);
+		MATSYS_CHECK(convert(PixelConversion::Rgb8ToRgba8, rgb) == convert_reference_8bit(rgb, 3));
+		auto rg = create_data(pixelCount * 2);
+		MATSYS_CHECK(convert(PixelConversion::Rg8ToRgba8, rg) == convert_reference_8bit(rg, 2));
+	}
+	// The kernel must not read past the end of the source buffer
+	auto rgb = create_data(6 * 3);
+	auto src = std::make_unique<uint8_t[]>(rgb.size());
+	std::memcpy(src.get(), rgb.data(), rgb.size());
+	std::vector<uint8_t> dst(6 * 4);
+	pragma::material::convert_pixels(PixelConversion::Rgb8ToRgba8, src.get(), dst.data(), 6);
+	MATSYS_CHECK(dst == convert_reference_8bit(rgb, 3));
+}
+
+MATSYS_TEST(parallel_conversion_matches_single_threaded)
+{
+	// Large enough to be split into several tasks, with a pixel count that isn't divisible by the number of tasks
+	constexpr size_t pixelCount = 1'024 * 1'024 + 7;
+	for(auto conversion : {PixelConversion::Rgb8ToRgba8, PixelConversion::Rg8ToRgba8}) {
+		auto src = create_data(pixelCount * pragma::material::get_pixel_conversion_source_size(conversion));
+		auto result = convert(conversion, src);
+		MATSYS_CHECK(result == convert(conversion, src, true));
+		MATSYS_CHECK(result == convert_reference_8bit(src, pragma::material::get_pixel_conversion_source_size(conversion)));
+	}
+	std::vector<float> values(pixelCount * 4);
+	std::mt19937 rng {0};
+	std::uniform_real_distribution<float> dist {-100.f, 100.f};
+	for(auto &v : values)
+		v = dist(rng);
+	auto src = to_bytes(values);
+	for(auto conversion : {PixelConversion::Rgba32fToRgba16f, PixelConversion::Rgba32fToRgb9e5})
+		MATSYS_CHECK(convert(conversion, src) == convert(conversion, src, true));
+	auto rgb32f = to_bytes(std::vector<float>(values.begin(), values.begin() + pixelCount * 3));
+	MATSYS_CHECK(convert(PixelConversion::Rgb32fToRgba32f, rgb32f) == convert(PixelConversion::Rgb32fToRgba32f, rgb32f, true));
+}
+
+MATSYS_TEST(rgb32f_to_rgba32f)
+{
+	auto result = convert(PixelConversion::Rgb32fToRgba32f, to_bytes({1.f, -2.f, 3.5f, 4.f, 5.f, 6.f}));
+	std::vector<float> values(8);
+	std::memcpy(values.data(), result.data(), result.size());
+	MATSYS_CHECK((values == std::vector<float> {1.f, -2.f, 3.5f, 1.f, 4.f, 5.f, 6.f, 1.f}));
+}
+
+MATSYS_TEST(half_float_edge_cases)
+{
+	auto inf = std::numeric_limits<float>::infinity();
+	std::vector<std::pair<float, uint16_t>> cases {
+	  {0.f, 0x0000},
+	  {-0.f, 0x8000},
+	  {1.f, 0x3c00},
+	  {-2.f, 0xc000},
+	  {65'504.f, 0x7bff}, // Largest finite value
+	  {65'520.f, 0x7c00}, // Rounds up to infinity
+	  {1e10f, 0x7c00},    // Overflow
+	  {inf, 0x7c00},
+	  {-inf, 0xfc00},
+	  {std::exp2(-14.f), 0x0400}, // Smallest normal value
+	  {std::exp2(-24.f), 0x0001}, // Smallest subnormal value
+	  {std::exp2(-25.f), 0x0000}, // Halfway to the smallest subnormal, rounds to even
+	  {1e-10f, 0x0000},           // Underflow
+	  {1.f + std::exp2(-11.f), 0x3c00}, // Halfway between two values, rounds to even
+	  {1.f + 3 * std::exp2(-11.f), 0x3c02},
+	};
+	std::vector<float> values;
+	for(auto &[f, expected] : cases)
+		values.push_back(f);
+	values.resize((values.size() + 3) / 4 * 4, 0.f);
+	auto result = convert(PixelConversion::Rgba32fToRgba16f, to_bytes(values));
+	for(size_t i = 0; i < cases.size(); ++i)
+		MATSYS_CHECK(get_half(result, i) == cases[i].second);
+	std::vector<float> nan(4, std::numeric_limits<float>::quiet_NaN());
+	auto v = get_half(convert(PixelConversion::Rgba32fToRgba16f, to_bytes(nan)), 0);
+	MATSYS_CHECK((v & 0x7c00) == 0x7c00 && (v & 0x3ff) != 0);
+}
+
+MATSYS_TEST(rgb9e5_edge_cases)
+{
+	auto encode = [](float r, float g, float b) {
+		auto result = convert(PixelConversion::Rgba32fToRgb9e5, to_bytes({r, g, b, 1.f}));
+		uint32_t v;
+		std::memcpy(&v, result.data(), sizeof(v));
+		return v;
+	};
+	MATSYS_CHECK(encode(0.f, 0.f, 0.f) == 0);
+	MATSYS_CHECK(encode(1.f, 1.f, 1.f) == ((16u << 27) | 256u | (256u << 9) | (256u << 18)));
+	// Negative values and NaN are clamped to 0, values that are too large to the maximum
+	MATSYS_CHECK(encode(-1.f, std::numeric_limits<float>::quiet_NaN(), 0.f) == 0);
+	auto maxValue = decode_rgb9e5(encode(1e10f, std::numeric_limits<float>::infinity(), 0.f));
+	MATSYS_CHECK(maxValue[0] == 65'408.f && maxValue[1] == 65'408.f && maxValue[2] == 0.f);
+
+	// Rounding of the largest component up to the next power of two must increase the exponent
+	auto rounded = decode_rgb9e5(encode(511.9f, 0.f, 0.f));
+	MATSYS_CHECK(rounded[0] == 512.f);
+	std::mt19937 rng {0};
+	std::uniform_real_distribution<float> dist {0.f, 1'000.f};
+	for(auto i = 0; i < 1'000; ++i) {
+		std::array<float, 3> c {dist(rng), dist(rng), dist(rng)};
+		auto decoded = decode_rgb9e5(encode(c[0], c[1], c[2]));
+		// The error is bounded by half a step of the shared exponent, which is determined by the largest component
+		auto maxc = std::max({c[0], c[1], c[2]});
+		auto tolerance = std::exp2(std::floor(std::log2(maxc)) + 1 - 9);
+		for(size_t j = 0; j < c.size(); ++j)
+			MATSYS_CHECK(std::abs(decoded[j] - c[j]) <= tolerance);
+	}
+}
+
+MATSYS_TEST_MAIN()
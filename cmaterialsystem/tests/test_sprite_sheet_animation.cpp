@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+namespace {
+	// In-memory stand-in for the virtual file system, which counts how often each file has been opened
+	class FakeFileSystem {
+	  public:
+		void SetFile(const std::string &fileName, const std::vector<uint8_t> &data)
+		{
+			std::scoped_lock lock {m_mutex};
+			m_files[fileName] = data;
+		}
+		void RemoveFile(const std::string &fileName)
+		{
+			std::scoped_lock lock {m_mutex};
+			m_files.erase(fileName);
+		}
+		uint32_t GetOpenCount(const std::string &fileName) const
+		{
+			std::scoped_lock lock {m_mutex};
+			auto it = m_openCounts.find(fileName);
+			return (it != m_openCounts.end()) ? it->second : 0;
+		}
+		pragma::material::SpriteSheetAnimationCache::FileOpener GetOpener()
+		{
+			return [this](const std::string &fileName) -> std::unique_ptr<ufile::IFile> {
+				// Make sure concurrent requests overlap with the load
+				std::this_thread::sleep_for(std::chrono::milliseconds {20});
+				std::scoped_lock lock {m_mutex};
+				++m_openCounts[fileName];
+				auto it = m_files.find(fileName);
+				if(it == m_files.end())
+					return nullptr;
+				return std::make_unique<ufile::VectorFile>(std::vector<uint8_t> {it->second});
+			};
+		}
+	  private:
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, std::vector<uint8_t>> m_files;
+		std::unordered_map<std::string, uint32_t> m_openCounts;
+	};
+
+	std::vector<uint8_t> create_psd(uint32_t numFrames, float frameDuration)
+	{
+		pragma::material::test::ByteWriter writer {};
+		writer.WriteBytes("PSD", 3).Write<uint32_t>(0); // Version
+		writer.Write<uint32_t>(1);                      // Sequence count
+		writer.Write<bool>(true).Write<uint32_t>(numFrames);
+		for(auto i = decltype(numFrames) {0u}; i < numFrames; ++i) {
+			auto u = static_cast<float>(i) / static_cast<float>(numFrames);
+			writer.Write<float>(u).Write<float>(0.f);                                     // uvStart
+			writer.Write<float>(u + 1.f / static_cast<float>(numFrames)).Write<float>(1.f); // uvEnd
+			writer.Write<float>(frameDuration);
+		}
+		return writer.GetData();
+	}
+
+	bool is_ready(const pragma::material::SpriteSheetAnimationCache::Handle &handle) { return handle.valid() && handle.wait_for(std::chrono::seconds {0}) == std::future_status::ready; }
+}
+
+MATSYS_TEST(concurrent_requests_share_one_load)
+{
+	FakeFileSystem fs {};
+	fs.SetFile("materials/fire.psd", create_psd(4, 0.25f));
+	pragma::material::SpriteSheetAnimationCache cache {fs.GetOpener()};
+
+	constexpr uint32_t numThreads = 16;
+	std::vector<pragma::material::SpriteSheetAnimationCache::Handle> handles(numThreads);
+	std::vector<std::thread> threads;
+	for(auto i = 0u; i < numThreads; ++i) {
+		threads.emplace_back([&cache, &handles, i]() {
+			// Different spellings of the same path have to map to the same entry
+			handles[i] = cache.Load((i % 2 == 0) ? "materials/fire.psd" : "materials\\FIRE.psd");
+			// Polling the readiness must never block
+			while(!is_ready(handles[i]))
+				std::this_thread::yield();
+		});
+	}
+	for(auto &t : threads)
+		t.join();
+
+	MATSYS_CHECK(fs.GetOpenCount("materials/fire.psd") + fs.GetOpenCount("materials\\FIRE.psd") == 1);
+	auto *anim = handles.front().get().get();
+	MATSYS_REQUIRE(anim != nullptr);
+	for(auto &handle : handles)
+		MATSYS_CHECK(handle.get().get() == anim);
+	MATSYS_REQUIRE(anim->sequences.size() == 1);
+	MATSYS_CHECK(anim->sequences.front().frames.size() == 4);
+	MATSYS_CHECK(anim->sequences.front().GetDuration() == 1.f);
+}
+
+MATSYS_TEST(failed_load_is_retried_after_change)
+{
+	FakeFileSystem fs {};
+	pragma::material::SpriteSheetAnimationCache cache {fs.GetOpener()};
+	auto handle = cache.Load("materials/smoke.psd");
+	MATSYS_CHECK(handle.get() == nullptr);
+
+	// The file hasn't changed, so the failed result is returned without starting another load
+	auto handle2 = cache.Load("materials/smoke.psd");
+	MATSYS_CHECK(is_ready(handle2) && handle2.get() == nullptr);
+
+	// A corrupt file fails as well
+	auto corrupt = create_psd(2, 0.5f);
+	corrupt.resize(corrupt.size() - 3);
+	fs.SetFile("materials/smoke.psd", corrupt);
+	auto handle3 = cache.Load("materials/smoke.psd");
+	MATSYS_CHECK(handle3.get() == nullptr);
+
+	fs.SetFile("materials/smoke.psd", create_psd(2, 0.5f));
+	auto handle4 = cache.Load("materials/smoke.psd");
+	MATSYS_REQUIRE(handle4.get() != nullptr);
+	MATSYS_CHECK(handle4.get()->sequences.front().frames.size() == 2);
+}
+
+MATSYS_TEST(corrupt_counts_are_rejected)
+{
+	// Claims a huge number of sequences, which must not be allocated
+	pragma::material::test::ByteWriter writer {};
+	writer.WriteBytes("PSD", 3).Write<uint32_t>(0).Write<uint32_t>(std::numeric_limits<uint32_t>::max());
+	ufile::VectorFile f {std::vector<uint8_t> {writer.GetData()}};
+	pragma::material::SpriteSheetAnimation anim {};
+	MATSYS_CHECK(!anim.Load(f));
+	MATSYS_CHECK(anim.sequences.empty());
+}
+
+MATSYS_TEST(invalidate_reloads_file)
+{
+	FakeFileSystem fs {};
+	fs.SetFile("materials/spark.psd", create_psd(1, 1.f));
+	pragma::material::SpriteSheetAnimationCache cache {fs.GetOpener()};
+	auto *anim = cache.Load("materials/spark.psd").get().get();
+	MATSYS_REQUIRE(anim != nullptr);
+	MATSYS_CHECK(cache.Load("materials/spark.psd").get().get() == anim);
+
+	fs.SetFile("materials/spark.psd", create_psd(3, 1.f));
+	cache.Invalidate("materials/spark.psd");
+	auto *anim2 = cache.Load("materials/spark.psd").get().get();
+	MATSYS_REQUIRE(anim2 != nullptr);
+	MATSYS_CHECK(anim2->sequences.front().frames.size() == 3);
+	MATSYS_CHECK(fs.GetOpenCount("materials/spark.psd") == 2);
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+using pragma::material::SvgRasterCache;
+using pragma::material::TextureFormatHandlerSvg;
+
+namespace {
+	// The edges of the square are at a quarter and three quarters of the image, so they lie on pixel boundaries at all levels down to 4x4
+	constexpr auto SVG = "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 64 64\"><rect class=\"a\" x=\"16\" y=\"16\" width=\"32\" height=\"32\" fill=\"#ff0000\"/></svg>";
+	struct Fixture {
+		std::vector<uint8_t> svgData {SVG, SVG + std::strlen(SVG)};
+		uint64_t contentHash = pragma::material::calc_fnv1a_hash(svgData.data(), svgData.size());
+		pragma::image::SvgImageInfo GetInfo(uint32_t width, uint32_t height) const
+		{
+			pragma::image::SvgImageInfo svgInfo {};
+			svgInfo.width = width;
+			svgInfo.height = height;
+			return svgInfo;
+		}
+		std::vector<std::shared_ptr<pragma::image::ImageBuffer>> Rasterize(uint32_t width, uint32_t height, const std::vector<std::string> &mipmapStyleSheets = {}) const
+		{
+			auto svgInfo = GetInfo(width, height);
+			auto baseInfo = svgInfo;
+			baseInfo.styleSheet += TextureFormatHandlerSvg::GetMipmapStyleSheet(mipmapStyleSheets, 0);
+			auto baseLevel = SvgRasterCache::Get().Rasterize(svgData, contentHash, baseInfo);
+			if(!baseLevel)
+				return {};
+			return TextureFormatHandlerSvg::RasterizeMipmaps(svgData, contentHash, svgInfo, mipmapStyleSheets, baseLevel);
+		}
+	};
+	const uint8_t *get_pixel(const pragma::image::ImageBuffer &imgBuf, uint32_t x, uint32_t y) { return static_cast<const uint8_t *>(imgBuf.GetData()) + (static_cast<size_t>(y) * imgBuf.GetWidth() + x) * 4; }
+	// Fraction of pixels which are neither fully covered nor fully empty, i.e. which are blurred
+	double get_blurred_pixel_ratio(const pragma::image::ImageBuffer &imgBuf)
+	{
+		size_t numBlurred = 0;
+		for(uint32_t y = 0; y < imgBuf.GetHeight(); ++y) {
+			for(uint32_t x = 0; x < imgBuf.GetWidth(); ++x) {
+				auto alpha = get_pixel(imgBuf, x, y)[3];
+				if(alpha != 0 && alpha != 255)
+					++numBlurred;
+			}
+		}
+		return static_cast<double>(numBlurred) / (imgBuf.GetWidth() * imgBuf.GetHeight());
+	}
+}
+
+MATSYS_TEST(mipmap_dimensions)
+{
+	Fixture fixture {};
+	for(auto [width, height] : std::vector<std::pair<uint32_t, uint32_t>> {{256, 256}, {256, 64}, {64, 256}, {100, 30}, {1, 1}, {2, 1}}) {
+		auto mipmaps = fixture.Rasterize(width, height);
+		MATSYS_REQUIRE(!mipmaps.empty());
+		auto expectedCount = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+		MATSYS_CHECK(mipmaps.size() == expectedCount);
+		for(uint32_t level = 0; level < mipmaps.size(); ++level) {
+			MATSYS_REQUIRE(mipmaps[level] != nullptr);
+			MATSYS_CHECK(mipmaps[level]->GetWidth() == std::max(width >> level, 1u));
+			MATSYS_CHECK(mipmaps[level]->GetHeight() == std::max(height >> level, 1u));
+			MATSYS_CHECK(mipmaps[level]->GetFormat() == mipmaps.front()->GetFormat());
+		}
+	}
+}
+
+// Every level is rasterized at its own resolution, so edges which lie on pixel boundaries stay sharp
+MATSYS_TEST(mipmaps_are_sharp)
+{
+	Fixture fixture {};
+	auto mipmaps = fixture.Rasterize(256, 256);
+	MATSYS_REQUIRE(mipmaps.size() == 9);
+	MATSYS_REQUIRE(mipmaps.front()->GetFormat() == pragma::image::Format::RGBA8);
+	for(uint32_t level = 0; level <= 6; ++level) {
+		auto &mipmap = *mipmaps[level];
+		MATSYS_CHECK(get_blurred_pixel_ratio(mipmap) == 0.0);
+		auto size = mipmap.GetWidth();
+		MATSYS_CHECK(get_pixel(mipmap, size / 2, size / 2)[3] == 255);
+		MATSYS_CHECK(get_pixel(mipmap, 0, 0)[3] == 0);
+	}
+}
+
+MATSYS_TEST(mipmap_style_sheets)
+{
+	std::vector<std::string> styleSheets {"", "", ".a{fill:#0000ff;}", "", ".a{fill:#00ff00;}"};
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 0).empty());
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 1).empty());
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 2) == ".a{fill:#0000ff;}");
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 3) == ".a{fill:#0000ff;}");
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 4) == ".a{fill:#00ff00;}");
+	MATSYS_CHECK(TextureFormatHandlerSvg::GetMipmapStyleSheet(styleSheets, 10) == ".a{fill:#00ff00;}");
+
+	Fixture fixture {};
+	auto mipmaps = fixture.Rasterize(128, 128, styleSheets);
+	MATSYS_REQUIRE(mipmaps.size() == 8);
+	MATSYS_REQUIRE(mipmaps.front()->GetFormat() == pragma::image::Format::RGBA8);
+	auto getCenter = [&](uint32_t level) {
+		auto *px = get_pixel(*mipmaps[level], mipmaps[level]->GetWidth() / 2, mipmaps[level]->GetHeight() / 2);
+		return std::array<uint8_t, 3> {px[0], px[1], px[2]};
+	};
+	MATSYS_CHECK((getCenter(0) == std::array<uint8_t, 3> {255, 0, 0}));
+	MATSYS_CHECK((getCenter(1) == std::array<uint8_t, 3> {255, 0, 0}));
+	MATSYS_CHECK((getCenter(2) == std::array<uint8_t, 3> {0, 0, 255}));
+	MATSYS_CHECK((getCenter(3) == std::array<uint8_t, 3> {0, 0, 255}));
+	MATSYS_CHECK((getCenter(4) == std::array<uint8_t, 3> {0, 255, 0}));
+	MATSYS_CHECK((getCenter(5) == std::array<uint8_t, 3> {0, 255, 0}));
+}
+
+MATSYS_TEST_MAIN()
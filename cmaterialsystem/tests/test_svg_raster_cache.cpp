@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+using pragma::material::SvgRasterCache;
+
+namespace {
+	constexpr auto SVG = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"16\" height=\"16\"><rect class=\"a\" x=\"2\" y=\"4\" width=\"8\" height=\"6\" fill=\"#ff8000\"/></svg>";
+	std::vector<uint8_t> get_svg_data() { return std::vector<uint8_t> {SVG, SVG + std::strlen(SVG)}; }
+	pragma::image::SvgImageInfo get_svg_info(uint32_t size)
+	{
+		pragma::image::SvgImageInfo svgInfo {};
+		svgInfo.width = size;
+		svgInfo.height = size;
+		svgInfo.styleSheet = ".a { fill: #0080ff; }";
+		return svgInfo;
+	}
+	std::shared_ptr<pragma::image::ImageBuffer> rasterize(uint32_t size)
+	{
+		auto svgData = get_svg_data();
+		return SvgRasterCache::Get().Rasterize(svgData, pragma::material::calc_fnv1a_hash(svgData.data(), svgData.size()), get_svg_info(size));
+	}
+	std::vector<uint8_t> get_pixels(const pragma::image::ImageBuffer &imgBuf)
+	{
+		auto *data = static_cast<const uint8_t *>(imgBuf.GetData());
+		return std::vector<uint8_t> {data, data + imgBuf.GetSize()};
+	}
+	std::vector<std::filesystem::path> get_files(const test::TempDirectory &dir)
+	{
+		std::vector<std::filesystem::path> files;
+		for(auto &entry : std::filesystem::directory_iterator {dir.GetPath()})
+			files.push_back(entry.path());
+		return files;
+	}
+	std::vector<uint8_t> read_file(const std::filesystem::path &path)
+	{
+		std::ifstream f {path, std::ios::binary};
+		return std::vector<uint8_t> {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> {}};
+	}
+	void write_file(const std::filesystem::path &path, const std::vector<uint8_t> &data)
+	{
+		std::ofstream f {path, std::ios::binary | std::ios::trunc};
+		f.write(reinterpret_cast<const char *>(data.data()), data.size());
+	}
+	// Offset of the image header (format, width, height, size) in a cache file
+	size_t get_image_header_offset(uint32_t size)
+	{
+		auto styleSheet = SvgRasterCache::NormalizeStyleSheet(get_svg_info(size).styleSheet);
+		return SvgRasterCache::PSVC_IDENTIFIER.size() + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t) * 3 + styleSheet.size();
+	}
+	struct DiskCacheScope {
+		DiskCacheScope(const test::TempDirectory &dir)
+		{
+			SvgRasterCache::Get().Clear();
+			SvgRasterCache::Get().SetDiskCachePath(dir.GetName());
+		}
+		~DiskCacheScope()
+		{
+			SvgRasterCache::Get().SetDiskCachePath("");
+			SvgRasterCache::Get().Clear();
+		}
+	};
+}
+
+// An image loaded from the disk cache has to be identical to a freshly rasterized one
+MATSYS_TEST(cached_matches_fresh)
+{
+	SvgRasterCache::Get().Clear();
+	auto fresh = rasterize(32);
+	MATSYS_REQUIRE(fresh != nullptr);
+	SvgRasterCache::Get().Clear();
+
+	test::TempDirectory dir {"svg_raster_cache", pragma::util::get_program_path()};
+	DiskCacheScope scope {dir};
+	auto first = rasterize(32);
+	MATSYS_REQUIRE(first != nullptr);
+	auto files = get_files(dir);
+	// Only the final file is left, not the temporary file it was written to
+	MATSYS_REQUIRE(files.size() == 1);
+	MATSYS_CHECK(files.front().extension() == ".psvc");
+
+	SvgRasterCache::Get().Clear();
+	auto cached = rasterize(32);
+	MATSYS_REQUIRE(cached != nullptr);
+	MATSYS_CHECK(cached != first);
+	MATSYS_CHECK(cached->GetFormat() == fresh->GetFormat());
+	MATSYS_CHECK(cached->GetWidth() == 32 && cached->GetHeight() == 32);
+	MATSYS_CHECK(get_pixels(*cached) == get_pixels(*fresh));
+	MATSYS_CHECK(get_pixels(*first) == get_pixels(*fresh));
+
+	// The cached file is actually used: A modified pixel has to show up in the loaded image
+	auto data = read_file(files.front());
+	data.back() ^= 0xff;
+	write_file(files.front(), data);
+	SvgRasterCache::Get().Clear();
+	auto modified = rasterize(32);
+	MATSYS_REQUIRE(modified != nullptr);
+	auto pixels = get_pixels(*fresh);
+	pixels.back() ^= 0xff;
+	MATSYS_CHECK(get_pixels(*modified) == pixels);
+}
+
+// Corrupt cache files must be ignored and the image rasterized again
+MATSYS_TEST(corrupt_cache_files_are_ignored)
+{
+	SvgRasterCache::Get().Clear();
+	auto fresh = rasterize(16);
+	MATSYS_REQUIRE(fresh != nullptr);
+
+	test::TempDirectory dir {"svg_raster_cache_corrupt", pragma::util::get_program_path()};
+	DiskCacheScope scope {dir};
+	MATSYS_REQUIRE(rasterize(16) != nullptr);
+	auto files = get_files(dir);
+	MATSYS_REQUIRE(files.size() == 1);
+	auto original = read_file(files.front());
+	auto offset = get_image_header_offset(16);
+	MATSYS_REQUIRE(original.size() > offset + sizeof(uint32_t) * 3 + sizeof(uint64_t));
+
+	auto checkCorruption = [&](const std::function<void(std::vector<uint8_t> &)> &corrupt) {
+		auto data = original;
+		corrupt(data);
+		write_file(files.front(), data);
+		SvgRasterCache::Get().Clear();
+		auto imgBuf = rasterize(16);
+		MATSYS_CHECK(imgBuf != nullptr && get_pixels(*imgBuf) == get_pixels(*fresh));
+	};
+	auto setValue = [](std::vector<uint8_t> &data, size_t offset, auto value) { std::memcpy(data.data() + offset, &value, sizeof(value)); };
+	// Dimensions which would overflow the size calculation in 32 bits, with a matching 32-bit size
+	checkCorruption([&](std::vector<uint8_t> &data) {
+		setValue(data, offset + 4, uint32_t {0x10000});
+		setValue(data, offset + 8, uint32_t {0x10000});
+	});
+	checkCorruption([&](std::vector<uint8_t> &data) { setValue(data, offset + 4, uint32_t {0xffffffff}); });
+	// Size which doesn't match the dimensions
+	checkCorruption([&](std::vector<uint8_t> &data) { setValue(data, offset + 12, uint64_t {16}); });
+	checkCorruption([&](std::vector<uint8_t> &data) { setValue(data, offset + 12, std::numeric_limits<uint64_t>::max()); });
+	// Invalid format
+	checkCorruption([&](std::vector<uint8_t> &data) { setValue(data, offset, uint32_t {0xffff}); });
+	// Truncated image data
+	checkCorruption([&](std::vector<uint8_t> &data) { data.resize(data.size() - 1); });
+	checkCorruption([&](std::vector<uint8_t> &data) { data.resize(offset + 2); });
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+using pragma::material::TextureFormatHandlerAssembly;
+
+namespace {
+	// Color which identifies the layer
+	std::array<uint8_t, 4> get_layer_color(uint32_t layer) { return {static_cast<uint8_t>(layer), static_cast<uint8_t>(layer * 7), static_cast<uint8_t>(255 - layer), 255}; }
+	// Uncompressed 32-bit tga with the origin in the top left corner
+	std::vector<uint8_t> create_tga(uint16_t width, uint16_t height, const std::array<uint8_t, 4> &rgba)
+	{
+		test::ByteWriter writer {};
+		writer.Write(uint8_t {0}).Write(uint8_t {0}).Write(uint8_t {2});
+		for(auto i = 0; i < 5; ++i)
+			writer.Write(uint8_t {0});
+		writer.Write(uint16_t {0}).Write(uint16_t {0}).Write(width).Write(height).Write(uint8_t {32}).Write(uint8_t {0x28});
+		for(uint32_t i = 0; i < static_cast<uint32_t>(width) * height; ++i)
+			writer.Write(rgba[2]).Write(rgba[1]).Write(rgba[0]).Write(rgba[3]);
+		return writer.GetData();
+	}
+	std::vector<std::string> create_layers(const test::TempDirectory &dir, uint32_t count, uint16_t size)
+	{
+		std::vector<std::string> paths;
+		for(uint32_t i = 0; i < count; ++i) {
+			auto fileName = "layer_" + std::to_string(i) + ".tga";
+			dir.WriteFile(fileName, create_tga(size, size, get_layer_color(i)));
+			paths.push_back(dir.GetName() + '/' + fileName);
+		}
+		return paths;
+	}
+	std::array<uint8_t, 4> get_first_pixel(const pragma::image::ImageBuffer &imgBuf)
+	{
+		auto *data = static_cast<const uint8_t *>(imgBuf.GetData());
+		return {data[0], data[1], data[2], (imgBuf.GetChannelCount() > 3) ? data[3] : uint8_t {255}};
+	}
+}
+
+// The layers are decoded in parallel, but have to end up in the order of the descriptor
+MATSYS_TEST(layers_keep_their_order)
+{
+	test::TempDirectory dir {"texture_assembly", pragma::util::get_program_path()};
+	constexpr uint32_t numLayers = 64;
+	auto paths = create_layers(dir, numLayers, 4);
+	// Reversed, so the order doesn't match the order of the files on disk
+	std::reverse(paths.begin(), paths.end());
+	for(auto attempt = 0; attempt < 4; ++attempt) {
+		auto layers = TextureFormatHandlerAssembly::DecodeLayers(paths);
+		MATSYS_REQUIRE(layers.size() == numLayers);
+		MATSYS_CHECK(TextureFormatHandlerAssembly::ValidateLayers(layers, false));
+		for(uint32_t i = 0; i < numLayers; ++i) {
+			MATSYS_REQUIRE(layers[i] != nullptr);
+			MATSYS_CHECK(layers[i]->GetWidth() == 4 && layers[i]->GetHeight() == 4);
+			MATSYS_CHECK(get_first_pixel(*layers[i]) == get_layer_color(numLayers - 1 - i));
+		}
+	}
+}
+
+MATSYS_TEST(cubemap_faces)
+{
+	test::TempDirectory dir {"texture_assembly_cubemap", pragma::util::get_program_path()};
+	auto paths = create_layers(dir, 6, 8);
+	auto layers = TextureFormatHandlerAssembly::DecodeLayers(paths);
+	MATSYS_CHECK(TextureFormatHandlerAssembly::ValidateLayers(layers, true));
+	for(uint32_t i = 0; i < layers.size(); ++i)
+		MATSYS_CHECK(layers[i] && get_first_pixel(*layers[i]) == get_layer_color(i));
+	// A cubemap requires exactly six square faces
+	MATSYS_CHECK(!TextureFormatHandlerAssembly::ValidateLayers({layers.begin(), layers.begin() + 5}, true));
+	dir.WriteFile("wide.tga", create_tga(16, 8, get_layer_color(0)));
+	std::vector<std::string> widePaths(6, dir.GetName() + "/wide.tga");
+	auto wideLayers = TextureFormatHandlerAssembly::DecodeLayers(widePaths);
+	MATSYS_CHECK(TextureFormatHandlerAssembly::ValidateLayers(wideLayers, false));
+	MATSYS_CHECK(!TextureFormatHandlerAssembly::ValidateLayers(wideLayers, true));
+}
+
+MATSYS_TEST(invalid_layers)
+{
+	test::TempDirectory dir {"texture_assembly_invalid", pragma::util::get_program_path()};
+	auto paths = create_layers(dir, 4, 4);
+	// Missing files result in an empty slot, without affecting the order of the other layers
+	paths.insert(paths.begin() + 2, dir.GetName() + "/missing.tga");
+	auto layers = TextureFormatHandlerAssembly::DecodeLayers(paths);
+	MATSYS_REQUIRE(layers.size() == 5);
+	MATSYS_CHECK(layers[2] == nullptr);
+	MATSYS_CHECK(layers[3] && get_first_pixel(*layers[3]) == get_layer_color(2));
+	MATSYS_CHECK(!TextureFormatHandlerAssembly::ValidateLayers(layers, false));
+
+	// All layers must have the same size
+	dir.WriteFile("layer_large.tga", create_tga(8, 8, get_layer_color(0)));
+	paths[2] = dir.GetName() + "/layer_large.tga";
+	MATSYS_CHECK(!TextureFormatHandlerAssembly::ValidateLayers(TextureFormatHandlerAssembly::DecodeLayers(paths), false));
+	MATSYS_CHECK(!TextureFormatHandlerAssembly::ValidateLayers({}, false));
+}
+
+MATSYS_TEST_MAIN()
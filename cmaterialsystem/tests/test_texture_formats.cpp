@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef DISABLE_VTF_SUPPORT
+#include <VTFFile.h>
+#endif
+
+import pragma.cmaterialsystem;
+#ifndef DISABLE_VTEX_SUPPORT
+import source2;
+#endif
+
+#include "test.hpp"
+
+// The format tables are shared by the texture format handlers and the legacy texture manager, so these tests cover both.
+// Only the GPU support query (IsImageFormatSupported) requires a device, the CPU conversion is tested for the case
+// where the GPU does not support the original format.
+
+using pragma::material::PixelConversion;
+using Swizzle = std::array<prosper::ComponentSwizzle, 4>;
+
+namespace {
+	constexpr Swizzle SWIZZLE_RGBA = {prosper::ComponentSwizzle::R, prosper::ComponentSwizzle::G, prosper::ComponentSwizzle::B, prosper::ComponentSwizzle::A};
+	struct ExpectedFormat {
+		prosper::Format format;
+		std::optional<prosper::Format> conversionFormat = {};
+		Swizzle swizzle = SWIZZLE_RGBA;
+		std::optional<PixelConversion> cpuConversion = {};
+		prosper::Format cpuTargetFormat = prosper::Format::Unknown;
+	};
+
+	std::vector<uint8_t> to_bytes(const std::vector<float> &values)
+	{
+		std::vector<uint8_t> data(values.size() * sizeof(float));
+		std::memcpy(data.data(), values.data(), data.size());
+		return data;
+	}
+	std::vector<uint8_t> to_bytes(const std::vector<uint16_t> &values)
+	{
+		std::vector<uint8_t> data(values.size() * sizeof(uint16_t));
+		std::memcpy(data.data(), values.data(), data.size());
+		return data;
+	}
+	// A single source pixel and the expected result of the CPU kernel
+	std::pair<std::vector<uint8_t>, std::vector<uint8_t>> get_conversion_sample(PixelConversion conversion)
+	{
+		switch(conversion) {
+		case PixelConversion::Rgb8ToRgba8:
+			return {{10, 20, 30}, {10, 20, 30, 255}};
+		case PixelConversion::Rg8ToRgba8:
+			return {{10, 20}, {10, 20, 0, 255}};
+		case PixelConversion::Rgb32fToRgba32f:
+			return {to_bytes(std::vector<float> {1.f, 2.f, 0.5f}), to_bytes(std::vector<float> {1.f, 2.f, 0.5f, 1.f})};
+		case PixelConversion::Rgba32fToRgba16f:
+			return {to_bytes(std::vector<float> {1.f, 2.f, 0.5f, 1.f}), to_bytes(std::vector<uint16_t> {0x3C00, 0x4000, 0x3800, 0x3C00})};
+		default:
+			return {};
+		}
+	}
+
+	void check_format(const std::optional<pragma::material::TextureFormatInfo> &info, const ExpectedFormat &expected)
+	{
+		MATSYS_REQUIRE(info.has_value());
+		MATSYS_CHECK(info->format == expected.format);
+		MATSYS_CHECK(info->conversionFormat == expected.conversionFormat);
+		MATSYS_CHECK(info->swizzle == expected.swizzle);
+
+		// Conversion that is applied if the GPU doesn't support the original format
+		auto targetFormat = prosper::Format::Unknown;
+		auto cpuConversion = pragma::material::find_pixel_conversion(info->format, targetFormat);
+		MATSYS_CHECK(cpuConversion == expected.cpuConversion);
+		if(!cpuConversion)
+			return;
+		MATSYS_CHECK(targetFormat == expected.cpuTargetFormat);
+		// The GPU conversion is skipped if the data has been converted on the CPU, so the converted data has to be usable as is
+		if(expected.conversionFormat)
+			MATSYS_CHECK(targetFormat == *expected.conversionFormat);
+
+		auto [src, expectedDst] = get_conversion_sample(*cpuConversion);
+		MATSYS_REQUIRE(src.size() == pragma::material::get_pixel_conversion_source_size(*cpuConversion));
+		MATSYS_REQUIRE(expectedDst.size() == pragma::material::get_pixel_conversion_target_size(*cpuConversion));
+		std::vector<uint8_t> dst(expectedDst.size());
+		pragma::material::convert_pixels(*cpuConversion, src.data(), dst.data(), 1);
+		MATSYS_CHECK(dst == expectedDst);
+	}
+}
+
+#ifndef DISABLE_VTF_SUPPORT
+MATSYS_TEST(vtf_formats)
+{
+	using F = prosper::Format;
+	using S = prosper::ComponentSwizzle;
+	const std::vector<std::pair<VTFImageFormat, ExpectedFormat>> expectedFormats = {
+	  {IMAGE_FORMAT_DXT1, {F::BC1_RGBA_UNorm_Block}},
+	  {IMAGE_FORMAT_DXT3, {F::BC2_UNorm_Block}},
+	  {IMAGE_FORMAT_DXT5, {F::BC3_UNorm_Block}},
+	  {IMAGE_FORMAT_RGBA8888, {F::R8G8B8A8_UNorm}},
+	  {IMAGE_FORMAT_RGB888, {F::R8G8B8_UNorm_PoorCoverage, F::R8G8B8A8_UNorm, SWIZZLE_RGBA, PixelConversion::Rgb8ToRgba8, F::R8G8B8A8_UNorm}},
+	  {IMAGE_FORMAT_BGRA8888, {F::B8G8R8A8_UNorm}},
+	  {IMAGE_FORMAT_BGR888, {F::B8G8R8_UNorm_PoorCoverage, F::B8G8R8A8_UNorm, SWIZZLE_RGBA, PixelConversion::Rgb8ToRgba8, F::B8G8R8A8_UNorm}},
+	  {IMAGE_FORMAT_UV88, {F::R8G8_UNorm, {}, SWIZZLE_RGBA, PixelConversion::Rg8ToRgba8, F::R8G8B8A8_UNorm}},
+	  {IMAGE_FORMAT_RGBA16161616F, {F::R16G16B16A16_SFloat}},
+	  {IMAGE_FORMAT_RGBA32323232F, {F::R32G32B32A32_SFloat, {}, SWIZZLE_RGBA, PixelConversion::Rgba32fToRgba16f, F::R16G16B16A16_SFloat}},
+	  {IMAGE_FORMAT_ABGR8888, {F::A8B8G8R8_UNorm_Pack32, {}, {S::A, S::B, S::G, S::R}}},
+	  {IMAGE_FORMAT_BGRX8888, {F::B8G8R8A8_UNorm, {}, {S::R, S::G, S::B, S::One}}},
+	};
+	for(auto &[vtfFormat, expected] : expectedFormats)
+		check_format(pragma::material::find_vtf_format_info(vtfFormat), expected);
+
+	// All other formats are rejected
+	for(int32_t i = 0; i < IMAGE_FORMAT_COUNT; ++i) {
+		auto vtfFormat = static_cast<VTFImageFormat>(i);
+		auto isExpected = std::find_if(expectedFormats.begin(), expectedFormats.end(), [vtfFormat](const auto &pair) { return pair.first == vtfFormat; }) != expectedFormats.end();
+		MATSYS_CHECK(pragma::material::find_vtf_format_info(vtfFormat).has_value() == isExpected);
+	}
+}
+#endif
+
+#ifndef DISABLE_VTEX_SUPPORT
+MATSYS_TEST(vtex_formats)
+{
+	using F = prosper::Format;
+	using S = prosper::ComponentSwizzle;
+	using VTexFormat = source2::VTexFormat;
+	const std::vector<std::pair<VTexFormat, ExpectedFormat>> expectedFormats = {
+	  {VTexFormat::DXT1, {F::BC1_RGBA_UNorm_Block}},
+	  {VTexFormat::DXT5, {F::BC3_UNorm_Block}},
+	  {VTexFormat::RGBA8888, {F::R8G8B8A8_UNorm}},
+	  {VTexFormat::RGBA16161616, {F::R16G16B16A16_SNorm}},
+	  {VTexFormat::RGBA16161616F, {F::R16G16B16A16_SFloat}},
+	  {VTexFormat::RGB323232F, {F::R32G32B32_SFloat, F::R32G32B32A32_SFloat, SWIZZLE_RGBA, PixelConversion::Rgb32fToRgba32f, F::R32G32B32A32_SFloat}},
+	  {VTexFormat::RGBA32323232F, {F::R32G32B32A32_SFloat, {}, SWIZZLE_RGBA, PixelConversion::Rgba32fToRgba16f, F::R16G16B16A16_SFloat}},
+	  {VTexFormat::BC6H, {F::BC6H_SFloat_Block}},
+	  {VTexFormat::BC7, {F::BC7_UNorm_Block}},
+	  {VTexFormat::BGRA8888, {F::B8G8R8A8_UNorm, {}, {S::B, S::G, S::R, S::A}}},
+	  {VTexFormat::ATI1N, {F::BC4_UNorm_Block}},
+	  {VTexFormat::ATI2N, {F::BC5_UNorm_Block}},
+	};
+	for(auto &[vtexFormat, expected] : expectedFormats)
+		check_format(pragma::material::find_vtex_format_info(vtexFormat), expected);
+
+	// All other formats are rejected
+	for(uint32_t i = 0; i < 256; ++i) {
+		auto vtexFormat = static_cast<VTexFormat>(i);
+		auto isExpected = std::find_if(expectedFormats.begin(), expectedFormats.end(), [vtexFormat](const auto &pair) { return pair.first == vtexFormat; }) != expectedFormats.end();
+		MATSYS_CHECK(pragma::material::find_vtex_format_info(vtexFormat).has_value() == isExpected);
+	}
+}
+#endif
+
+MATSYS_TEST_MAIN()
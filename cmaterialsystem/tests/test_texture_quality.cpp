@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+using pragma::material::TextureQualityTier;
+using pragma::material::TextureUsage;
+
+namespace {
+	struct QualityTierScope {
+		QualityTierScope(TextureQualityTier tier) { pragma::material::set_texture_quality_tier(tier); }
+		~QualityTierScope() { pragma::material::set_texture_quality_tier(TextureQualityTier::Ultra); }
+	};
+	// Dimensions of the base level that is uploaded, i.e. the first level that isn't skipped
+	std::pair<uint32_t, uint32_t> get_base_level_size(uint32_t width, uint32_t height, uint32_t mipmapCount, uint32_t maxResolution)
+	{
+		auto skipped = pragma::material::calculate_skipped_mipmap_count(width, height, mipmapCount, maxResolution);
+		uint32_t w, h;
+		prosper::util::calculate_mipmap_size(width, height, &w, &h, skipped);
+		return {w, h};
+	}
+}
+
+MATSYS_TEST(default_tiers)
+{
+	struct Expected {
+		TextureQualityTier tier;
+		uint32_t albedo;
+		uint32_t rma;
+	};
+	for(auto &expected : {Expected {TextureQualityTier::Low, 512, 256}, Expected {TextureQualityTier::Medium, 1'024, 512}, Expected {TextureQualityTier::High, 2'048, 1'024}, Expected {TextureQualityTier::Ultra, 0, 0}}) {
+		MATSYS_CHECK(pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Albedo) == expected.albedo);
+		MATSYS_CHECK(pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Normal) == expected.albedo);
+		MATSYS_CHECK(pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Generic) == expected.albedo);
+		MATSYS_CHECK(pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Rma) == expected.rma);
+		MATSYS_CHECK(pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Emission) == expected.rma);
+	}
+	MATSYS_CHECK(pragma::material::get_texture_max_resolution(TextureQualityTier::Count, TextureUsage::Albedo) == 0);
+	MATSYS_CHECK(pragma::material::get_texture_max_resolution(TextureQualityTier::Low, TextureUsage::Count) == 0);
+
+	pragma::material::set_texture_max_resolution(TextureQualityTier::Low, TextureUsage::Albedo, 128);
+	MATSYS_CHECK(pragma::material::get_texture_max_resolution(TextureQualityTier::Low, TextureUsage::Albedo) == 128);
+	pragma::material::set_texture_max_resolution(TextureQualityTier::Low, TextureUsage::Albedo, 512);
+}
+
+MATSYS_TEST(texture_usage)
+{
+	MATSYS_CHECK(pragma::material::get_texture_usage("albedo_map") == TextureUsage::Albedo);
+	MATSYS_CHECK(pragma::material::get_texture_usage("diffusemap") == TextureUsage::Albedo);
+	MATSYS_CHECK(pragma::material::get_texture_usage("normal_map") == TextureUsage::Normal);
+	MATSYS_CHECK(pragma::material::get_texture_usage("rma_map") == TextureUsage::Rma);
+	MATSYS_CHECK(pragma::material::get_texture_usage("roughness_map") == TextureUsage::Rma);
+	MATSYS_CHECK(pragma::material::get_texture_usage("emission_map") == TextureUsage::Emission);
+	MATSYS_CHECK(pragma::material::get_texture_usage("parallax_map") == TextureUsage::Generic);
+}
+
+// The skipped levels are neither read from disk nor uploaded, the first remaining level determines the texture size
+MATSYS_TEST(skipped_mipmaps_per_tier)
+{
+	// 4096x2048 with a full mipmap chain
+	constexpr uint32_t width = 4'096;
+	constexpr uint32_t height = 2'048;
+	constexpr uint32_t mipmapCount = 13;
+	struct Expected {
+		TextureQualityTier tier;
+		uint32_t skippedAlbedo;
+		uint32_t skippedRma;
+	};
+	for(auto &expected : {Expected {TextureQualityTier::Low, 3, 4}, Expected {TextureQualityTier::Medium, 2, 3}, Expected {TextureQualityTier::High, 1, 2}, Expected {TextureQualityTier::Ultra, 0, 0}}) {
+		auto albedoLimit = pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Albedo);
+		auto rmaLimit = pragma::material::get_texture_max_resolution(expected.tier, TextureUsage::Rma);
+		MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(width, height, mipmapCount, albedoLimit) == expected.skippedAlbedo);
+		MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(width, height, mipmapCount, rmaLimit) == expected.skippedRma);
+		auto [w, h] = get_base_level_size(width, height, mipmapCount, albedoLimit);
+		MATSYS_CHECK(w == (width >> expected.skippedAlbedo) && h == (height >> expected.skippedAlbedo));
+		MATSYS_CHECK(albedoLimit == 0 || std::max(w, h) <= albedoLimit);
+	}
+	// Textures within the limit are unaffected
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(256, 256, 9, 512) == 0);
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(512, 512, 10, 512) == 0);
+	// Non-power-of-two sizes
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(1'000, 600, 10, 512) == 1);
+	MATSYS_CHECK((get_base_level_size(1'000, 600, 10, 512) == std::pair<uint32_t, uint32_t> {500, 300}));
+	// Without mipmaps nothing can be skipped, and at least one level is always kept
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(4'096, 4'096, 1, 512) == 0);
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(4'096, 4'096, 3, 512) == 2);
+	MATSYS_CHECK(pragma::material::calculate_skipped_mipmap_count(4'096, 4'096, 13, 1) == 12);
+}
+
+MATSYS_TEST(effective_max_resolution)
+{
+	pragma::material::TextureLoadInfo loadInfo {};
+	loadInfo.usage = TextureUsage::Rma;
+	MATSYS_CHECK(pragma::material::TextureManager::GetEffectiveMaxResolution(loadInfo) == 0);
+	{
+		QualityTierScope scope {TextureQualityTier::Medium};
+		MATSYS_CHECK(pragma::material::TextureManager::GetEffectiveMaxResolution(loadInfo) == 512);
+		loadInfo.usage = TextureUsage::Albedo;
+		MATSYS_CHECK(pragma::material::TextureManager::GetEffectiveMaxResolution(loadInfo) == 1'024);
+		// An explicit limit (e.g. from the material) takes precedence over the tier
+		loadInfo.maxResolution = 256;
+		MATSYS_CHECK(pragma::material::TextureManager::GetEffectiveMaxResolution(loadInfo) == 256);
+		loadInfo.maxResolution = 0;
+		MATSYS_CHECK(pragma::material::TextureManager::GetEffectiveMaxResolution(loadInfo) == 0);
+	}
+}
+
+// Cached textures are only re-used silently if they have been loaded with at least the requested resolution
+MATSYS_TEST(cached_resolution_limit)
+{
+	using pragma::material::is_resolution_limit_exceeded;
+	MATSYS_CHECK(!is_resolution_limit_exceeded(0, 0));
+	MATSYS_CHECK(!is_resolution_limit_exceeded(0, 512));
+	MATSYS_CHECK(is_resolution_limit_exceeded(512, 0));
+	MATSYS_CHECK(is_resolution_limit_exceeded(512, 1'024));
+	MATSYS_CHECK(!is_resolution_limit_exceeded(512, 512));
+	MATSYS_CHECK(!is_resolution_limit_exceeded(1'024, 512));
+}
+
+MATSYS_TEST_MAIN()
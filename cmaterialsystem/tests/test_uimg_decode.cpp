@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.cmaterialsystem;
+
+#include "test.hpp"
+
+using pragma::material::ITextureFormatHandler;
+using pragma::material::TextureFormatHandlerUimg;
+using HdrPacking = TextureFormatHandlerUimg::HdrPacking;
+
+namespace {
+	constexpr uint32_t WIDTH = 4;
+	constexpr uint32_t HEIGHT = 2;
+	// Values which are exactly representable in the rgbe encoding of radiance hdr files
+	const std::vector<std::array<float, 3>> HDR_PIXELS {
+	  {1.f, 0.5f, 0.25f},
+	  {1'000.f, 500.f, 248.f},
+	  {0.f, 0.f, 0.f},
+	  {3.5f, 0.125f, 2.f},
+	  {40'960.f, 256.f, 0.f}, // Beyond the range of 8-bit and 16-bit integer formats
+	  {0.015625f, 0.0078125f, 0.f},
+	  {65.f, 64.f, 63.f},
+	  {7.f, 6.f, 5.f},
+	};
+
+	std::array<uint8_t, 4> encode_rgbe(const std::array<float, 3> &rgb)
+	{
+		auto maxc = std::max({rgb[0], rgb[1], rgb[2]});
+		if(maxc < 1e-32f)
+			return {0, 0, 0, 0};
+		int e;
+		auto scale = std::frexp(maxc, &e) * 256.f / maxc;
+		return {static_cast<uint8_t>(rgb[0] * scale), static_cast<uint8_t>(rgb[1] * scale), static_cast<uint8_t>(rgb[2] * scale), static_cast<uint8_t>(e + 128)};
+	}
+	// Radiance hdr file with flat (not run-length encoded) scanlines
+	std::vector<uint8_t> create_hdr_file()
+	{
+		std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " + std::to_string(HEIGHT) + " +X " + std::to_string(WIDTH) + "\n";
+		std::vector<uint8_t> data {header.begin(), header.end()};
+		for(auto &px : HDR_PIXELS) {
+			auto rgbe = encode_rgbe(px);
+			data.insert(data.end(), rgbe.begin(), rgbe.end());
+		}
+		return data;
+	}
+
+	uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+	{
+		crc = ~crc;
+		for(size_t i = 0; i < size; ++i) {
+			crc ^= data[i];
+			for(auto k = 0; k < 8; ++k)
+				crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+		}
+		return ~crc;
+	}
+	void write_be32(std::vector<uint8_t> &data, uint32_t v)
+	{
+		for(auto shift : {24, 16, 8, 0})
+			data.push_back(static_cast<uint8_t>(v >> shift));
+	}
+	void write_chunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &chunkData)
+	{
+		write_be32(png, static_cast<uint32_t>(chunkData.size()));
+		std::vector<uint8_t> typeAndData {type, type + 4};
+		typeAndData.insert(typeAndData.end(), chunkData.begin(), chunkData.end());
+		png.insert(png.end(), typeAndData.begin(), typeAndData.end());
+		write_be32(png, crc32(typeAndData.data(), typeAndData.size()));
+	}
+	uint16_t get_png_value(uint32_t x, uint32_t y, uint32_t c) { return static_cast<uint16_t>((x * 7'919 + y * 104'729 + c * 15'485'863 + 12'345) & 0xffff); }
+	// 16-bit rgba png, with the image data stored in uncompressed deflate blocks
+	std::vector<uint8_t> create_png16_file()
+	{
+		std::vector<uint8_t> raw;
+		for(uint32_t y = 0; y < HEIGHT; ++y) {
+			raw.push_back(0); // No filter
+			for(uint32_t x = 0; x < WIDTH; ++x) {
+				for(uint32_t c = 0; c < 4; ++c) {
+					auto v = get_png_value(x, y, c);
+					raw.push_back(static_cast<uint8_t>(v >> 8));
+					raw.push_back(static_cast<uint8_t>(v & 0xff));
+				}
+			}
+		}
+		std::vector<uint8_t> zlib {0x78, 0x01, 0x01}; // Single final stored block
+		auto len = static_cast<uint16_t>(raw.size());
+		for(auto v : {len, static_cast<uint16_t>(~len)}) {
+			zlib.push_back(static_cast<uint8_t>(v & 0xff));
+			zlib.push_back(static_cast<uint8_t>(v >> 8));
+		}
+		zlib.insert(zlib.end(), raw.begin(), raw.end());
+		uint32_t a = 1, b = 0;
+		for(auto v : raw) {
+			a = (a + v) % 65'521;
+			b = (b + a) % 65'521;
+		}
+		write_be32(zlib, (b << 16) | a);
+
+		std::vector<uint8_t> png {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+		std::vector<uint8_t> ihdr;
+		write_be32(ihdr, WIDTH);
+		write_be32(ihdr, HEIGHT);
+		ihdr.insert(ihdr.end(), {16, 6, 0, 0, 0}); // Bit depth, color type rgba, compression, filter, interlace
+		write_chunk(png, "IHDR", ihdr);
+		write_chunk(png, "IDAT", zlib);
+		write_chunk(png, "IEND", {});
+		return png;
+	}
+
+	float half_to_float(uint16_t h)
+	{
+		auto sign = (h & 0x8000) ? -1.f : 1.f;
+		auto e = (h >> 10) & 0x1f;
+		auto m = h & 0x3ff;
+		if(e == 0)
+			return sign * std::ldexp(static_cast<float>(m), -24);
+		if(e == 31)
+			return (m == 0) ? sign * std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+		return sign * std::ldexp(static_cast<float>(m + 1'024), e - 25);
+	}
+	std::array<float, 3> decode_rgb9e5(uint32_t v)
+	{
+		auto scale = std::exp2(static_cast<float>(static_cast<int32_t>(v >> 27) - 15 - 9));
+		return {(v & 0x1ff) * scale, ((v >> 9) & 0x1ff) * scale, ((v >> 18) & 0x1ff) * scale};
+	}
+	template<typename T>
+	T get_value(const std::vector<uint8_t> &data, size_t idx)
+	{
+		T v;
+		std::memcpy(&v, data.data() + idx * sizeof(T), sizeof(T));
+		return v;
+	}
+	std::optional<TextureFormatHandlerUimg::DecodedImage> decode(const std::vector<uint8_t> &fileData, ITextureFormatHandler::InputTextureInfo &outTexInfo)
+	{
+		ufile::VectorFile f {std::vector<uint8_t> {fileData}};
+		return TextureFormatHandlerUimg::Decode(f, outTexInfo);
+	}
+	struct HdrSettingsScope {
+		HdrSettingsScope(HdrPacking packing, bool cpuMipmaps)
+		{
+			TextureFormatHandlerUimg::SetHdrPacking(packing);
+			TextureFormatHandlerUimg::SetGenerateHdrMipmapsOnCpu(cpuMipmaps);
+		}
+		~HdrSettingsScope()
+		{
+			TextureFormatHandlerUimg::SetHdrPacking(HdrPacking::Half);
+			TextureFormatHandlerUimg::SetGenerateHdrMipmapsOnCpu(false);
+		}
+	};
+	// Relative error of a half float, plus the smallest subnormal for values close to 0
+	bool is_within_half_precision(float value, float expected) { return std::abs(value - expected) <= std::abs(expected) * std::exp2(-11.f) + std::exp2(-24.f); }
+}
+
+MATSYS_TEST(pixel_format_detection)
+{
+	auto getPixelFormat = [](const std::vector<uint8_t> &data) {
+		ufile::VectorFile f {std::vector<uint8_t> {data}};
+		return TextureFormatHandlerUimg::GetPixelFormat(f);
+	};
+	MATSYS_CHECK(getPixelFormat(create_hdr_file()) == pragma::image::PixelFormat::Float);
+	MATSYS_CHECK(getPixelFormat(create_png16_file()) == pragma::image::PixelFormat::HDR);
+	auto png8 = create_png16_file();
+	png8[24] = 8;
+	MATSYS_CHECK(getPixelFormat(png8) == pragma::image::PixelFormat::LDR);
+	MATSYS_CHECK(getPixelFormat({'#', '?', 'R', 'G', 'B', 'E'}) == pragma::image::PixelFormat::Float);
+	MATSYS_CHECK(getPixelFormat({}) == pragma::image::PixelFormat::LDR);
+}
+
+// The default packing stores hdr images as half floats, values have to survive to within half float precision
+MATSYS_TEST(hdr_half_precision)
+{
+	HdrSettingsScope scope {HdrPacking::Half, false};
+	ITextureFormatHandler::InputTextureInfo texInfo {};
+	auto image = decode(create_hdr_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value());
+	MATSYS_CHECK(texInfo.width == WIDTH && texInfo.height == HEIGHT);
+	MATSYS_CHECK(texInfo.format == prosper::Format::R16G16B16A16_SFloat);
+	MATSYS_CHECK(!pragma::math::is_flag_set(texInfo.flags, ITextureFormatHandler::InputTextureInfo::Flags::SrgbBit));
+	MATSYS_CHECK(texInfo.mipmapCount == 1);
+	MATSYS_REQUIRE(image->mipmapData.size() == 1);
+	auto &data = image->mipmapData.front();
+	MATSYS_REQUIRE(data.size() == WIDTH * HEIGHT * 4 * sizeof(uint16_t));
+	for(size_t i = 0; i < HDR_PIXELS.size(); ++i) {
+		for(size_t c = 0; c < 3; ++c)
+			MATSYS_CHECK(is_within_half_precision(half_to_float(get_value<uint16_t>(data, i * 4 + c)), HDR_PIXELS[i][c]));
+		MATSYS_CHECK(half_to_float(get_value<uint16_t>(data, i * 4 + 3)) == 1.f);
+	}
+}
+
+MATSYS_TEST(hdr_full_precision)
+{
+	HdrSettingsScope scope {HdrPacking::None, false};
+	ITextureFormatHandler::InputTextureInfo texInfo {};
+	auto image = decode(create_hdr_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value() && image->imgBuf != nullptr);
+	MATSYS_CHECK(texInfo.format == prosper::Format::R32G32B32A32_SFloat);
+	MATSYS_REQUIRE(image->imgBuf->GetSize() == WIDTH * HEIGHT * 4 * sizeof(float));
+	auto *values = static_cast<const float *>(image->imgBuf->GetData());
+	for(size_t i = 0; i < HDR_PIXELS.size(); ++i) {
+		for(size_t c = 0; c < 3; ++c)
+			MATSYS_CHECK(values[i * 4 + c] == HDR_PIXELS[i][c]);
+	}
+}
+
+// Shared exponent packing always generates the mipmaps on the CPU
+MATSYS_TEST(hdr_shared_exponent)
+{
+	HdrSettingsScope scope {HdrPacking::SharedExponent, false};
+	ITextureFormatHandler::InputTextureInfo texInfo {};
+	auto image = decode(create_hdr_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value());
+	MATSYS_CHECK(texInfo.format == prosper::Format::E5B9G9R9_UFloat_Pack32);
+	MATSYS_CHECK(texInfo.mipmapCount == 3);
+	MATSYS_REQUIRE(image->mipmapData.size() == 3);
+	auto &data = image->mipmapData.front();
+	MATSYS_REQUIRE(data.size() == WIDTH * HEIGHT * sizeof(uint32_t));
+	for(size_t i = 0; i < HDR_PIXELS.size(); ++i) {
+		auto decoded = decode_rgb9e5(get_value<uint32_t>(data, i));
+		// The precision is determined by the largest component
+		auto maxc = std::max({HDR_PIXELS[i][0], HDR_PIXELS[i][1], HDR_PIXELS[i][2]});
+		auto tolerance = (maxc > 0.f) ? std::exp2(std::floor(std::log2(maxc)) + 1 - 9) : 0.f;
+		for(size_t c = 0; c < 3; ++c)
+			MATSYS_CHECK(std::abs(decoded[c] - HDR_PIXELS[i][c]) <= tolerance);
+	}
+	MATSYS_CHECK(image->mipmapData[1].size() == 2 * 1 * sizeof(uint32_t));
+	MATSYS_CHECK(image->mipmapData[2].size() == 1 * 1 * sizeof(uint32_t));
+}
+
+MATSYS_TEST(hdr_cpu_mipmaps)
+{
+	HdrSettingsScope scope {HdrPacking::None, true};
+	ITextureFormatHandler::InputTextureInfo texInfo {};
+	auto image = decode(create_hdr_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value());
+	MATSYS_CHECK(texInfo.mipmapCount == 3);
+	MATSYS_REQUIRE(image->mipmapData.size() == 3);
+	// Every pixel of the first level is the average of a 2x2 block of the base level
+	auto &level1 = image->mipmapData[1];
+	MATSYS_REQUIRE(level1.size() == 2 * 1 * 4 * sizeof(float));
+	for(uint32_t x = 0; x < 2; ++x) {
+		for(size_t c = 0; c < 3; ++c) {
+			auto expected = (HDR_PIXELS[x * 2][c] + HDR_PIXELS[x * 2 + 1][c] + HDR_PIXELS[WIDTH + x * 2][c] + HDR_PIXELS[WIDTH + x * 2 + 1][c]) * 0.25f;
+			MATSYS_CHECK(std::abs(get_value<float>(level1, x * 4 + c) - expected) <= std::abs(expected) * 1e-6f);
+		}
+	}
+}
+
+// 16-bit integer images keep all 16 bits and are treated as srgb like 8-bit images
+MATSYS_TEST(png_16bit)
+{
+	HdrSettingsScope scope {HdrPacking::Half, false};
+	ITextureFormatHandler::InputTextureInfo texInfo {};
+	auto image = decode(create_png16_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value() && image->imgBuf != nullptr);
+	MATSYS_CHECK(texInfo.width == WIDTH && texInfo.height == HEIGHT);
+	MATSYS_CHECK(texInfo.format == prosper::Format::R16G16B16A16_UNorm);
+	MATSYS_CHECK(pragma::math::is_flag_set(texInfo.flags, ITextureFormatHandler::InputTextureInfo::Flags::SrgbBit));
+	MATSYS_REQUIRE(image->imgBuf->GetSize() == WIDTH * HEIGHT * 4 * sizeof(uint16_t));
+	auto *values = static_cast<const uint16_t *>(image->imgBuf->GetData());
+	for(uint32_t y = 0; y < HEIGHT; ++y) {
+		for(uint32_t x = 0; x < WIDTH; ++x) {
+			for(uint32_t c = 0; c < 4; ++c)
+				MATSYS_CHECK(values[(y * WIDTH + x) * 4 + c] == get_png_value(x, y, c));
+		}
+	}
+
+	TextureFormatHandlerUimg::SetGenerateHdrMipmapsOnCpu(true);
+	texInfo = {};
+	image = decode(create_png16_file(), texInfo);
+	MATSYS_REQUIRE(image.has_value());
+	MATSYS_CHECK(texInfo.mipmapCount == 3 && image->mipmapData.size() == 3);
+	MATSYS_CHECK(image->imgBuf == nullptr);
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Shared helpers for the libFuzzer targets. Every target source file defines LLVMFuzzerTestOneInput and is built as its own executable.
+// Has to be included after the module imports, which provide the standard library.
+
+#pragma once
+
+namespace pragma::material::fuzz {
+	// Exposes the file of a format handler, so the input can be passed to the handler directly instead of through the virtual file system
+	template<class THandler>
+	class InMemoryHandler : public THandler {
+	  public:
+		InMemoryHandler(pragma::util::IAssetManager &assetManager, const uint8_t *data, size_t size) : THandler {assetManager} { this->m_file = std::make_unique<ufile::VectorFile>(std::vector<uint8_t> {data, data + size}); }
+	};
+
+	// Directory for files written by a target (e.g. converted materials). The returned path is relative to the program path, so it can be
+	// used with the virtual file system.
+	inline std::string get_output_directory(const std::string &target)
+	{
+		auto path = "matsys_fuzz/" + target;
+		std::filesystem::create_directories(std::filesystem::path {pragma::util::get_program_path()} / path);
+		return path;
+	}
+}
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Standalone driver for compilers without libFuzzer. Runs every input file passed on the command line once, directories are
+// searched recursively. Arguments starting with '-' are libFuzzer options and are ignored, so both builds can be invoked the same way.
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace {
+	void run_input(const std::filesystem::path &path)
+	{
+		std::ifstream f {path, std::ios::binary};
+		std::vector<uint8_t> data {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> {}};
+		std::cout << "Running " << path.generic_string() << " (" << data.size() << " bytes)" << std::endl;
+		LLVMFuzzerTestOneInput(data.data(), data.size());
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t numInputs = 0;
+	for(auto i = 1; i < argc; ++i) {
+		std::filesystem::path path {argv[i]};
+		if(argv[i][0] == '-')
+			continue;
+		if(std::filesystem::is_directory(path)) {
+			for(auto &entry : std::filesystem::recursive_directory_iterator {path}) {
+				if(!entry.is_regular_file())
+					continue;
+				run_input(entry.path());
+				++numInputs;
+			}
+			continue;
+		}
+		if(!std::filesystem::is_regular_file(path)) {
+			std::cerr << "Input '" << path.generic_string() << "' does not exist!" << std::endl;
+			return EXIT_FAILURE;
+		}
+		run_input(path);
+		++numInputs;
+	}
+	std::cout << numInputs << " inputs executed" << std::endl;
+	return EXIT_SUCCESS;
+}
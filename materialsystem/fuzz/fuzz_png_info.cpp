@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "fuzz.hpp"
+
+namespace fuzz = pragma::material::fuzz;
+
+// Reads a png file with libpng. The reader only accepts files, so the input is written to disk first.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	static auto path = (std::filesystem::path {pragma::util::get_program_path()} / fuzz::get_output_directory("png_info") / "input.png").generic_string();
+	{
+		std::ofstream f {path, std::ios::binary | std::ios::trunc};
+		f.write(reinterpret_cast<const char *>(data), size);
+	}
+	std::shared_ptr<pragma::fs::VFilePtrInternal> f = pragma::fs::open_system_file(path, pragma::fs::FileMode::Read | pragma::fs::FileMode::Binary);
+	if(!f)
+		return 0;
+	pragma::material::PNGInfo info {};
+	if(pragma::material::load_png_data(f, info)) {
+		// Successfully decoded images are always RGBA, touching every pixel detects buffers that are smaller than the dimensions claim
+		volatile uint8_t sum = 0;
+		for(size_t i = 0; i < static_cast<size_t>(info.width) * info.height * 4; ++i)
+			sum = static_cast<uint8_t>(sum + info.image_data[i]);
+	}
+	info.Release();
+	return 0;
+}
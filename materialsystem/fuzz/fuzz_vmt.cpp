@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "fuzz.hpp"
+
+namespace fuzz = pragma::material::fuzz;
+
+// Imports a vmt file with the VTFLib parser and saves the converted material
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+#ifndef DISABLE_VMT_SUPPORT
+	static auto manager = pragma::material::MaterialManager::Create();
+	static auto outputPath = fuzz::get_output_directory("vmt") + "/material";
+	fuzz::InMemoryHandler<pragma::material::SourceVmtFormatHandler> handler {*manager, data, size};
+	std::string outFilePath;
+	handler.Import(outputPath, outFilePath);
+	// Failures are remembered by their content hash, which would accumulate over the run
+	manager->GetImportDiagnostics().ClearRecords();
+	manager->GetImportDiagnostics().ClearFailures();
+#endif
+	return 0;
+}
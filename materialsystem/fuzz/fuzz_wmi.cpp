@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "fuzz.hpp"
+
+namespace fuzz = pragma::material::fuzz;
+
+// Parses a wmi file and creates the material from it
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	static auto manager = pragma::material::MaterialManager::Create();
+	static pragma::material::MaterialLoader loader {*manager};
+	// The processor owns the handler, like it does when the material is loaded through the manager
+	auto handler = std::make_unique<fuzz::InMemoryHandler<pragma::material::WmiFormatHandler>>(*manager, data, size);
+	auto &matHandler = *handler;
+	pragma::material::MaterialProcessor processor {loader, std::move(handler)};
+	pragma::material::MaterialLoadInfo loadInfo {};
+	if(!matHandler.LoadData(processor, loadInfo))
+		return 0;
+	manager->CreateMaterial(matHandler.shader, matHandler.data);
+	return 0;
+}
@@ -0,0 +1,63 @@
+# Each fuzz target source file is built as its own executable and registered with CTest, which runs it on its seed corpus
+# (corpus/<name> in the current source directory) for a fixed number of iterations.
+# With Clang the targets are libFuzzer binaries, other compilers link the standalone driver instead, which only replays the corpus.
+# Usage: matsys_add_fuzzer(<name> <library target>), where <name>.cpp is located in the current source directory.
+set(MATSYS_FUZZ_INCLUDE_DIR "${CMAKE_CURRENT_LIST_DIR}")
+set(MATSYS_FUZZ_SANITIZERS "address,undefined" CACHE STRING "Sanitizers the fuzz targets and the libraries are built with, empty to disable.")
+set(MATSYS_FUZZ_RUNS 10000 CACHE STRING "Number of inputs every fuzz target executes when run through CTest.")
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND NOT MSVC)
+	set(MATSYS_FUZZ_LIBFUZZER ON)
+else()
+	set(MATSYS_FUZZ_LIBFUZZER OFF)
+endif()
+
+function(matsys_get_fuzz_sanitizer_flags OUT_VAR)
+	set(FLAGS "")
+	if(MATSYS_FUZZ_SANITIZERS AND NOT MSVC)
+		list(APPEND FLAGS "-fsanitize=${MATSYS_FUZZ_SANITIZERS}" -fno-omit-frame-pointer -fno-sanitize-recover=all)
+	endif()
+	set(${OUT_VAR} ${FLAGS} PARENT_SCOPE)
+endfunction()
+
+# Out-of-bounds reads are only detected in code that has been built with the sanitizers, so the library has to be instrumented as well
+# Usage: matsys_enable_fuzz_instrumentation(<library target>)
+function(matsys_enable_fuzz_instrumentation LIBRARY)
+	matsys_get_fuzz_sanitizer_flags(FLAGS)
+	if(MATSYS_FUZZ_LIBFUZZER)
+		list(APPEND FLAGS -fsanitize=fuzzer-no-link)
+	endif()
+	if(FLAGS)
+		target_compile_options(${LIBRARY} PRIVATE ${FLAGS})
+		target_link_options(${LIBRARY} PRIVATE ${FLAGS})
+	endif()
+endfunction()
+
+function(matsys_add_fuzzer NAME LIBRARY)
+	add_executable(${NAME} "${CMAKE_CURRENT_SOURCE_DIR}/${NAME}.cpp")
+	target_link_libraries(${NAME} PRIVATE ${LIBRARY})
+	target_include_directories(${NAME} PRIVATE "${MATSYS_FUZZ_INCLUDE_DIR}")
+	get_target_property(LIBRARY_CXX_STANDARD ${LIBRARY} CXX_STANDARD)
+	if(LIBRARY_CXX_STANDARD)
+		set_target_properties(${NAME} PROPERTIES CXX_STANDARD ${LIBRARY_CXX_STANDARD})
+	endif()
+	set_target_properties(${NAME} PROPERTIES CXX_SCAN_FOR_MODULES ON FOLDER fuzz)
+
+	matsys_get_fuzz_sanitizer_flags(FLAGS)
+	set(RUN_ARGS "")
+	if(MATSYS_FUZZ_LIBFUZZER)
+		list(APPEND FLAGS -fsanitize=fuzzer)
+		# New inputs are written to the first corpus directory, which must not be the seed corpus in the source tree
+		set(WORK_CORPUS_DIR "${CMAKE_CURRENT_BINARY_DIR}/corpus/${NAME}")
+		file(MAKE_DIRECTORY "${WORK_CORPUS_DIR}")
+		set(RUN_ARGS -runs=${MATSYS_FUZZ_RUNS} -timeout=30 -rss_limit_mb=4096 "${WORK_CORPUS_DIR}")
+	else()
+		target_sources(${NAME} PRIVATE "${MATSYS_FUZZ_INCLUDE_DIR}/fuzz_main.cpp")
+	endif()
+	if(FLAGS)
+		target_compile_options(${NAME} PRIVATE ${FLAGS})
+		target_link_options(${NAME} PRIVATE ${FLAGS})
+	endif()
+	add_test(NAME ${NAME} COMMAND ${NAME} ${RUN_ARGS} "${CMAKE_CURRENT_SOURCE_DIR}/corpus/${NAME}" WORKING_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}")
+	set_tests_properties(${NAME} PROPERTIES LABELS fuzz)
+endfunction()
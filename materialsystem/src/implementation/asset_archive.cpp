@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include <lz4.h>
+#include <zlib.h>
+
+module pragma.materialsystem;
+
+import :asset_archive;
+import :material_manager;
+import :util;
+
+std::string pragma::material::AssetArchive::NormalizePath(const std::string &path)
+{
+	auto normalizedPath = normalize_cache_path(path);
+	while(normalizedPath.starts_with("./"))
+		normalizedPath.erase(0, 2);
+	while(!normalizedPath.empty() && normalizedPath.front() == '/')
+		normalizedPath.erase(0, 1);
+	return normalizedPath;
+}
+
+std::shared_ptr<pragma::material::AssetArchive> pragma::material::AssetArchive::Open(const std::string &fileName, std::string &outErr)
+{
+	auto f = fs::open_file(fileName, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return nullptr;
+	}
+	Header header {};
+	if(f->Read(&header, sizeof(header)) != sizeof(header) || header.identifier != PMPK_IDENTIFIER) {
+		outErr = "Incorrect format!";
+		return nullptr;
+	}
+	if(header.version < 1 || header.version > PMPK_VERSION) {
+		outErr = "Unsupported version " + std::to_string(header.version) + "!";
+		return nullptr;
+	}
+	uint64_t fileSize = f->GetSize();
+	auto indexSize = static_cast<uint64_t>(header.entryCount) * sizeof(IndexEntry);
+	// The sizes are read from the file, so the bounds checks have to be written in a way that can't overflow
+	if(indexSize > fileSize - sizeof(Header) || header.stringTableSize > fileSize - sizeof(Header) - indexSize) {
+		outErr = "Archive is truncated!";
+		return nullptr;
+	}
+	auto archive = std::shared_ptr<AssetArchive> {new AssetArchive {}};
+	archive->m_fileName = fileName;
+	archive->m_entries.resize(header.entryCount);
+	archive->m_stringTable.resize(header.stringTableSize);
+	if(f->Read(archive->m_entries.data(), indexSize) != indexSize || f->Read(archive->m_stringTable.data(), header.stringTableSize) != header.stringTableSize) {
+		outErr = "Unable to read archive index!";
+		return nullptr;
+	}
+	// Upper bounds for the decompressed size, so a corrupt entry can't cause an excessive allocation
+	constexpr uint64_t maxLz4Ratio = 255;
+	constexpr uint64_t maxZlibRatio = 1'032;
+	for(auto &entry : archive->m_entries) {
+		auto valid = static_cast<uint64_t>(entry.nameOffset) + entry.nameLength <= header.stringTableSize && entry.storedSize <= fileSize && entry.offset <= fileSize - entry.storedSize;
+		switch(entry.compression) {
+		case Compression::None:
+			valid = valid && entry.size == entry.storedSize;
+			break;
+		case Compression::Lz4:
+			valid = valid && entry.size / maxLz4Ratio <= entry.storedSize;
+			break;
+		case Compression::Zlib:
+			valid = valid && entry.size / maxZlibRatio <= entry.storedSize;
+			break;
+		default:
+			valid = false;
+			break;
+		}
+		if(!valid) {
+			outErr = "Archive index is corrupt!";
+			return nullptr;
+		}
+	}
+	// FindEntry uses a binary search, which requires the paths to be sorted and unique
+	for(size_t i = 1; i < archive->m_entries.size(); ++i) {
+		if(!(archive->GetEntryPath(i - 1) < archive->GetEntryPath(i))) {
+			outErr = "Archive index is not sorted!";
+			return nullptr;
+		}
+	}
+	archive->m_file = f;
+	return archive;
+}
+
+std::string_view pragma::material::AssetArchive::GetEntryPath(size_t idx) const
+{
+	auto &entry = m_entries[idx];
+	return std::string_view {m_stringTable}.substr(entry.nameOffset, entry.nameLength);
+}
+
+const pragma::material::AssetArchive::IndexEntry *pragma::material::AssetArchive::FindEntry(const std::string &path) const
+{
+	auto normalizedPath = NormalizePath(path);
+	std::string_view stringTable {m_stringTable};
+	auto it = std::lower_bound(m_entries.begin(), m_entries.end(), normalizedPath, [&stringTable](const IndexEntry &entry, const std::string &path) { return stringTable.substr(entry.nameOffset, entry.nameLength) < path; });
+	if(it == m_entries.end() || stringTable.substr(it->nameOffset, it->nameLength) != normalizedPath)
+		return nullptr;
+	return &*it;
+}
+
+bool pragma::material::AssetArchive::Read(const IndexEntry &entry, std::vector<uint8_t> &outData) const
+{
+	if(entry.size == 0) {
+		outData.clear();
+		return true;
+	}
+	std::vector<uint8_t> storedData;
+	auto &readData = (entry.compression == Compression::None) ? outData : storedData;
+	readData.resize(entry.storedSize);
+	{
+		std::scoped_lock lock {m_fileMutex};
+		m_file->Seek(entry.offset);
+		if(m_file->Read(readData.data(), readData.size()) != readData.size())
+			return false;
+	}
+	switch(entry.compression) {
+	case Compression::None:
+		return true;
+	case Compression::Lz4:
+		{
+			outData.resize(entry.size);
+			auto r = LZ4_decompress_safe(reinterpret_cast<const char *>(storedData.data()), reinterpret_cast<char *>(outData.data()), static_cast<int>(storedData.size()), static_cast<int>(outData.size()));
+			return r >= 0 && static_cast<uint64_t>(r) == entry.size;
+		}
+	case Compression::Zlib:
+		{
+			outData.resize(entry.size);
+			auto size = static_cast<uLongf>(outData.size());
+			auto r = uncompress(outData.data(), &size, storedData.data(), static_cast<uLong>(storedData.size()));
+			return r == Z_OK && size == entry.size;
+		}
+	}
+	return false;
+}
+
+std::unique_ptr<ufile::IFile> pragma::material::AssetArchive::OpenFile(const std::string &path) const
+{
+	auto *entry = FindEntry(path);
+	if(!entry)
+		return nullptr;
+	std::vector<uint8_t> data;
+	if(!Read(*entry, data))
+		return nullptr;
+	return std::make_unique<ufile::VectorFile>(std::move(data));
+}
+
+/////////////
+
+pragma::material::AssetArchiveBuilder::AssetArchiveBuilder(uint32_t alignment) : m_alignment {std::max(alignment, 1u)} {}
+
+void pragma::material::AssetArchiveBuilder::AddFile(const std::string &path, std::vector<uint8_t> &&data, CompressionMode compression)
+{
+	FileData fileData {};
+	fileData.uncompressedSize = data.size();
+	switch(compression) {
+	case CompressionMode::Lz4:
+		{
+			std::vector<uint8_t> compressedData(LZ4_compressBound(static_cast<int>(data.size())));
+			auto size = LZ4_compress_default(reinterpret_cast<const char *>(data.data()), reinterpret_cast<char *>(compressedData.data()), static_cast<int>(data.size()), static_cast<int>(compressedData.size()));
+			if(size > 0) {
+				compressedData.resize(size);
+				fileData.data = std::move(compressedData);
+				fileData.compression = AssetArchive::Compression::Lz4;
+			}
+			break;
+		}
+	case CompressionMode::Zlib:
+	case CompressionMode::Auto:
+		{
+			auto size = compressBound(static_cast<uLong>(data.size()));
+			std::vector<uint8_t> compressedData(size);
+			if(compress2(compressedData.data(), &size, data.data(), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) != Z_OK)
+				break;
+			if(compression == CompressionMode::Auto && size > data.size() - data.size() / 10)
+				break;
+			compressedData.resize(size);
+			fileData.data = std::move(compressedData);
+			fileData.compression = AssetArchive::Compression::Zlib;
+			break;
+		}
+	}
+	if(fileData.compression == AssetArchive::Compression::None)
+		fileData.data = std::move(data);
+	m_files[AssetArchive::NormalizePath(path)] = std::move(fileData);
+}
+
+bool pragma::material::AssetArchiveBuilder::AddFileFromDisk(const std::string &path, const std::string &diskPath, CompressionMode compression)
+{
+	auto f = fs::open_system_file(diskPath, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr)
+		return false;
+	std::vector<uint8_t> data(f->GetSize());
+	if(f->Read(data.data(), data.size()) != data.size())
+		return false;
+	AddFile(path, std::move(data), compression);
+	return true;
+}
+
+bool pragma::material::AssetArchiveBuilder::Write(const std::string &fileName, std::string &outErr) const
+{
+	AssetArchive::Header header {};
+	header.identifier = AssetArchive::PMPK_IDENTIFIER;
+	header.version = AssetArchive::PMPK_VERSION;
+	header.entryCount = static_cast<uint32_t>(m_files.size());
+	header.alignment = m_alignment;
+
+	// std::map is sorted, so the index will be as well
+	std::vector<AssetArchive::IndexEntry> entries;
+	entries.reserve(m_files.size());
+	std::string stringTable;
+	for(auto &[path, fileData] : m_files) {
+		AssetArchive::IndexEntry entry {};
+		entry.nameOffset = static_cast<uint32_t>(stringTable.size());
+		entry.nameLength = static_cast<uint32_t>(path.size());
+		entry.storedSize = fileData.data.size();
+		entry.size = fileData.uncompressedSize;
+		entry.compression = fileData.compression;
+		stringTable += path;
+		entries.push_back(entry);
+	}
+	header.stringTableSize = stringTable.size();
+
+	auto alignOffset = [this](uint64_t offset) { return ((offset + m_alignment - 1) / m_alignment) * m_alignment; };
+	auto offset = alignOffset(sizeof(header) + entries.size() * sizeof(AssetArchive::IndexEntry) + stringTable.size());
+	for(auto &entry : entries) {
+		entry.offset = offset;
+		offset = alignOffset(offset + entry.storedSize);
+	}
+
+	fs::create_path(ufile::get_path_from_filename(fileName));
+	auto f = fs::open_file<fs::VFilePtrReal>(fileName, fs::FileMode::Write | fs::FileMode::Binary);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return false;
+	}
+	f->Write(&header, sizeof(header));
+	f->Write(entries.data(), entries.size() * sizeof(AssetArchive::IndexEntry));
+	f->Write(stringTable.data(), stringTable.size());
+	std::vector<uint8_t> padding(m_alignment, 0);
+	uint64_t pos = sizeof(header) + entries.size() * sizeof(AssetArchive::IndexEntry) + stringTable.size();
+	auto itFile = m_files.begin();
+	for(auto &entry : entries) {
+		f->Write(padding.data(), entry.offset - pos);
+		f->Write(itFile->second.data.data(), itFile->second.data.size());
+		pos = entry.offset + entry.storedSize;
+		++itFile;
+	}
+	return true;
+}
+
+extern const std::array<std::string, 5> g_knownMaterialFormats;
+bool pragma::material::build_asset_archive(const std::string &rootPath, const std::string &archiveRoot, const std::string &outFileName, std::string &outErr, AssetArchiveBuilder::CompressionMode compression, uint32_t *optOutFileCount)
+{
+	std::unordered_set<std::string> extensions {g_knownMaterialFormats.begin(), g_knownMaterialFormats.end()};
+	extensions.insert({"vmt", "vmat_c", "svg"});
+	for(auto &format : ::MaterialManager::get_supported_image_formats())
+		extensions.insert(format.extension);
+
+	AssetArchiveBuilder builder {};
+	uint32_t numFiles = 0;
+	std::error_code ec;
+	for(auto it = std::filesystem::recursive_directory_iterator {rootPath, ec}; !ec && it != std::filesystem::recursive_directory_iterator {}; it.increment(ec)) {
+		if(!it->is_regular_file(ec))
+			continue;
+		auto ext = it->path().extension().generic_string();
+		if(ext.empty())
+			continue;
+		ext = ext.substr(1);
+		pragma::string::to_lower(ext);
+		if(extensions.find(ext) == extensions.end())
+			continue;
+		auto relPath = std::filesystem::relative(it->path(), rootPath, ec).generic_string();
+		if(ec)
+			break;
+		if(!archiveRoot.empty())
+			relPath = archiveRoot + '/' + relPath;
+		if(!builder.AddFileFromDisk(relPath, it->path().string(), compression)) {
+			outErr = "Unable to read file '" + it->path().string() + "'!";
+			return false;
+		}
+		++numFiles;
+	}
+	if(ec) {
+		outErr = "Unable to iterate directory '" + rootPath + "': " + ec.message();
+		return false;
+	}
+	if(optOutFileCount)
+		*optOutFileCount = numFiles;
+	return builder.Write(outFileName, outErr);
+}
+
+/////////////
+
+static std::shared_mutex g_mountedArchiveMutex;
+static std::vector<std::shared_ptr<pragma::material::AssetArchive>> g_mountedArchives;
+void pragma::material::mount_asset_archive(const std::shared_ptr<AssetArchive> &archive)
+{
+	std::unique_lock lock {g_mountedArchiveMutex};
+	g_mountedArchives.insert(g_mountedArchives.begin(), archive);
+}
+void pragma::material::unmount_asset_archive(const AssetArchive &archive)
+{
+	std::unique_lock lock {g_mountedArchiveMutex};
+	auto it = std::find_if(g_mountedArchives.begin(), g_mountedArchives.end(), [&archive](const std::shared_ptr<AssetArchive> &other) { return other.get() == &archive; });
+	if(it != g_mountedArchives.end())
+		g_mountedArchives.erase(it);
+}
+void pragma::material::unmount_all_asset_archives()
+{
+	std::unique_lock lock {g_mountedArchiveMutex};
+	g_mountedArchives.clear();
+}
+std::unique_ptr<ufile::IFile> pragma::material::open_archived_asset_file(const std::string &path)
+{
+	std::shared_lock lock {g_mountedArchiveMutex};
+	for(auto &archive : g_mountedArchives) {
+		auto f = archive->OpenFile(path);
+		if(f)
+			return f;
+	}
+	return nullptr;
+}
+bool pragma::material::archived_asset_file_exists(const std::string &path)
+{
+	std::shared_lock lock {g_mountedArchiveMutex};
+	for(auto &archive : g_mountedArchives) {
+		if(archive->Exists(path))
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.materialsystem;
+
+import :asset_dependency_graph;
+
+size_t pragma::material::AssetDependencyGraph::AssetIdHash::operator()(const AssetId &id) const { return std::hash<std::string> {}(id.name) ^ (static_cast<size_t>(id.type) << 1); }
+
+void pragma::material::AssetDependencyGraph::RemoveOutgoingEdges(const AssetId &asset, Node &node)
+{
+	for(auto &dep : node.dependencies) {
+		auto it = m_nodes.find(dep);
+		if(it == m_nodes.end())
+			continue;
+		it->second.dependents.erase(asset);
+		RemoveNodeIfOrphaned(dep);
+	}
+	node.dependencies.clear();
+}
+void pragma::material::AssetDependencyGraph::RemoveNodeIfOrphaned(const AssetId &asset)
+{
+	auto it = m_nodes.find(asset);
+	if(it != m_nodes.end() && it->second.dependencies.empty() && it->second.dependents.empty())
+		m_nodes.erase(it);
+}
+void pragma::material::AssetDependencyGraph::SetDependencies(const AssetId &asset, const std::vector<AssetId> &dependencies)
+{
+	std::unique_lock lock {m_mutex};
+	auto &node = m_nodes[asset];
+	// Former dependencies are kept even if they're orphaned now, so they can still be collected (and evicted) by CollectUnused
+	for(auto &dep : node.dependencies) {
+		auto it = m_nodes.find(dep);
+		if(it != m_nodes.end())
+			it->second.dependents.erase(asset);
+	}
+	node.dependencies.clear();
+	for(auto &dep : dependencies) {
+		if(dep == asset)
+			continue;
+		node.dependencies.insert(dep);
+		m_nodes[dep].dependents.insert(asset);
+	}
+}
+void pragma::material::AssetDependencyGraph::AddDependency(const AssetId &asset, const AssetId &dependency)
+{
+	if(asset == dependency)
+		return;
+	std::unique_lock lock {m_mutex};
+	m_nodes[dependency].dependents.insert(asset);
+	m_nodes[asset].dependencies.insert(dependency);
+}
+void pragma::material::AssetDependencyGraph::RemoveAsset(const AssetId &asset)
+{
+	std::unique_lock lock {m_mutex};
+	auto it = m_nodes.find(asset);
+	if(it == m_nodes.end())
+		return;
+	RemoveOutgoingEdges(asset, it->second);
+	RemoveNodeIfOrphaned(asset);
+}
+void pragma::material::AssetDependencyGraph::Clear()
+{
+	std::unique_lock lock {m_mutex};
+	m_nodes.clear();
+}
+bool pragma::material::AssetDependencyGraph::HasAsset(const AssetId &asset) const
+{
+	std::unique_lock lock {m_mutex};
+	return m_nodes.find(asset) != m_nodes.end();
+}
+std::vector<pragma::material::AssetDependencyGraph::AssetId> pragma::material::AssetDependencyGraph::GetDependencies(const AssetId &asset) const
+{
+	std::unique_lock lock {m_mutex};
+	auto it = m_nodes.find(asset);
+	if(it == m_nodes.end())
+		return {};
+	return {it->second.dependencies.begin(), it->second.dependencies.end()};
+}
+std::vector<pragma::material::AssetDependencyGraph::AssetId> pragma::material::AssetDependencyGraph::GetDependents(const AssetId &asset) const
+{
+	std::unique_lock lock {m_mutex};
+	auto it = m_nodes.find(asset);
+	if(it == m_nodes.end())
+		return {};
+	return {it->second.dependents.begin(), it->second.dependents.end()};
+}
+std::vector<pragma::material::AssetDependencyGraph::AssetId> pragma::material::AssetDependencyGraph::GetTransitiveDependents(const AssetId &asset) const
+{
+	std::unique_lock lock {m_mutex};
+	std::vector<AssetId> result;
+	std::unordered_set<AssetId, AssetIdHash> traversed {asset};
+	std::queue<AssetId> queue;
+	queue.push(asset);
+	while(!queue.empty()) {
+		auto id = std::move(queue.front());
+		queue.pop();
+		auto it = m_nodes.find(id);
+		if(it == m_nodes.end())
+			continue;
+		for(auto &dependent : it->second.dependents) {
+			if(!traversed.insert(dependent).second)
+				continue; // Already traversed (or cyclic dependency)
+			result.push_back(dependent);
+			queue.push(dependent);
+		}
+	}
+	return result;
+}
+std::vector<pragma::material::AssetDependencyGraph::AssetId> pragma::material::AssetDependencyGraph::CollectUnused(const std::function<bool(const AssetId &)> &isInUse)
+{
+	std::unique_lock lock {m_mutex};
+	std::vector<AssetId> removed;
+	std::vector<AssetId> candidates;
+	candidates.reserve(m_nodes.size());
+	for(auto &[id, node] : m_nodes) {
+		if(node.dependents.empty())
+			candidates.push_back(id);
+	}
+	while(!candidates.empty()) {
+		auto id = std::move(candidates.back());
+		candidates.pop_back();
+		auto it = m_nodes.find(id);
+		if(it == m_nodes.end() || !it->second.dependents.empty() || isInUse(id))
+			continue;
+		auto dependencies = std::move(it->second.dependencies);
+		m_nodes.erase(it);
+		for(auto &dep : dependencies) {
+			auto itDep = m_nodes.find(dep);
+			if(itDep == m_nodes.end())
+				continue;
+			itDep->second.dependents.erase(id);
+			if(itDep->second.dependents.empty())
+				candidates.push_back(dep);
+		}
+		removed.push_back(std::move(id));
+	}
+	return removed;
+}
+void pragma::material::AssetDependencyGraph::ExportDot(std::ostream &out) const
+{
+	std::unique_lock lock {m_mutex};
+	auto getNodeName = [](const AssetId &id) -> std::string { return std::string {(id.type == AssetType::Material) ? "material:" : "texture:"} + id.name; };
+	out << "digraph assets {\n";
+	for(auto &[id, node] : m_nodes) {
+		out << "\t\"" << getNodeName(id) << "\" [shape=" << ((id.type == AssetType::Material) ? "box" : "ellipse") << "];\n";
+		for(auto &dep : node.dependencies)
+			out << "\t\"" << getNodeName(id) << "\" -> \"" << getNodeName(dep) << "\";\n";
+	}
+	out << "}\n";
+}
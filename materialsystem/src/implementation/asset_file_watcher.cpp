@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+module pragma.materialsystem;
+
+import :asset_file_watcher;
+
+std::unique_ptr<pragma::material::AssetFileWatcher> pragma::material::AssetFileWatcher::Create(std::chrono::milliseconds debounceTime)
+{
+	auto watcher = std::unique_ptr<AssetFileWatcher> {new AssetFileWatcher {debounceTime}};
+	if(!watcher->IsValid())
+		return nullptr;
+	return watcher;
+}
+pragma::material::AssetFileWatcher::AssetFileWatcher(std::chrono::milliseconds debounceTime) : m_debounceTime {debounceTime}
+{
+#ifdef __linux__
+	m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+pragma::material::AssetFileWatcher::~AssetFileWatcher()
+{
+#ifdef __linux__
+	if(m_fd != -1)
+		close(m_fd);
+#endif
+}
+bool pragma::material::AssetFileWatcher::IsValid() const { return m_fd != -1; }
+bool pragma::material::AssetFileWatcher::AddWatch(const std::string &rootPath, const std::string &relativePath)
+{
+#ifdef __linux__
+	auto path = relativePath.empty() ? rootPath : (rootPath + '/' + relativePath);
+	auto wd = inotify_add_watch(m_fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if(wd == -1)
+		return false;
+	m_watches[wd] = {rootPath, relativePath};
+	return true;
+#else
+	return false;
+#endif
+}
+bool pragma::material::AssetFileWatcher::AddDirectory(const std::string &path)
+{
+	if(!IsValid())
+		return false;
+	auto rootPath = path;
+	std::replace(rootPath.begin(), rootPath.end(), '\\', '/');
+	while(!rootPath.empty() && rootPath.back() == '/')
+		rootPath.pop_back();
+	if(!AddWatch(rootPath, ""))
+		return false;
+	std::error_code ec;
+	for(auto it = std::filesystem::recursive_directory_iterator {rootPath, ec}; !ec && it != std::filesystem::recursive_directory_iterator {}; it.increment(ec)) {
+		if(!it->is_directory(ec))
+			continue;
+		AddWatch(rootPath, std::filesystem::relative(it->path(), rootPath, ec).generic_string());
+	}
+	return true;
+}
+void pragma::material::AssetFileWatcher::AddHandler(const std::vector<std::string> &extensions, const ReloadHandler &handler)
+{
+	for(auto ext : extensions) {
+		pragma::string::to_lower(ext);
+		m_handlers[ext].push_back(handler);
+	}
+}
+void pragma::material::AssetFileWatcher::OnFileChanged(const std::string &relativePath)
+{
+	// Editors usually write a file in several steps, so we only record the time of the most recent change here
+	m_pendingChanges[relativePath] = std::chrono::steady_clock::now();
+}
+void pragma::material::AssetFileWatcher::ReadEvents()
+{
+#ifdef __linux__
+	alignas(inotify_event) std::array<char, 4'096> buf;
+	for(;;) {
+		auto len = read(m_fd, buf.data(), buf.size());
+		if(len <= 0)
+			break;
+		for(auto *ptr = buf.data(); ptr < buf.data() + len;) {
+			auto &ev = *reinterpret_cast<const inotify_event *>(ptr);
+			ptr += sizeof(inotify_event) + ev.len;
+			auto it = m_watches.find(ev.wd);
+			if(it == m_watches.end() || ev.len == 0)
+				continue;
+			auto &watchInfo = it->second;
+			std::string name = ev.name;
+			auto relPath = watchInfo.relativePath.empty() ? name : (watchInfo.relativePath + '/' + name);
+			if((ev.mask & IN_ISDIR) != 0) {
+				// New sub-directory, which needs to be watched as well
+				if((ev.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+					AddWatch(watchInfo.rootPath, relPath);
+				continue;
+			}
+			// Files that have just been created are still being written, we'll get an IN_CLOSE_WRITE event for them later
+			if((ev.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0)
+				OnFileChanged(relPath);
+		}
+	}
+#endif
+}
+void pragma::material::AssetFileWatcher::Poll()
+{
+	if(!IsValid())
+		return;
+	ReadEvents();
+	if(m_pendingChanges.empty())
+		return;
+	auto t = std::chrono::steady_clock::now();
+	std::vector<std::string> changedFiles;
+	for(auto it = m_pendingChanges.begin(); it != m_pendingChanges.end();) {
+		if(t - it->second < m_debounceTime) {
+			++it;
+			continue;
+		}
+		changedFiles.push_back(it->first);
+		it = m_pendingChanges.erase(it);
+	}
+	for(auto &relPath : changedFiles) {
+		std::string ext;
+		ufile::get_extension(relPath, &ext);
+		if(ext.empty())
+			continue;
+		pragma::string::to_lower(ext);
+		auto it = m_handlers.find(ext);
+		if(it == m_handlers.end())
+			continue;
+		auto identifier = relPath.substr(0, relPath.length() - ext.length() - 1);
+		pragma::string::to_lower(identifier);
+		for(auto &handler : it->second)
+			handler(identifier, ext);
+	}
+}
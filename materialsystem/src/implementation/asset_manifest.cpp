@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.materialsystem;
+
+import :asset_manifest;
+
+std::shared_ptr<pragma::material::AssetManifest> pragma::material::AssetManifest::Load(const std::string &fileName, std::string &outErr)
+{
+	auto f = fs::open_file(fileName, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return nullptr;
+	}
+	std::shared_ptr<udm::Data> udmData = nullptr;
+	try {
+		udmData = udm::Data::Load(f);
+	}
+	catch(const udm::Exception &e) {
+		outErr = e.what();
+		return nullptr;
+	}
+	if(udmData == nullptr) {
+		outErr = "Unable to load UDM data!";
+		return nullptr;
+	}
+	auto manifest = std::make_shared<AssetManifest>();
+	if(!manifest->Load(udmData->GetAssetData(), outErr))
+		return nullptr;
+	return manifest;
+}
+
+bool pragma::material::AssetManifest::AddEntry(const Entry &entry)
+{
+	if(!m_ids.insert(entry.id).second)
+		return false;
+	m_entries.push_back(entry);
+	return true;
+}
+bool pragma::material::AssetManifest::HasEntry(const AssetDependencyGraph::AssetId &id) const { return m_ids.find(id) != m_ids.end(); }
+void pragma::material::AssetManifest::Clear()
+{
+	m_entries.clear();
+	m_ids.clear();
+}
+
+bool pragma::material::AssetManifest::Save(udm::AssetData outData, std::string &outErr) const
+{
+	outData.SetAssetType(PMAN_IDENTIFIER);
+	outData.SetAssetVersion(PMAN_VERSION);
+	auto udm = *outData;
+	auto udmEntries = udm.AddArray("entries", m_entries.size(), udm::Type::Element);
+	for(auto i = decltype(m_entries.size()) {0u}; i < m_entries.size(); ++i) {
+		auto &entry = m_entries[i];
+		auto udmEntry = udmEntries[i];
+		udmEntry["type"] = std::string {(entry.id.type == AssetDependencyGraph::AssetType::Material) ? "material" : "texture"};
+		udmEntry["name"] = entry.id.name;
+		udmEntry["path"] = entry.filePath;
+		udmEntry["size"] = entry.fileSize;
+	}
+	return true;
+}
+bool pragma::material::AssetManifest::Save(const std::string &fileName, std::string &outErr) const
+{
+	auto udmData = udm::Data::Create();
+	if(!Save(udmData->GetAssetData(), outErr))
+		return false;
+	std::string ext;
+	auto binary = ufile::get_extension(fileName, &ext) && ext == FORMAT_MANIFEST_BINARY;
+	fs::create_path(ufile::get_path_from_filename(fileName));
+	auto f = fs::open_file<fs::VFilePtrReal>(fileName, binary ? (fs::FileMode::Write | fs::FileMode::Binary) : fs::FileMode::Write);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return false;
+	}
+	auto result = binary ? udmData->Save(f) : udmData->SaveAscii(f, udm::AsciiSaveFlags::None);
+	if(result == false) {
+		outErr = "Unable to save UDM data!";
+		return false;
+	}
+	return true;
+}
+bool pragma::material::AssetManifest::Load(const udm::AssetData &data, std::string &outErr)
+{
+	if(data.GetAssetType() != PMAN_IDENTIFIER) {
+		outErr = "Incorrect format!";
+		return false;
+	}
+	if(data.GetAssetVersion() < 1) {
+		outErr = "Invalid version!";
+		return false;
+	}
+	Clear();
+	auto udm = *data;
+	auto udmEntries = udm["entries"];
+	auto n = udmEntries.GetSize();
+	m_entries.reserve(n);
+	for(auto i = decltype(n) {0u}; i < n; ++i) {
+		auto udmEntry = udmEntries[i];
+		Entry entry {};
+		std::string type;
+		udmEntry["type"](type);
+		if(type == "material")
+			entry.id.type = AssetDependencyGraph::AssetType::Material;
+		else if(type == "texture")
+			entry.id.type = AssetDependencyGraph::AssetType::Texture;
+		else
+			continue;
+		udmEntry["name"](entry.id.name);
+		udmEntry["path"](entry.filePath);
+		udmEntry["size"](entry.fileSize);
+		if(entry.id.name.empty())
+			continue;
+		AddEntry(entry);
+	}
+	return true;
+}
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.materialsystem;
+
+import :continuation;
+
+pragma::material::ContinuationHandle::ContinuationHandle(const std::shared_ptr<std::atomic<bool>> &cancelled) : m_cancelled {cancelled} {}
+void pragma::material::ContinuationHandle::Cancel()
+{
+	if(m_cancelled)
+		*m_cancelled = true;
+}
+bool pragma::material::ContinuationHandle::IsCancelled() const { return m_cancelled && *m_cancelled; }
+bool pragma::material::ContinuationHandle::IsValid() const { return m_cancelled && !*m_cancelled; }
+
+static std::mutex g_mainThreadCallbackMutex;
+static std::vector<std::function<void()>> g_mainThreadCallbacks;
+void pragma::material::queue_main_thread_callback(const std::function<void()> &f)
+{
+	std::scoped_lock lock {g_mainThreadCallbackMutex};
+	g_mainThreadCallbacks.push_back(f);
+}
+void pragma::material::dispatch_main_thread_callbacks()
+{
+	// Callbacks may queue further callbacks, which will be executed during the next dispatch
+	std::vector<std::function<void()>> callbacks;
+	{
+		std::scoped_lock lock {g_mainThreadCallbackMutex};
+		callbacks = std::move(g_mainThreadCallbacks);
+		g_mainThreadCallbacks.clear();
+	}
+	for(auto &f : callbacks)
+		f();
+}
@@ -6,6 +6,8 @@ module;
 module pragma.materialsystem;
 
 import :format_handlers.source2_vmat;
+import :format_handlers.source2_vmat_mapping;
+import :material_manager2;
 import :vmat;
 
 #ifndef DISABLE_VMAT_SUPPORT
@@ -14,18 +16,41 @@ import source2;
 pragma::material::Source2VmatFormatHandler::Source2VmatFormatHandler(pragma::util::IAssetManager &assetManager) : IImportAssetFormatHandler {assetManager} {}
 bool pragma::material::Source2VmatFormatHandler::Import(const std::string &outputPath, std::string &outFilePath)
 {
-	auto resource = source2::load_resource(*m_file);
-	return resource ? LoadVMat(*resource, outputPath, outFilePath) : false;
+	auto size = m_file->GetSize();
+	std::vector<uint8_t> data;
+	data.resize(size);
+	if(size > 0)
+		size = m_file->Read(data.data(), size);
+	data.resize(size);
+	// The contents are only read to identify the version of the source file, the resource parser reads the file itself
+	m_file->Seek(0);
+
+	// Failed imports are not retried until the vmat has changed, parsing the resource is expensive
+	auto &diagnostics = static_cast<MaterialManager &>(GetAssetManager()).GetImportDiagnostics();
+	return diagnostics.Execute(create_import_record(*m_file, "vmat_c", outputPath, data.data(), data.size()), m_error, [this, &data, &outputPath, &outFilePath]() -> ImportErrorClass {
+		if(data.empty())
+			return ImportErrorClass::ReadError;
+		auto resource = source2::load_resource(*m_file);
+		if(!resource) {
+			m_error = "Failed to parse Source 2 resource!";
+			return ImportErrorClass::ParseError;
+		}
+		if(!LoadVMat(*resource, outputPath, outFilePath))
+			return (m_errorClass != ImportErrorClass::None) ? m_errorClass : ImportErrorClass::ConversionError;
+		return ImportErrorClass::None;
+	});
 }
 bool pragma::material::Source2VmatFormatHandler::LoadVMat(source2::resource::Resource &resource, const std::string &outputPath, std::string &outFilePath)
 {
 	auto *s2Mat = dynamic_cast<source2::resource::Material *>(resource.FindBlock(source2::BlockType::DATA));
-	if(s2Mat == nullptr)
+	if(s2Mat == nullptr) {
+		m_error = "Resource does not contain any material data!";
+		m_errorClass = ImportErrorClass::InvalidData;
 		return false;
-	auto dataSettings = datasystem::create_data_settings({});
+	}
+	auto &dataSettings = get_shared_data_settings();
 	auto root = std::make_shared<datasystem::Block>(*dataSettings);
 
-	std::string shaderName = "pbr";
 	auto fLoadTexture = [this](const std::string &strPath) -> std::string {
 		std::string inputPath;
 		auto outputPath = vmat::get_vmat_texture_path(strPath, &inputPath);
@@ -46,93 +71,19 @@ bool pragma::material::Source2VmatFormatHandler::LoadVMat(source2::resource::Res
 	if(aoMap)
 		fLoadTexture(*aoMap);
 
-	auto origin = VMatOrigin::Source2;
-	if(s2Mat->GetShaderName() == "vr_simple_2way_blend.vfx") {
-		shaderName = "pbr_blend";
-		auto *albedoMapA = s2Mat->FindTextureParam("g_tColorA");
-		auto *albedoMapB = s2Mat->FindTextureParam("g_tColorB");
-
-		if(albedoMapA)
-			root->AddData(ematerial::ALBEDO_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMapA)));
-		if(albedoMapB)
-			root->AddData(ematerial::ALBEDO_MAP2_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMapB)));
-
-		auto *normalMapA = s2Mat->FindTextureParam("g_tNormalA");
-		auto *normalMapB = s2Mat->FindTextureParam("g_tNormalB");
-
-		if(normalMapA)
-			root->AddData(ematerial::NORMAL_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*normalMapA)));
-
-		auto *metalnessA = s2Mat->FindFloatParam("g_flMetalnessA");
-		auto *metalnessB = s2Mat->FindFloatParam("g_flMetalnessB");
-
-		if(metalnessA)
-			root->AddValue("float", "metalness_factor", util::to_string(*metalnessA));
-
-		auto *roughnessA = s2Mat->FindVectorParam("TextureRoughnessA");
-		auto *roughnessB = s2Mat->FindVectorParam("TextureRoughnessB");
-
-		// TODO: Vector roughness?
-		//if(roughnessA)
-		//	root->AddValue("float","roughness_factor",util::to_string(*roughnessA));
-
-		// TODO: Add support for secondary normal map / metalness / roughness
-	}
-	else if(s2Mat->GetShaderName() == "vr_cilia.vfx") {
-		// TODO: Can these have a ColorB/NormalB/etc??
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColorA");
-		if(albedoMap)
-			root->AddData(ematerial::ALBEDO_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormalA");
-		if(normalMap)
-			root->AddData(ematerial::NORMAL_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-
-		auto *metalness = s2Mat->FindFloatParam("g_flMetalnessA");
-		if(metalness)
-			root->AddValue("float", "metalness_factor", util::to_string(*metalness));
-
-		auto *textureColor = s2Mat->FindVectorParam("TextureColorA");
-		// TODO
-	}
-	else if(s2Mat->GetShaderName() == "hero.vfx") {
-		origin = VMatOrigin::Dota2;
-		// Dota 2
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColor");
-		if(albedoMap)
-			root->AddData(ematerial::ALBEDO_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormal");
-		if(normalMap)
-			root->AddData(ematerial::NORMAL_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-#if 0
-		// TODO
-		+		["g_tMasks1"]	("g_tMasks1", "materials/models/courier/drodo/drodo_detailmask_tga_bcdebe17.vtex")	std::pair<std::basic_string<char,std::char_traits<char>,std::allocator<char> > const ,std::basic_string<char,std::char_traits<char>,std::allocator<char> > >
-		+		["g_tMasks2"]	("g_tMasks2", "materials/models/courier/drodo/drodo_specmask_tga_cff5ad3a.vtex")	std::pair<std::basic_string<char,std::char_traits<char>,std::allocator<char> > const ,std::basic_string<char,std::char_traits<char>,std::allocator<char> > >
-#endif
-	}
-	else {
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColor");
-		if(albedoMap == nullptr)
-			albedoMap = s2Mat->FindTextureParam("g_tColor1");
-		if(albedoMap == nullptr)
-			albedoMap = s2Mat->FindTextureParam("g_tColor2");
-		if(albedoMap)
-			root->AddData(ematerial::ALBEDO_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormal");
-		if(normalMap)
-			root->AddData(ematerial::NORMAL_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-
-		auto *emissionMap = s2Mat->FindTextureParam("g_tSelfIllumMask");
-		if(emissionMap)
-			root->AddData(ematerial::EMISSION_MAP_IDENTIFIER, pragma::util::make_shared<datasystem::Texture>(*dataSettings, fLoadTexture(*emissionMap)));
-
-		auto *metalness = s2Mat->FindFloatParam("g_flMetalness");
-		if(metalness)
-			root->AddValue("float", "metalness_factor", util::to_string(*metalness));
-		// TODO: Is there an attribute like this for roughness?
+	auto *mapping = find_source2_vmat_shader_mapping(s2Mat->GetShaderName());
+	Source2VmatImportReport report {};
+	report.fileName = outputPath;
+	report.shader = s2Mat->GetShaderName();
+	if(mapping == nullptr) {
+		mapping = &get_default_source2_vmat_shader_mapping();
+		report.unknownShader = true;
 	}
+	auto shaderName = mapping->materialShader;
+	auto origin = mapping->origin;
+	apply_source2_vmat_shader_mapping(*mapping, *s2Mat, *root, *dataSettings, fLoadTexture);
+	report.unmappedParameters = find_unmapped_source2_vmat_parameters(*mapping, *s2Mat);
+	report_source2_vmat_import(report);
 
 	if(!InitializeVMatData(resource, *s2Mat, *root, *dataSettings, shaderName, origin))
 		return false;
@@ -143,6 +94,7 @@ bool pragma::material::Source2VmatFormatHandler::LoadVMat(source2::resource::Res
 	outFilePath = outputPath + ".pmat";
 	if(!mat->Save(outFilePath, err, true)) {
 		m_error = std::move(err);
+		m_errorClass = ImportErrorClass::SaveError;
 		return false;
 	}
 	return true;
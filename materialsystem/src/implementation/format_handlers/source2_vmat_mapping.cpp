@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.materialsystem;
+
+import :format_handlers.source2_vmat_mapping;
+import :material;
+
+#ifndef DISABLE_VMAT_SUPPORT
+import source2;
+
+using ValueType = pragma::material::Source2VmatShaderMapping::ValueMapping::Type;
+
+// Parameters that are evaluated for all shaders (see Source2VmatFormatHandler::LoadVMat and the client-side import)
+static const std::vector<std::string> g_sharedParameters = {"g_tAmbientOcclusion", "F_ALPHA_TEST", "F_TRANSLUCENT", "F_SPECULAR"};
+
+static std::vector<pragma::material::Source2VmatShaderMapping> create_mappings()
+{
+	using Mapping = pragma::material::Source2VmatShaderMapping;
+	namespace ematerial = pragma::material::ematerial;
+	std::vector<Mapping> mappings;
+
+	// SteamVR (The Lab, SteamVR Home). The client-side import decomposes the metalness-reflectance map into an RMA map.
+	{
+		Mapping mapping {};
+		mapping.name = "steamvr_standard";
+		mapping.shaders = {"vr_standard.vfx"};
+		mapping.origin = pragma::material::VMatOrigin::SteamVR;
+		mapping.textures = {
+		  {{"g_tColor"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+		  {{"g_tNormal"}, ematerial::NORMAL_MAP_IDENTIFIER},
+		  {{"g_tSelfIllumMask"}, ematerial::EMISSION_MAP_IDENTIFIER},
+		};
+		mapping.values = {
+		  {"g_flMetalness", "metalness_factor", ValueType::Float, "g_tMetalnessReflectance"},
+		};
+		mapping.knownParameters = {"g_tMetalnessReflectance", "TextureColor", "TextureNormal", "TextureMetalnessReflectance"};
+		mappings.push_back(std::move(mapping));
+	}
+	{
+		Mapping mapping {};
+		mapping.name = "steamvr_2way_blend";
+		mapping.shaders = {"vr_simple_2way_blend.vfx"};
+		mapping.materialShader = "pbr_blend";
+		mapping.textures = {
+		  {{"g_tColorA"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+		  {{"g_tColorB"}, ematerial::ALBEDO_MAP2_IDENTIFIER},
+		  {{"g_tNormalA"}, ematerial::NORMAL_MAP_IDENTIFIER},
+		  {{"g_tNormalB"}, "normal_map2"},
+		};
+		// The roughness is stored in the alpha channel of the normal maps, the constant is only used if there is no normal map
+		mapping.values = {
+		  {"g_flMetalnessA", "metalness_factor", ValueType::Float},
+		  {"g_flMetalnessB", "metalness_factor2", ValueType::Float},
+		  {"TextureRoughnessA", "roughness_factor", ValueType::VectorX, "g_tNormalA"},
+		  {"TextureRoughnessB", "roughness_factor2", ValueType::VectorX, "g_tNormalB"},
+		};
+		mapping.knownParameters = {"TextureColorA", "TextureColorB", "TextureNormalA", "TextureNormalB"};
+		mappings.push_back(std::move(mapping));
+	}
+	{
+		Mapping mapping {};
+		mapping.name = "steamvr_cilia";
+		mapping.shaders = {"vr_cilia.vfx"};
+		mapping.textures = {
+		  {{"g_tColorA"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+		  {{"g_tNormalA"}, ematerial::NORMAL_MAP_IDENTIFIER},
+		};
+		mapping.values = {
+		  {"g_flMetalnessA", "metalness_factor", ValueType::Float},
+		  {"TextureRoughnessA", "roughness_factor", ValueType::VectorX, "g_tNormalA"},
+		};
+		// The texture constants are already baked into the textures
+		mapping.knownParameters = {"TextureColorA", "TextureNormalA"};
+		mappings.push_back(std::move(mapping));
+	}
+
+	// Dota 2. The client-side import generates the RMA map from the mask textures.
+	{
+		Mapping mapping {};
+		mapping.name = "dota2_hero";
+		mapping.shaders = {"hero.vfx"};
+		mapping.origin = pragma::material::VMatOrigin::Dota2;
+		mapping.textures = {
+		  {{"g_tColor"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+		  {{"g_tNormal"}, ematerial::NORMAL_MAP_IDENTIFIER},
+		};
+		mapping.knownParameters = {"g_tMasks1", "g_tMasks2"};
+		mappings.push_back(std::move(mapping));
+	}
+	{
+		Mapping mapping {};
+		mapping.name = "dota2_global_lit_simple";
+		mapping.shaders = {"global_lit_simple.vfx"};
+		mapping.origin = pragma::material::VMatOrigin::Dota2;
+		mapping.textures = {
+		  {{"g_tColor"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+		  {{"g_tNormal"}, ematerial::NORMAL_MAP_IDENTIFIER},
+		};
+		mapping.knownParameters = {"g_tMasks1", "g_tMasks2"};
+		mappings.push_back(std::move(mapping));
+	}
+	return mappings;
+}
+
+static pragma::material::Source2VmatShaderMapping create_default_mapping()
+{
+	namespace ematerial = pragma::material::ematerial;
+	pragma::material::Source2VmatShaderMapping mapping {};
+	mapping.name = "source2_generic";
+	mapping.textures = {
+	  {{"g_tColor", "g_tColor1", "g_tColor2"}, ematerial::ALBEDO_MAP_IDENTIFIER},
+	  {{"g_tNormal"}, ematerial::NORMAL_MAP_IDENTIFIER},
+	  {{"g_tSelfIllumMask"}, ematerial::EMISSION_MAP_IDENTIFIER},
+	};
+	mapping.values = {
+	  {"g_flMetalness", "metalness_factor", ValueType::Float},
+	};
+	mapping.knownParameters = {"TextureColor", "TextureNormal", "TextureRoughness"};
+	return mapping;
+}
+
+bool pragma::material::Source2VmatShaderMapping::IsKnownParameter(const std::string &parameter) const
+{
+	auto matches = [&parameter](const std::string &other) { return pragma::string::compare<std::string_view>(parameter, other, false); };
+	if(std::find_if(g_sharedParameters.begin(), g_sharedParameters.end(), matches) != g_sharedParameters.end())
+		return true;
+	if(std::find_if(knownParameters.begin(), knownParameters.end(), matches) != knownParameters.end())
+		return true;
+	for(auto &texMapping : textures) {
+		if(std::find_if(texMapping.parameters.begin(), texMapping.parameters.end(), matches) != texMapping.parameters.end())
+			return true;
+	}
+	return std::find_if(values.begin(), values.end(), [&matches](const ValueMapping &valMapping) { return matches(valMapping.parameter); }) != values.end();
+}
+
+static pragma::material::Source2VmatImportReportCallback g_reportCallback = nullptr;
+static std::mutex g_reportCallbackMutex;
+static std::atomic<bool> g_reportWarningsEnabled = false;
+void pragma::material::set_source2_vmat_import_report_callback(const Source2VmatImportReportCallback &callback)
+{
+	std::scoped_lock lock {g_reportCallbackMutex};
+	g_reportCallback = callback;
+}
+void pragma::material::set_source2_vmat_import_report_warnings_enabled(bool enabled) { g_reportWarningsEnabled = enabled; }
+bool pragma::material::are_source2_vmat_import_report_warnings_enabled() { return g_reportWarningsEnabled; }
+void pragma::material::report_source2_vmat_import(const Source2VmatImportReport &report)
+{
+	if(report.IsEmpty())
+		return;
+	Source2VmatImportReportCallback callback;
+	{
+		std::scoped_lock lock {g_reportCallbackMutex};
+		callback = g_reportCallback;
+	}
+	if(callback) {
+		callback(report);
+		return;
+	}
+	if(!g_reportWarningsEnabled)
+		return;
+	std::stringstream ss;
+	ss << "WARNING: Incomplete import of Source 2 material '" << report.fileName << "' (shader '" << report.shader << "'):";
+	if(report.unknownShader)
+		ss << " Unknown shader, generic mapping has been used.";
+	if(!report.unmappedParameters.empty()) {
+		ss << " Unmapped parameters:";
+		for(auto &param : report.unmappedParameters)
+			ss << " " << param.name << "=" << param.value;
+	}
+	std::cout << ss.str() << std::endl;
+}
+
+const std::vector<pragma::material::Source2VmatShaderMapping> &pragma::material::get_source2_vmat_shader_mappings()
+{
+	static auto mappings = create_mappings();
+	return mappings;
+}
+const pragma::material::Source2VmatShaderMapping &pragma::material::get_default_source2_vmat_shader_mapping()
+{
+	static auto mapping = create_default_mapping();
+	return mapping;
+}
+const pragma::material::Source2VmatShaderMapping *pragma::material::find_source2_vmat_shader_mapping(const std::string &shader)
+{
+	for(auto &mapping : get_source2_vmat_shader_mappings()) {
+		auto it = std::find_if(mapping.shaders.begin(), mapping.shaders.end(), [&shader](const std::string &other) { return pragma::string::compare<std::string_view>(shader, other, false); });
+		if(it != mapping.shaders.end())
+			return &mapping;
+	}
+	return nullptr;
+}
+
+void pragma::material::apply_source2_vmat_shader_mapping(const Source2VmatShaderMapping &mapping, source2::resource::Material &vmat, datasystem::Block &rootData, datasystem::Settings &settings, const std::function<std::string(const std::string &)> &loadTexture)
+{
+	for(auto &texMapping : mapping.textures) {
+		for(auto &param : texMapping.parameters) {
+			auto *texPath = vmat.FindTextureParam(param);
+			if(!texPath)
+				continue;
+			rootData.AddData(texMapping.key, pragma::util::make_shared<datasystem::Texture>(settings, loadTexture(*texPath)));
+			break;
+		}
+	}
+	for(auto &valMapping : mapping.values) {
+		if(!valMapping.unlessTexture.empty() && vmat.FindTextureParam(valMapping.unlessTexture))
+			continue;
+		switch(valMapping.type) {
+		case ValueType::Float:
+			{
+				auto *value = vmat.FindFloatParam(valMapping.parameter);
+				if(value)
+					rootData.AddValue("float", valMapping.key, util::to_string(*value));
+				break;
+			}
+		case ValueType::Int:
+			{
+				auto *value = vmat.FindIntParam(valMapping.parameter);
+				if(value)
+					rootData.AddValue("int", valMapping.key, std::to_string(*value));
+				break;
+			}
+		case ValueType::VectorX:
+			{
+				auto *value = vmat.FindVectorParam(valMapping.parameter);
+				if(value)
+					rootData.AddValue("float", valMapping.key, util::to_string(value->x));
+				break;
+			}
+		case ValueType::Vector3:
+			{
+				auto *value = vmat.FindVectorParam(valMapping.parameter);
+				if(value)
+					rootData.AddValue("vector", valMapping.key, util::to_string(value->x) + ' ' + util::to_string(value->y) + ' ' + util::to_string(value->z));
+				break;
+			}
+		case ValueType::Vector4:
+			{
+				auto *value = vmat.FindVectorParam(valMapping.parameter);
+				if(value)
+					rootData.AddValue("vector4", valMapping.key, util::to_string(value->x) + ' ' + util::to_string(value->y) + ' ' + util::to_string(value->z) + ' ' + util::to_string(value->w));
+				break;
+			}
+		}
+	}
+}
+
+std::vector<pragma::material::Source2VmatImportReport::Parameter> pragma::material::find_unmapped_source2_vmat_parameters(const Source2VmatShaderMapping &mapping, source2::resource::Material &vmat)
+{
+	using ParameterType = Source2VmatImportReport::ParameterType;
+	std::vector<Source2VmatImportReport::Parameter> params;
+	for(auto &[name, value] : vmat.GetIntParams()) {
+		if(!mapping.IsKnownParameter(name))
+			params.push_back({ParameterType::Int, name, std::to_string(value)});
+	}
+	for(auto &[name, value] : vmat.GetFloatParams()) {
+		if(!mapping.IsKnownParameter(name))
+			params.push_back({ParameterType::Float, name, util::to_string(value)});
+	}
+	for(auto &[name, value] : vmat.GetVectorParams()) {
+		if(!mapping.IsKnownParameter(name))
+			params.push_back({ParameterType::Vector, name, util::to_string(value.x) + ' ' + util::to_string(value.y) + ' ' + util::to_string(value.z) + ' ' + util::to_string(value.w)});
+	}
+	for(auto &[name, value] : vmat.GetTextureParams()) {
+		if(!mapping.IsKnownParameter(name))
+			params.push_back({ParameterType::Texture, name, value});
+	}
+	// The parameter containers are unordered, sort them to get a deterministic report
+	std::sort(params.begin(), params.end(), [](const Source2VmatImportReport::Parameter &a, const Source2VmatImportReport::Parameter &b) { return a.name < b.name; });
+	return params;
+}
+#endif
@@ -11,6 +11,7 @@ module;
 module pragma.materialsystem;
 
 import :format_handlers.source_vmt;
+import :material_manager2;
 import :vmt;
 
 #ifndef DISABLE_VMT_SUPPORT
@@ -132,7 +133,7 @@ bool pragma::material::ISourceVmtFormatHandler::LoadVMT(const IVmtNode &rootNode
 	auto bWater = false;
 	std::string shaderName;
 	std::shared_ptr<const IVmtNode> node = nullptr;
-	auto dataSettings = datasystem::create_data_settings({});
+	auto &dataSettings = get_shared_data_settings();
 	auto root = std::make_shared<datasystem::Block>(*dataSettings);
 	if(shader == "worldvertextransition")
 		shaderName = "pbr";
@@ -435,6 +436,7 @@ bool pragma::material::ISourceVmtFormatHandler::LoadVMT(const IVmtNode &rootNode
 	outFilePath = outputPath + ".pmat";
 	if(!mat->Save(outFilePath, err, true)) {
 		m_error = std::move(err);
+		m_errorClass = ImportErrorClass::SaveError;
 		return false;
 	}
 	return true;
@@ -573,23 +575,28 @@ static void merge_dx_node_values(VTFLib::Nodes::CVMTGroupNode &node)
 bool pragma::material::SourceVmtFormatHandler::Import(const std::string &outputPath, std::string &outFilePath)
 {
 	auto size = m_file->GetSize();
-	if(size == 0)
-		return false;
 	std::vector<uint8_t> data;
 	data.resize(size);
-	size = m_file->Read(data.data(), size);
-	if(size == 0)
-		return false;
+	if(size > 0)
+		size = m_file->Read(data.data(), size);
 	data.resize(size);
 
-	VTFLib::CVMTFile vmt {};
-	if(vmt.Load(data.data(), static_cast<vlUInt>(size)) != vlTrue) {
-		m_error = "VMT Parsing error in material: " + std::string {vlGetLastError()};
-		return false;
-	}
-	auto *vmtRoot = vmt.GetRoot();
-	merge_dx_node_values(*vmtRoot);
-	m_rootNode = std::make_shared<VtfLibVmtNode>(*vmtRoot);
-	return LoadVMT(*m_rootNode, outputPath, outFilePath);
+	// Failed imports are not retried until the vmt has changed
+	auto &diagnostics = static_cast<MaterialManager &>(GetAssetManager()).GetImportDiagnostics();
+	return diagnostics.Execute(create_import_record(*m_file, "vmt", outputPath, data.data(), data.size()), m_error, [this, &data, &outputPath, &outFilePath]() -> ImportErrorClass {
+		if(data.empty())
+			return ImportErrorClass::ReadError;
+		VTFLib::CVMTFile vmt {};
+		if(vmt.Load(data.data(), static_cast<vlUInt>(data.size())) != vlTrue) {
+			m_error = "VMT Parsing error in material: " + std::string {vlGetLastError()};
+			return ImportErrorClass::ParseError;
+		}
+		auto *vmtRoot = vmt.GetRoot();
+		merge_dx_node_values(*vmtRoot);
+		m_rootNode = std::make_shared<VtfLibVmtNode>(*vmtRoot);
+		if(!LoadVMT(*m_rootNode, outputPath, outFilePath))
+			return (m_errorClass != ImportErrorClass::None) ? m_errorClass : ImportErrorClass::ConversionError;
+		return ImportErrorClass::None;
+	});
 }
 #endif
@@ -10,6 +10,7 @@ module;
 module pragma.materialsystem;
 
 import :format_handlers.source_vmt;
+import :material_manager2;
 
 #ifndef DISABLE_VMT_SUPPORT
 #ifdef ENABLE_VKV_PARSER
@@ -108,27 +109,32 @@ pragma::material::SourceVmtFormatHandler2::SourceVmtFormatHandler2(pragma::util:
 bool pragma::material::SourceVmtFormatHandler2::Import(const std::string &outputPath, std::string &outFilePath)
 {
 	auto size = m_file->GetSize();
-	if(size == 0)
-		return false;
 	std::string data;
 	data.resize(size);
-	size = m_file->Read(data.data(), size);
-	if(size == 0)
-		return false;
+	if(size > 0)
+		size = m_file->Read(data.data(), size);
 	data.resize(size);
 
-	auto kvNode = ValveKeyValueFormat::parseKVBuffer(data);
-	if(!kvNode) {
-		auto fileName = m_file->GetFileName();
-		if(!fileName)
-			fileName = "UNKNOWN";
-		m_error = "Failed to parse VMT file data for file '" + *fileName + "'!";
-		return false;
-	}
-	auto *vmtRoot = kvNode.get();
-	merge_dx_node_values(*vmtRoot);
-	m_rootNode = pragma::util::make_shared<VkvNode>(*kvNode);
-	return LoadVMT(*m_rootNode, outputPath, outFilePath);
+	// Failed imports are not retried until the vmt has changed
+	auto &diagnostics = static_cast<MaterialManager &>(GetAssetManager()).GetImportDiagnostics();
+	return diagnostics.Execute(create_import_record(*m_file, "vmt", outputPath, data.data(), data.size()), m_error, [this, &data, &outputPath, &outFilePath]() -> ImportErrorClass {
+		if(data.empty())
+			return ImportErrorClass::ReadError;
+		auto kvNode = ValveKeyValueFormat::parseKVBuffer(data);
+		if(!kvNode) {
+			auto fileName = m_file->GetFileName();
+			if(!fileName)
+				fileName = "UNKNOWN";
+			m_error = "Failed to parse VMT file data for file '" + *fileName + "'!";
+			return ImportErrorClass::ParseError;
+		}
+		auto *vmtRoot = kvNode.get();
+		merge_dx_node_values(*vmtRoot);
+		m_rootNode = pragma::util::make_shared<VkvNode>(*kvNode);
+		if(!LoadVMT(*m_rootNode, outputPath, outFilePath))
+			return (m_errorClass != ImportErrorClass::None) ? m_errorClass : ImportErrorClass::ConversionError;
+		return ImportErrorClass::None;
+	});
 }
 
 std::string pragma::material::SourceVmtFormatHandler2::GetShader() const
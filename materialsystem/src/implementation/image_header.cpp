@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.materialsystem;
+
+import :image_header;
+import pragma.image;
+
+namespace {
+	// Serves reads from the probe buffer and only falls back to the file for data beyond it (e.g. JPG segments or vtex data blocks)
+	struct HeaderReader {
+		const uint8_t *data = nullptr;
+		size_t size = 0;
+		pragma::fs::VFilePtrInternal *file = nullptr;
+		bool Read(uint64_t offset, void *out, size_t n) const
+		{
+			if(offset + n <= size) {
+				std::memcpy(out, data + offset, n);
+				return true;
+			}
+			if(!file)
+				return false;
+			file->Seek(offset);
+			return file->Read(out, n) == n;
+		}
+		template<typename T>
+		bool Read(uint64_t offset, T &out) const
+		{
+			return Read(offset, &out, sizeof(T));
+		}
+	};
+}
+
+static uint16_t swap_bytes(uint16_t v) { return static_cast<uint16_t>((v >> 8) | (v << 8)); }
+static uint32_t swap_bytes(uint32_t v) { return ((v >> 24) & 0xFF) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24); }
+
+static bool parse_png_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	std::array<uint8_t, 26> header;
+	if(!reader.Read(0, header.data(), header.size()) || std::memcmp(header.data() + 12, "IHDR", 4) != 0)
+		return false;
+	uint32_t width, height;
+	std::memcpy(&width, header.data() + 16, sizeof(width));
+	std::memcpy(&height, header.data() + 20, sizeof(height));
+	outInfo.type = pragma::material::TextureType::PNG;
+	outInfo.width = swap_bytes(width);
+	outInfo.height = swap_bytes(height);
+	outInfo.format = header[25] | (header[24] << 8);
+	return true;
+}
+
+static bool parse_dds_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+	constexpr uint32_t DDPF_FOURCC = 0x4;
+	constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+	constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+	uint32_t flags, height, width, mipmapCount, pfFlags, fourCC, rgbBitCount, caps2;
+	if(!reader.Read(8, flags) || !reader.Read(12, height) || !reader.Read(16, width) || !reader.Read(28, mipmapCount) || !reader.Read(80, pfFlags) || !reader.Read(84, fourCC) || !reader.Read(88, rgbBitCount) || !reader.Read(112, caps2))
+		return false;
+	outInfo.type = pragma::material::TextureType::DDS;
+	outInfo.width = width;
+	outInfo.height = height;
+	outInfo.mipmapCount = ((flags & DDSD_MIPMAPCOUNT) != 0) ? std::max(mipmapCount, 1u) : 1u;
+	outInfo.cubemap = (caps2 & DDSCAPS2_CUBEMAP) != 0;
+	outInfo.layerCount = outInfo.cubemap ? 6 : 1;
+	outInfo.format = ((pfFlags & DDPF_FOURCC) != 0) ? fourCC : rgbBitCount;
+	if((pfFlags & DDPF_FOURCC) != 0 && std::memcmp(&fourCC, "DX10", 4) == 0) {
+		uint32_t dxgiFormat, miscFlag, arraySize;
+		if(!reader.Read(128, dxgiFormat) || !reader.Read(136, miscFlag) || !reader.Read(140, arraySize))
+			return false;
+		outInfo.format = dxgiFormat;
+		outInfo.cubemap = (miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0;
+		outInfo.layerCount = std::max(arraySize, 1u) * (outInfo.cubemap ? 6 : 1);
+	}
+	return true;
+}
+
+static bool parse_ktx_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	uint32_t endianness, internalFormat, width, height, arrayElements, faces, mipmapCount;
+	if(!reader.Read(12, endianness) || !reader.Read(28, internalFormat) || !reader.Read(36, width) || !reader.Read(40, height) || !reader.Read(48, arrayElements) || !reader.Read(52, faces) || !reader.Read(56, mipmapCount))
+		return false;
+	if(endianness == 0x01020304) {
+		internalFormat = swap_bytes(internalFormat);
+		width = swap_bytes(width);
+		height = swap_bytes(height);
+		arrayElements = swap_bytes(arrayElements);
+		faces = swap_bytes(faces);
+		mipmapCount = swap_bytes(mipmapCount);
+	}
+	else if(endianness != 0x04030201)
+		return false;
+	outInfo.type = pragma::material::TextureType::KTX;
+	outInfo.width = width;
+	outInfo.height = std::max(height, 1u);
+	outInfo.mipmapCount = std::max(mipmapCount, 1u);
+	outInfo.cubemap = (faces == 6);
+	outInfo.layerCount = std::max(arrayElements, 1u) * std::max(faces, 1u);
+	outInfo.format = internalFormat;
+	return true;
+}
+
+static bool parse_ktx2_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	uint32_t vkFormat, width, height, layerCount, faces, mipmapCount;
+	if(!reader.Read(12, vkFormat) || !reader.Read(20, width) || !reader.Read(24, height) || !reader.Read(32, layerCount) || !reader.Read(36, faces) || !reader.Read(40, mipmapCount))
+		return false;
+	outInfo.type = pragma::material::TextureType::KTX;
+	outInfo.width = width;
+	outInfo.height = std::max(height, 1u);
+	outInfo.mipmapCount = std::max(mipmapCount, 1u);
+	outInfo.cubemap = (faces == 6);
+	outInfo.layerCount = std::max(layerCount, 1u) * std::max(faces, 1u);
+	outInfo.format = vkFormat;
+	return true;
+}
+
+static bool parse_vtf_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	constexpr uint32_t TEXTUREFLAGS_ENVMAP = 0x4000;
+	uint16_t width, height;
+	uint32_t flags;
+	int32_t format;
+	uint8_t mipmapCount;
+	if(!reader.Read(16, width) || !reader.Read(18, height) || !reader.Read(20, flags) || !reader.Read(52, format) || !reader.Read(56, mipmapCount))
+		return false;
+	outInfo.type = pragma::material::TextureType::VTF;
+	outInfo.width = width;
+	outInfo.height = height;
+	outInfo.mipmapCount = std::max<uint32_t>(mipmapCount, 1u);
+	outInfo.cubemap = (flags & TEXTUREFLAGS_ENVMAP) != 0;
+	outInfo.layerCount = outInfo.cubemap ? 6 : 1;
+	outInfo.format = static_cast<uint32_t>(format);
+	return true;
+}
+
+static bool parse_vtex_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	constexpr uint16_t RESOURCE_HEADER_VERSION = 12;
+	constexpr uint32_t MAX_BLOCK_COUNT = 32;
+	constexpr uint16_t VTEX_FLAG_CUBE_TEXTURE = 0x10;
+	uint16_t headerVersion;
+	uint32_t blockOffset, blockCount;
+	if(!reader.Read(4, headerVersion) || headerVersion != RESOURCE_HEADER_VERSION || !reader.Read(8, blockOffset) || !reader.Read(12, blockCount) || blockCount > MAX_BLOCK_COUNT)
+		return false;
+	uint64_t blockPos = 8 + blockOffset;
+	for(auto i = decltype(blockCount) {0u}; i < blockCount; ++i, blockPos += 12) {
+		std::array<char, 4> blockType;
+		uint32_t offset;
+		if(!reader.Read(blockPos, blockType.data(), blockType.size()) || !reader.Read(blockPos + 4, offset))
+			return false;
+		if(std::memcmp(blockType.data(), "DATA", 4) != 0)
+			continue;
+		auto dataPos = blockPos + 4 + offset;
+		uint16_t flags, width, height;
+		uint8_t format, mipmapCount;
+		if(!reader.Read(dataPos + 2, flags) || !reader.Read(dataPos + 20, width) || !reader.Read(dataPos + 22, height) || !reader.Read(dataPos + 26, format) || !reader.Read(dataPos + 27, mipmapCount))
+			return false;
+		outInfo.type = pragma::material::TextureType::VTex;
+		outInfo.width = width;
+		outInfo.height = height;
+		outInfo.mipmapCount = std::max<uint32_t>(mipmapCount, 1u);
+		outInfo.cubemap = (flags & VTEX_FLAG_CUBE_TEXTURE) != 0;
+		outInfo.layerCount = outInfo.cubemap ? 6 : 1;
+		outInfo.format = format;
+		return true;
+	}
+	return false;
+}
+
+static bool parse_tga_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	std::array<uint8_t, 18> header;
+	if(!reader.Read(0, header.data(), header.size()))
+		return false;
+	auto imageType = header[2];
+	switch(imageType) {
+	case 1:
+	case 2:
+	case 3:
+	case 9:
+	case 10:
+	case 11:
+		break;
+	default:
+		return false;
+	}
+	uint16_t width, height;
+	std::memcpy(&width, header.data() + 12, sizeof(width));
+	std::memcpy(&height, header.data() + 14, sizeof(height));
+	outInfo.type = pragma::material::TextureType::TGA;
+	outInfo.width = width;
+	outInfo.height = height;
+	outInfo.format = header[16] | (imageType << 8);
+	return true;
+}
+
+static bool parse_jpg_header(const HeaderReader &reader, pragma::material::ImageHeaderInfo &outInfo)
+{
+	// Walk the segments until we find a start-of-frame marker
+	uint64_t pos = 2;
+	for(;;) {
+		std::array<uint8_t, 4> segment;
+		if(!reader.Read(pos, segment.data(), segment.size()) || segment[0] != 0xFF)
+			return false;
+		auto marker = segment[1];
+		if(marker == 0xFF) {
+			// Fill byte
+			++pos;
+			continue;
+		}
+		auto length = static_cast<uint16_t>((segment[2] << 8) | segment[3]);
+		if(length < 2)
+			return false;
+		auto isSof = (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC);
+		if(isSof) {
+			std::array<uint8_t, 6> frame;
+			if(!reader.Read(pos + 4, frame.data(), frame.size()))
+				return false;
+			outInfo.type = pragma::material::TextureType::JPG;
+			outInfo.height = (frame[1] << 8) | frame[2];
+			outInfo.width = (frame[3] << 8) | frame[4];
+			outInfo.format = frame[5] | (frame[0] << 8);
+			return true;
+		}
+		if(marker == 0xD9 || marker == 0xDA) // End of image / start of scan
+			return false;
+		pos += 2 + length;
+	}
+	return false;
+}
+
+static bool parse_image_header(const HeaderReader &reader, pragma::material::TextureType type, pragma::material::ImageHeaderInfo &outInfo)
+{
+	constexpr std::array<uint8_t, 8> PNG_SIGNATURE {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+	constexpr std::array<uint8_t, 12> KTX_IDENTIFIER {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+	constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+	outInfo = {};
+	std::array<uint8_t, 12> magic {};
+	if(!reader.Read(0, magic.data(), magic.size()))
+		return false;
+	if(std::memcmp(magic.data(), PNG_SIGNATURE.data(), PNG_SIGNATURE.size()) == 0)
+		return parse_png_header(reader, outInfo);
+	if(std::memcmp(magic.data(), "DDS ", 4) == 0)
+		return parse_dds_header(reader, outInfo);
+	if(magic == KTX_IDENTIFIER)
+		return parse_ktx_header(reader, outInfo);
+	if(magic == KTX2_IDENTIFIER)
+		return parse_ktx2_header(reader, outInfo);
+	if(std::memcmp(magic.data(), "VTF\0", 4) == 0)
+		return parse_vtf_header(reader, outInfo);
+	if(magic[0] == 0xFF && magic[1] == 0xD8)
+		return parse_jpg_header(reader, outInfo);
+	// No magic number for these formats
+	switch(type) {
+	case pragma::material::TextureType::VTex:
+		return parse_vtex_header(reader, outInfo);
+	case pragma::material::TextureType::TGA:
+		return parse_tga_header(reader, outInfo);
+	default:
+		break;
+	}
+	return false;
+}
+
+bool pragma::material::parse_image_header(const void *data, size_t size, TextureType type, ImageHeaderInfo &outInfo)
+{
+	HeaderReader reader {};
+	reader.data = static_cast<const uint8_t *>(data);
+	reader.size = size;
+	return ::parse_image_header(reader, type, outInfo);
+}
+
+bool pragma::material::probe_image_header(std::shared_ptr<fs::VFilePtrInternal> &f, TextureType type, ImageHeaderInfo &outInfo)
+{
+	std::array<uint8_t, IMAGE_HEADER_PROBE_SIZE> buffer;
+	HeaderReader reader {};
+	reader.data = buffer.data();
+	reader.size = f->Read(buffer.data(), buffer.size());
+	reader.file = f.get();
+	return ::parse_image_header(reader, type, outInfo);
+}
+
+static std::shared_mutex g_imageHeaderCacheMutex;
+static std::unordered_map<std::string, pragma::material::ImageHeaderInfo> g_imageHeaderCache;
+bool pragma::material::probe_image_header(const std::string &fileName, ImageHeaderInfo &outInfo, bool useCache)
+{
+	auto path = fs::get_normalized_path(fileName);
+	if(useCache) {
+		std::shared_lock lock {g_imageHeaderCacheMutex};
+		auto it = g_imageHeaderCache.find(path);
+		if(it != g_imageHeaderCache.end()) {
+			outInfo = it->second;
+			return true;
+		}
+	}
+
+	std::string ext;
+	ufile::get_extension(path, &ext);
+	pragma::string::to_lower(ext);
+	auto &formats = ::MaterialManager::get_supported_image_formats();
+	auto itFormat = std::find_if(formats.begin(), formats.end(), [&ext](const ::MaterialManager::ImageFormat &format) { return ext == format.extension; });
+	auto type = (itFormat != formats.end()) ? itFormat->type : TextureType::Invalid;
+
+	auto f = fs::open_file(path, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr)
+		return false;
+	if(!probe_image_header(f, type, outInfo)) {
+		// Formats we don't have a dedicated parser for
+		f = nullptr;
+		outInfo = {};
+		if(!pragma::image::read_image_size(path, outInfo.width, outInfo.height))
+			return false;
+		outInfo.type = type;
+	}
+	if(useCache) {
+		std::unique_lock lock {g_imageHeaderCacheMutex};
+		g_imageHeaderCache[path] = outInfo;
+	}
+	return true;
+}
+void pragma::material::invalidate_image_header_cache(const std::string &fileName)
+{
+	std::unique_lock lock {g_imageHeaderCacheMutex};
+	g_imageHeaderCache.erase(fs::get_normalized_path(fileName));
+}
+void pragma::material::clear_image_header_cache()
+{
+	std::unique_lock lock {g_imageHeaderCacheMutex};
+	g_imageHeaderCache.clear();
+}
@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.materialsystem;
+
+import :import_diagnostics;
+import :util;
+
+uint64_t pragma::material::ImportDiagnostics::CalcSourceHash(const void *data, size_t size) { return calc_fnv1a_hash(data, size); }
+
+bool pragma::material::ImportDiagnostics::IsCacheableFailure(ImportErrorClass errorClass)
+{
+	switch(errorClass) {
+	case ImportErrorClass::ReadError:
+	case ImportErrorClass::ParseError:
+	case ImportErrorClass::InvalidData:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool pragma::material::ImportDiagnostics::Execute(ImportRecord record, std::string &inOutErr, const std::function<ImportErrorClass()> &import)
+{
+	auto key = normalize_cache_path(record.sourceFile);
+	{
+		std::scoped_lock lock {m_mutex};
+		auto it = m_failures.find(key);
+		if(it != m_failures.end()) {
+			auto &failure = it->second;
+			if(failure.sourceSize == record.sourceSize && failure.sourceHash == record.sourceHash) {
+				++m_skippedImportCount;
+				inOutErr = "Skipped import of '" + record.sourceFile + "', previous import has failed: " + std::string {magic_enum::enum_name(failure.errorClass)};
+				if(!failure.message.empty())
+					inOutErr += " (" + failure.message + ")";
+				return false;
+			}
+		}
+	}
+
+	auto t = std::chrono::steady_clock::now();
+	record.errorClass = import();
+	record.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t);
+	if(!record.IsSuccessful())
+		record.message = inOutErr;
+	AddRecord(record);
+	return record.IsSuccessful();
+}
+
+void pragma::material::ImportDiagnostics::AddRecord(const ImportRecord &record)
+{
+	auto key = normalize_cache_path(record.sourceFile);
+	RecordCallback callback;
+	{
+		std::scoped_lock lock {m_mutex};
+		m_records[key] = record;
+		if(record.sourceHash != 0 && IsCacheableFailure(record.errorClass))
+			m_failures[key] = record;
+		else
+			m_failures.erase(key);
+		callback = m_recordCallback;
+	}
+	if(callback)
+		callback(record);
+}
+
+std::optional<pragma::material::ImportRecord> pragma::material::ImportDiagnostics::FindRecord(const std::string &sourceFile) const
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_records.find(normalize_cache_path(sourceFile));
+	if(it == m_records.end())
+		return {};
+	return it->second;
+}
+std::vector<pragma::material::ImportRecord> pragma::material::ImportDiagnostics::GetRecords() const
+{
+	std::scoped_lock lock {m_mutex};
+	std::vector<ImportRecord> records;
+	records.reserve(m_records.size());
+	for(auto &[key, record] : m_records)
+		records.push_back(record);
+	return records;
+}
+std::vector<pragma::material::ImportRecord> pragma::material::ImportDiagnostics::GetFailures() const
+{
+	std::scoped_lock lock {m_mutex};
+	std::vector<ImportRecord> failures;
+	failures.reserve(m_failures.size());
+	for(auto &[key, record] : m_failures)
+		failures.push_back(record);
+	return failures;
+}
+bool pragma::material::ImportDiagnostics::IsKnownFailure(const std::string &sourceFile, uint64_t sourceSize, uint64_t sourceHash) const
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_failures.find(normalize_cache_path(sourceFile));
+	return it != m_failures.end() && it->second.sourceSize == sourceSize && it->second.sourceHash == sourceHash;
+}
+void pragma::material::ImportDiagnostics::ForgetFailure(const std::string &sourceFile)
+{
+	std::scoped_lock lock {m_mutex};
+	m_failures.erase(normalize_cache_path(sourceFile));
+}
+void pragma::material::ImportDiagnostics::ClearRecords()
+{
+	std::scoped_lock lock {m_mutex};
+	m_records.clear();
+}
+void pragma::material::ImportDiagnostics::ClearFailures()
+{
+	std::scoped_lock lock {m_mutex};
+	m_failures.clear();
+}
+void pragma::material::ImportDiagnostics::SetRecordCallback(const RecordCallback &callback)
+{
+	std::scoped_lock lock {m_mutex};
+	m_recordCallback = callback;
+}
+
+bool pragma::material::ImportDiagnostics::SaveFailureCache(udm::AssetData outData, std::string &outErr) const
+{
+	auto failures = GetFailures();
+	outData.SetAssetType(PIFC_IDENTIFIER);
+	outData.SetAssetVersion(PIFC_VERSION);
+	auto udm = *outData;
+	auto udmFailures = udm.AddArray("failures", failures.size(), udm::Type::Element);
+	for(auto i = decltype(failures.size()) {0u}; i < failures.size(); ++i) {
+		auto &failure = failures[i];
+		auto udmFailure = udmFailures[i];
+		udmFailure["source"] = failure.sourceFile;
+		udmFailure["output"] = failure.outputPath;
+		udmFailure["handler"] = failure.handler;
+		udmFailure["error"] = std::string {magic_enum::enum_name(failure.errorClass)};
+		udmFailure["message"] = failure.message;
+		udmFailure["size"] = failure.sourceSize;
+		udmFailure["hash"] = failure.sourceHash;
+	}
+	return true;
+}
+bool pragma::material::ImportDiagnostics::SaveFailureCache(const std::string &fileName, std::string &outErr) const
+{
+	auto udmData = udm::Data::Create();
+	if(!SaveFailureCache(udmData->GetAssetData(), outErr))
+		return false;
+	std::string ext;
+	auto binary = ufile::get_extension(fileName, &ext) && ext == FORMAT_FAILURE_CACHE_BINARY;
+	fs::create_path(ufile::get_path_from_filename(fileName));
+	auto f = fs::open_file<fs::VFilePtrReal>(fileName, binary ? (fs::FileMode::Write | fs::FileMode::Binary) : fs::FileMode::Write);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return false;
+	}
+	auto result = binary ? udmData->Save(f) : udmData->SaveAscii(f, udm::AsciiSaveFlags::None);
+	if(result == false) {
+		outErr = "Unable to save UDM data!";
+		return false;
+	}
+	return true;
+}
+bool pragma::material::ImportDiagnostics::LoadFailureCache(const udm::AssetData &data, std::string &outErr)
+{
+	if(data.GetAssetType() != PIFC_IDENTIFIER) {
+		outErr = "Incorrect format!";
+		return false;
+	}
+	if(data.GetAssetVersion() < 1) {
+		outErr = "Invalid version!";
+		return false;
+	}
+	auto udm = *data;
+	auto udmFailures = udm["failures"];
+	auto n = udmFailures.GetSize();
+	std::unordered_map<std::string, ImportRecord> failures;
+	failures.reserve(n);
+	for(auto i = decltype(n) {0u}; i < n; ++i) {
+		auto udmFailure = udmFailures[i];
+		ImportRecord record {};
+		udmFailure["source"](record.sourceFile);
+		udmFailure["output"](record.outputPath);
+		udmFailure["handler"](record.handler);
+		std::string errorClass;
+		udmFailure["error"](errorClass);
+		udmFailure["message"](record.message);
+		udmFailure["size"](record.sourceSize);
+		udmFailure["hash"](record.sourceHash);
+		auto eErrorClass = magic_enum::enum_cast<ImportErrorClass>(errorClass);
+		// Caches written by older versions may contain failures that are no longer cached
+		if(record.sourceFile.empty() || record.sourceHash == 0 || !eErrorClass || !IsCacheableFailure(*eErrorClass))
+			continue;
+		record.errorClass = *eErrorClass;
+		failures[normalize_cache_path(record.sourceFile)] = std::move(record);
+	}
+	std::scoped_lock lock {m_mutex};
+	m_failures = std::move(failures);
+	return true;
+}
+bool pragma::material::ImportDiagnostics::LoadFailureCache(const std::string &fileName, std::string &outErr)
+{
+	auto f = fs::open_file(fileName, fs::FileMode::Read | fs::FileMode::Binary);
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return false;
+	}
+	std::shared_ptr<udm::Data> udmData = nullptr;
+	try {
+		udmData = udm::Data::Load(f);
+	}
+	catch(const udm::Exception &e) {
+		outErr = e.what();
+		return false;
+	}
+	if(udmData == nullptr) {
+		outErr = "Unable to load UDM data!";
+		return false;
+	}
+	return LoadFailureCache(udmData->GetAssetData(), outErr);
+}
+
+pragma::material::ImportRecord pragma::material::create_import_record(ufile::IFile &f, const std::string &handler, const std::string &outputPath, const void *data, size_t size)
+{
+	ImportRecord record {};
+	auto fileName = f.GetFileName();
+	record.sourceFile = fileName ? *fileName : outputPath;
+	record.outputPath = outputPath;
+	record.handler = handler;
+	record.sourceSize = size;
+	record.sourceHash = ImportDiagnostics::CalcSourceHash(data, size);
+	return record;
+}
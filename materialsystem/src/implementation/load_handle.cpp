@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.materialsystem;
+
+import :load_handle;
+
+struct pragma::material::LoadHandle::State {
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	LoadState state = LoadState::Pending;
+	float progress = 0.f;
+	std::vector<LoadHandle> dependencies;
+	ContinuationList<bool> onComplete;
+};
+
+pragma::material::LoadHandle pragma::material::LoadHandle::CreateCompleted(bool success)
+{
+	LoadPromise promise {};
+	promise.Complete(success);
+	return promise.GetHandle();
+}
+pragma::material::LoadHandle::LoadHandle(const std::shared_ptr<State> &state) : m_state {state} {}
+bool pragma::material::LoadHandle::IsValid() const { return m_state != nullptr; }
+pragma::material::LoadState pragma::material::LoadHandle::GetState() const
+{
+	if(!m_state)
+		return LoadState::Failed;
+	std::scoped_lock lock {m_state->mutex};
+	return m_state->state;
+}
+bool pragma::material::LoadHandle::IsReady() const { return GetState() != LoadState::Pending; }
+bool pragma::material::LoadHandle::IsSuccessful() const { return GetState() == LoadState::Succeeded; }
+float pragma::material::LoadHandle::GetProgress() const
+{
+	if(!m_state)
+		return 1.f;
+	std::vector<LoadHandle> dependencies;
+	{
+		std::scoped_lock lock {m_state->mutex};
+		if(m_state->state != LoadState::Pending)
+			return 1.f;
+		if(m_state->dependencies.empty())
+			return m_state->progress;
+		dependencies = m_state->dependencies;
+	}
+	auto progress = 0.f;
+	for(auto &hDependency : dependencies)
+		progress += hDependency.GetProgress();
+	return progress / static_cast<float>(dependencies.size());
+}
+bool pragma::material::LoadHandle::Wait(std::chrono::milliseconds timeout) const
+{
+	if(!m_state)
+		return true;
+	std::unique_lock lock {m_state->mutex};
+	return m_state->condition.wait_for(lock, timeout, [this]() { return m_state->state != LoadState::Pending; });
+}
+void pragma::material::LoadHandle::Wait() const
+{
+	if(!m_state)
+		return;
+	std::unique_lock lock {m_state->mutex};
+	m_state->condition.wait(lock, [this]() { return m_state->state != LoadState::Pending; });
+}
+pragma::material::ContinuationHandle pragma::material::LoadHandle::Then(const std::function<void(bool)> &f, CallbackThread thread) const
+{
+	if(!m_state) {
+		f(false);
+		return {};
+	}
+	return m_state->onComplete.Add(f, thread);
+}
+
+pragma::material::LoadPromise::LoadPromise() : m_state {std::make_shared<LoadHandle::State>()} {}
+pragma::material::LoadHandle pragma::material::LoadPromise::GetHandle() const { return LoadHandle {m_state}; }
+void pragma::material::LoadPromise::SetProgress(float progress)
+{
+	std::scoped_lock lock {m_state->mutex};
+	m_state->progress = std::clamp(progress, 0.f, 1.f);
+}
+void pragma::material::LoadPromise::AddDependency(const LoadHandle &handle)
+{
+	std::scoped_lock lock {m_state->mutex};
+	if(m_state->state == LoadState::Pending)
+		m_state->dependencies.push_back(handle);
+}
+void pragma::material::LoadPromise::Complete(bool success)
+{
+	{
+		std::scoped_lock lock {m_state->mutex};
+		if(m_state->state != LoadState::Pending)
+			return;
+		m_state->state = success ? LoadState::Succeeded : LoadState::Failed;
+		m_state->progress = 1.f;
+		m_state->dependencies.clear();
+	}
+	m_state->condition.notify_all();
+	m_state->onComplete.Complete(success);
+}
+
+pragma::material::LoadHandle pragma::material::when_all(const std::vector<LoadHandle> &handles)
+{
+	if(handles.empty())
+		return LoadHandle::CreateCompleted(true);
+	struct Counter {
+		std::atomic<size_t> remaining;
+		std::atomic<bool> success = true;
+	};
+	auto counter = std::make_shared<Counter>();
+	counter->remaining = handles.size();
+	LoadPromise promise {};
+	for(auto &handle : handles)
+		promise.AddDependency(handle);
+	for(auto &handle : handles) {
+		handle.Then([counter, promise](bool success) mutable {
+			if(!success)
+				counter->success = false;
+			if(--counter->remaining == 0)
+				promise.Complete(counter->success);
+		});
+	}
+	return promise.GetHandle();
+}
+
+std::pair<pragma::material::LoadHandle, bool> pragma::material::PendingLoadRegistry::Add(const std::string &identifier)
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_pending.find(identifier);
+	if(it != m_pending.end())
+		return {it->second.GetHandle(), false};
+	it = m_pending.emplace(identifier, LoadPromise {}).first;
+	return {it->second.GetHandle(), true};
+}
+void pragma::material::PendingLoadRegistry::Complete(const std::string &identifier, bool success)
+{
+	std::optional<LoadPromise> promise {};
+	{
+		std::scoped_lock lock {m_mutex};
+		auto it = m_pending.find(identifier);
+		if(it == m_pending.end())
+			return;
+		promise = std::move(it->second);
+		m_pending.erase(it);
+	}
+	// Continuations must not be executed while the registry is locked, since they may start new loads
+	promise->Complete(success);
+}
+void pragma::material::PendingLoadRegistry::Clear(bool success)
+{
+	std::unordered_map<std::string, LoadPromise> pending;
+	{
+		std::scoped_lock lock {m_mutex};
+		pending = std::move(m_pending);
+		m_pending.clear();
+	}
+	for(auto &[identifier, promise] : pending)
+		promise.Complete(success);
+}
+bool pragma::material::PendingLoadRegistry::IsPending(const std::string &identifier) const
+{
+	std::scoped_lock lock {m_mutex};
+	return m_pending.find(identifier) != m_pending.end();
+}
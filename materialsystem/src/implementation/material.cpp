@@ -9,6 +9,7 @@ module pragma.materialsystem;
 
 import :material;
 import :material_manager;
+import :material_property_storage;
 
 #undef CreateFile
 
@@ -126,7 +127,12 @@ void pragma::material::Material::Assign(const Material &other)
 	m_data = other.m_data;
 	m_shaderInfo = other.m_shaderInfo;
 	m_shader = other.m_shader ? std::make_unique<std::string>(*other.m_shader) : nullptr;
-	m_baseMaterial = m_baseMaterial ? std::make_unique<BaseMaterial>(*m_baseMaterial) : nullptr;
+	if(other.m_baseMaterial) {
+		if(other.m_baseMaterial->material)
+			SetBaseMaterial(other.m_baseMaterial->material.get());
+		else
+			SetBaseMaterial(other.m_baseMaterial->name);
+	}
 	// m_index = other.m_index;
 
 	if(IsValid())
@@ -208,32 +214,21 @@ void pragma::material::Material::UpdateTextures(bool forceUpdate)
 	OnTexturesUpdated();
 }
 
-void pragma::material::Material::CallEventListeners(Event event)
-{
-	auto itLs = m_eventListeners.find(event);
-	if(itLs == m_eventListeners.end())
-		return;
-	auto &listeners = itLs->second;
-	for(auto it = listeners.begin(); it != listeners.end();) {
-		auto &listener = *it;
-		if(listener.IsValid() == false) {
-			it = listeners.erase(it);
-			continue;
-		}
-		listener();
-		++it;
-	}
-}
+void pragma::material::Material::CallEventListeners(Event event) { m_eventListeners[static_cast<size_t>(event)].Invoke(); }
 
 CallbackHandle pragma::material::Material::AddEventListener(Event event, const std::function<void(void)> &f)
 {
-	auto it = m_eventListeners.find(event);
-	if(it == m_eventListeners.end())
-		it = m_eventListeners.emplace(event, std::vector<CallbackHandle> {}).first;
-	auto &vec = it->second;
-	vec.emplace_back(FunctionCallback<void>::Create(f));
-	return vec.back();
+	auto cb = FunctionCallback<void>::Create(f);
+	// The wrapper is removed from the list once the handle has been removed
+	m_eventListeners[static_cast<size_t>(event)].Add(
+	  [cb]() mutable {
+		  if(cb.IsValid())
+			  cb();
+	  },
+	  CallbackThread::Any, [cb]() { return !cb.IsValid(); });
+	return cb;
 }
+pragma::material::ContinuationHandle pragma::material::Material::AddEventListener(Event event, const std::function<void(void)> &f, CallbackThread thread) { return m_eventListeners[static_cast<size_t>(event)].Add(f, thread); }
 
 void pragma::material::Material::OnTexturesUpdated() { CallEventListeners(Event::OnTexturesUpdated); }
 
@@ -245,10 +240,9 @@ void pragma::material::Material::SetShaderInfo(const pragma::util::WeakHandle<pr
 
 pragma::material::Material::~Material()
 {
-	for(auto &hCb : m_callOnLoaded) {
-		if(hCb.IsValid() == true)
-			hCb.Remove();
-	}
+	m_onLoaded.Clear();
+	for(auto &listeners : m_eventListeners)
+		listeners.Clear();
 }
 
 bool pragma::material::Material::IsValid() const { return (m_data != nullptr) ? true : false; }
@@ -258,83 +252,23 @@ void pragma::material::Material::SetLoaded(bool b)
 	if(pragma::math::is_flag_set(m_stateFlags, StateFlags::ExecutingOnLoadCallbacks))
 		return; // Prevent possible recursion while on-load callbacks are being executed
 	pragma::math::set_flag(m_stateFlags, StateFlags::Loaded, b);
-	if(b == true) {
-		pragma::math::set_flag(m_stateFlags, StateFlags::ExecutingOnLoadCallbacks, true);
-		for(auto &f : m_callOnLoaded) {
-			if(f.IsValid())
-				f();
-		}
-		m_callOnLoaded.clear();
-		pragma::math::set_flag(m_stateFlags, StateFlags::ExecutingOnLoadCallbacks, false);
+	if(b == false) {
+		// Material is being reloaded, callbacks added from here on will wait for the reload to complete
+		m_onLoaded.Reset();
+		return;
 	}
+	pragma::math::set_flag(m_stateFlags, StateFlags::ExecutingOnLoadCallbacks, true);
+	m_onLoaded.Complete();
+	pragma::math::set_flag(m_stateFlags, StateFlags::ExecutingOnLoadCallbacks, false);
 }
 bool pragma::material::Material::Save(udm::AssetData outData, std::string &outErr)
 {
 	outData.GetData().Add(GetShaderIdentifier());
 	auto udm = (*outData)[GetShaderIdentifier()];
-	std::function<void(udm::LinkedPropertyWrapper, datasystem::Block &)> dataBlockToUdm = nullptr;
-	dataBlockToUdm = [&dataBlockToUdm, &udm](udm::LinkedPropertyWrapper prop, datasystem::Block &block) {
-		for(auto &pair : *block.GetData()) {
-			auto &key = pair.first;
-			auto &val = pair.second;
-			if(val->IsBlock()) {
-				auto &block = static_cast<datasystem::Block &>(*pair.second);
-				dataBlockToUdm(prop[key], block);
-				continue;
-			}
-			if(val->IsContainer()) {
-				auto &container = static_cast<datasystem::Container &>(*pair.second);
-				auto &children = container.GetBlocks();
-				auto udmChildren = prop.AddArray(key, children.size());
-				uint32_t idx = 0;
-				for(auto &child : children) {
-					if(child->IsContainer() || child->IsBlock())
-						continue;
-					auto *dsValue = dynamic_cast<datasystem::Value *>(pair.second.get());
-					if(dsValue == nullptr)
-						continue;
-					udmChildren[idx++] = dsValue->GetString();
-				}
-				udmChildren.Resize(idx);
-				continue;
-			}
-			auto *dsValue = dynamic_cast<datasystem::Value *>(val.get());
-			assert(dsValue);
-			if(dsValue) {
-				auto *dsStr = dynamic_cast<datasystem::String *>(dsValue);
-				if(dsStr)
-					prop[key] = dsStr->GetString();
-				auto *dsInt = dynamic_cast<datasystem::Int *>(dsValue);
-				if(dsInt)
-					prop[key] = dsInt->GetInt();
-				auto *dsFloat = dynamic_cast<datasystem::Float *>(dsValue);
-				if(dsFloat)
-					prop[key] = dsFloat->GetFloat();
-				auto *dsBool = dynamic_cast<datasystem::Bool *>(dsValue);
-				if(dsBool)
-					prop[key] = dsBool->GetBool();
-				auto *dsVec = dynamic_cast<datasystem::Vector *>(dsValue);
-				if(dsVec)
-					prop[key] = dsVec->GetVector();
-				auto *dsVec4 = dynamic_cast<datasystem::Vector4 *>(dsValue);
-				if(dsVec4)
-					prop[key] = dsVec4->GetVector4();
-				auto *dsVec2 = dynamic_cast<datasystem::Vector2 *>(dsValue);
-				if(dsVec2)
-					prop[key] = dsVec2->GetVector2();
-				auto *dsTex = dynamic_cast<datasystem::Texture *>(dsValue);
-				if(dsTex)
-					udm["textures"][key] = dsTex->GetString();
-				auto *dsCol = dynamic_cast<datasystem::Color *>(dsValue);
-				if(dsCol)
-					prop[key] = dsCol->GetColor().ToVector4();
-			}
-		}
-	};
 
 	outData.SetAssetType(ematerial::PMAT_IDENTIFIER);
 	outData.SetAssetVersion(ematerial::PMAT_VERSION);
-	dataBlockToUdm(udm["properties"], *m_data);
+	DataBlockPropertyStorage {m_data}.Save(udm);
 	if(m_baseMaterial)
 		udm["base_material"] = m_baseMaterial->name;
 	return true;
@@ -461,13 +395,16 @@ bool pragma::material::Material::SaveLegacy(const std::string &fileName, const s
 }
 CallbackHandle pragma::material::Material::CallOnLoaded(const std::function<void(void)> &f) const
 {
-	if(IsLoaded()) {
-		f();
-		return {};
-	}
-	m_callOnLoaded.push_back(FunctionCallback<>::Create(f));
-	return m_callOnLoaded.back();
+	auto cb = FunctionCallback<>::Create(f);
+	m_onLoaded.Add(
+	  [cb]() mutable {
+		  if(cb.IsValid())
+			  cb();
+	  },
+	  CallbackThread::Any, [cb]() { return !cb.IsValid(); });
+	return cb;
 }
+pragma::material::ContinuationHandle pragma::material::Material::CallOnLoaded(const std::function<void(void)> &f, CallbackThread thread) const { return m_onLoaded.Add(f, thread); }
 bool pragma::material::Material::IsLoaded() const { return pragma::math::is_flag_set(m_stateFlags, StateFlags::Loaded); }
 
 const TextureInfo *pragma::material::Material::GetDiffuseMap() const { return const_cast<Material *>(this)->GetDiffuseMap(); }
@@ -595,6 +532,7 @@ void pragma::material::Material::SetTextureProperty(const std::string_view &strP
 	if(block == nullptr)
 		return;
 	block->AddValue("texture", std::string {key}, std::string {tex});
+	m_manager.UpdateDependencies(*this);
 }
 
 std::pair<std::shared_ptr<pragma::datasystem::Block>, std::string> pragma::material::Material::ResolvePropertyPath(const std::string_view &strPath) const
@@ -666,6 +604,7 @@ void pragma::material::Material::SetBaseMaterial(const std::string &baseMaterial
 	m_baseMaterial = std::make_unique<BaseMaterial>();
 	m_baseMaterial->name = baseMaterial;
 	m_manager.PreloadAsset(m_baseMaterial->name);
+	m_manager.UpdateDependencies(*this);
 }
 void pragma::material::Material::SetBaseMaterial(Material *baseMaterial)
 {
@@ -676,6 +615,7 @@ void pragma::material::Material::SetBaseMaterial(Material *baseMaterial)
 	m_baseMaterial->material = baseMaterial->shared_from_this();
 	m_baseMaterial->onBaseTexturesUpdated = baseMaterial->AddEventListener(Event::OnTexturesUpdated, [this]() { OnBaseMaterialChanged(); });
 	m_baseMaterial->name = baseMaterial->GetName();
+	m_manager.UpdateDependencies(*this);
 }
 
 void pragma::material::Material::OnBaseMaterialChanged() {}
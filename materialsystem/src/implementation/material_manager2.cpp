@@ -13,6 +13,7 @@ pragma::material::MaterialFormatHandler::MaterialFormatHandler(pragma::util::IAs
 bool pragma::material::udm_to_data_block(udm::LinkedPropertyWrapper &udmDataRoot, datasystem::Block &root)
 {
 	std::function<void(const std::string &key, udm::LinkedPropertyWrapper &prop, datasystem::Block &block, bool texture)> udmToDataSys = nullptr;
+	// Values are added with their binary type directly, rather than being converted to strings and parsed by the data system
 	udmToDataSys = [&udmToDataSys](const std::string &key, udm::LinkedPropertyWrapper &prop, datasystem::Block &block, bool texture) {
 		prop.InitializeProperty();
 		if(prop.prop) {
@@ -28,33 +29,24 @@ bool pragma::material::udm_to_data_block(udm::LinkedPropertyWrapper &udmDataRoot
 			case udm::Type::UInt32:
 			case udm::Type::Int64:
 			case udm::Type::UInt64:
-				block.AddValue("int", key, util::to_string(prop.prop->ToValue<int32_t>(0)));
+				block.AddValue(key, prop.prop->ToValue<int32_t>(0));
 				break;
 			case udm::Type::Float:
 			case udm::Type::Double:
-				block.AddValue("float", key, util::to_string(prop.prop->ToValue<float>(0.f)));
+				block.AddValue(key, prop.prop->ToValue<float>(0.f));
 				break;
 			case udm::Type::Boolean:
-				block.AddValue("bool", key, util::to_string(prop.prop->ToValue<bool>(false)));
+				block.AddValue(key, prop.prop->ToValue<bool>(false));
 				break;
 			case udm::Type::Vector2:
-				{
-					auto v = prop.prop->ToValue<Vector2>(Vector2 {});
-					block.AddValue("vector2", key, util::to_string(v.x) + ' ' + util::to_string(v.y));
-					break;
-				}
+				block.AddValue(key, prop.prop->ToValue<Vector2>(Vector2 {}));
+				break;
 			case udm::Type::Vector3:
-				{
-					auto v = prop.prop->ToValue<Vector3>(Vector3 {});
-					block.AddValue("vector", key, util::to_string(v.x) + ' ' + util::to_string(v.y) + ' ' + util::to_string(v.z));
-					break;
-				}
+				block.AddValue(key, prop.prop->ToValue<Vector3>(Vector3 {}));
+				break;
 			case udm::Type::Vector4:
-				{
-					auto v = prop.prop->ToValue<Vector4>(Vector4 {});
-					block.AddValue("vector4", key, util::to_string(v.x) + ' ' + util::to_string(v.y) + ' ' + util::to_string(v.z) + ' ' + util::to_string(v.w));
-					break;
-				}
+				block.AddValue(key, prop.prop->ToValue<Vector4>(Vector4 {}));
+				break;
 			case udm::Type::Element:
 				{
 					if(texture) {
@@ -84,6 +76,11 @@ bool pragma::material::udm_to_data_block(udm::LinkedPropertyWrapper &udmDataRoot
 		udmToDataSys(std::string {udmProp.key}, udmProp.property, root, false);
 	return true;
 }
+const std::shared_ptr<pragma::datasystem::Settings> &pragma::material::get_shared_data_settings()
+{
+	static auto settings = datasystem::create_data_settings({});
+	return settings;
+}
 bool pragma::material::PmatFormatHandler::LoadData(MaterialProcessor &processor, MaterialLoadInfo &info)
 {
 	std::shared_ptr<udm::Data> udmData = nullptr;
@@ -97,8 +94,7 @@ bool pragma::material::PmatFormatHandler::LoadData(MaterialProcessor &processor,
 		return false;
 	auto udmDataRoot = udmData->GetAssetData().GetData();
 
-	auto dataSettings = static_cast<MaterialManager &>(GetAssetManager()).CreateDataSettings();
-	auto root = pragma::util::make_shared<datasystem::Block>(*dataSettings);
+	auto root = pragma::util::make_shared<datasystem::Block>(*get_shared_data_settings());
 	auto it = udmDataRoot.begin_el();
 	if(it == udmDataRoot.end_el())
 		return false;
@@ -159,10 +155,21 @@ pragma::material::MaterialProcessor::MaterialProcessor(pragma::util::AssetFormat
 bool pragma::material::MaterialProcessor::Load()
 {
 	auto &matHandler = static_cast<MaterialFormatHandler &>(*handler);
+	auto &manager = static_cast<MaterialManager &>(matHandler.GetAssetManager());
 	auto r = matHandler.LoadData(*this, static_cast<MaterialLoadInfo &>(*loadInfo));
-	if(!r)
+	if(!r) {
+		manager.m_pendingLoads.Complete(manager.ToCacheIdentifier(identifier), false);
 		return false;
-	auto mat = static_cast<MaterialManager &>(matHandler.GetAssetManager()).CreateMaterialObject(matHandler.shader, matHandler.data);
+	}
+	return true;
+}
+bool pragma::material::MaterialProcessor::Finalize()
+{
+	// Creating the material may trigger callbacks and linking the base material may load
+	// other materials, neither of which is safe to do on a worker thread.
+	auto &matHandler = static_cast<MaterialFormatHandler &>(*handler);
+	auto &manager = static_cast<MaterialManager &>(matHandler.GetAssetManager());
+	auto mat = manager.CreateMaterialObject(matHandler.shader, matHandler.data);
 	mat->SetLoaded(true);
 	mat->SetName(identifier);
 	if(!matHandler.baseMaterial.empty())
@@ -170,7 +177,6 @@ bool pragma::material::MaterialProcessor::Load()
 	material = mat;
 	return true;
 }
-bool pragma::material::MaterialProcessor::Finalize() { return true; }
 
 std::shared_ptr<pragma::material::MaterialManager> pragma::material::MaterialManager::Create()
 {
@@ -182,6 +188,9 @@ pragma::material::MaterialManager::MaterialManager()
 {
 	auto fileHandler = std::make_unique<pragma::util::AssetFileHandler>();
 	fileHandler->open = [](const std::string &path, pragma::util::AssetFormatType formatType) -> std::unique_ptr<ufile::IFile> {
+		auto fArchived = open_archived_asset_file(path);
+		if(fArchived)
+			return fArchived;
 		auto openMode = fs::FileMode::Read;
 		openMode |= fs::FileMode::Binary;
 		auto f = fs::open_file(path, openMode);
@@ -189,7 +198,7 @@ pragma::material::MaterialManager::MaterialManager()
 			return nullptr;
 		return std::make_unique<fs::File>(f);
 	};
-	fileHandler->exists = [](const std::string &path) -> bool { return fs::exists(path); };
+	fileHandler->exists = [](const std::string &path) -> bool { return archived_asset_file_exists(path) || fs::exists(path); };
 	SetFileHandler(std::move(fileHandler));
 	SetRootDirectory("materials");
 	m_loader = std::make_unique<MaterialLoader>(*this);
@@ -205,10 +214,35 @@ void pragma::material::MaterialManager::Initialize()
 	RegisterFormatHandler<WmiFormatHandler>("wmi", pragma::util::AssetFormatType::Text);
 	InitializeImportHandlers();
 }
+void pragma::material::MaterialManager::SetImportFailureCacheFile(const std::string &fileName)
+{
+	m_importFailureCacheFile = fileName;
+	if(fileName.empty() || !fs::exists(fileName))
+		return;
+	std::string err;
+	if(!m_importDiagnostics.LoadFailureCache(fileName, err))
+		std::cout << "WARNING: Unable to load import failure cache '" << fileName << "': " << err << std::endl;
+}
+bool pragma::material::MaterialManager::SaveImportFailureCache() const
+{
+	if(m_importFailureCacheFile.empty())
+		return false;
+	// Nothing to save, and no previous cache that would have to be cleared
+	if(m_importDiagnostics.GetFailures().empty() && !fs::exists(m_importFailureCacheFile))
+		return true;
+	std::string err;
+	if(!m_importDiagnostics.SaveFailureCache(m_importFailureCacheFile, err)) {
+		std::cout << "WARNING: Unable to save import failure cache '" << m_importFailureCacheFile << "': " << err << std::endl;
+		return false;
+	}
+	return true;
+}
 void pragma::material::MaterialManager::Reset()
 {
 	m_error = nullptr;
 	TFileAssetManager<Material, MaterialLoadInfo>::Reset();
+	m_completedLoads.clear();
+	m_pendingLoads.Clear();
 }
 std::shared_ptr<pragma::material::Material> pragma::material::MaterialManager::ReloadAsset(const std::string &path, std::unique_ptr<MaterialLoadInfo> &&loadInfo, PreloadResult *optOutResult)
 {
@@ -222,6 +256,8 @@ std::shared_ptr<pragma::material::Material> pragma::material::MaterialManager::R
 		return nullptr;
 	auto matOld = GetAssetObject(*asset);
 	matOld->Assign(*matNew);
+	// The reloaded material may reference different textures
+	UpdateDependencies(*matOld);
 	OnAssetReloaded(path);
 	return matOld;
 }
@@ -230,6 +266,245 @@ pragma::util::AssetObject pragma::material::MaterialManager::ReloadAsset(const s
 	return ReloadAsset(path, pragma::util::static_unique_pointer_cast<pragma::util::AssetLoadInfo, MaterialLoadInfo>(std::move(loadInfo)), optOutResult);
 }
 
+extern const std::array<std::string, 5> g_knownMaterialFormats;
+bool pragma::material::MaterialManager::SetFileWatcherEnabled(bool enabled)
+{
+	if(!enabled) {
+		m_fileWatcher = nullptr;
+		return true;
+	}
+	if(m_fileWatcher)
+		return true;
+	m_fileWatcher = AssetFileWatcher::Create();
+	if(!m_fileWatcher)
+		return false;
+	InitializeFileWatcher(*m_fileWatcher);
+	return true;
+}
+void pragma::material::MaterialManager::InitializeFileWatcher(AssetFileWatcher &watcher)
+{
+	std::vector<std::string> extensions {g_knownMaterialFormats.begin(), g_knownMaterialFormats.end()};
+	watcher.AddHandler(extensions, [this](const std::string &identifier, const std::string &ext) {
+		// Only materials that are currently loaded need to be reloaded. Materials using the reloaded
+		// material as base material will be updated through the OnTexturesUpdated event.
+		if(!FindCachedAsset(identifier))
+			return;
+		ReloadAsset(identifier);
+	});
+}
+void pragma::material::MaterialManager::ReloadDependents(const AssetDependencyGraph::AssetId &id)
+{
+	for(auto &dependent : m_dependencyGraph.GetDependents(id)) {
+		if(dependent.type != AssetDependencyGraph::AssetType::Material || !FindCachedAsset(dependent.name))
+			continue;
+		ReloadAsset(dependent.name);
+	}
+}
+void pragma::material::MaterialManager::Poll()
+{
+	TFileAssetManager<Material, MaterialLoadInfo>::Poll();
+	// The materials are only cached once InitializeAsset has returned, so the pending loads are completed here
+	auto completedLoads = std::move(m_completedLoads);
+	m_completedLoads.clear();
+	for(auto &identifier : completedLoads)
+		m_pendingLoads.Complete(identifier, true);
+	if(m_fileWatcher)
+		m_fileWatcher->Poll();
+	dispatch_main_thread_callbacks();
+}
+
+pragma::material::LoadHandle pragma::material::MaterialManager::LoadAssetAsync(const std::string &path, std::unique_ptr<MaterialLoadInfo> &&loadInfo)
+{
+	auto identifier = ToCacheIdentifier(path);
+	auto *asset = FindCachedAsset(identifier);
+	if(asset && GetAssetObject(*asset)) {
+		RecordManifestEntry(identifier);
+		return LoadHandle::CreateCompleted(true);
+	}
+	auto [handle, isNewLoad] = m_pendingLoads.Add(identifier);
+	if(isNewLoad) {
+		auto result = PreloadAsset(path, std::move(loadInfo));
+		// No load job has been queued (e.g. the file doesn't exist), so the load would never be completed otherwise
+		if(!result.success)
+			m_pendingLoads.Complete(identifier, false);
+	}
+	return handle;
+}
+bool pragma::material::MaterialManager::WaitForLoad(const LoadHandle &handle, std::chrono::milliseconds timeout)
+{
+	auto tEnd = std::chrono::steady_clock::now() + timeout;
+	for(;;) {
+		Poll();
+		if(handle.IsReady())
+			return true;
+		auto t = std::chrono::steady_clock::now();
+		if(t >= tEnd)
+			return false;
+		// Give the loader threads some time instead of spinning
+		handle.Wait(std::min(std::chrono::duration_cast<std::chrono::milliseconds>(tEnd - t), std::chrono::milliseconds {1}));
+	}
+}
+uint32_t pragma::material::MaterialManager::LoadAssetBatch(const std::vector<std::string> &materials, std::chrono::milliseconds timeout, bool *optOutTimedOut)
+{
+	std::vector<LoadHandle> handles;
+	handles.reserve(materials.size());
+	for(auto &mat : materials)
+		handles.push_back(LoadAssetAsync(mat));
+	auto completed = WaitForLoad(when_all(handles), timeout);
+	if(optOutTimedOut)
+		*optOutTimedOut = !completed;
+
+	uint32_t numSuccessful = 0;
+	for(auto &handle : handles) {
+		if(handle.IsSuccessful())
+			++numSuccessful;
+	}
+	return numSuccessful;
+}
+
+void pragma::material::MaterialManager::BeginManifestRecording() { m_manifestRecording = std::make_unique<std::vector<std::string>>(); }
+void pragma::material::MaterialManager::RecordManifestEntry(const std::string &identifier)
+{
+	if(m_manifestRecording)
+		m_manifestRecording->push_back(identifier);
+}
+std::shared_ptr<pragma::material::AssetManifest> pragma::material::MaterialManager::EndManifestRecording()
+{
+	if(!m_manifestRecording)
+		return nullptr;
+	auto materials = std::move(m_manifestRecording);
+	auto manifest = std::make_shared<AssetManifest>();
+	std::function<void(const AssetDependencyGraph::AssetId &)> addEntry = nullptr;
+	addEntry = [this, &manifest, &addEntry](const AssetDependencyGraph::AssetId &id) {
+		if(manifest->HasEntry(id))
+			return;
+		auto filePath = ResolveAssetFilePath(id);
+		if(!filePath)
+			return;
+		AssetManifest::Entry entry {id, std::move(*filePath)};
+		auto f = fs::open_file(entry.filePath, fs::FileMode::Read | fs::FileMode::Binary);
+		if(f)
+			entry.fileSize = f->GetSize();
+		manifest->AddEntry(entry);
+		// Base materials and textures are added after the material, so they are prefetched in the order in which they're needed
+		for(auto &dependency : m_dependencyGraph.GetDependencies(id))
+			addEntry(dependency);
+	};
+	for(auto &identifier : *materials)
+		addEntry({AssetDependencyGraph::AssetType::Material, identifier});
+	return manifest;
+}
+std::optional<std::string> pragma::material::MaterialManager::ResolveAssetFilePath(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Material)
+		return {};
+	auto path = FindAssetFilePath(id.name);
+	if(!path)
+		return {};
+	return GetRootDirectory().GetString() + '/' + *path;
+}
+pragma::material::LoadHandle pragma::material::MaterialManager::PrefetchAsset(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Material)
+		return LoadHandle::CreateCompleted(false);
+	return LoadAssetAsync(id.name);
+}
+pragma::material::LoadHandle pragma::material::MaterialManager::PrefetchManifest(const AssetManifest &manifest, uint32_t *optOutStaleCount)
+{
+	uint32_t numStale = 0;
+	std::vector<LoadHandle> handles;
+	handles.reserve(manifest.GetEntries().size());
+	for(auto &entry : manifest.GetEntries()) {
+		auto f = fs::open_file(entry.filePath, fs::FileMode::Read | fs::FileMode::Binary);
+		if(!f) {
+			// The file may have been moved or replaced by a different format, in which case
+			// the asset will be found the regular way once it is requested.
+			++numStale;
+			continue;
+		}
+		if(f->GetSize() != entry.fileSize)
+			++numStale;
+		f = nullptr;
+		handles.push_back(PrefetchAsset(entry.id));
+	}
+	if(optOutStaleCount)
+		*optOutStaleCount = numStale;
+	return when_all(handles);
+}
+
+static std::string get_texture_dependency_name(const std::string &texName)
+{
+	auto name = texName;
+	std::string ext;
+	ufile::get_extension(name, &ext);
+	if(!ext.empty()) {
+		auto &formats = ::MaterialManager::get_supported_image_formats();
+		auto it = std::find_if(formats.begin(), formats.end(), [&ext](const ::MaterialManager::ImageFormat &format) { return ext == format.extension; });
+		if(it != formats.end() || ext == "svg")
+			name = name.substr(0, name.length() - ext.length() - 1);
+	}
+	return name;
+}
+static void collect_texture_dependencies(const pragma::datasystem::Block &block, std::vector<pragma::material::AssetDependencyGraph::AssetId> &outDependencies)
+{
+	for(auto &[key, value] : *block.GetData()) {
+		if(value->IsBlock()) {
+			collect_texture_dependencies(static_cast<const pragma::datasystem::Block &>(*value), outDependencies);
+			continue;
+		}
+		auto &val = static_cast<pragma::datasystem::Value &>(*value);
+		if(typeid(val) != typeid(pragma::datasystem::Texture))
+			continue;
+		auto &texName = static_cast<pragma::datasystem::Texture &>(val).GetValue().name;
+		if(texName.empty())
+			continue;
+		outDependencies.push_back({pragma::material::AssetDependencyGraph::AssetType::Texture, get_texture_dependency_name(texName)});
+	}
+}
+void pragma::material::MaterialManager::UpdateDependencies(const Material &mat)
+{
+	auto &name = mat.GetName();
+	if(name.empty())
+		return;
+	std::vector<AssetDependencyGraph::AssetId> dependencies;
+	if(mat.m_baseMaterial)
+		dependencies.push_back({AssetDependencyGraph::AssetType::Material, ToCacheIdentifier(mat.m_baseMaterial->name)});
+	if(mat.m_data)
+		collect_texture_dependencies(*mat.m_data, dependencies);
+	m_dependencyGraph.SetDependencies({AssetDependencyGraph::AssetType::Material, name}, dependencies);
+}
+bool pragma::material::MaterialManager::IsAssetInUse(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Material)
+		return false;
+	auto *asset = FindCachedAsset(id.name);
+	if(!asset)
+		return false;
+	// One reference is held by the cache, one by us
+	auto mat = GetAssetObject(*asset);
+	return mat && (mat.use_count() > 2 || mat.get() == m_error.get());
+}
+void pragma::material::MaterialManager::EvictAsset(const AssetDependencyGraph::AssetId &id)
+{
+	if(id.type != AssetDependencyGraph::AssetType::Material)
+		return;
+	RemoveFromCache(id.name);
+}
+std::vector<pragma::material::AssetDependencyGraph::AssetId> pragma::material::MaterialManager::CollectUnusedAssets()
+{
+	std::vector<AssetDependencyGraph::AssetId> evicted;
+	for(;;) {
+		auto unused = m_dependencyGraph.CollectUnused([this](const AssetDependencyGraph::AssetId &id) { return IsAssetInUse(id); });
+		if(unused.empty())
+			break;
+		for(auto &id : unused)
+			EvictAsset(id);
+		// Evicted materials release their references to base materials and textures, which may be unused now as well
+		evicted.insert(evicted.end(), unused.begin(), unused.end());
+	}
+	return evicted;
+}
+
 static bool g_shouldUseVkvVmtParser = false;
 void pragma::material::set_use_vkv_vmt_parser(bool useVkvParser) { g_shouldUseVkvVmtParser = useVkvParser; }
 bool pragma::material::should_use_vkv_vmt_parser() { return g_shouldUseVkvVmtParser; }
@@ -261,14 +536,17 @@ pragma::util::AssetObject pragma::material::MaterialManager::InitializeAsset(con
 {
 	auto &matProcessor = *static_cast<MaterialProcessor *>(job.processor.get());
 	matProcessor.material->SetIndex(asset.index);
+	UpdateDependencies(*matProcessor.material);
+	auto identifier = ToCacheIdentifier(job.identifier);
+	RecordManifestEntry(identifier);
+	m_completedLoads.push_back(std::move(identifier));
 	return matProcessor.material;
 }
 std::shared_ptr<pragma::datasystem::Settings> pragma::material::MaterialManager::CreateDataSettings() const { return datasystem::create_data_settings({}); }
 std::shared_ptr<pragma::material::Material> pragma::material::MaterialManager::CreateMaterialObject(const std::string &shader, const std::shared_ptr<datasystem::Block> &data) { return Material::Create(*this, shader, data); }
 std::shared_ptr<pragma::material::Material> pragma::material::MaterialManager::CreateMaterial(const udm::AssetData &assetData, std::string &outErr)
 {
-	auto dataSettings = CreateDataSettings();
-	auto root = pragma::util::make_shared<datasystem::Block>(*dataSettings);
+	auto root = pragma::util::make_shared<datasystem::Block>(*get_shared_data_settings());
 	auto data = assetData.GetData();
 	auto it = data.begin_el();
 	if(it == data.end_el()) {
@@ -321,5 +599,6 @@ std::shared_ptr<pragma::material::Material> pragma::material::MaterialManager::C
 		mat->SetLoaded(true);
 		mat->SetName(ToCacheIdentifier(identifier));
 	}
+	UpdateDependencies(*mat);
 	return mat;
 }
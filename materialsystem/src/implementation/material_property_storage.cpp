@@ -0,0 +1,322 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include <cassert>
+
+module pragma.materialsystem;
+
+import :material_manager2;
+import :material_property_storage;
+
+using UdmValueWriter = void (*)(udm::LinkedPropertyWrapper &udm, udm::LinkedPropertyWrapper &prop, const std::string &key, pragma::datasystem::Value &val);
+template<typename T, auto TGetter>
+static void write_udm_value(udm::LinkedPropertyWrapper &udm, udm::LinkedPropertyWrapper &prop, const std::string &key, pragma::datasystem::Value &val)
+{
+	prop[key] = (static_cast<T &>(val).*TGetter)();
+}
+// Writers for the data system value types, indexed by pragma::datasystem::ValueType. Types without a writer are not saved.
+static const std::array<UdmValueWriter, pragma::math::to_integral(pragma::datasystem::ValueType::Count)> g_udmValueWriters = []() {
+	std::array<UdmValueWriter, pragma::math::to_integral(pragma::datasystem::ValueType::Count)> writers {};
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::String)] = &write_udm_value<pragma::datasystem::String, &pragma::datasystem::String::GetString>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Texture)] = [](udm::LinkedPropertyWrapper &udm, udm::LinkedPropertyWrapper &prop, const std::string &key, pragma::datasystem::Value &val) { udm["textures"][key] = static_cast<pragma::datasystem::Texture &>(val).GetString(); };
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Int)] = &write_udm_value<pragma::datasystem::Int, &pragma::datasystem::Int::GetInt>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Float)] = &write_udm_value<pragma::datasystem::Float, &pragma::datasystem::Float::GetFloat>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Bool)] = &write_udm_value<pragma::datasystem::Bool, &pragma::datasystem::Bool::GetBool>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Color)] = [](udm::LinkedPropertyWrapper &udm, udm::LinkedPropertyWrapper &prop, const std::string &key, pragma::datasystem::Value &val) { prop[key] = static_cast<pragma::datasystem::Color &>(val).GetColor().ToVector4(); };
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Vector2)] = &write_udm_value<pragma::datasystem::Vector2, &pragma::datasystem::Vector2::GetVector2>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Vector3)] = &write_udm_value<pragma::datasystem::Vector, &pragma::datasystem::Vector::GetVector>;
+	writers[pragma::math::to_integral(pragma::datasystem::ValueType::Vector4)] = &write_udm_value<pragma::datasystem::Vector4, &pragma::datasystem::Vector4::GetVector4>;
+	return writers;
+}();
+
+pragma::material::DataBlockPropertyStorage::DataBlockPropertyStorage(const std::shared_ptr<datasystem::Block> &data) : m_data {data} {}
+std::pair<std::shared_ptr<pragma::datasystem::Block>, std::string> pragma::material::DataBlockPropertyStorage::ResolvePath(const std::string_view &path) const
+{
+	if(path.find('/') == std::string::npos)
+		return {m_data, std::string {path}};
+	auto filePath = pragma::util::FilePath(path);
+	auto data = m_data;
+	std::shared_ptr<datasystem::Block> secondToLastBlock;
+	std::string_view lastSegment;
+	for(auto &segment : filePath) {
+		if(data == nullptr)
+			return {};
+		secondToLastBlock = data;
+		data = data->GetBlock(std::string {segment});
+		lastSegment = segment;
+	}
+	if(!secondToLastBlock)
+		return {m_data, std::string {path}};
+	return {secondToLastBlock, std::string {lastSegment}};
+}
+bool pragma::material::DataBlockPropertyStorage::AddBlock(const std::string_view &path)
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return false;
+	block->AddBlock(key);
+	return true;
+}
+void pragma::material::DataBlockPropertyStorage::SetTextureProperty(const std::string_view &path, const std::string_view &tex)
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return;
+	block->AddValue("texture", key, std::string {tex});
+}
+void pragma::material::DataBlockPropertyStorage::ClearProperty(const std::string_view &path)
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return;
+	block->RemoveValue(key);
+}
+pragma::material::PropertyType pragma::material::DataBlockPropertyStorage::GetPropertyType(const std::string_view &path) const
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return PropertyType::None;
+	auto &dsVal = block->GetValue(key);
+	if(dsVal == nullptr)
+		return PropertyType::None;
+	if(dsVal->IsBlock())
+		return PropertyType::Block;
+	if(dsVal->IsValue() && static_cast<datasystem::Value &>(*dsVal).GetType() == datasystem::ValueType::Texture)
+		return PropertyType::Texture;
+	return PropertyType::Value;
+}
+void pragma::material::DataBlockPropertyStorage::Save(udm::LinkedPropertyWrapper &udm) const
+{
+	std::function<void(udm::LinkedPropertyWrapper, datasystem::Block &)> dataBlockToUdm = nullptr;
+	dataBlockToUdm = [&dataBlockToUdm, &udm](udm::LinkedPropertyWrapper prop, datasystem::Block &block) {
+		for(auto &pair : *block.GetData()) {
+			auto &key = pair.first;
+			auto &val = pair.second;
+			if(val->IsBlock()) {
+				auto &block = static_cast<datasystem::Block &>(*pair.second);
+				dataBlockToUdm(prop[key], block);
+				continue;
+			}
+			if(val->IsContainer()) {
+				auto &container = static_cast<datasystem::Container &>(*pair.second);
+				auto &children = container.GetBlocks();
+				auto udmChildren = prop.AddArray(key, children.size());
+				uint32_t idx = 0;
+				for(auto &child : children) {
+					if(!child->IsValue())
+						continue;
+					udmChildren[idx++] = static_cast<datasystem::Value &>(*child).GetString();
+				}
+				udmChildren.Resize(idx);
+				continue;
+			}
+			assert(val->IsValue());
+			if(!val->IsValue())
+				continue;
+			auto &dsValue = static_cast<datasystem::Value &>(*val);
+			auto type = pragma::math::to_integral(dsValue.GetType());
+			if(type >= g_udmValueWriters.size() || g_udmValueWriters[type] == nullptr)
+				continue;
+			g_udmValueWriters[type](udm, prop, key, dsValue);
+		}
+	};
+	dataBlockToUdm(udm["properties"], *m_data);
+}
+void pragma::material::DataBlockPropertyStorage::SetValue(const std::string_view &path, Value &&value)
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return;
+	std::visit(
+	  [&block, &key](auto &v) {
+		  using T = std::decay_t<decltype(v)>;
+		  if constexpr(std::is_same_v<T, udm::String>)
+			  block->AddValue("string", key, v);
+		  else
+			  block->AddValue(key, v);
+	  },
+	  value);
+}
+std::optional<pragma::material::IMaterialPropertyStorage::Value> pragma::material::DataBlockPropertyStorage::GetValue(const std::string_view &path) const
+{
+	auto [block, key] = ResolvePath(path);
+	if(block == nullptr)
+		return {};
+	auto &dsBase = block->GetValue(key);
+	if(dsBase == nullptr || !dsBase->IsValue())
+		return {};
+	auto &dsVal = static_cast<datasystem::Value &>(*dsBase);
+	switch(dsVal.GetType()) {
+	case datasystem::ValueType::String:
+	case datasystem::ValueType::Texture:
+		return Value {std::in_place_type<udm::String>, dsVal.GetString()};
+	case datasystem::ValueType::Int:
+		return Value {std::in_place_type<udm::Int32>, dsVal.GetInt()};
+	case datasystem::ValueType::Float:
+		return Value {std::in_place_type<udm::Float>, dsVal.GetFloat()};
+	case datasystem::ValueType::Bool:
+		return Value {std::in_place_type<udm::Boolean>, dsVal.GetBool()};
+	case datasystem::ValueType::Color:
+		return Value {std::in_place_type<udm::Vector3>, dsVal.GetColor().ToVector3()};
+	case datasystem::ValueType::Vector2:
+		return Value {std::in_place_type<udm::Vector2>, dsVal.GetVector2()};
+	case datasystem::ValueType::Vector3:
+		return Value {std::in_place_type<udm::Vector3>, dsVal.GetVector()};
+	case datasystem::ValueType::Vector4:
+		return Value {std::in_place_type<udm::Vector4>, dsVal.GetVector4()};
+	default:
+		break;
+	}
+	return {};
+}
+
+///////////
+
+static bool has_children(udm::LinkedPropertyWrapper prop)
+{
+	for(auto child : prop.ElIt())
+		return true;
+	return false;
+}
+static std::string get_texture_path(udm::LinkedPropertyWrapper prop)
+{
+	if(prop->type != udm::Type::Element)
+		return prop->ToValue<std::string>("");
+	// Textures with additional settings, see udm_to_data_block
+	auto udmTexture = prop["texture"];
+	return udmTexture ? udmTexture->ToValue<std::string>("") : std::string {};
+}
+
+pragma::material::UdmPropertyStorage::UdmPropertyStorage() : m_udmData {udm::Data::Create()}
+{
+	auto root = GetRoot();
+	root.Add("textures");
+	root.Add("properties");
+}
+udm::LinkedPropertyWrapper pragma::material::UdmPropertyStorage::GetRoot() const { return m_udmData->GetAssetData().GetData(); }
+void pragma::material::UdmPropertyStorage::Load(const udm::LinkedPropertyWrapper &udm)
+{
+	m_udmData = udm::Data::Create();
+	auto root = GetRoot();
+	for(auto *name : {"textures", "properties"}) {
+		auto udmDst = root.Add(name);
+		auto udmSrc = udm[name];
+		if(udmSrc)
+			udmDst.Merge(udmSrc, udm::MergeFlags::OverwriteExisting | udm::MergeFlags::DeepCopy);
+	}
+}
+bool pragma::material::UdmPropertyStorage::ToDataBlock(datasystem::Block &outBlock) const
+{
+	auto root = GetRoot();
+	return udm_to_data_block(root, outBlock);
+}
+udm::LinkedPropertyWrapper pragma::material::UdmPropertyStorage::FindProperty(const std::string_view &path) const
+{
+	auto prop = GetRoot()["properties"];
+	for(auto &segment : pragma::util::FilePath(path)) {
+		if(!prop || prop->type != udm::Type::Element)
+			return {};
+		prop = prop[std::string {segment}];
+	}
+	return prop ? prop : udm::LinkedPropertyWrapper {};
+}
+std::pair<udm::LinkedPropertyWrapper, std::string> pragma::material::UdmPropertyStorage::ResolvePath(const std::string_view &path) const
+{
+	auto pos = path.find_last_of('/');
+	if(pos == std::string::npos)
+		return {GetRoot()["properties"], std::string {path}};
+	auto parent = FindProperty(path.substr(0, pos));
+	if(!parent || parent->type != udm::Type::Element)
+		return {};
+	return {parent, std::string {path.substr(pos + 1)}};
+}
+bool pragma::material::UdmPropertyStorage::AddBlock(const std::string_view &path)
+{
+	auto [parent, key] = ResolvePath(path);
+	if(!parent)
+		return false;
+	auto existing = parent[key];
+	if(existing && existing->type == udm::Type::Element)
+		return true;
+	if(path.find('/') == std::string::npos)
+		GetRoot()["textures"].RemoveValue(key);
+	parent.RemoveValue(key);
+	parent.Add(key);
+	return true;
+}
+void pragma::material::UdmPropertyStorage::SetTextureProperty(const std::string_view &path, const std::string_view &tex)
+{
+	if(path.find('/') != std::string::npos)
+		return;
+	auto key = std::string {path};
+	GetRoot()["properties"].RemoveValue(key);
+	auto udmTextures = GetRoot()["textures"];
+	udmTextures.RemoveValue(key);
+	udmTextures[key] = std::string {tex};
+}
+void pragma::material::UdmPropertyStorage::ClearProperty(const std::string_view &path)
+{
+	auto [parent, key] = ResolvePath(path);
+	if(!parent)
+		return;
+	if(path.find('/') == std::string::npos)
+		GetRoot()["textures"].RemoveValue(key);
+	parent.RemoveValue(key);
+}
+pragma::material::PropertyType pragma::material::UdmPropertyStorage::GetPropertyType(const std::string_view &path) const
+{
+	if(path.find('/') == std::string::npos && GetRoot()["textures"][std::string {path}])
+		return PropertyType::Texture;
+	auto prop = FindProperty(path);
+	if(!prop)
+		return PropertyType::None;
+	return (prop->type == udm::Type::Element) ? PropertyType::Block : PropertyType::Value;
+}
+void pragma::material::UdmPropertyStorage::Save(udm::LinkedPropertyWrapper &udm) const
+{
+	// The data is already in the layout of the pmat format, so it only has to be copied
+	auto root = GetRoot();
+	for(auto *name : {"textures", "properties"}) {
+		auto udmSrc = root[name];
+		if(has_children(udmSrc))
+			udm.Add(name).Merge(udmSrc, udm::MergeFlags::OverwriteExisting | udm::MergeFlags::DeepCopy);
+	}
+}
+void pragma::material::UdmPropertyStorage::SetValue(const std::string_view &path, Value &&value)
+{
+	auto [parent, key] = ResolvePath(path);
+	if(!parent)
+		return;
+	if(path.find('/') == std::string::npos)
+		GetRoot()["textures"].RemoveValue(key);
+	// Removed first, so the new value is stored with its own type instead of being converted to the type of the previous value
+	parent.RemoveValue(key);
+	std::visit([&parent, &key](auto &v) { parent[key] = v; }, value);
+}
+std::optional<pragma::material::IMaterialPropertyStorage::Value> pragma::material::UdmPropertyStorage::GetValue(const std::string_view &path) const
+{
+	if(path.find('/') == std::string::npos) {
+		auto udmTexture = GetRoot()["textures"][std::string {path}];
+		if(udmTexture)
+			return Value {std::in_place_type<udm::String>, get_texture_path(udmTexture)};
+	}
+	auto prop = FindProperty(path);
+	if(!prop)
+		return {};
+	std::optional<Value> result {};
+	// Values loaded from pmat files may have any UDM type, they're normalized the same way as by udm_to_data_block
+	udm::visit(prop->type, [&prop, &result](auto tag) {
+		using TSource = typename decltype(tag)::type;
+		if constexpr(is_property_type<TSource>) {
+			constexpr auto normalizedType = to_udm_type(to_ds_type(udm::type_to_enum<TSource>()));
+			udm::visit(normalizedType, [&prop, &result](auto tagNorm) {
+				using TNorm = typename decltype(tagNorm)::type;
+				if constexpr(is_underlying_property_udm_type<TNorm> && udm::is_convertible<TSource, TNorm>())
+					result = Value {std::in_place_type<TNorm>, udm::convert<TSource, TNorm>(prop->template GetValue<TSource>())};
+			});
+		}
+	});
+	return result;
+}
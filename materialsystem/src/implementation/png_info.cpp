@@ -14,6 +14,8 @@ void pragma::material::PNGInfo::Release()
 	png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
 	free(image_data);
 	free(row_pointers);
+	image_data = nullptr;
+	row_pointers = nullptr;
 }
 
 static void ReadPNGDataFromFile(png_structp png_ptr, png_bytep outBytes, png_size_t byteCountToRead)
@@ -21,7 +23,9 @@ static void ReadPNGDataFromFile(png_structp png_ptr, png_bytep outBytes, png_siz
 	if(png_get_io_ptr(png_ptr) == NULL)
 		return;
 	pragma::fs::VFilePtr &fp = *static_cast<pragma::fs::VFilePtr *>(png_get_io_ptr(png_ptr));
-	fp->Read(&outBytes[0], byteCountToRead);
+	// Truncated files would otherwise be decoded from uninitialized memory
+	if(fp->Read(&outBytes[0], byteCountToRead) != byteCountToRead)
+		png_error(png_ptr, "Unexpected end of file");
 }
 
 bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInternal> &fp, PNGInfo &info)
@@ -29,7 +33,8 @@ bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInterna
 	png_byte header[8];
 
 	// read the header
-	fp->Read(&header[0], 8);
+	if(fp->Read(&header[0], 8) != 8)
+		return false;
 
 	if(png_sig_cmp(header, 0, 8)) {
 		// fprintf(stderr, "error: %s is not a PNG.\n", file_name);
@@ -62,8 +67,8 @@ bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInterna
 #pragma warning(disable : 4611)
 	if(setjmp(png_jmpbuf(info.png_ptr))) {
 #pragma warning(default : 4611)
-		//fprintf(stderr, "error from libpng\n");
-		png_destroy_read_struct(&info.png_ptr, &info.info_ptr, &info.end_info);
+		// The error may have been raised while reading the image data, which has already been allocated at that point
+		info.Release();
 		return false;
 	}
 
@@ -88,28 +93,54 @@ bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInterna
 
 	if(bit_depth != 8) {
 		// fprintf(stderr, "%s: Unsupported bit depth %d.  Must be 8.\n", file_name, bit_depth);
+		info.Release();
 		return false;
 	}
 
-	if(!(color_type & PNG_COLOR_MASK_COLOR))
+	if(!(color_type & PNG_COLOR_MASK_COLOR)) {
+		info.Release();
 		return false;
-	info.format = !(color_type & PNG_COLOR_MASK_ALPHA) ? 23u : // vk::Format::eR8G8B8Unorm
-	  37u;                                                     // vk::Format::eR8G8B8A8Unorm
+	}
+	// Palette images have one byte per pixel, they have to be expanded to match the format below
+	if(color_type & PNG_COLOR_MASK_PALETTE) {
+		png_set_palette_to_rgb(info.png_ptr);
+		if(png_get_valid(info.png_ptr, info.info_ptr, PNG_INFO_tRNS))
+			png_set_tRNS_to_alpha(info.png_ptr);
+	}
 
 	// Update the png info struct.
 	png_read_update_info(info.png_ptr, info.info_ptr);
 
+	// The format is determined after the transformations, so it always matches the decoded data
+	auto channels = png_get_channels(info.png_ptr, info.info_ptr);
+	if(channels != 3 && channels != 4) {
+		info.Release();
+		return false;
+	}
+	info.format = (channels == 3) ? 23u : // vk::Format::eR8G8B8Unorm
+	  37u;                                // vk::Format::eR8G8B8A8Unorm
+
 	// Row size in bytes.
-	int rowbytes = static_cast<int>(png_get_rowbytes(info.png_ptr, info.info_ptr));
+	size_t rowbytes = png_get_rowbytes(info.png_ptr, info.info_ptr);
+	if(rowbytes < static_cast<size_t>(temp_width) * channels) {
+		info.Release();
+		return false;
+	}
 
 	// glTexImage2d requires rows to be 4-byte aligned
 	rowbytes += 3 - ((rowbytes - 1) % 4);
 
+	// The dimensions are untrusted, make sure the buffer size can't overflow
+	if(temp_height == 0 || rowbytes > (std::numeric_limits<size_t>::max() - 15) / temp_height) {
+		info.Release();
+		return false;
+	}
+
 	// Allocate the image_data as a big block, to be given to opengl
 	info.image_data = (png_byte *)malloc(rowbytes * temp_height * sizeof(png_byte) + 15);
 	if(info.image_data == NULL) {
 		// fprintf(stderr,"error: could not allocate memory for PNG image data\n");
-		png_destroy_read_struct(&info.png_ptr, &info.info_ptr, &info.end_info);
+		info.Release();
 		return false;
 	}
 
@@ -117,8 +148,7 @@ bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInterna
 	info.row_pointers = (png_byte **)malloc(temp_height * sizeof(png_byte *));
 	if(info.row_pointers == NULL) {
 		// fprintf(stderr, "error: could not allocate memory for PNG row pointers\n");
-		png_destroy_read_struct(&info.png_ptr, &info.info_ptr, &info.end_info);
-		free(info.image_data);
+		info.Release();
 		return false;
 	}
 
@@ -130,14 +160,21 @@ bool pragma::material::load_png_data(std::shared_ptr<pragma::fs::VFilePtrInterna
 	png_read_image(info.png_ptr, info.row_pointers);
 
 	if(info.format == 23u) {
-		auto numPixels = info.width * info.height;
+		auto numPixels = static_cast<size_t>(info.width) * info.height;
 		auto *rgbaData = static_cast<uint8_t *>(malloc(numPixels * 4u));
-		for(auto i = decltype(numPixels) {0u}; i < numPixels; ++i) {
-			auto srcPxIdx = i * 3u;
-			auto dstPxIdx = i * 4u;
-			for(auto j = 0u; j < 3u; ++j)
-				rgbaData[dstPxIdx + j] = info.image_data[srcPxIdx + j];
-			rgbaData[dstPxIdx + 3u] = std::numeric_limits<uint8_t>::max();
+		if(rgbaData == nullptr) {
+			info.Release();
+			return false;
+		}
+		// The source rows are padded to 4 bytes
+		for(size_t y = 0; y < info.height; ++y) {
+			auto *srcRow = info.image_data + y * rowbytes;
+			auto *dstRow = rgbaData + y * info.width * 4u;
+			for(size_t x = 0; x < info.width; ++x) {
+				for(auto j = 0u; j < 3u; ++j)
+					dstRow[x * 4u + j] = srcRow[x * 3u + j];
+				dstRow[x * 4u + 3u] = std::numeric_limits<uint8_t>::max();
+			}
 		}
 		free(info.image_data);
 		info.image_data = rgbaData;
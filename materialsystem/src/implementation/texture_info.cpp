@@ -5,41 +5,30 @@ module;
 
 module pragma.materialsystem;
 
+import :image_header;
 import :texture_info;
-import pragma.image;
 
-static bool read_image_size(std::string &imgFile, uint32_t &width, uint32_t &height)
+static bool read_image_size(const std::string &texName, uint32_t &width, uint32_t &height)
 {
 	pragma::material::TextureType type;
-	imgFile = translate_image_path(imgFile, type);
-	auto r = pragma::image::read_image_size(imgFile, width, height);
-	auto rootPath = MaterialManager::GetRootMaterialLocation() + "/";
-	imgFile = imgFile.substr(rootPath.length());
+	auto imgFile = translate_image_path(texName, type);
+	pragma::material::ImageHeaderInfo headerInfo;
+	auto r = pragma::material::probe_image_header(imgFile, headerInfo);
+	width = headerInfo.width;
+	height = headerInfo.height;
 	return r;
 }
 
 pragma::datasystem::Texture::Texture(Settings &dataSettings, const std::string &value, bool bCubemap) : Value(dataSettings)
 {
-	auto str = value;
-	if(str.empty()) {
-		m_value.texture = nullptr;
-		m_value.width = 0;
-		m_value.height = 0;
+	m_value.texture = nullptr;
+	m_value.width = 0;
+	m_value.height = 0;
+	if(value.empty())
 		return;
-	}
-	uint32_t width;
-	uint32_t height;
-	if(read_image_size(str, width, height) == true) {
-		m_value.texture = nullptr;
-		m_value.width = width;
-		m_value.height = height;
-	}
-	else {
-		m_value.texture = nullptr;
-		m_value.width = 0;
-		m_value.height = 0;
-	}
-	m_value.name = str;
+	// The texture size is resolved on demand, so we don't touch the file system here
+	m_value.name = pragma::fs::get_normalized_path(value);
+	pragma::string::to_lower(m_value.name);
 }
 pragma::datasystem::Texture::Texture(Settings &dataSettings, const std::string &value) : Texture(dataSettings, value, false) {}
 pragma::datasystem::Texture::Texture(Settings &dataSettings, const TextureInfo &value) : Value(dataSettings), m_value(value) {}
@@ -74,4 +63,58 @@ REGISTER_DATA_TYPE(pragma::datasystem::Cubemap,cubemap)*/
 
 TextureInfo::TextureInfo() : name(), width(0), height(0), texture(nullptr) {}
 
-TextureInfo::TextureInfo(const TextureInfo &other) : name(other.name), width(other.width), height(other.height), texture(other.texture) {}
+TextureInfo::TextureInfo(const TextureInfo &other) : name(other.name), width(other.width), height(other.height), texture(other.texture), sizeResolved(other.sizeResolved), sizeLookupFailed(other.sizeLookupFailed) {}
+
+void TextureInfo::SetSize(uint32_t width, uint32_t height)
+{
+	this->width = width;
+	this->height = height;
+	sizeResolved = true;
+}
+bool TextureInfo::ResolveSize()
+{
+	if(sizeResolved)
+		return width > 0 && height > 0;
+	if(sizeLookupFailed)
+		return false;
+	uint32_t w = 0;
+	uint32_t h = 0;
+	if(name.empty() || !read_image_size(name, w, h)) {
+		// Failures are not retried, the texture manager will update the size once the texture has been loaded
+		sizeLookupFailed = true;
+		return false;
+	}
+	SetSize(w, h);
+	return true;
+}
+uint32_t TextureInfo::GetWidth()
+{
+	ResolveSize();
+	return width;
+}
+uint32_t TextureInfo::GetHeight()
+{
+	ResolveSize();
+	return height;
+}
+
+void pragma::material::resolve_texture_sizes(const std::vector<TextureInfo *> &textures)
+{
+	std::unordered_map<std::string, std::optional<std::pair<uint32_t, uint32_t>>> resolved;
+	for(auto *texInfo : textures) {
+		if(texInfo->IsSizeResolved() || texInfo->sizeLookupFailed)
+			continue;
+		auto it = resolved.find(texInfo->name);
+		if(it == resolved.end()) {
+			std::pair<uint32_t, uint32_t> size {0u, 0u};
+			auto r = !texInfo->name.empty() && read_image_size(texInfo->name, size.first, size.second);
+			it = resolved.insert(std::make_pair(texInfo->name, r ? size : std::optional<std::pair<uint32_t, uint32_t>> {})).first;
+		}
+		if(!it->second) {
+			// See TextureInfo::ResolveSize
+			texInfo->sizeLookupFailed = true;
+			continue;
+		}
+		texInfo->SetSize(it->second->first, it->second->second);
+	}
+}
@@ -50,3 +50,20 @@ std::string pragma::material::translate_image_path(const std::string &imgFile, p
 {
 	return translate_image_path(imgFile, type, ::MaterialManager::GetRootMaterialLocation() + '/', fileHandler, optOutFound);
 }
+
+uint64_t pragma::material::calc_fnv1a_hash(const void *data, size_t size, uint64_t seed)
+{
+	auto hash = seed;
+	auto *bytes = static_cast<const uint8_t *>(data);
+	for(size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1'099'511'628'211ull;
+	}
+	return hash;
+}
+std::string pragma::material::normalize_cache_path(std::string path)
+{
+	std::replace(path.begin(), path.end(), '\\', '/');
+	pragma::string::to_lower(path);
+	return path;
+}
@@ -6,6 +6,7 @@ module;
 module pragma.materialsystem;
 
 import :vmat;
+import :format_handlers.source2_vmat_mapping;
 
 #ifndef DISABLE_VMAT_SUPPORT
 import source2;
@@ -47,93 +48,19 @@ bool MaterialManager::LoadVMat(source2::resource::Resource &resource, LoadInfo &
 	if(aoMap)
 		fLoadTexture(*aoMap);
 
-	auto origin = VMatOrigin::Source2;
-	if(s2Mat->GetShaderName() == "vr_simple_2way_blend.vfx") {
-		shaderName = "pbr_blend";
-		auto *albedoMapA = s2Mat->FindTextureParam("g_tColorA");
-		auto *albedoMapB = s2Mat->FindTextureParam("g_tColorB");
-
-		if(albedoMapA)
-			root->AddData(pragma::material::ematerial::ALBEDO_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMapA)));
-		if(albedoMapB)
-			root->AddData(pragma::material::ematerial::ALBEDO_MAP2_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMapB)));
-
-		auto *normalMapA = s2Mat->FindTextureParam("g_tNormalA");
-		auto *normalMapB = s2Mat->FindTextureParam("g_tNormalB");
-
-		if(normalMapA)
-			root->AddData(pragma::material::ematerial::NORMAL_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*normalMapA)));
-
-		auto *metalnessA = s2Mat->FindFloatParam("g_flMetalnessA");
-		auto *metalnessB = s2Mat->FindFloatParam("g_flMetalnessB");
-
-		if(metalnessA)
-			root->AddValue("float", "metalness_factor", pragma::util::to_string(*metalnessA));
-
-		auto *roughnessA = s2Mat->FindVectorParam("TextureRoughnessA");
-		auto *roughnessB = s2Mat->FindVectorParam("TextureRoughnessB");
-
-		// TODO: Vector roughness?
-		//if(roughnessA)
-		//	root->AddValue("float","roughness_factor",util::to_string(*roughnessA));
-
-		// TODO: Add support for secondary normal map / metalness / roughness
-	}
-	else if(s2Mat->GetShaderName() == "vr_cilia.vfx") {
-		// TODO: Can these have a ColorB/NormalB/etc??
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColorA");
-		if(albedoMap)
-			root->AddData(pragma::material::ematerial::ALBEDO_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormalA");
-		if(normalMap)
-			root->AddData(pragma::material::ematerial::NORMAL_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-
-		auto *metalness = s2Mat->FindFloatParam("g_flMetalnessA");
-		if(metalness)
-			root->AddValue("float", "metalness_factor", pragma::util::to_string(*metalness));
-
-		auto *textureColor = s2Mat->FindVectorParam("TextureColorA");
-		// TODO
-	}
-	else if(s2Mat->GetShaderName() == "hero.vfx") {
-		origin = VMatOrigin::Dota2;
-		// Dota 2
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColor");
-		if(albedoMap)
-			root->AddData(pragma::material::ematerial::ALBEDO_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormal");
-		if(normalMap)
-			root->AddData(pragma::material::ematerial::NORMAL_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-#if 0
-		// TODO
-		+		["g_tMasks1"]	("g_tMasks1", "materials/models/courier/drodo/drodo_detailmask_tga_bcdebe17.vtex")	std::pair<std::basic_string<char,std::char_traits<char>,std::allocator<char> > const ,std::basic_string<char,std::char_traits<char>,std::allocator<char> > >
-		+		["g_tMasks2"]	("g_tMasks2", "materials/models/courier/drodo/drodo_specmask_tga_cff5ad3a.vtex")	std::pair<std::basic_string<char,std::char_traits<char>,std::allocator<char> > const ,std::basic_string<char,std::char_traits<char>,std::allocator<char> > >
-#endif
-	}
-	else {
-		auto *albedoMap = s2Mat->FindTextureParam("g_tColor");
-		if(albedoMap == nullptr)
-			albedoMap = s2Mat->FindTextureParam("g_tColor1");
-		if(albedoMap == nullptr)
-			albedoMap = s2Mat->FindTextureParam("g_tColor2");
-		if(albedoMap)
-			root->AddData(pragma::material::ematerial::ALBEDO_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*albedoMap)));
-
-		auto *normalMap = s2Mat->FindTextureParam("g_tNormal");
-		if(normalMap)
-			root->AddData(pragma::material::ematerial::NORMAL_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*normalMap)));
-
-		auto *emissionMap = s2Mat->FindTextureParam("g_tSelfIllumMask");
-		if(emissionMap)
-			root->AddData(pragma::material::ematerial::EMISSION_MAP_IDENTIFIER, std::make_shared<pragma::datasystem::Texture>(*dataSettings, fLoadTexture(*emissionMap)));
-
-		auto *metalness = s2Mat->FindFloatParam("g_flMetalness");
-		if(metalness)
-			root->AddValue("float", "metalness_factor", pragma::util::to_string(*metalness));
-		// TODO: Is there an attribute like this for roughness?
+	auto *mapping = pragma::material::find_source2_vmat_shader_mapping(s2Mat->GetShaderName());
+	pragma::material::Source2VmatImportReport report {};
+	report.fileName = info.identifier;
+	report.shader = s2Mat->GetShaderName();
+	if(mapping == nullptr) {
+		mapping = &pragma::material::get_default_source2_vmat_shader_mapping();
+		report.unknownShader = true;
 	}
+	shaderName = mapping->materialShader;
+	auto origin = static_cast<VMatOrigin>(pragma::math::to_integral(mapping->origin));
+	pragma::material::apply_source2_vmat_shader_mapping(*mapping, *s2Mat, *root, *dataSettings, fLoadTexture);
+	report.unmappedParameters = pragma::material::find_unmapped_source2_vmat_parameters(*mapping, *s2Mat);
+	pragma::material::report_source2_vmat_import(report);
 
 	info.shader = shaderName;
 	info.root = root;
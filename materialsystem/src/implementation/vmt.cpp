@@ -66,9 +66,9 @@ static void merge_dx_node_values(VTFLib::Nodes::CVMTGroupNode &node)
 static std::array<float, 3> get_vmt_matrix(VTFLib::Nodes::CVMTStringNode &node)
 {
 	std::string value = node.GetValue();
-	if(value.front() == '[')
+	if(!value.empty() && value.front() == '[')
 		value = value.substr(1);
-	if(value.back() == ']')
+	if(!value.empty() && value.back() == ']')
 		value = value.substr(0, value.length() - 1);
 	std::vector<std::string> substrings {};
 	pragma::string::explode_whitespace(value, substrings);
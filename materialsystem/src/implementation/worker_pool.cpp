@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.materialsystem;
+
+import :worker_pool;
+
+pragma::material::WorkerPool::WorkerPool(uint32_t threadCount)
+{
+	threadCount = std::max(threadCount, 1u);
+	m_threads.reserve(threadCount);
+	for(auto i = decltype(threadCount) {0u}; i < threadCount; ++i)
+		m_threads.emplace_back([this]() { RunWorker(); });
+}
+pragma::material::WorkerPool::~WorkerPool()
+{
+	{
+		std::scoped_lock lock {m_taskMutex};
+		m_stop = true;
+	}
+	m_taskCondition.notify_all();
+	for(auto &t : m_threads)
+		t.join();
+}
+void pragma::material::WorkerPool::Enqueue(std::function<void()> task)
+{
+	{
+		std::scoped_lock lock {m_taskMutex};
+		m_tasks.push_back(std::move(task));
+	}
+	m_taskCondition.notify_one();
+}
+void pragma::material::WorkerPool::RunWorker()
+{
+	for(;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock lock {m_taskMutex};
+			m_taskCondition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+			if(m_tasks.empty())
+				return;
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
+void pragma::material::WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)> &f)
+{
+	if(count == 0)
+		return;
+	if(count == 1) {
+		f(0);
+		return;
+	}
+	struct State {
+		std::atomic<size_t> next = 0;
+		std::atomic<size_t> completed = 0;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::exception_ptr exception;
+	};
+	auto state = std::make_shared<State>();
+	// Helper tasks that are only started after all indices have been claimed return without touching 'f',
+	// so it's safe to reference it even though this function may have already returned by then.
+	auto run = [state, count, &f]() {
+		for(;;) {
+			auto i = state->next++;
+			if(i >= count)
+				return;
+			try {
+				f(i);
+			}
+			catch(...) {
+				std::scoped_lock lock {state->mutex};
+				if(!state->exception)
+					state->exception = std::current_exception();
+			}
+			if(++state->completed == count) {
+				std::scoped_lock lock {state->mutex};
+				state->condition.notify_all();
+			}
+		}
+	};
+	auto numHelpers = std::min<size_t>(count - 1, m_threads.size());
+	for(auto i = decltype(numHelpers) {0u}; i < numHelpers; ++i)
+		Enqueue(run);
+	run();
+
+	// All remaining indices are being processed by workers at this point, so this can't block indefinitely
+	std::unique_lock lock {state->mutex};
+	state->condition.wait(lock, [&state, count]() { return state->completed == count; });
+	if(state->exception)
+		std::rethrow_exception(state->exception);
+}
+
+pragma::material::WorkerPool &pragma::material::get_worker_pool()
+{
+	static WorkerPool pool {std::thread::hardware_concurrency()};
+	return pool;
+}
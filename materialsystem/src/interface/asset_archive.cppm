@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:asset_archive;
+
+export import pragma.filesystem;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Read-only archive for material and texture files.
+	// Layout: Header | IndexEntry[entryCount] (sorted by path) | string table | payloads (each aligned to Header::alignment)
+	class DLLMATSYS AssetArchive {
+	  public:
+		static constexpr std::array<char, 4> PMPK_IDENTIFIER = {'P', 'M', 'P', 'K'};
+		static constexpr uint32_t PMPK_VERSION = 1;
+		static constexpr auto FORMAT_ARCHIVE = "pmpk";
+		enum class Compression : uint8_t { None = 0, Lz4, Zlib };
+		struct Header {
+			std::array<char, 4> identifier;
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t alignment;
+			uint64_t stringTableSize;
+		};
+		struct IndexEntry {
+			uint64_t offset;
+			uint64_t storedSize;
+			uint64_t size;
+			uint32_t nameOffset;
+			uint32_t nameLength;
+			Compression compression;
+			std::array<uint8_t, 7> padding;
+		};
+		static_assert(sizeof(Header) == 24 && sizeof(IndexEntry) == 40);
+
+		// Paths are stored in lower-case with forward slashes
+		static std::string NormalizePath(const std::string &path);
+		static std::shared_ptr<AssetArchive> Open(const std::string &fileName, std::string &outErr);
+
+		const std::string &GetFileName() const { return m_fileName; }
+		size_t GetEntryCount() const { return m_entries.size(); }
+		std::string_view GetEntryPath(size_t idx) const;
+		const IndexEntry *FindEntry(const std::string &path) const;
+		bool Exists(const std::string &path) const { return FindEntry(path) != nullptr; }
+		// Reads and decompresses the entry. Thread-safe.
+		bool Read(const IndexEntry &entry, std::vector<uint8_t> &outData) const;
+		// Returns a memory-backed file with the decompressed contents of the entry, or nullptr if it doesn't exist
+		std::unique_ptr<ufile::IFile> OpenFile(const std::string &path) const;
+	  private:
+		AssetArchive() = default;
+		std::string m_fileName;
+		std::vector<IndexEntry> m_entries;
+		std::string m_stringTable;
+		mutable std::mutex m_fileMutex;
+		std::shared_ptr<fs::VFilePtrInternal> m_file;
+	};
+
+	// Creates asset archives, see also build_asset_archive
+	class DLLMATSYS AssetArchiveBuilder {
+	  public:
+		enum class CompressionMode : uint8_t {
+			None = 0,
+			Lz4,
+			Zlib,
+			// Compresses with zlib, but only keeps the result if it is at least 10% smaller (i.e. already compressed formats like png are stored as-is)
+			Auto,
+		};
+		AssetArchiveBuilder(uint32_t alignment = 16);
+		// Replaces the entry if a file with the same path has already been added
+		void AddFile(const std::string &path, std::vector<uint8_t> &&data, CompressionMode compression = CompressionMode::Auto);
+		bool AddFileFromDisk(const std::string &path, const std::string &diskPath, CompressionMode compression = CompressionMode::Auto);
+		bool Write(const std::string &fileName, std::string &outErr) const;
+	  private:
+		struct FileData {
+			std::vector<uint8_t> data;
+			uint64_t uncompressedSize = 0;
+			AssetArchive::Compression compression = AssetArchive::Compression::None;
+		};
+		uint32_t m_alignment;
+		std::map<std::string, FileData> m_files;
+	};
+	// Packs all material and texture files in the specified absolute directory. 'archiveRoot' is prepended to the relative paths of the files, i.e.
+	// to pack the materials directory, the call would look like build_asset_archive("<program path>/materials", "materials", "materials.pmpk").
+	DLLMATSYS bool build_asset_archive(const std::string &rootPath, const std::string &archiveRoot, const std::string &outFileName, std::string &outErr, AssetArchiveBuilder::CompressionMode compression = AssetArchiveBuilder::CompressionMode::Auto,
+	  uint32_t *optOutFileCount = nullptr);
+
+	// Mounted archives are searched by the material and texture managers before the regular file system.
+	// Archives that have been mounted last take precedence. Thread-safe.
+	DLLMATSYS void mount_asset_archive(const std::shared_ptr<AssetArchive> &archive);
+	DLLMATSYS void unmount_asset_archive(const AssetArchive &archive);
+	DLLMATSYS void unmount_all_asset_archives();
+	DLLMATSYS std::unique_ptr<ufile::IFile> open_archived_asset_file(const std::string &path);
+	DLLMATSYS bool archived_asset_file_exists(const std::string &path);
+#pragma warning(pop)
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:asset_dependency_graph;
+
+export import pragma.filesystem;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Keeps track of which assets depend on which other assets (e.g. materials on their base materials and textures).
+	// All methods are thread-safe.
+	class DLLMATSYS AssetDependencyGraph {
+	  public:
+		enum class AssetType : uint8_t { Material = 0, Texture };
+		struct DLLMATSYS AssetId {
+			AssetType type = AssetType::Material;
+			std::string name;
+			bool operator==(const AssetId &other) const { return type == other.type && name == other.name; }
+		};
+		struct DLLMATSYS AssetIdHash {
+			size_t operator()(const AssetId &id) const;
+		};
+
+		// Replaces all dependencies of the specified asset. The asset and its former dependencies remain in the graph until they're
+		// removed or collected, even if they have no edges left.
+		void SetDependencies(const AssetId &asset, const std::vector<AssetId> &dependencies);
+		void AddDependency(const AssetId &asset, const AssetId &dependency);
+		// Removes the asset and all of its outgoing edges. Assets depending on it will keep their edges to it.
+		void RemoveAsset(const AssetId &asset);
+		void Clear();
+
+		bool HasAsset(const AssetId &asset) const;
+		std::vector<AssetId> GetDependencies(const AssetId &asset) const;
+		std::vector<AssetId> GetDependents(const AssetId &asset) const;
+		// Returns all assets that directly or indirectly depend on the specified asset, in breadth-first order
+		std::vector<AssetId> GetTransitiveDependents(const AssetId &asset) const;
+
+		// Removes all assets that have no dependents and for which isInUse returns false. Dependencies of removed assets are
+		// checked again afterwards, so entire unused sub-graphs are collected. Returns the removed assets, which can then be evicted.
+		// Note: isInUse is called while the graph is locked and must not access the graph.
+		std::vector<AssetId> CollectUnused(const std::function<bool(const AssetId &)> &isInUse);
+
+		// Writes the graph in the Graphviz DOT format
+		void ExportDot(std::ostream &out) const;
+	  private:
+		struct Node {
+			std::unordered_set<AssetId, AssetIdHash> dependencies;
+			std::unordered_set<AssetId, AssetIdHash> dependents;
+		};
+		void RemoveOutgoingEdges(const AssetId &asset, Node &node);
+		void RemoveNodeIfOrphaned(const AssetId &asset);
+		mutable std::mutex m_mutex;
+		std::unordered_map<AssetId, Node, AssetIdHash> m_nodes;
+	};
+#pragma warning(pop)
+}
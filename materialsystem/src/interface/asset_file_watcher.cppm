@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:asset_file_watcher;
+
+export import pragma.filesystem;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Watches asset directories for file changes and triggers reloads of the affected assets.
+	// Currently only implemented for Linux (inotify), on other platforms the watcher will be invalid.
+	class DLLMATSYS AssetFileWatcher {
+	  public:
+		// Identifier is the file path relative to the watched directory, without the extension
+		using ReloadHandler = std::function<void(const std::string &identifier, const std::string &ext)>;
+		static std::unique_ptr<AssetFileWatcher> Create(std::chrono::milliseconds debounceTime = std::chrono::milliseconds {250});
+		~AssetFileWatcher();
+		bool IsValid() const;
+
+		// Watches the specified absolute directory path, including all of its sub-directories
+		bool AddDirectory(const std::string &path);
+		void AddHandler(const std::vector<std::string> &extensions, const ReloadHandler &handler);
+
+		// Collects pending file changes and invokes the handlers for all files that haven't been
+		// modified for at least the debounce time. Has to be called from the main thread.
+		void Poll();
+	  private:
+		struct WatchInfo {
+			std::string rootPath;
+			std::string relativePath;
+		};
+		AssetFileWatcher(std::chrono::milliseconds debounceTime);
+		bool AddWatch(const std::string &rootPath, const std::string &relativePath);
+		void ReadEvents();
+		void OnFileChanged(const std::string &relativePath);
+
+		int m_fd = -1;
+		std::chrono::milliseconds m_debounceTime;
+		std::unordered_map<int, WatchInfo> m_watches;
+		std::unordered_map<std::string, std::vector<ReloadHandler>> m_handlers;
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_pendingChanges;
+	};
+#pragma warning(pop)
+}
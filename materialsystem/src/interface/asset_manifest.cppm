@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:asset_manifest;
+
+export import :asset_dependency_graph;
+export import pragma.udm;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// List of the material and texture files used by a scene, which can be used to start loading all of them up-front
+	// the next time the scene is loaded (see MaterialManager::PrefetchManifest).
+	class DLLMATSYS AssetManifest {
+	  public:
+		static constexpr auto PMAN_IDENTIFIER = "PMAN";
+		static constexpr uint32_t PMAN_VERSION = 1;
+		static constexpr auto FORMAT_MANIFEST_BINARY = "pman_b";
+		static constexpr auto FORMAT_MANIFEST_ASCII = "pman";
+		struct DLLMATSYS Entry {
+			AssetDependencyGraph::AssetId id;
+			// Resolved file path relative to the program directory, including the extension
+			std::string filePath;
+			uint64_t fileSize = 0;
+		};
+		static std::shared_ptr<AssetManifest> Load(const std::string &fileName, std::string &outErr);
+
+		// Adds the entry if no entry for the same asset exists yet, returns false otherwise
+		bool AddEntry(const Entry &entry);
+		bool HasEntry(const AssetDependencyGraph::AssetId &id) const;
+		const std::vector<Entry> &GetEntries() const { return m_entries; }
+		void Clear();
+
+		bool Save(udm::AssetData outData, std::string &outErr) const;
+		bool Save(const std::string &fileName, std::string &outErr) const;
+		bool Load(const udm::AssetData &data, std::string &outErr);
+	  private:
+		std::vector<Entry> m_entries;
+		std::unordered_set<AssetDependencyGraph::AssetId, AssetDependencyGraph::AssetIdHash> m_ids;
+	};
+#pragma warning(pop)
+}
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:continuation;
+
+export import pragma.filesystem;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	enum class CallbackThread : uint8_t {
+		// The callback is executed on the thread that triggers it (or on the registering thread, if it has already been triggered)
+		Any = 0,
+		// The callback is deferred until the next call to dispatch_main_thread_callbacks (i.e. MaterialManager::Poll)
+		Main,
+	};
+
+	// Shared between a callback and the code that registered it. Once cancelled, the callback will never be executed,
+	// even if it has already been queued for the main thread.
+	class DLLMATSYS ContinuationHandle {
+	  public:
+		ContinuationHandle() = default;
+		ContinuationHandle(const std::shared_ptr<std::atomic<bool>> &cancelled);
+		void Cancel();
+		bool IsCancelled() const;
+		bool IsValid() const;
+	  private:
+		std::shared_ptr<std::atomic<bool>> m_cancelled;
+	};
+
+	// Thread-safe
+	DLLMATSYS void queue_main_thread_callback(const std::function<void()> &f);
+	// Executes all callbacks that have been queued with CallbackThread::Main. Has to be called from the main thread.
+	DLLMATSYS void dispatch_main_thread_callbacks();
+
+	namespace detail {
+		template<typename... TArgs>
+		struct ContinuationEntry {
+			std::function<void(TArgs...)> function;
+			CallbackThread thread = CallbackThread::Any;
+			std::shared_ptr<std::atomic<bool>> cancelled;
+			// Optional, for callbacks whose lifetime is tied to something else (e.g. a legacy CallbackHandle that may be removed at any time)
+			std::function<bool()> isExpired;
+			bool IsActive() const { return !*cancelled && (!isExpired || !isExpired()); }
+		};
+		template<typename... TArgs>
+		void invoke_continuation(const ContinuationEntry<TArgs...> &entry, const std::tuple<std::decay_t<TArgs>...> &args)
+		{
+			if(!entry.IsActive())
+				return;
+			if(entry.thread == CallbackThread::Main) {
+				queue_main_thread_callback([entry, args]() {
+					if(!entry.IsActive())
+						return;
+					std::apply(entry.function, args);
+				});
+				return;
+			}
+			std::apply(entry.function, args);
+		}
+	}
+
+	// One-shot callbacks for an operation that completes once (e.g. an asset finishing loading).
+	// Callbacks that are added after completion are executed immediately with the arguments that were passed to Complete,
+	// so the result doesn't depend on whether registration or completion happened first. All methods are thread-safe,
+	// callbacks are never executed while the internal lock is held, so they may add further callbacks.
+	// If 'isExpired' is specified, the callback is skipped and removed once it returns true.
+	template<typename... TArgs>
+	class ContinuationList {
+	  public:
+		using Function = std::function<void(TArgs...)>;
+		ContinuationHandle Add(const Function &f, CallbackThread thread = CallbackThread::Any, const std::function<bool()> &isExpired = nullptr)
+		{
+			detail::ContinuationEntry<TArgs...> entry {f, thread, std::make_shared<std::atomic<bool>>(false), isExpired};
+			ContinuationHandle handle {entry.cancelled};
+			std::unique_lock lock {m_mutex};
+			if(!m_result) {
+				// Callbacks that have been cancelled while waiting would otherwise accumulate until the list is completed
+				m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [](const detail::ContinuationEntry<TArgs...> &entry) { return !entry.IsActive(); }), m_pending.end());
+				m_pending.push_back(std::move(entry));
+				return handle;
+			}
+			auto args = *m_result;
+			lock.unlock();
+			detail::invoke_continuation(entry, args);
+			return handle;
+		}
+		// Executes all pending callbacks in the order they were added. Has no effect if the list has already been completed.
+		void Complete(TArgs... args)
+		{
+			std::vector<detail::ContinuationEntry<TArgs...>> pending;
+			std::tuple<std::decay_t<TArgs>...> result {args...};
+			{
+				std::scoped_lock lock {m_mutex};
+				if(m_result)
+					return;
+				m_result = result;
+				pending = std::move(m_pending);
+				m_pending.clear();
+			}
+			for(auto &entry : pending)
+				detail::invoke_continuation(entry, result);
+		}
+		// Returns the list to the pending state, callbacks added afterwards will wait for the next call to Complete
+		void Reset()
+		{
+			std::scoped_lock lock {m_mutex};
+			m_result = {};
+		}
+		// Cancels and removes all pending callbacks
+		void Clear()
+		{
+			std::scoped_lock lock {m_mutex};
+			for(auto &entry : m_pending)
+				*entry.cancelled = true;
+			m_pending.clear();
+		}
+		bool IsComplete() const
+		{
+			std::scoped_lock lock {m_mutex};
+			return m_result.has_value();
+		}
+		size_t GetPendingCount() const
+		{
+			std::scoped_lock lock {m_mutex};
+			return m_pending.size();
+		}
+	  private:
+		mutable std::mutex m_mutex;
+		std::vector<detail::ContinuationEntry<TArgs...>> m_pending;
+		std::optional<std::tuple<std::decay_t<TArgs>...>> m_result {};
+	};
+
+	// Callbacks for events that can occur any number of times. Thread-safe, callbacks are executed outside of the lock.
+	// Cancelled and expired callbacks are removed when the list is invoked or a callback is added.
+	template<typename... TArgs>
+	class CallbackList {
+	  public:
+		using Function = std::function<void(TArgs...)>;
+		ContinuationHandle Add(const Function &f, CallbackThread thread = CallbackThread::Any, const std::function<bool()> &isExpired = nullptr)
+		{
+			detail::ContinuationEntry<TArgs...> entry {f, thread, std::make_shared<std::atomic<bool>>(false), isExpired};
+			ContinuationHandle handle {entry.cancelled};
+			std::scoped_lock lock {m_mutex};
+			// Some events are rarely invoked, while callbacks may be added and removed repeatedly in the meantime
+			RemoveInactiveEntries();
+			m_entries.push_back(std::move(entry));
+			return handle;
+		}
+		void Invoke(TArgs... args)
+		{
+			std::vector<detail::ContinuationEntry<TArgs...>> entries;
+			{
+				std::scoped_lock lock {m_mutex};
+				RemoveInactiveEntries();
+				entries = m_entries;
+			}
+			std::tuple<std::decay_t<TArgs>...> tArgs {args...};
+			for(auto &entry : entries)
+				detail::invoke_continuation(entry, tArgs);
+		}
+		void Clear()
+		{
+			std::scoped_lock lock {m_mutex};
+			for(auto &entry : m_entries)
+				*entry.cancelled = true;
+			m_entries.clear();
+		}
+		size_t GetSize() const
+		{
+			std::scoped_lock lock {m_mutex};
+			return m_entries.size();
+		}
+	  private:
+		void RemoveInactiveEntries()
+		{
+			m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const detail::ContinuationEntry<TArgs...> &entry) { return !entry.IsActive(); }), m_entries.end());
+		}
+		mutable std::mutex m_mutex;
+		std::vector<detail::ContinuationEntry<TArgs...>> m_entries;
+	};
+#pragma warning(pop)
+}
@@ -6,3 +6,4 @@ module;
 export module pragma.materialsystem:format_handlers;
 export import :format_handlers.source_vmt;
 export import :format_handlers.source2_vmat;
+export import :format_handlers.source2_vmat_mapping;
@@ -4,6 +4,7 @@
 export module pragma.materialsystem:format_handlers.source2_vmat;
 
 import pragma.datasystem;
+export import :import_diagnostics;
 import source2;
 
 #ifndef DISABLE_VMAT_SUPPORT
@@ -16,6 +17,8 @@ export namespace pragma::material {
 	  protected:
 		virtual bool ImportTexture(const std::string &fpath, const std::string &outputPath) { return false; }
 		virtual bool InitializeVMatData(source2::resource::Resource &resource, source2::resource::Material &vmat, datasystem::Block &rootData, datasystem::Settings &settings, const std::string &shader, VMatOrigin origin);
+		// Set if the import has failed for a reason other than a conversion error
+		ImportErrorClass m_errorClass = ImportErrorClass::None;
 	  private:
 		bool LoadVMat(source2::resource::Resource &resource, const std::string &outputPath, std::string &outFilePath);
 	};
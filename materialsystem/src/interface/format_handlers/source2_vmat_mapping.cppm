@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:format_handlers.source2_vmat_mapping;
+
+export import :format_handlers.source2_vmat;
+import pragma.datasystem;
+import source2;
+
+#ifndef DISABLE_VMAT_SUPPORT
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Describes how the parameters of a family of Source 2 shaders translate to Pragma material properties
+	struct DLLMATSYS Source2VmatShaderMapping {
+		struct TextureMapping {
+			// The first parameter that exists in the vmat is used
+			std::vector<std::string> parameters;
+			std::string key;
+		};
+		struct ValueMapping {
+			enum class Type : uint8_t {
+				Float = 0,
+				Int,
+				VectorX, // First component of a vector parameter as float
+				Vector3,
+				Vector4,
+			};
+			std::string parameter;
+			std::string key;
+			Type type = Type::Float;
+			// If set, the value is only applied if the vmat does not have this texture parameter. Source 2 materials
+			// often contain constant values (e.g. "TextureRoughnessA") that are only used if no texture has been assigned.
+			std::string unlessTexture = {};
+		};
+		std::string name;
+		std::vector<std::string> shaders;
+		VMatOrigin origin = VMatOrigin::Source2;
+		std::string materialShader = "pbr";
+		std::vector<TextureMapping> textures;
+		std::vector<ValueMapping> values;
+		// Parameters that are handled elsewhere (e.g. the texture conversions in the client-side import) or that intentionally have no equivalent
+		std::vector<std::string> knownParameters;
+
+		bool IsKnownParameter(const std::string &parameter) const;
+	};
+
+	// Structured information about the parts of a vmat that could not be translated during an import
+	struct DLLMATSYS Source2VmatImportReport {
+		enum class ParameterType : uint8_t { Int = 0, Float, Vector, Texture };
+		struct Parameter {
+			ParameterType type;
+			std::string name;
+			std::string value;
+		};
+		std::string fileName;
+		std::string shader;
+		// True if there is no mapping for the shader, in which case the generic Source 2 mapping has been used
+		bool unknownShader = false;
+		std::vector<Parameter> unmappedParameters;
+
+		bool IsEmpty() const { return !unknownShader && unmappedParameters.empty(); }
+	};
+	using Source2VmatImportReportCallback = std::function<void(const Source2VmatImportReport &)>;
+	// Called for every imported vmat that has unmapped parameters or an unknown shader
+	DLLMATSYS void set_source2_vmat_import_report_callback(const Source2VmatImportReportCallback &callback);
+	// If enabled, reports are printed as warnings if no callback is set. Disabled by default, since most materials contain engine-only
+	// parameters (e.g. F_* flags) that have no equivalent.
+	DLLMATSYS void set_source2_vmat_import_report_warnings_enabled(bool enabled);
+	DLLMATSYS bool are_source2_vmat_import_report_warnings_enabled();
+	DLLMATSYS void report_source2_vmat_import(const Source2VmatImportReport &report);
+
+	DLLMATSYS const std::vector<Source2VmatShaderMapping> &get_source2_vmat_shader_mappings();
+	// Mapping that is used for shaders without a dedicated mapping
+	DLLMATSYS const Source2VmatShaderMapping &get_default_source2_vmat_shader_mapping();
+	DLLMATSYS const Source2VmatShaderMapping *find_source2_vmat_shader_mapping(const std::string &shader);
+
+	// Writes the mapped textures and values of the vmat to the material data. 'loadTexture' translates (and imports) a vmat texture path and returns the Pragma texture path.
+	DLLMATSYS void apply_source2_vmat_shader_mapping(const Source2VmatShaderMapping &mapping, source2::resource::Material &vmat, datasystem::Block &rootData, datasystem::Settings &settings, const std::function<std::string(const std::string &)> &loadTexture);
+	DLLMATSYS std::vector<Source2VmatImportReport::Parameter> find_unmapped_source2_vmat_parameters(const Source2VmatShaderMapping &mapping, source2::resource::Material &vmat);
+#pragma warning(pop)
+};
+#endif
@@ -12,6 +12,7 @@ export module pragma.materialsystem:format_handlers.source_vmt;
 import pragma.datasystem;
 import pragma.math;
 export import pragma.util;
+export import :import_diagnostics;
 #define ENABLE_VKV_PARSER
 #ifdef ENABLE_VKV_PARSER
 import REDxEYE.VKVParser;
@@ -58,6 +59,8 @@ export namespace pragma::material {
 		bool LoadVMT(const IVmtNode &rootNode, const std::string &outputPath, std::string &outFilePath);
 
 		std::shared_ptr<IVmtNode> m_rootNode;
+		// Set if the import has failed for a reason other than a conversion error
+		ImportErrorClass m_errorClass = ImportErrorClass::None;
 	};
 	class DLLMATSYS SourceVmtFormatHandler : public ISourceVmtFormatHandler {
 	  public:
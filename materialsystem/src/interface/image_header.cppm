@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:image_header;
+
+export import :enums;
+export import pragma.filesystem;
+
+export namespace pragma::material {
+	struct DLLMATSYS ImageHeaderInfo {
+		TextureType type = TextureType::Invalid;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipmapCount = 1;
+		uint32_t layerCount = 1;
+		bool cubemap = false;
+		// Format identifier as stored in the file, its meaning depends on the type:
+		// DDS: DXGI format if a DX10 header is present, otherwise FourCC (or bit count for uncompressed formats)
+		// KTX: glInternalFormat (KTX1) / VkFormat (KTX2)
+		// VTF: VTFImageFormat
+		// VTex: source2::VTexFormat
+		// PNG: color type | (bit depth << 8)
+		// TGA: pixel depth | (image type << 8)
+		// JPG: component count | (precision << 8)
+		uint32_t format = 0;
+	};
+	// Number of bytes read up-front by probe_image_header. The headers of all supported formats except JPG and vtex_c are guaranteed to fit,
+	// those may require additional reads.
+	constexpr size_t IMAGE_HEADER_PROBE_SIZE = 512;
+
+	// Parses the image header from the beginning of an image file. Does not allocate any memory.
+	// 'type' is only used as a hint for formats without a magic number (i.e. TGA and vtex_c).
+	DLLMATSYS bool parse_image_header(const void *data, size_t size, TextureType type, ImageHeaderInfo &outInfo);
+	// Reads the image header of the specified file. Results are cached by file path.
+	DLLMATSYS bool probe_image_header(const std::string &fileName, ImageHeaderInfo &outInfo, bool useCache = true);
+	DLLMATSYS bool probe_image_header(std::shared_ptr<fs::VFilePtrInternal> &f, TextureType type, ImageHeaderInfo &outInfo);
+	DLLMATSYS void invalidate_image_header_cache(const std::string &fileName);
+	DLLMATSYS void clear_image_header_cache();
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:import_diagnostics;
+
+export import pragma.udm;
+
+export namespace pragma::material {
+	enum class ImportErrorClass : uint8_t {
+		None = 0,
+		ReadError,       // Source file is empty or could not be read
+		ParseError,      // Source file could not be parsed (VTFLib, KeyValues or Source 2 resource parser)
+		InvalidData,     // Source file was parsed, but does not contain the expected data
+		ConversionError, // Source data could not be translated to a Pragma asset
+		SaveError,       // Converted asset could not be written
+	};
+	struct DLLMATSYS ImportRecord {
+		// Location of the source file. For files inside of an archive this is the path within the archive.
+		std::string sourceFile;
+		std::string outputPath;
+		// Format extension of the import handler, e.g. "vmt"
+		std::string handler;
+		ImportErrorClass errorClass = ImportErrorClass::None;
+		std::string message;
+		// Identify the version of the source file, a failed import is only retried once these have changed
+		uint64_t sourceSize = 0;
+		uint64_t sourceHash = 0;
+		std::chrono::nanoseconds duration {0};
+
+		bool IsSuccessful() const { return errorClass == ImportErrorClass::None; }
+	};
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Keeps track of the results of all asset imports, as well as a failure cache that prevents imports that have already failed from
+	// being executed again on every request, as long as the source file hasn't changed. The failure cache can be saved and loaded,
+	// so that it persists between sessions. Thread-safe.
+	class DLLMATSYS ImportDiagnostics {
+	  public:
+		static constexpr auto PIFC_IDENTIFIER = "PIFC";
+		static constexpr uint32_t PIFC_VERSION = 1;
+		static constexpr auto FORMAT_FAILURE_CACHE_BINARY = "pifc_b";
+		static constexpr auto FORMAT_FAILURE_CACHE_ASCII = "pifc";
+		using RecordCallback = std::function<void(const ImportRecord &)>;
+
+		static uint64_t CalcSourceHash(const void *data, size_t size);
+		// Only failures that are caused by the source file itself are cached. Other failures (e.g. a missing texture or a full disk)
+		// may be resolved without the source file changing, so those imports are always retried.
+		static bool IsCacheableFailure(ImportErrorClass errorClass);
+
+		// Executes 'import' and records the result. 'record' has to contain the source information, 'import' returns the error class
+		// and may write a message to 'inOutErr'. If an import of the same source data has failed before, 'import' is skipped and
+		// the previous error is returned instead.
+		bool Execute(ImportRecord record, std::string &inOutErr, const std::function<ImportErrorClass()> &import);
+		// Records the result of an import that has been executed elsewhere. Failures without source hash are not added to the failure cache.
+		// A successful or non-cacheable result removes the source file from the failure cache.
+		void AddRecord(const ImportRecord &record);
+
+		// Returns the most recent record for the specified source file
+		std::optional<ImportRecord> FindRecord(const std::string &sourceFile) const;
+		std::vector<ImportRecord> GetRecords() const;
+		std::vector<ImportRecord> GetFailures() const;
+		bool IsKnownFailure(const std::string &sourceFile, uint64_t sourceSize, uint64_t sourceHash) const;
+		// Removes the source file from the failure cache, so the next import is executed regardless
+		void ForgetFailure(const std::string &sourceFile);
+		void ClearRecords();
+		void ClearFailures();
+		// Number of imports that have been skipped because of the failure cache
+		uint32_t GetSkippedImportCount() const { return m_skippedImportCount; }
+		// Called for every new record (not for skipped imports). The callback may be invoked from the loader threads.
+		void SetRecordCallback(const RecordCallback &callback);
+
+		bool SaveFailureCache(udm::AssetData outData, std::string &outErr) const;
+		bool SaveFailureCache(const std::string &fileName, std::string &outErr) const;
+		bool LoadFailureCache(const udm::AssetData &data, std::string &outErr);
+		bool LoadFailureCache(const std::string &fileName, std::string &outErr);
+	  private:
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, ImportRecord> m_records;
+		std::unordered_map<std::string, ImportRecord> m_failures;
+		RecordCallback m_recordCallback = nullptr;
+		std::atomic<uint32_t> m_skippedImportCount = 0;
+	};
+#pragma warning(pop)
+
+	// Creates a record for an import of the specified source data, 'handler' is the format extension of the import handler
+	DLLMATSYS ImportRecord create_import_record(ufile::IFile &f, const std::string &handler, const std::string &outputPath, const void *data, size_t size);
+}
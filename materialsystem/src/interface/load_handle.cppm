@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:load_handle;
+
+export import :continuation;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	enum class LoadState : uint8_t { Pending = 0, Succeeded, Failed };
+
+	class LoadPromise;
+	// Future-like handle for an asynchronous asset load. Handles are cheap to copy, all copies refer to the same load.
+	class DLLMATSYS LoadHandle {
+	  public:
+		static LoadHandle CreateCompleted(bool success);
+		LoadHandle() = default;
+		bool IsValid() const;
+		LoadState GetState() const;
+		bool IsReady() const;
+		bool IsSuccessful() const;
+		// Returns the progress in the range [0,1]. Loads that depend on other loads (see when_all) report the average progress of their dependencies.
+		float GetProgress() const;
+		// Blocks until the load has completed or the timeout has expired and returns true if the load has completed.
+		// Loads are finalized on the main thread, so these must not be called from the main thread, use MaterialManager::WaitForLoad instead.
+		bool Wait(std::chrono::milliseconds timeout) const;
+		void Wait() const;
+		// The callback receives whether the load was successful. If the load has already completed, it is executed immediately (or queued, for CallbackThread::Main).
+		ContinuationHandle Then(const std::function<void(bool)> &f, CallbackThread thread = CallbackThread::Any) const;
+	  private:
+		friend LoadPromise;
+		struct State;
+		LoadHandle(const std::shared_ptr<State> &state);
+		std::shared_ptr<State> m_state;
+	};
+
+	// Producer side of a LoadHandle
+	class DLLMATSYS LoadPromise {
+	  public:
+		LoadPromise();
+		LoadHandle GetHandle() const;
+		void SetProgress(float progress);
+		// The progress of the specified load will be included in the progress of this one
+		void AddDependency(const LoadHandle &handle);
+		// Has no effect if the promise has already been completed
+		void Complete(bool success);
+	  private:
+		std::shared_ptr<LoadHandle::State> m_state;
+	};
+
+	// Returns a handle that completes once all of the specified loads have completed. The result is only successful if all loads were successful.
+	DLLMATSYS LoadHandle when_all(const std::vector<LoadHandle> &handles);
+
+	// Keeps track of the pending loads of an asset manager by asset identifier. Thread-safe.
+	class DLLMATSYS PendingLoadRegistry {
+	  public:
+		// Returns the handle for the load of the specified asset. The second value is true if no load was pending and it has to be started by the caller.
+		std::pair<LoadHandle, bool> Add(const std::string &identifier);
+		void Complete(const std::string &identifier, bool success);
+		// Completes all pending loads
+		void Clear(bool success = false);
+		bool IsPending(const std::string &identifier) const;
+	  private:
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, LoadPromise> m_pending;
+	};
+#pragma warning(pop)
+}
@@ -8,6 +8,7 @@ module;
 
 export module pragma.materialsystem:material;
 
+export import :continuation;
 export import :texture_info;
 export import pragma.datasystem;
 export import pragma.udm;
@@ -236,7 +237,10 @@ export {
 
 			virtual void SetLoaded(bool b);
 			CallbackHandle CallOnLoaded(const std::function<void(void)> &f) const;
+			// Thread-safe. If the material has already been loaded, the callback is executed immediately (or queued, for CallbackThread::Main).
+			ContinuationHandle CallOnLoaded(const std::function<void(void)> &f, CallbackThread thread) const;
 			CallbackHandle AddEventListener(Event event, const std::function<void(void)> &f);
+			ContinuationHandle AddEventListener(Event event, const std::function<void(void)> &f, CallbackThread thread);
 			bool IsValid() const;
 			MaterialManager &GetManager() const;
 			std::optional<std::string> GetAbsolutePath() const;
@@ -295,8 +299,8 @@ export {
 			std::string m_name;
 			std::shared_ptr<datasystem::Block> m_data;
 			StateFlags m_stateFlags = StateFlags::None;
-			mutable std::vector<CallbackHandle> m_callOnLoaded;
-			std::unordered_map<Event, std::vector<CallbackHandle>> m_eventListeners;
+			mutable ContinuationList<> m_onLoaded;
+			std::array<CallbackList<>, static_cast<size_t>(Event::Count)> m_eventListeners;
 			MaterialManager &m_manager;
 			TextureInfo *m_texDiffuse = nullptr;
 			TextureInfo *m_texNormal = nullptr;
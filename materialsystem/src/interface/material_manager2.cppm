@@ -3,16 +3,27 @@
 
 export module pragma.materialsystem:material_manager2;
 
+export import :asset_archive;
+export import :asset_dependency_graph;
+export import :asset_file_watcher;
+export import :asset_manifest;
+export import :import_diagnostics;
+export import :load_handle;
 export import :material;
 
 export namespace pragma::material {
 	DLLMATSYS void set_use_vkv_vmt_parser(bool useVkvParser);
 	DLLMATSYS bool should_use_vkv_vmt_parser();
 	DLLMATSYS bool udm_to_data_block(udm::LinkedPropertyWrapper &udmDataRoot, datasystem::Block &root);
+	// Data settings shared by all material data blocks created by the material loaders.
+	// The settings are never modified after creation, so they can be used from any thread.
+	DLLMATSYS const std::shared_ptr<datasystem::Settings> &get_shared_data_settings();
 	class DLLMATSYS MaterialProcessor : public pragma::util::FileAssetProcessor {
 	  public:
 		MaterialProcessor(pragma::util::AssetFormatLoader &loader, std::unique_ptr<pragma::util::IAssetFormatHandler> &&handler);
+		// Parses the material file, executed on one of the loader's worker threads
 		virtual bool Load() override;
+		// Creates the material object and links the base material, executed on the main thread
 		virtual bool Finalize() override;
 
 		std::shared_ptr<Material> material = nullptr;
@@ -50,27 +61,86 @@ export namespace pragma::material {
 	class DLLMATSYS MaterialManager : public pragma::util::TFileAssetManager<Material, MaterialLoadInfo> {
 	  public:
 		static std::shared_ptr<MaterialManager> Create();
+		// Suggested location of the import failure cache, see SetImportFailureCacheFile
+		static constexpr auto DEFAULT_IMPORT_FAILURE_CACHE_FILE = "cache/materials/import_failures.pifc_b";
 		virtual ~MaterialManager() = default;
 
 		void SetErrorMaterial(Material *mat);
 		Material *GetErrorMaterial() const;
 
 		std::shared_ptr<Material> ReloadAsset(const std::string &path, std::unique_ptr<MaterialLoadInfo> &&loadInfo = nullptr, PreloadResult *optOutResult = nullptr);
+		// Starts loading the material in the background. The returned handle is completed on the main thread (during Poll) once the material
+		// has been initialized, or on the loader thread if loading has failed.
+		LoadHandle LoadAssetAsync(const std::string &path, std::unique_ptr<MaterialLoadInfo> &&loadInfo = nullptr);
+		// Polls the manager until the load has completed or the timeout has expired. Has to be called from the main thread.
+		bool WaitForLoad(const LoadHandle &handle, std::chrono::milliseconds timeout);
+		// Loads all of the specified materials concurrently and waits until they have completed, or until the timeout has expired.
+		// Has to be called from the main thread. Returns the number of materials that have been loaded successfully.
+		uint32_t LoadAssetBatch(const std::vector<std::string> &materials, std::chrono::milliseconds timeout, bool *optOutTimedOut = nullptr);
 
 		std::shared_ptr<datasystem::Settings> CreateDataSettings() const;
 		virtual std::shared_ptr<Material> CreateMaterial(const std::string &shader, const std::shared_ptr<datasystem::Block> &data);
 		virtual std::shared_ptr<Material> CreateMaterial(const udm::AssetData &data, std::string &outErr);
 		std::shared_ptr<Material> CreateMaterial(const std::string &identifier, const std::string &shader, const std::shared_ptr<datasystem::Block> &data);
+
+		// Enables automatic reloading of assets when their files have changed. The directories to watch
+		// have to be added to the watcher via GetFileWatcher()->AddDirectory.
+		bool SetFileWatcherEnabled(bool enabled);
+		AssetFileWatcher *GetFileWatcher() { return m_fileWatcher.get(); }
+		virtual void Poll() override;
+
+		AssetDependencyGraph &GetDependencyGraph() { return m_dependencyGraph; }
+		const AssetDependencyGraph &GetDependencyGraph() const { return m_dependencyGraph; }
+		// Updates the dependencies of the material in the dependency graph, has to be called whenever the material's base material or textures change
+		void UpdateDependencies(const Material &mat);
+		// Removes all assets that are no longer referenced by anything other than the caches from the dependency graph and evicts them
+		// from the material and texture caches. Materials and textures depending on each other are collected together. Returns the evicted assets.
+		std::vector<AssetDependencyGraph::AssetId> CollectUnusedAssets();
+		// Reloads all loaded materials that directly depend on the specified asset
+		void ReloadDependents(const AssetDependencyGraph::AssetId &id);
+
+		// Records all materials that are loaded from here on, as well as their base materials and textures, until EndManifestRecording is called
+		void BeginManifestRecording();
+		std::shared_ptr<AssetManifest> EndManifestRecording();
+		bool IsRecordingManifest() const { return m_manifestRecording != nullptr; }
+		// Starts loading all assets listed in the manifest in the background. Entries for files that no longer exist are skipped,
+		// entries for files that have changed since the manifest was recorded are loaded regardless. The returned handle completes once all
+		// prefetched assets have been loaded.
+		LoadHandle PrefetchManifest(const AssetManifest &manifest, uint32_t *optOutStaleCount = nullptr);
+
+		// Results of the vmt and vmat imports, including the failure cache that prevents failed imports from being retried
+		ImportDiagnostics &GetImportDiagnostics() { return m_importDiagnostics; }
+		const ImportDiagnostics &GetImportDiagnostics() const { return m_importDiagnostics; }
+		// Sets the file the import failure cache is persisted in and loads the cache from it, if the file exists. An empty path (default)
+		// disables persistence. Managers that share a file overwrite each other's cache, so only one of them should use it.
+		void SetImportFailureCacheFile(const std::string &fileName);
+		const std::string &GetImportFailureCacheFile() const { return m_importFailureCacheFile; }
+		// Has to be called explicitly by the owner of the manager (e.g. on shutdown), returns false if persistence is disabled or the file could not be written
+		bool SaveImportFailureCache() const;
 	  protected:
 		friend MaterialProcessor;
 		MaterialManager();
 		virtual void Reset() override;
 		virtual void Initialize();
 		virtual void InitializeImportHandlers();
+		virtual void InitializeFileWatcher(AssetFileWatcher &watcher);
+		virtual bool IsAssetInUse(const AssetDependencyGraph::AssetId &id);
+		virtual void EvictAsset(const AssetDependencyGraph::AssetId &id);
+		virtual std::optional<std::string> ResolveAssetFilePath(const AssetDependencyGraph::AssetId &id);
+		virtual LoadHandle PrefetchAsset(const AssetDependencyGraph::AssetId &id);
+		void RecordManifestEntry(const std::string &identifier);
 		virtual void InitializeProcessor(pragma::util::IAssetProcessor &processor) override;
 		virtual std::shared_ptr<Material> CreateMaterialObject(const std::string &shader, const std::shared_ptr<datasystem::Block> &data);
 		virtual pragma::util::AssetObject InitializeAsset(const pragma::util::Asset &asset, const pragma::util::AssetLoadJob &job) override;
 		virtual pragma::util::AssetObject ReloadAsset(const std::string &path, std::unique_ptr<pragma::util::AssetLoadInfo> &&loadInfo, PreloadResult *optOutResult = nullptr) override;
 		MaterialHandle m_error;
+		std::unique_ptr<AssetFileWatcher> m_fileWatcher;
+		AssetDependencyGraph m_dependencyGraph;
+		PendingLoadRegistry m_pendingLoads;
+		// Materials that have been initialized since the last Poll, only accessed from the main thread
+		std::vector<std::string> m_completedLoads;
+		std::unique_ptr<std::vector<std::string>> m_manifestRecording;
+		ImportDiagnostics m_importDiagnostics;
+		std::string m_importFailureCacheFile;
 	};
 };
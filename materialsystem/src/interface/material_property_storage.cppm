@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:material_property_storage;
+
+export import :material;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Storage of the property tree of a material. Paths use '/' as separator, and blocks have to be added (see AddBlock) before
+	// values can be assigned to them. Values are normalized to the underlying property types when they are set and converted to the
+	// requested type when they are read, in the same way as Material::SetProperty and Material::GetProperty do.
+	class DLLMATSYS IMaterialPropertyStorage {
+	  public:
+		// One of the underlying property types (see is_underlying_property_udm_type)
+		using Value = std::variant<udm::String, udm::Int32, udm::Float, udm::Boolean, udm::Vector2, udm::Vector3, udm::Vector4>;
+
+		virtual ~IMaterialPropertyStorage() = default;
+		template<typename T>
+		    requires(is_property_type<T>)
+		void SetProperty(const std::string_view &path, const T &value);
+		template<typename TTarget>
+		    requires(is_property_type<TTarget>)
+		bool GetProperty(const std::string_view &path, TTarget *outValue) const;
+		template<typename TTarget>
+		    requires(is_property_type<TTarget>)
+		TTarget GetProperty(const std::string_view &path, const TTarget &defVal) const;
+
+		// Returns false if the parent block does not exist
+		virtual bool AddBlock(const std::string_view &path) = 0;
+		virtual void SetTextureProperty(const std::string_view &path, const std::string_view &tex) = 0;
+		virtual void ClearProperty(const std::string_view &path) = 0;
+		virtual PropertyType GetPropertyType(const std::string_view &path) const = 0;
+		// Writes the properties in the layout of the pmat format, i.e. textures to the "textures" element and everything else to "properties"
+		virtual void Save(udm::LinkedPropertyWrapper &udm) const = 0;
+
+		virtual void SetValue(const std::string_view &path, Value &&value) = 0;
+		// Texture properties are returned as their texture path
+		virtual std::optional<Value> GetValue(const std::string_view &path) const = 0;
+	};
+
+	// The data system block tree, which is used by Material
+	class DLLMATSYS DataBlockPropertyStorage : public IMaterialPropertyStorage {
+	  public:
+		DataBlockPropertyStorage(const std::shared_ptr<datasystem::Block> &data);
+		const std::shared_ptr<datasystem::Block> &GetData() const { return m_data; }
+
+		virtual bool AddBlock(const std::string_view &path) override;
+		virtual void SetTextureProperty(const std::string_view &path, const std::string_view &tex) override;
+		virtual void ClearProperty(const std::string_view &path) override;
+		virtual PropertyType GetPropertyType(const std::string_view &path) const override;
+		virtual void Save(udm::LinkedPropertyWrapper &udm) const override;
+
+		virtual void SetValue(const std::string_view &path, Value &&value) override;
+		virtual std::optional<Value> GetValue(const std::string_view &path) const override;
+	  private:
+		std::pair<std::shared_ptr<datasystem::Block>, std::string> ResolvePath(const std::string_view &path) const;
+		std::shared_ptr<datasystem::Block> m_data;
+	};
+
+	// Keeps the properties as UDM data in the layout of the pmat format. Typed values are stored in their binary representation,
+	// and properties loaded from a pmat file keep their original UDM type, so saving doesn't require any conversions.
+	// Textures can only be assigned at the top level, since the pmat format has no nested textures.
+	class DLLMATSYS UdmPropertyStorage : public IMaterialPropertyStorage {
+	  public:
+		UdmPropertyStorage();
+		// Takes over the "textures" and "properties" of a material element of a pmat file
+		void Load(const udm::LinkedPropertyWrapper &udm);
+		// Converts the properties to a data block, which can be used to create a Material
+		bool ToDataBlock(datasystem::Block &outBlock) const;
+
+		virtual bool AddBlock(const std::string_view &path) override;
+		virtual void SetTextureProperty(const std::string_view &path, const std::string_view &tex) override;
+		virtual void ClearProperty(const std::string_view &path) override;
+		virtual PropertyType GetPropertyType(const std::string_view &path) const override;
+		virtual void Save(udm::LinkedPropertyWrapper &udm) const override;
+
+		virtual void SetValue(const std::string_view &path, Value &&value) override;
+		virtual std::optional<Value> GetValue(const std::string_view &path) const override;
+	  private:
+		udm::LinkedPropertyWrapper GetRoot() const;
+		// Returns the element the last path segment belongs to, as well as the last path segment
+		std::pair<udm::LinkedPropertyWrapper, std::string> ResolvePath(const std::string_view &path) const;
+		udm::LinkedPropertyWrapper FindProperty(const std::string_view &path) const;
+		std::shared_ptr<udm::Data> m_udmData;
+	};
+#pragma warning(pop)
+
+	template<typename T>
+	    requires(is_property_type<T>)
+	void IMaterialPropertyStorage::SetProperty(const std::string_view &path, const T &value)
+	{
+		if constexpr(std::is_same_v<T, Quat>)
+			SetProperty(path, EulerAngles {value});
+		else {
+			constexpr auto normalizedUdmType = to_udm_type(to_ds_type(udm::type_to_enum<T>()));
+			udm::visit(normalizedUdmType, [&](auto tag) {
+				using TNorm = typename decltype(tag)::type;
+				if constexpr(is_underlying_property_udm_type<TNorm> && udm::is_convertible<T, TNorm>())
+					SetValue(path, Value {std::in_place_type<TNorm>, udm::convert<T, TNorm>(value)});
+			});
+		}
+	}
+	template<typename TTarget>
+	    requires(is_property_type<TTarget>)
+	bool IMaterialPropertyStorage::GetProperty(const std::string_view &path, TTarget *outValue) const
+	{
+		auto value = GetValue(path);
+		if(!value.has_value())
+			return false;
+		return std::visit(
+		  [outValue](const auto &v) -> bool {
+			  using TSource = std::decay_t<decltype(v)>;
+			  if constexpr(udm::is_convertible<TSource, TTarget>()) {
+				  *outValue = udm::convert<TSource, TTarget>(v);
+				  return true;
+			  }
+			  else
+				  return false;
+		  },
+		  *value);
+	}
+	template<typename TTarget>
+	    requires(is_property_type<TTarget>)
+	TTarget IMaterialPropertyStorage::GetProperty(const std::string_view &path, const TTarget &defVal) const
+	{
+		TTarget val;
+		if(GetProperty<TTarget>(path, &val))
+			return val;
+		return defVal;
+	}
+}
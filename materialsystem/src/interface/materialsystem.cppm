@@ -4,17 +4,27 @@
 module;
 
 export module pragma.materialsystem;
+export import :asset_archive;
+export import :asset_dependency_graph;
+export import :asset_file_watcher;
+export import :asset_manifest;
+export import :continuation;
 export import :enums;
 export import :format_handlers;
+export import :image_header;
+export import :import_diagnostics;
+export import :load_handle;
 export import :material;
 export import :material_manager;
 export import :material_manager2;
 export import :material_property_block_view;
+export import :material_property_storage;
 export import :png_info;
 export import :texture_info;
 export import :util;
 export import :vmat;
 export import :vmt;
+export import :worker_pool;
 
 export namespace pragma::msys {
     using namespace material;
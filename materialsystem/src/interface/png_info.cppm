@@ -11,14 +11,15 @@ export import pragma.filesystem;
 
 export namespace pragma::material {
 	struct DLLMATSYS PNGInfo {
-		uint32_t format; // vk::Format
-		unsigned int width;
-		unsigned int height;
-		png_byte *image_data;
-		png_structp png_ptr;
-		png_infop info_ptr;
-		png_infop end_info;
-		png_byte **row_pointers;
+		uint32_t format = 0; // vk::Format
+		unsigned int width = 0;
+		unsigned int height = 0;
+		png_byte *image_data = nullptr;
+		png_structp png_ptr = nullptr;
+		png_infop info_ptr = nullptr;
+		png_infop end_info = nullptr;
+		png_byte **row_pointers = nullptr;
+		// Frees all resources, can be called multiple times
 		void Release();
 	};
 
@@ -11,11 +11,27 @@ export {
 	struct DLLMATSYS TextureInfo {
 		TextureInfo();
 		TextureInfo(const TextureInfo &other);
+		// Width and height are resolved lazily from the image header, or filled in by the texture manager once the
+		// image has been loaded. Until then, both are 0. If the header can't be read, the size remains unresolved (so
+		// the texture manager can still fill it in), but the header lookup isn't repeated.
+		bool IsSizeResolved() const { return sizeResolved; }
+		void SetSize(uint32_t width, uint32_t height);
+		bool ResolveSize();
+		uint32_t GetWidth();
+		uint32_t GetHeight();
+
 		std::string name;
 		unsigned int width;
 		unsigned int height;
 		std::shared_ptr<void> texture;
 		std::shared_ptr<void> userData;
+		bool sizeResolved = false;
+		bool sizeLookupFailed = false;
+	};
+
+	namespace pragma::material {
+		// Resolves the sizes of all specified textures, reading each image header only once
+		DLLMATSYS void resolve_texture_sizes(const std::vector<TextureInfo *> &textures);
 	};
 
 	namespace pragma::datasystem {
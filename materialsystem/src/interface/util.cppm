@@ -9,4 +9,10 @@ export import pragma.filesystem;
 export namespace pragma::material {
 	DLLMATSYS std::string translate_image_path(const std::string &imgFile, TextureType &type, std::string path, const std::function<std::shared_ptr<fs::VFilePtrInternal>(const std::string &)> &fileHandler = nullptr, bool *optOutFound = nullptr);
 	DLLMATSYS std::string translate_image_path(const std::string &imgFile, TextureType &type, const std::function<std::shared_ptr<fs::VFilePtrInternal>(const std::string &)> &fileHandler = nullptr, bool *optOutFound = nullptr);
+
+	// FNV-1a, stable across program runs and platforms. Pass the hash of the preceding data as 'seed' to hash multiple ranges as one.
+	constexpr uint64_t FNV1A_OFFSET_BASIS = 14'695'981'039'346'656'037ull;
+	DLLMATSYS uint64_t calc_fnv1a_hash(const void *data, size_t size, uint64_t seed = FNV1A_OFFSET_BASIS);
+	// Lower-case path with forward slashes, so that different spellings of the same file map to the same cache key
+	DLLMATSYS std::string normalize_cache_path(std::string path);
 }
@@ -145,9 +145,9 @@ export namespace pragma::material {
 
 	std::array<float, 3> get_vmt_matrix(std::string value)
 	{
-		if(value.front() == '[')
+		if(!value.empty() && value.front() == '[')
 			value = value.substr(1);
-		if(value.back() == ']')
+		if(!value.empty() && value.back() == ']')
 			value = value.substr(0, value.length() - 1);
 		std::vector<std::string> substrings {};
 		pragma::string::explode_whitespace(value, substrings);
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.materialsystem:worker_pool;
+
+export import pragma.filesystem;
+
+export namespace pragma::material {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	// Fixed number of worker threads for CPU-heavy load work (sprite sheets, pixel conversion, rasterization, decoding of texture layers).
+	// The asset loaders already run several jobs in parallel, so tasks should use the shared pool (see get_worker_pool) instead of
+	// spawning their own threads, which keeps the total number of threads bounded. Thread-safe.
+	class DLLMATSYS WorkerPool {
+	  public:
+		WorkerPool(uint32_t threadCount);
+		~WorkerPool();
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool &operator=(const WorkerPool &) = delete;
+
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+		void Enqueue(std::function<void()> task);
+		template<typename TFunc>
+		std::future<std::invoke_result_t<TFunc>> Submit(TFunc &&f)
+		{
+			auto task = std::make_shared<std::packaged_task<std::invoke_result_t<TFunc>()>>(std::forward<TFunc>(f));
+			auto future = task->get_future();
+			Enqueue([task]() { (*task)(); });
+			return future;
+		}
+		// Executes f(i) for all i in [0, count) and returns once all of them have completed. The calling thread takes part in the work,
+		// so this can also be used from within a task of the pool without the risk of a deadlock. The first exception thrown by f is re-thrown.
+		void ParallelFor(size_t count, const std::function<void(size_t)> &f);
+	  private:
+		void RunWorker();
+		std::vector<std::thread> m_threads;
+		std::mutex m_taskMutex;
+		std::condition_variable m_taskCondition;
+		std::deque<std::function<void()>> m_tasks;
+		bool m_stop = false;
+	};
+#pragma warning(pop)
+
+	// Pool with one thread per hardware thread, which is shared by the material and texture systems
+	DLLMATSYS WorkerPool &get_worker_pool();
+}
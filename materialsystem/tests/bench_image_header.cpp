@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Compares probe_image_header with the full image size query of util_image (which was used for all textures at material parse time before).
+// Usage: bench_image_header [<directory relative to the program path>]
+// If no directory is specified, a synthetic corpus is generated in materials/matsys_bench_image_header.
+
+import pragma.materialsystem;
+import pragma.image;
+
+#include "test.hpp"
+#include "image_fixtures.hpp"
+
+namespace test = pragma::material::test;
+
+static std::vector<std::string> generate_corpus(const std::string &programPath, const std::string &dir)
+{
+	constexpr uint32_t FILES_PER_FORMAT = 1'000;
+	std::vector<std::pair<std::string, std::vector<uint8_t>>> templates {
+	  {"png", test::create_png(256, 256)},
+	  {"tga", test::create_tga(128, 128)},
+	  {"dds", test::create_dds(256, 256, 1)},
+	  {"jpg", test::create_jpg_header(1'024, 1'024)},
+	};
+	std::vector<std::string> files;
+	for(auto &[ext, data] : templates) {
+		for(auto i = 0u; i < FILES_PER_FORMAT; ++i) {
+			auto path = dir + '/' + ext + '_' + std::to_string(i) + '.' + ext;
+			auto absPath = std::filesystem::path {programPath} / path;
+			std::filesystem::create_directories(absPath.parent_path());
+			std::ofstream f {absPath, std::ios::binary | std::ios::trunc};
+			f.write(reinterpret_cast<const char *>(data.data()), data.size());
+			files.push_back(path);
+		}
+	}
+	return files;
+}
+
+static std::vector<std::string> find_corpus_files(const std::string &programPath, const std::string &dir)
+{
+	std::vector<std::string> files;
+	std::error_code ec;
+	for(auto it = std::filesystem::recursive_directory_iterator {std::filesystem::path {programPath} / dir, ec}; !ec && it != std::filesystem::recursive_directory_iterator {}; it.increment(ec)) {
+		if(it->is_regular_file(ec))
+			files.push_back(std::filesystem::relative(it->path(), programPath, ec).generic_string());
+	}
+	return files;
+}
+
+template<typename TFunc>
+static void run(const std::string &name, const std::vector<std::string> &files, const TFunc &f)
+{
+	uint32_t numFailed = 0;
+	auto t = std::chrono::steady_clock::now();
+	for(auto &file : files) {
+		if(!f(file))
+			++numFailed;
+	}
+	auto dt = std::chrono::duration<double, std::micro> {std::chrono::steady_clock::now() - t}.count();
+	std::cout << std::left << std::setw(40) << name << std::fixed << std::setprecision(1) << std::setw(12) << (dt / 1'000.0) << " ms" << std::setw(10) << (dt / std::max<size_t>(files.size(), 1)) << " us/file" << numFailed << " failed" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	auto programPath = pragma::util::get_program_path();
+	auto generated = (argc < 2);
+	std::string dir = generated ? "materials/matsys_bench_image_header" : argv[1];
+	auto files = generated ? generate_corpus(programPath, dir) : find_corpus_files(programPath, dir);
+	std::cout << "Corpus: " << files.size() << " files in '" << dir << "'" << std::endl;
+
+	run("pragma::image::read_image_size", files, [](const std::string &file) {
+		uint32_t w, h;
+		return pragma::image::read_image_size(file, w, h);
+	});
+	run("probe_image_header (uncached)", files, [](const std::string &file) {
+		pragma::material::ImageHeaderInfo info;
+		return pragma::material::probe_image_header(file, info, false);
+	});
+	pragma::material::clear_image_header_cache();
+	run("probe_image_header (cold cache)", files, [](const std::string &file) {
+		pragma::material::ImageHeaderInfo info;
+		return pragma::material::probe_image_header(file, info);
+	});
+	run("probe_image_header (warm cache)", files, [](const std::string &file) {
+		pragma::material::ImageHeaderInfo info;
+		return pragma::material::probe_image_header(file, info);
+	});
+
+	if(generated) {
+		std::error_code ec;
+		std::filesystem::remove_all(std::filesystem::path {programPath} / dir, ec);
+	}
+	return EXIT_SUCCESS;
+}
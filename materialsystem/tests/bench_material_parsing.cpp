@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Measures how material parsing scales with the number of threads, as well as the throughput of the material manager when
+// loading synchronously and asynchronously (where the files are parsed on the loader's worker threads).
+// Usage: bench_material_parsing [<material count>]
+// A synthetic corpus of pmat_b, pmat and wmi files (10'000 in total by default) is generated in materials/matsys_bench_material_parsing.
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+
+static const std::array<std::string, 3> FORMATS = {"pmat_b", "pmat", "wmi"};
+
+static std::string get_template_material()
+{
+	return "\"pbr\"\n{\n"
+	       "\t$texture albedo_map \"models/crate_albedo\"\n"
+	       "\t$texture normal_map \"models/crate_normal\"\n"
+	       "\t$texture rma_map \"models/crate_rma\"\n"
+	       "\t$float metalness_factor 0.5\n"
+	       "\t$float roughness_factor 0.75\n"
+	       "\t$bool translucent 0\n"
+	       "\t\"subsurface_scattering\"\n\t{\n\t\t$float factor 0.1\n\t\t$vector color \"1 0 0\"\n\t}\n"
+	       "}\n";
+}
+
+// Returns the paths of the generated files relative to the program path
+static std::vector<std::string> generate_corpus(const test::TempDirectory &dir, uint32_t count)
+{
+	dir.WriteFile("template.wmi", get_template_material());
+	{
+		// The binary and ascii templates are created from the wmi template
+		auto manager = pragma::material::MaterialManager::Create();
+		auto mat = manager->LoadAsset(dir.GetName() + "/template");
+		if(!mat)
+			return {};
+		std::string err;
+		for(auto &ext : {FORMATS[0], FORMATS[1]}) {
+			if(!mat->Save(MaterialManager::GetRootMaterialLocation() + '/' + dir.GetName() + "/template." + ext, err, true))
+				return {};
+		}
+	}
+	std::vector<std::string> files;
+	files.reserve(count);
+	for(auto i = 0u; i < count; ++i) {
+		auto &ext = FORMATS[i % FORMATS.size()];
+		auto name = "material_" + std::to_string(i) + '.' + ext;
+		std::filesystem::copy_file(dir.GetPath() / ("template." + ext), dir.GetPath() / name, std::filesystem::copy_options::overwrite_existing);
+		files.push_back(MaterialManager::GetRootMaterialLocation() + '/' + dir.GetName() + '/' + name);
+	}
+	return files;
+}
+
+// Same work as the material format handlers do on the loader's worker threads
+static bool parse_material(const std::string &path)
+{
+	auto f = pragma::fs::open_file(path, pragma::fs::FileMode::Read | pragma::fs::FileMode::Binary);
+	if(!f)
+		return false;
+	std::string ext;
+	ufile::get_extension(path, &ext);
+	if(ext == "wmi") {
+		pragma::fs::File file {f};
+		return pragma::datasystem::System::ReadData(file, {}) != nullptr;
+	}
+	std::shared_ptr<udm::Data> udmData = nullptr;
+	try {
+		udmData = udm::Data::Load(std::make_unique<pragma::fs::File>(f));
+	}
+	catch(const udm::Exception &e) {
+		return false;
+	}
+	if(!udmData)
+		return false;
+	auto udmDataRoot = udmData->GetAssetData().GetData();
+	auto it = udmDataRoot.begin_el();
+	if(it == udmDataRoot.end_el())
+		return false;
+	auto root = pragma::util::make_shared<pragma::datasystem::Block>(*pragma::material::get_shared_data_settings());
+	return pragma::material::udm_to_data_block((*it).property, *root);
+}
+
+static void print_result(const std::string &name, size_t count, double dtMs, uint32_t numFailed, std::optional<double> baselineMs = {})
+{
+	std::cout << std::left << std::setw(36) << name << std::fixed << std::setprecision(1) << std::setw(12) << dtMs << " ms" << std::setw(14) << (count / (dtMs / 1'000.0)) << " materials/s";
+	if(baselineMs.has_value())
+		std::cout << std::setprecision(2) << std::setw(8) << (*baselineMs / dtMs) << "x";
+	std::cout << numFailed << " failed" << std::endl;
+}
+
+template<typename TFunc>
+static double measure(const TFunc &f)
+{
+	auto t = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli> {std::chrono::steady_clock::now() - t}.count();
+}
+
+int main(int argc, char *argv[])
+{
+	auto count = (argc > 1) ? static_cast<uint32_t>(std::stoul(argv[1])) : 10'000u;
+	test::TempDirectory dir {"bench_material_parsing", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	auto files = generate_corpus(dir, count);
+	if(files.empty()) {
+		std::cerr << "Failed to generate the material corpus!" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "Corpus: " << files.size() << " materials (" << FORMATS.size() << " formats)" << std::endl;
+
+	// Parsing only, with an increasing number of threads
+	std::optional<double> singleThreadedMs {};
+	auto maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	for(auto numThreads = 1u;; numThreads = std::min(numThreads * 2, maxThreads)) {
+		std::atomic<uint32_t> numFailed = 0;
+		auto dt = measure([&]() {
+			auto parse = [&](size_t i) {
+				if(!parse_material(files[i]))
+					++numFailed;
+			};
+			if(numThreads == 1) {
+				for(size_t i = 0; i < files.size(); ++i)
+					parse(i);
+				return;
+			}
+			// The calling thread takes part in the work
+			pragma::material::WorkerPool pool {numThreads - 1};
+			pool.ParallelFor(files.size(), parse);
+		});
+		if(!singleThreadedMs.has_value())
+			singleThreadedMs = dt;
+		print_result("parse (" + std::to_string(numThreads) + " threads)", files.size(), dt, numFailed, singleThreadedMs);
+		if(numThreads == maxThreads)
+			break;
+	}
+
+	// Loading through the material manager, which also creates the material objects and links base materials on the main thread
+	auto getIdentifier = [&dir](const std::string &file) { return dir.GetName() + '/' + std::filesystem::path {file}.filename().string(); };
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		uint32_t numFailed = 0;
+		auto dt = measure([&]() {
+			for(auto &file : files) {
+				if(!manager->LoadAsset(getIdentifier(file)))
+					++numFailed;
+			}
+		});
+		print_result("MaterialManager::LoadAsset", files.size(), dt, numFailed);
+	}
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		uint32_t numFailed = 0;
+		auto dt = measure([&]() {
+			std::vector<pragma::material::LoadHandle> handles;
+			handles.reserve(files.size());
+			for(auto &file : files)
+				handles.push_back(manager->LoadAssetAsync(getIdentifier(file)));
+			manager->WaitForLoad(pragma::material::when_all(handles), std::chrono::minutes {10});
+			for(auto &handle : handles) {
+				if(!handle.IsSuccessful())
+					++numFailed;
+			}
+		});
+		print_result("MaterialManager::LoadAssetAsync", files.size(), dt, numFailed);
+	}
+	return EXIT_SUCCESS;
+}
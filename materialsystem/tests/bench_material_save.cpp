@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Measures the throughput of saving materials, as done by the batch conversion tools.
+// Usage: bench_material_save [<material count>]
+// Compares building the pmat document from the data block of a material (Material::Save) with building it from a
+// UdmPropertyStorage, and measures writing complete pmat_b files.
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+
+static std::string get_template_material()
+{
+	return "\"pbr\"\n{\n"
+	       "\t$texture albedo_map \"models/crate_albedo\"\n"
+	       "\t$texture normal_map \"models/crate_normal\"\n"
+	       "\t$texture rma_map \"models/crate_rma\"\n"
+	       "\t$float metalness_factor 0.5\n"
+	       "\t$float roughness_factor 0.75\n"
+	       "\t$int alpha_mode 1\n"
+	       "\t$bool translucent 0\n"
+	       "\t$string surface_material \"wood\"\n"
+	       "\t$vector color_factor \"1 0.5 0.25\"\n"
+	       "\t\"subsurface_scattering\"\n\t{\n\t\t$float factor 0.1\n\t\t$vector color \"1 0 0\"\n\t}\n"
+	       "}\n";
+}
+
+static void print_result(const std::string &name, size_t count, double dtMs, uint32_t numFailed)
+{
+	std::cout << std::left << std::setw(36) << name << std::fixed << std::setprecision(1) << std::setw(12) << dtMs << " ms" << std::setw(14) << (count / (dtMs / 1'000.0)) << " materials/s" << numFailed << " failed" << std::endl;
+}
+
+template<typename TFunc>
+static double measure(const TFunc &f)
+{
+	auto t = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli> {std::chrono::steady_clock::now() - t}.count();
+}
+
+int main(int argc, char *argv[])
+{
+	auto count = (argc > 1) ? static_cast<uint32_t>(std::stoul(argv[1])) : 10'000u;
+	test::TempDirectory dir {"bench_material_save", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	dir.WriteFile("template.wmi", get_template_material());
+	auto manager = pragma::material::MaterialManager::Create();
+	auto mat = manager->LoadAsset(dir.GetName() + "/template");
+	if(!mat) {
+		std::cerr << "Failed to load the template material!" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "Saving " << count << " materials" << std::endl;
+
+	{
+		uint32_t numFailed = 0;
+		auto dt = measure([&]() {
+			std::string err;
+			for(auto i = 0u; i < count; ++i) {
+				auto udmData = udm::Data::Create();
+				if(!mat->Save(udmData->GetAssetData(), err))
+					++numFailed;
+			}
+		});
+		print_result("document (data block)", count, dt, numFailed);
+	}
+	{
+		auto udmData = udm::Data::Create();
+		std::string err;
+		mat->Save(udmData->GetAssetData(), err);
+		pragma::material::UdmPropertyStorage storage {};
+		storage.Load(udmData->GetAssetData().GetData()[mat->GetShaderIdentifier()]);
+		auto dt = measure([&]() {
+			for(auto i = 0u; i < count; ++i) {
+				auto udmOut = udm::Data::Create();
+				auto udmMat = udmOut->GetAssetData().GetData().Add(mat->GetShaderIdentifier());
+				storage.Save(udmMat);
+			}
+		});
+		print_result("document (udm storage)", count, dt, 0);
+	}
+	{
+		uint32_t numFailed = 0;
+		auto dt = measure([&]() {
+			std::string err;
+			for(auto i = 0u; i < count; ++i) {
+				if(!mat->Save(MaterialManager::GetRootMaterialLocation() + '/' + dir.GetName() + "/material_" + std::to_string(i) + ".pmat_b", err, true))
+					++numFailed;
+			}
+		});
+		print_result("Material::Save (pmat_b file)", count, dt, numFailed);
+	}
+	return EXIT_SUCCESS;
+}
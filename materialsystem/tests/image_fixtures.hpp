@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Generators for small, valid image files that are used as test fixtures. Has to be included after test.hpp.
+
+#pragma once
+
+namespace pragma::material::test {
+	inline uint32_t calc_crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+	{
+		crc = ~crc;
+		for(size_t i = 0; i < size; ++i) {
+			crc ^= data[i];
+			for(auto bit = 0; bit < 8; ++bit)
+				crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+		}
+		return ~crc;
+	}
+	inline uint32_t to_big_endian(uint32_t v) { return ((v >> 24) & 0xFF) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24); }
+
+	// 8-bit RGBA PNG, the pixel data is stored uncompressed. 'pixels' has to contain width * height * 4 bytes, if it is empty, a gradient is generated.
+	inline std::vector<uint8_t> create_png(uint32_t width, uint32_t height, std::vector<uint8_t> pixels = {})
+	{
+		if(pixels.empty()) {
+			pixels.resize(static_cast<size_t>(width) * height * 4);
+			for(size_t i = 0; i < pixels.size(); ++i)
+				pixels[i] = static_cast<uint8_t>(i * 7);
+		}
+		ByteWriter png {};
+		png.WriteBytes("\x89PNG\r\n\x1a\n", 8);
+		auto writeChunk = [&png](const char *type, const std::vector<uint8_t> &data) {
+			png.Write(to_big_endian(static_cast<uint32_t>(data.size())));
+			std::vector<uint8_t> crcData {type, type + 4};
+			crcData.insert(crcData.end(), data.begin(), data.end());
+			png.WriteBytes(crcData.data(), crcData.size());
+			png.Write(to_big_endian(calc_crc32(crcData.data(), crcData.size())));
+		};
+		ByteWriter ihdr {};
+		ihdr.Write(to_big_endian(width)).Write(to_big_endian(height));
+		ihdr.Write<uint8_t>(8).Write<uint8_t>(6).Write<uint8_t>(0).Write<uint8_t>(0).Write<uint8_t>(0); // Bit depth, RGBA, compression, filter, interlace
+		writeChunk("IHDR", ihdr.GetData());
+
+		// Scanlines with filter type 0, wrapped in stored deflate blocks
+		std::vector<uint8_t> raw;
+		auto rowSize = static_cast<size_t>(width) * 4;
+		for(uint32_t y = 0; y < height; ++y) {
+			raw.push_back(0);
+			raw.insert(raw.end(), pixels.begin() + y * rowSize, pixels.begin() + (y + 1) * rowSize);
+		}
+		ByteWriter zlib {};
+		zlib.Write<uint8_t>(0x78).Write<uint8_t>(0x01);
+		size_t offset = 0;
+		do {
+			auto blockSize = std::min<size_t>(raw.size() - offset, 65'535);
+			auto last = (offset + blockSize == raw.size());
+			zlib.Write<uint8_t>(last ? 1 : 0).Write<uint16_t>(static_cast<uint16_t>(blockSize)).Write<uint16_t>(static_cast<uint16_t>(~blockSize));
+			zlib.WriteBytes(raw.data() + offset, blockSize);
+			offset += blockSize;
+		} while(offset < raw.size());
+		uint32_t a = 1, b = 0;
+		for(auto v : raw) {
+			a = (a + v) % 65'521;
+			b = (b + a) % 65'521;
+		}
+		zlib.Write(to_big_endian((b << 16) | a));
+		writeChunk("IDAT", zlib.GetData());
+		writeChunk("IEND", {});
+		return png.GetData();
+	}
+
+	// Uncompressed 32-bit TGA
+	inline std::vector<uint8_t> create_tga(uint32_t width, uint32_t height)
+	{
+		ByteWriter tga {};
+		tga.Write<uint8_t>(0).Write<uint8_t>(0).Write<uint8_t>(2);                          // ID length, no color map, true-color image
+		tga.Write<uint16_t>(0).Write<uint16_t>(0).Write<uint8_t>(0);                        // Color map specification
+		tga.Write<uint16_t>(0).Write<uint16_t>(0);                                          // Origin
+		tga.Write<uint16_t>(width).Write<uint16_t>(height).Write<uint8_t>(32).Write<uint8_t>(8); // Size, pixel depth, descriptor
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4, 0x7F);
+		tga.WriteBytes(pixels.data(), pixels.size());
+		return tga.GetData();
+	}
+
+	// Uncompressed 32-bit DDS, optionally with a DX10 header (dxgiFormat != 0) and as cubemap
+	inline std::vector<uint8_t> create_dds(uint32_t width, uint32_t height, uint32_t mipmapCount, bool cubemap = false, uint32_t dxgiFormat = 0, uint32_t arraySize = 1)
+	{
+		constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+		constexpr uint32_t DDPF_FOURCC = 0x4;
+		constexpr uint32_t DDPF_RGB = 0x40;
+		ByteWriter dds {};
+		dds.WriteBytes("DDS ", 4).Write<uint32_t>(124).Write<uint32_t>(0x1007 | DDSD_MIPMAPCOUNT).Write<uint32_t>(height).Write<uint32_t>(width);
+		dds.Write<uint32_t>(width * 4).Write<uint32_t>(0).Write<uint32_t>(mipmapCount);
+		for(auto i = 0; i < 11; ++i)
+			dds.Write<uint32_t>(0);
+		dds.Write<uint32_t>(32).Write<uint32_t>((dxgiFormat != 0) ? DDPF_FOURCC : DDPF_RGB);
+		if(dxgiFormat != 0)
+			dds.WriteBytes("DX10", 4);
+		else
+			dds.Write<uint32_t>(0);
+		dds.Write<uint32_t>(32).Write<uint32_t>(0x00FF0000).Write<uint32_t>(0x0000FF00).Write<uint32_t>(0x000000FF).Write<uint32_t>(0xFF000000);
+		dds.Write<uint32_t>(0x1000).Write<uint32_t>(cubemap ? 0xFE00 : 0).Write<uint32_t>(0).Write<uint32_t>(0).Write<uint32_t>(0);
+		if(dxgiFormat != 0)
+			dds.Write<uint32_t>(dxgiFormat).Write<uint32_t>(3).Write<uint32_t>(cubemap ? 0x4 : 0).Write<uint32_t>(arraySize).Write<uint32_t>(0);
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4, 0x7F);
+		dds.WriteBytes(pixels.data(), pixels.size());
+		return dds.GetData();
+	}
+
+	inline std::vector<uint8_t> create_ktx(uint32_t width, uint32_t height, uint32_t mipmapCount, uint32_t glInternalFormat, uint32_t faces = 1)
+	{
+		ByteWriter ktx {};
+		ktx.WriteBytes("\xABKTX 11\xBB\r\n\x1A\n", 12).Write<uint32_t>(0x04030201);
+		ktx.Write<uint32_t>(0x1401).Write<uint32_t>(1).Write<uint32_t>(0x1908).Write<uint32_t>(glInternalFormat).Write<uint32_t>(0x1908);
+		ktx.Write<uint32_t>(width).Write<uint32_t>(height).Write<uint32_t>(0).Write<uint32_t>(0).Write<uint32_t>(faces).Write<uint32_t>(mipmapCount).Write<uint32_t>(0);
+		return ktx.GetData();
+	}
+
+	inline std::vector<uint8_t> create_ktx2(uint32_t width, uint32_t height, uint32_t mipmapCount, uint32_t vkFormat, uint32_t layerCount = 0)
+	{
+		ByteWriter ktx {};
+		ktx.WriteBytes("\xABKTX 20\xBB\r\n\x1A\n", 12).Write<uint32_t>(vkFormat).Write<uint32_t>(1);
+		ktx.Write<uint32_t>(width).Write<uint32_t>(height).Write<uint32_t>(0).Write<uint32_t>(layerCount).Write<uint32_t>(1).Write<uint32_t>(mipmapCount);
+		for(auto i = 0; i < 8; ++i)
+			ktx.Write<uint32_t>(0);
+		return ktx.GetData();
+	}
+
+	// VTF 7.2 header without image data
+	inline std::vector<uint8_t> create_vtf_header(uint16_t width, uint16_t height, uint8_t mipmapCount, int32_t format, bool envmap = false)
+	{
+		constexpr uint32_t TEXTUREFLAGS_ENVMAP = 0x4000;
+		ByteWriter vtf {};
+		vtf.WriteBytes("VTF\0", 4).Write<uint32_t>(7).Write<uint32_t>(2).Write<uint32_t>(80);
+		vtf.Write<uint16_t>(width).Write<uint16_t>(height).Write<uint32_t>(envmap ? TEXTUREFLAGS_ENVMAP : 0).Write<uint16_t>(1).Write<uint16_t>(0).Write<uint32_t>(0);
+		vtf.Write<float>(0.f).Write<float>(0.f).Write<float>(0.f).Write<uint32_t>(0).Write<float>(1.f);
+		vtf.Write<int32_t>(format).Write<uint8_t>(mipmapCount).Write<int32_t>(-1).Write<uint8_t>(0).Write<uint8_t>(0).Write<uint16_t>(1);
+		while(vtf.GetData().size() < 80)
+			vtf.Write<uint8_t>(0);
+		return vtf.GetData();
+	}
+
+	// Source 2 resource header with a single DATA block that contains the texture header
+	inline std::vector<uint8_t> create_vtex_header(uint16_t width, uint16_t height, uint8_t mipmapCount, uint8_t format, bool cubemap = false)
+	{
+		constexpr uint16_t VTEX_FLAG_CUBE_TEXTURE = 0x10;
+		ByteWriter vtex {};
+		vtex.Write<uint32_t>(0).Write<uint16_t>(12).Write<uint16_t>(1); // File size, header version, type version
+		vtex.Write<uint32_t>(8).Write<uint32_t>(1);                     // Block offset (relative to this field), block count
+		vtex.WriteBytes("DATA", 4).Write<uint32_t>(8).Write<uint32_t>(40); // Offset relative to this field, size
+		vtex.Write<uint16_t>(1).Write<uint16_t>(cubemap ? VTEX_FLAG_CUBE_TEXTURE : 0).Write<float>(0.f).Write<float>(0.f).Write<float>(0.f).Write<float>(0.f);
+		vtex.Write<uint16_t>(width).Write<uint16_t>(height).Write<uint16_t>(1).Write<uint8_t>(format).Write<uint8_t>(mipmapCount);
+		while(vtex.GetData().size() < 80)
+			vtex.Write<uint8_t>(0);
+		return vtex.GetData();
+	}
+
+	// Baseline JPEG header up to the start-of-frame segment, preceded by an APP0 segment
+	inline std::vector<uint8_t> create_jpg_header(uint16_t width, uint16_t height, uint8_t componentCount = 3)
+	{
+		ByteWriter jpg {};
+		jpg.Write<uint8_t>(0xFF).Write<uint8_t>(0xD8);
+		jpg.Write<uint8_t>(0xFF).Write<uint8_t>(0xE0).Write<uint8_t>(0).Write<uint8_t>(16).WriteBytes("JFIF\0", 5);
+		jpg.Write<uint8_t>(1).Write<uint8_t>(1).Write<uint8_t>(0).Write<uint16_t>(0x0100).Write<uint16_t>(0x0100).Write<uint8_t>(0).Write<uint8_t>(0);
+		jpg.Write<uint8_t>(0xFF).Write<uint8_t>(0xC0).Write<uint8_t>(0).Write<uint8_t>(static_cast<uint8_t>(8 + componentCount * 3)).Write<uint8_t>(8);
+		jpg.Write<uint8_t>(height >> 8).Write<uint8_t>(height & 0xFF).Write<uint8_t>(width >> 8).Write<uint8_t>(width & 0xFF).Write<uint8_t>(componentCount);
+		for(uint8_t i = 0; i < componentCount; ++i)
+			jpg.Write<uint8_t>(i + 1).Write<uint8_t>(0x11).Write<uint8_t>(0);
+		return jpg.GetData();
+	}
+}
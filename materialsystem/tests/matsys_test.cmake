@@ -0,0 +1,25 @@
+# Each test source file is built as its own executable and registered with CTest.
+# Usage: matsys_add_test(<name> <library target>), where <name>.cpp is located in the current source directory.
+set(MATSYS_TEST_INCLUDE_DIR "${CMAKE_CURRENT_LIST_DIR}")
+
+function(matsys_add_test_executable NAME LIBRARY)
+	add_executable(${NAME} "${CMAKE_CURRENT_SOURCE_DIR}/${NAME}.cpp")
+	target_link_libraries(${NAME} PRIVATE ${LIBRARY})
+	target_include_directories(${NAME} PRIVATE "${MATSYS_TEST_INCLUDE_DIR}")
+	get_target_property(LIBRARY_CXX_STANDARD ${LIBRARY} CXX_STANDARD)
+	if(LIBRARY_CXX_STANDARD)
+		set_target_properties(${NAME} PROPERTIES CXX_STANDARD ${LIBRARY_CXX_STANDARD})
+	endif()
+	set_target_properties(${NAME} PROPERTIES CXX_SCAN_FOR_MODULES ON FOLDER tests)
+endfunction()
+
+function(matsys_add_test NAME LIBRARY)
+	matsys_add_test_executable(${NAME} ${LIBRARY})
+	add_test(NAME ${NAME} COMMAND ${NAME} WORKING_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}")
+endfunction()
+
+# Benchmarks are built like tests, but not registered with CTest, since their results have to be interpreted manually.
+# Usage: matsys_add_benchmark(<name> <library target>)
+function(matsys_add_benchmark NAME LIBRARY)
+	matsys_add_test_executable(${NAME} ${LIBRARY})
+endfunction()
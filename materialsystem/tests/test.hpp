@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Minimal test harness for the materialsystem tests. Every test source file is its own executable, which runs all of
+// its test cases and returns a non-zero exit code if any check has failed.
+// Has to be included after the module imports, which provide the standard library.
+
+#pragma once
+
+namespace pragma::material::test {
+	struct TestCase {
+		const char *name;
+		void (*function)();
+	};
+	inline std::vector<TestCase> &get_test_cases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+	inline std::atomic<uint32_t> &get_failure_count()
+	{
+		static std::atomic<uint32_t> failureCount = 0;
+		return failureCount;
+	}
+	struct TestRegistrar {
+		TestRegistrar(const char *name, void (*function)()) { get_test_cases().push_back({name, function}); }
+	};
+	inline void report_failure(const char *file, int line, const std::string &msg)
+	{
+		++get_failure_count();
+		static std::mutex mutex;
+		std::scoped_lock lock {mutex};
+		std::cerr << file << ":" << line << ": check failed: " << msg << std::endl;
+	}
+	inline int run_tests()
+	{
+		uint32_t numFailedTests = 0;
+		for(auto &testCase : get_test_cases()) {
+			std::cout << "[ RUN  ] " << testCase.name << std::endl;
+			auto prevFailureCount = get_failure_count().load();
+			try {
+				testCase.function();
+			}
+			catch(const std::exception &e) {
+				report_failure(__FILE__, __LINE__, std::string {"unexpected exception: "} + e.what());
+			}
+			auto failed = get_failure_count() != prevFailureCount;
+			if(failed)
+				++numFailedTests;
+			std::cout << (failed ? "[ FAIL ] " : "[  OK  ] ") << testCase.name << std::endl;
+		}
+		std::cout << (get_test_cases().size() - numFailedTests) << "/" << get_test_cases().size() << " tests passed" << std::endl;
+		return (numFailedTests == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Unique directory for files created by a test, removed again on destruction. By default it is located in the system's
+	// temporary directory, files that have to be accessible through the virtual file system have to use a directory below the program path.
+	class TempDirectory {
+	  public:
+		TempDirectory(const std::string &name, const std::filesystem::path &root = std::filesystem::temp_directory_path())
+		{
+			m_name = "matsys_test_" + name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+			m_path = root / m_name;
+			std::filesystem::create_directories(m_path);
+		}
+		~TempDirectory()
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_path, ec);
+		}
+		const std::filesystem::path &GetPath() const { return m_path; }
+		// Name of the directory within the root directory
+		const std::string &GetName() const { return m_name; }
+		std::string GetFilePath(const std::string &fileName) const { return (m_path / fileName).generic_string(); }
+		void WriteFile(const std::string &fileName, const std::vector<uint8_t> &data) const
+		{
+			auto path = m_path / fileName;
+			std::filesystem::create_directories(path.parent_path());
+			std::ofstream f {path, std::ios::binary | std::ios::trunc};
+			f.write(reinterpret_cast<const char *>(data.data()), data.size());
+		}
+		void WriteFile(const std::string &fileName, const std::string &data) const { WriteFile(fileName, std::vector<uint8_t> {data.begin(), data.end()}); }
+	  private:
+		std::string m_name;
+		std::filesystem::path m_path;
+	};
+
+	// Helper for assembling binary fixtures
+	class ByteWriter {
+	  public:
+		template<typename T>
+		ByteWriter &Write(const T &value)
+		{
+			auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+			m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+			return *this;
+		}
+		ByteWriter &WriteBytes(const void *data, size_t size)
+		{
+			auto *bytes = static_cast<const uint8_t *>(data);
+			m_data.insert(m_data.end(), bytes, bytes + size);
+			return *this;
+		}
+		const std::vector<uint8_t> &GetData() const { return m_data; }
+	  private:
+		std::vector<uint8_t> m_data;
+	};
+}
+
+#define MATSYS_TEST(NAME) \
+	static void NAME(); \
+	static pragma::material::test::TestRegistrar NAME##_registrar {#NAME, &NAME}; \
+	static void NAME()
+#define MATSYS_CHECK(EXPR) \
+	do { \
+		if(!(EXPR)) \
+			pragma::material::test::report_failure(__FILE__, __LINE__, #EXPR); \
+	} while(false)
+// Like MATSYS_CHECK, but aborts the test case on failure
+#define MATSYS_REQUIRE(EXPR) \
+	do { \
+		if(!(EXPR)) { \
+			pragma::material::test::report_failure(__FILE__, __LINE__, #EXPR); \
+			return; \
+		} \
+	} while(false)
+#define MATSYS_TEST_MAIN() \
+	int main(int argc, char *argv[]) { return pragma::material::test::run_tests(); }
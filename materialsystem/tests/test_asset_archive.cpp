@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::AssetArchive;
+using pragma::material::AssetArchiveBuilder;
+namespace test = pragma::material::test;
+
+namespace {
+	std::vector<uint8_t> create_data(size_t size, bool compressible)
+	{
+		std::vector<uint8_t> data(size);
+		std::mt19937 rng {static_cast<uint32_t>(size)};
+		for(size_t i = 0; i < size; ++i)
+			data[i] = compressible ? static_cast<uint8_t>((i / 64) % 4) : static_cast<uint8_t>(rng());
+		return data;
+	}
+	// Archives are written to and read from the virtual file system
+	struct ArchiveFixture {
+		ArchiveFixture() : dir {"asset_archive", pragma::util::get_program_path()} {}
+		std::string GetArchivePath(const std::string &name) const { return dir.GetName() + '/' + name + '.' + AssetArchive::FORMAT_ARCHIVE; }
+		std::vector<uint8_t> ReadArchive(const std::string &name) const
+		{
+			std::ifstream f {dir.GetPath() / (name + '.' + AssetArchive::FORMAT_ARCHIVE), std::ios::binary};
+			return {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> {}};
+		}
+		void WriteArchive(const std::string &name, const std::vector<uint8_t> &data) const { dir.WriteFile(name + '.' + AssetArchive::FORMAT_ARCHIVE, data); }
+		test::TempDirectory dir;
+	};
+	AssetArchive::IndexEntry &get_index_entry(std::vector<uint8_t> &archiveData, size_t idx) { return *reinterpret_cast<AssetArchive::IndexEntry *>(archiveData.data() + sizeof(AssetArchive::Header) + idx * sizeof(AssetArchive::IndexEntry)); }
+}
+
+MATSYS_TEST(write_read_round_trip)
+{
+	ArchiveFixture fixture {};
+	std::map<std::string, std::vector<uint8_t>> files {
+	  {"materials/models/crate.pmat_b", create_data(1'000, true)},
+	  {"materials/models/crate_albedo.png", create_data(50'000, false)},
+	  {"materials/models/crate_normal.dds", create_data(100'000, true)},
+	  {"materials/empty.wmi", {}},
+	};
+	std::vector<AssetArchiveBuilder::CompressionMode> modes {AssetArchiveBuilder::CompressionMode::None, AssetArchiveBuilder::CompressionMode::Lz4, AssetArchiveBuilder::CompressionMode::Zlib, AssetArchiveBuilder::CompressionMode::Auto};
+	for(auto mode : modes) {
+		AssetArchiveBuilder builder {64};
+		for(auto &[path, data] : files)
+			builder.AddFile(path, std::vector<uint8_t> {data}, mode);
+		// Replaces the previous entry
+		builder.AddFile("Materials\\Models\\Crate.pmat_b", std::vector<uint8_t> {files["materials/models/crate.pmat_b"]}, mode);
+		std::string err;
+		auto name = "archive_" + std::to_string(static_cast<int>(mode));
+		MATSYS_REQUIRE(builder.Write(fixture.GetArchivePath(name), err));
+
+		auto archive = AssetArchive::Open(fixture.GetArchivePath(name), err);
+		MATSYS_REQUIRE(archive != nullptr);
+		MATSYS_CHECK(archive->GetEntryCount() == files.size());
+		for(auto &[path, data] : files) {
+			auto *entry = archive->FindEntry(path);
+			MATSYS_REQUIRE(entry != nullptr);
+			MATSYS_CHECK(entry->offset % 64 == 0 && entry->size == data.size());
+			std::vector<uint8_t> readData;
+			MATSYS_CHECK(archive->Read(*entry, readData) && readData == data);
+		}
+		// Incompressible data is stored as-is in the automatic mode
+		auto *entry = archive->FindEntry("materials/models/crate_albedo.png");
+		if(mode == AssetArchiveBuilder::CompressionMode::Auto || mode == AssetArchiveBuilder::CompressionMode::None)
+			MATSYS_CHECK(entry->compression == AssetArchive::Compression::None);
+		// Lookups are case-insensitive
+		MATSYS_CHECK(archive->Exists("./Materials/Models/CRATE.pmat_b"));
+		MATSYS_CHECK(!archive->Exists("materials/models/crate"));
+		MATSYS_CHECK(archive->OpenFile("materials/missing.png") == nullptr);
+		auto f = archive->OpenFile("materials/models/crate_normal.dds");
+		MATSYS_REQUIRE(f != nullptr);
+		MATSYS_CHECK(f->GetSize() == files["materials/models/crate_normal.dds"].size());
+	}
+}
+
+MATSYS_TEST(mounted_archives)
+{
+	ArchiveFixture fixture {};
+	std::string err;
+	for(auto &name : {"a", "b"}) {
+		AssetArchiveBuilder builder {};
+		builder.AddFile("materials/shared.wmi", std::vector<uint8_t>(name, name + 1));
+		builder.AddFile(std::string {"materials/only_"} + name + ".wmi", {});
+		MATSYS_REQUIRE(builder.Write(fixture.GetArchivePath(name), err));
+	}
+	auto archiveA = AssetArchive::Open(fixture.GetArchivePath("a"), err);
+	auto archiveB = AssetArchive::Open(fixture.GetArchivePath("b"), err);
+	MATSYS_REQUIRE(archiveA && archiveB);
+	pragma::material::mount_asset_archive(archiveA);
+	pragma::material::mount_asset_archive(archiveB);
+	// The archive that has been mounted last takes precedence
+	auto f = pragma::material::open_archived_asset_file("materials/shared.wmi");
+	MATSYS_REQUIRE(f != nullptr);
+	char c = 0;
+	f->Read(&c, 1);
+	MATSYS_CHECK(c == 'b');
+	MATSYS_CHECK(pragma::material::archived_asset_file_exists("materials/only_a.wmi"));
+
+	pragma::material::unmount_asset_archive(*archiveB);
+	f = pragma::material::open_archived_asset_file("materials/shared.wmi");
+	MATSYS_REQUIRE(f != nullptr);
+	f->Read(&c, 1);
+	MATSYS_CHECK(c == 'a');
+	MATSYS_CHECK(!pragma::material::archived_asset_file_exists("materials/only_b.wmi"));
+	pragma::material::unmount_all_asset_archives();
+	MATSYS_CHECK(!pragma::material::archived_asset_file_exists("materials/only_a.wmi"));
+}
+
+MATSYS_TEST(corrupt_archives_are_rejected)
+{
+	ArchiveFixture fixture {};
+	AssetArchiveBuilder builder {};
+	builder.AddFile("materials/a.wmi", create_data(100, true), AssetArchiveBuilder::CompressionMode::None);
+	builder.AddFile("materials/b.wmi", create_data(200, true), AssetArchiveBuilder::CompressionMode::Zlib);
+	std::string err;
+	MATSYS_REQUIRE(builder.Write(fixture.GetArchivePath("valid"), err));
+	auto valid = fixture.ReadArchive("valid");
+	MATSYS_REQUIRE(valid.size() > sizeof(AssetArchive::Header) + 2 * sizeof(AssetArchive::IndexEntry));
+
+	auto isRejected = [&fixture](const std::vector<uint8_t> &data) {
+		fixture.WriteArchive("corrupt", data);
+		std::string err;
+		return AssetArchive::Open(fixture.GetArchivePath("corrupt"), err) == nullptr && !err.empty();
+	};
+	MATSYS_CHECK(!isRejected(valid));
+
+	// Unsorted index
+	auto data = valid;
+	std::swap(get_index_entry(data, 0), get_index_entry(data, 1));
+	MATSYS_CHECK(isRejected(data));
+
+	// Duplicate paths
+	data = valid;
+	get_index_entry(data, 1).nameOffset = get_index_entry(data, 0).nameOffset;
+	MATSYS_CHECK(isRejected(data));
+
+	// Payload offsets that would overflow with a naive bounds check
+	data = valid;
+	get_index_entry(data, 0).offset = std::numeric_limits<uint64_t>::max() - 16;
+	MATSYS_CHECK(isRejected(data));
+	data = valid;
+	get_index_entry(data, 0).storedSize = std::numeric_limits<uint64_t>::max();
+	get_index_entry(data, 0).size = std::numeric_limits<uint64_t>::max();
+	MATSYS_CHECK(isRejected(data));
+
+	// Implausible decompressed size
+	data = valid;
+	get_index_entry(data, 1).size = std::numeric_limits<uint64_t>::max();
+	MATSYS_CHECK(isRejected(data));
+
+	// Name outside of the string table
+	data = valid;
+	get_index_entry(data, 1).nameLength = 10'000;
+	MATSYS_CHECK(isRejected(data));
+
+	// Index and string table sizes that exceed the file
+	data = valid;
+	reinterpret_cast<AssetArchive::Header *>(data.data())->entryCount = std::numeric_limits<uint32_t>::max();
+	MATSYS_CHECK(isRejected(data));
+	data = valid;
+	reinterpret_cast<AssetArchive::Header *>(data.data())->stringTableSize = std::numeric_limits<uint64_t>::max() - 8;
+	MATSYS_CHECK(isRejected(data));
+
+	// Truncated files
+	for(auto size : {size_t {0}, size_t {10}, sizeof(AssetArchive::Header), sizeof(AssetArchive::Header) + sizeof(AssetArchive::IndexEntry)})
+		MATSYS_CHECK(isRejected({valid.begin(), valid.begin() + size}));
+	data = {valid.begin(), valid.end() - 1};
+	MATSYS_CHECK(isRejected(data));
+}
+
+MATSYS_TEST_MAIN()
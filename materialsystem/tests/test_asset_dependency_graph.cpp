@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::AssetDependencyGraph;
+namespace test = pragma::material::test;
+
+static AssetDependencyGraph::AssetId material(const std::string &name) { return {AssetDependencyGraph::AssetType::Material, name}; }
+static AssetDependencyGraph::AssetId texture(const std::string &name) { return {AssetDependencyGraph::AssetType::Texture, name}; }
+static bool contains(const std::vector<AssetDependencyGraph::AssetId> &ids, const AssetDependencyGraph::AssetId &id) { return std::find(ids.begin(), ids.end(), id) != ids.end(); }
+
+MATSYS_TEST(edges_are_symmetric)
+{
+	AssetDependencyGraph graph {};
+	graph.SetDependencies(material("a"), {material("base"), texture("albedo"), texture("normal")});
+	graph.SetDependencies(material("b"), {material("base"), texture("albedo")});
+	MATSYS_CHECK(graph.GetDependencies(material("a")).size() == 3);
+	auto dependents = graph.GetDependents(texture("albedo"));
+	MATSYS_CHECK(dependents.size() == 2 && contains(dependents, material("a")) && contains(dependents, material("b")));
+
+	// Replacing the dependencies removes the old edges in both directions
+	graph.SetDependencies(material("a"), {texture("normal2")});
+	MATSYS_CHECK(graph.GetDependents(texture("albedo")).size() == 1);
+	MATSYS_CHECK(graph.GetDependents(texture("normal")).empty());
+	// The former dependency is kept until it is collected
+	MATSYS_CHECK(graph.HasAsset(texture("normal")));
+
+	graph.AddDependency(material("b"), material("b"));
+	MATSYS_CHECK(!contains(graph.GetDependencies(material("b")), material("b")));
+}
+
+MATSYS_TEST(transitive_dependents)
+{
+	AssetDependencyGraph graph {};
+	graph.SetDependencies(material("base"), {texture("albedo")});
+	graph.SetDependencies(material("derived"), {material("base")});
+	graph.SetDependencies(material("derived2"), {material("derived")});
+	// Cycles must not cause infinite loops
+	graph.AddDependency(material("base"), material("derived2"));
+	auto dependents = graph.GetTransitiveDependents(texture("albedo"));
+	MATSYS_CHECK(dependents.size() == 3);
+	MATSYS_CHECK(dependents.front() == material("base"));
+}
+
+MATSYS_TEST(collect_unused_sub_graphs)
+{
+	AssetDependencyGraph graph {};
+	graph.SetDependencies(material("a"), {material("base"), texture("shared")});
+	graph.SetDependencies(material("base"), {texture("base_albedo")});
+	graph.SetDependencies(material("b"), {texture("shared"), texture("b_albedo")});
+	graph.SetDependencies(material("no_textures"), {});
+
+	std::unordered_set<std::string> inUse {"b"};
+	auto removed = graph.CollectUnused([&inUse](const AssetDependencyGraph::AssetId &id) { return inUse.contains(id.name); });
+	MATSYS_CHECK(removed.size() == 4);
+	for(auto &id : {material("a"), material("base"), texture("base_albedo"), material("no_textures")})
+		MATSYS_CHECK(contains(removed, id) && !graph.HasAsset(id));
+	// Still referenced by b
+	MATSYS_CHECK(graph.HasAsset(texture("shared")) && graph.HasAsset(texture("b_albedo")));
+	// Dependents are always removed before their dependencies
+	MATSYS_CHECK(std::find(removed.begin(), removed.end(), material("a")) < std::find(removed.begin(), removed.end(), material("base")));
+
+	inUse.clear();
+	removed = graph.CollectUnused([&inUse](const AssetDependencyGraph::AssetId &id) { return inUse.contains(id.name); });
+	MATSYS_CHECK(removed.size() == 3);
+	MATSYS_CHECK(!graph.HasAsset(material("b")) && !graph.HasAsset(texture("shared")));
+}
+
+///////////
+
+namespace {
+	// Materials have to be located in the materials directory of the virtual file system
+	struct MaterialFixture {
+		MaterialFixture() : dir {"dependency_graph", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()}, manager {pragma::material::MaterialManager::Create()} {}
+		void WriteMaterial(const std::string &name, const std::vector<std::string> &textures)
+		{
+			std::string data = "\"test\"\n{\n";
+			auto i = 0u;
+			for(auto &tex : textures)
+				data += "\t$texture tex" + std::to_string(i++) + " \"" + dir.GetName() + '/' + tex + "\"\n";
+			data += "}\n";
+			dir.WriteFile(name + ".wmi", data);
+		}
+		std::string GetIdentifier(const std::string &name) const { return manager->ToCacheIdentifier(dir.GetName() + '/' + name); }
+		AssetDependencyGraph::AssetId GetMaterialId(const std::string &name) const { return material(GetIdentifier(name)); }
+		AssetDependencyGraph::AssetId GetTextureId(const std::string &name) const { return texture(dir.GetName() + '/' + name); }
+		std::shared_ptr<pragma::material::Material> Load(const std::string &name) { return manager->LoadAsset(dir.GetName() + '/' + name); }
+		test::TempDirectory dir;
+		std::shared_ptr<pragma::material::MaterialManager> manager;
+	};
+}
+
+MATSYS_TEST(manager_load_reload_unload)
+{
+	MaterialFixture fixture {};
+	fixture.WriteMaterial("a", {"albedo", "normal"});
+	fixture.WriteMaterial("b", {"albedo"});
+	auto matA = fixture.Load("a");
+	auto matB = fixture.Load("b");
+	MATSYS_REQUIRE(matA != nullptr && matB != nullptr);
+
+	// Load
+	auto &graph = fixture.manager->GetDependencyGraph();
+	auto depsA = graph.GetDependencies(fixture.GetMaterialId("a"));
+	MATSYS_CHECK(depsA.size() == 2 && contains(depsA, fixture.GetTextureId("albedo")) && contains(depsA, fixture.GetTextureId("normal")));
+	MATSYS_CHECK(graph.GetDependents(fixture.GetTextureId("albedo")).size() == 2);
+
+	// Reload with a different texture
+	fixture.WriteMaterial("a", {"detail"});
+	MATSYS_REQUIRE(fixture.manager->ReloadAsset(fixture.dir.GetName() + "/a") == matA);
+	depsA = graph.GetDependencies(fixture.GetMaterialId("a"));
+	MATSYS_CHECK(depsA.size() == 1 && depsA.front() == fixture.GetTextureId("detail"));
+	MATSYS_CHECK(graph.GetDependents(fixture.GetTextureId("albedo")).size() == 1);
+	MATSYS_CHECK(graph.GetDependents(fixture.GetTextureId("normal")).empty());
+
+	// Nothing is evicted while the materials are in use
+	auto evicted = fixture.manager->CollectUnusedAssets();
+	MATSYS_CHECK(!contains(evicted, fixture.GetMaterialId("a")) && !contains(evicted, fixture.GetMaterialId("b")));
+	MATSYS_CHECK(contains(evicted, fixture.GetTextureId("normal")));
+	MATSYS_CHECK(fixture.manager->FindCachedAsset(fixture.GetIdentifier("a")) != nullptr);
+
+	// Unload
+	matA = nullptr;
+	evicted = fixture.manager->CollectUnusedAssets();
+	MATSYS_CHECK(contains(evicted, fixture.GetMaterialId("a")) && contains(evicted, fixture.GetTextureId("detail")));
+	MATSYS_CHECK(!graph.HasAsset(fixture.GetMaterialId("a")));
+	MATSYS_CHECK(fixture.manager->FindCachedAsset(fixture.GetIdentifier("a")) == nullptr);
+	MATSYS_CHECK(fixture.manager->FindCachedAsset(fixture.GetIdentifier("b")) != nullptr);
+	MATSYS_CHECK(graph.HasAsset(fixture.GetTextureId("albedo")));
+
+	matB = nullptr;
+	fixture.manager->CollectUnusedAssets();
+	MATSYS_CHECK(fixture.manager->FindCachedAsset(fixture.GetIdentifier("b")) == nullptr);
+	MATSYS_CHECK(!graph.HasAsset(fixture.GetTextureId("albedo")));
+
+	// Evicted materials can be loaded again
+	matA = fixture.Load("a");
+	MATSYS_REQUIRE(matA != nullptr);
+	MATSYS_CHECK(graph.GetDependencies(fixture.GetMaterialId("a")).size() == 1);
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+
+namespace {
+	struct ChangeRecorder {
+		std::vector<std::pair<std::string, std::string>> changes;
+		pragma::material::AssetFileWatcher::ReloadHandler GetHandler()
+		{
+			return [this](const std::string &identifier, const std::string &ext) { changes.push_back({identifier, ext}); };
+		}
+	};
+	constexpr std::chrono::milliseconds DEBOUNCE_TIME {100};
+	// Polls the watcher until the debounce time has passed without any new changes
+	void poll_until_settled(pragma::material::AssetFileWatcher &watcher)
+	{
+		auto tEnd = std::chrono::steady_clock::now() + DEBOUNCE_TIME * 4;
+		while(std::chrono::steady_clock::now() < tEnd) {
+			watcher.Poll();
+			std::this_thread::sleep_for(std::chrono::milliseconds {10});
+		}
+	}
+}
+
+MATSYS_TEST(changed_files_are_reported)
+{
+	auto watcher = pragma::material::AssetFileWatcher::Create(DEBOUNCE_TIME);
+	if(!watcher) {
+		std::cout << "File watcher is not supported on this platform, skipping test." << std::endl;
+		return;
+	}
+	test::TempDirectory dir {"file_watcher"};
+	dir.WriteFile("models/crate.pmat", "initial");
+	MATSYS_REQUIRE(watcher->AddDirectory(dir.GetPath().string()));
+	ChangeRecorder materials {};
+	ChangeRecorder textures {};
+	watcher->AddHandler({"pmat", "vmt"}, materials.GetHandler());
+	watcher->AddHandler({"png"}, textures.GetHandler());
+
+	dir.WriteFile("models/crate.pmat", "changed");
+	dir.WriteFile("models/Barrel.VMT", "changed");
+	dir.WriteFile("models/crate.png", "changed");
+	dir.WriteFile("models/ignored.txt", "changed");
+	poll_until_settled(*watcher);
+
+	std::sort(materials.changes.begin(), materials.changes.end());
+	MATSYS_REQUIRE(materials.changes.size() == 2);
+	// Identifiers are relative to the watched directory, lower-case and without extension
+	MATSYS_CHECK(materials.changes[0].first == "models/barrel" && materials.changes[0].second == "vmt");
+	MATSYS_CHECK(materials.changes[1].first == "models/crate" && materials.changes[1].second == "pmat");
+	MATSYS_REQUIRE(textures.changes.size() == 1);
+	MATSYS_CHECK(textures.changes[0].first == "models/crate");
+}
+
+MATSYS_TEST(bursts_of_writes_are_debounced)
+{
+	auto watcher = pragma::material::AssetFileWatcher::Create(DEBOUNCE_TIME);
+	if(!watcher)
+		return;
+	test::TempDirectory dir {"file_watcher_debounce"};
+	MATSYS_REQUIRE(watcher->AddDirectory(dir.GetPath().string()));
+	ChangeRecorder recorder {};
+	watcher->AddHandler({"pmat"}, recorder.GetHandler());
+
+	// An editor saving a file several times in quick succession
+	for(auto i = 0; i < 10; ++i) {
+		dir.WriteFile("wall.pmat", "version " + std::to_string(i));
+		watcher->Poll();
+		std::this_thread::sleep_for(DEBOUNCE_TIME / 10);
+	}
+	MATSYS_CHECK(recorder.changes.empty());
+	poll_until_settled(*watcher);
+	MATSYS_CHECK(recorder.changes.size() == 1);
+
+	// No further changes, no further reloads
+	poll_until_settled(*watcher);
+	MATSYS_CHECK(recorder.changes.size() == 1);
+}
+
+MATSYS_TEST(new_directories_are_watched)
+{
+	auto watcher = pragma::material::AssetFileWatcher::Create(DEBOUNCE_TIME);
+	if(!watcher)
+		return;
+	test::TempDirectory dir {"file_watcher_subdir"};
+	MATSYS_REQUIRE(watcher->AddDirectory(dir.GetPath().string()));
+	ChangeRecorder recorder {};
+	watcher->AddHandler({"pmat"}, recorder.GetHandler());
+
+	std::filesystem::create_directories(dir.GetPath() / "new_dir");
+	// The watch for the new directory is added while processing the events
+	poll_until_settled(*watcher);
+	dir.WriteFile("new_dir/floor.pmat", "data");
+	poll_until_settled(*watcher);
+	MATSYS_REQUIRE(recorder.changes.size() == 1);
+	MATSYS_CHECK(recorder.changes[0].first == "new_dir/floor");
+}
+
+MATSYS_TEST_MAIN()
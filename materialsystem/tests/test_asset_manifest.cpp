@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::AssetDependencyGraph;
+using pragma::material::AssetManifest;
+namespace test = pragma::material::test;
+
+static std::filesystem::path get_material_root() { return std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation(); }
+static std::string get_material_data(const std::string &texture) { return "\"test\"\n{\n\t$texture albedo_map \"" + texture + "\"\n}\n"; }
+
+MATSYS_TEST(entries_are_unique)
+{
+	AssetManifest manifest {};
+	MATSYS_CHECK(manifest.AddEntry({{AssetDependencyGraph::AssetType::Material, "a"}, "materials/a.wmi", 10}));
+	MATSYS_CHECK(manifest.AddEntry({{AssetDependencyGraph::AssetType::Texture, "a"}, "materials/a.png", 20}));
+	MATSYS_CHECK(!manifest.AddEntry({{AssetDependencyGraph::AssetType::Material, "a"}, "materials/a.pmat", 30}));
+	MATSYS_CHECK(manifest.GetEntries().size() == 2);
+	MATSYS_CHECK(manifest.GetEntries().front().filePath == "materials/a.wmi");
+}
+
+MATSYS_TEST(save_and_load)
+{
+	AssetManifest manifest {};
+	manifest.AddEntry({{AssetDependencyGraph::AssetType::Material, "models/crate"}, "materials/models/crate.pmat_b", 1'234});
+	manifest.AddEntry({{AssetDependencyGraph::AssetType::Texture, "models/crate_albedo"}, "materials/models/crate_albedo.dds", 5'000'000'000ull});
+	manifest.AddEntry({{AssetDependencyGraph::AssetType::Material, "models/base"}, "materials/models/base.wmi", 0});
+
+	test::TempDirectory dir {"asset_manifest", pragma::util::get_program_path()};
+	for(auto &ext : {AssetManifest::FORMAT_MANIFEST_BINARY, AssetManifest::FORMAT_MANIFEST_ASCII}) {
+		auto fileName = dir.GetName() + "/scene." + ext;
+		std::string err;
+		MATSYS_REQUIRE(manifest.Save(fileName, err));
+		auto loaded = AssetManifest::Load(fileName, err);
+		MATSYS_REQUIRE(loaded != nullptr);
+		auto &entries = loaded->GetEntries();
+		MATSYS_REQUIRE(entries.size() == manifest.GetEntries().size());
+		// The order has to be preserved, since it determines the prefetch order
+		for(size_t i = 0; i < entries.size(); ++i) {
+			auto &a = entries[i];
+			auto &b = manifest.GetEntries()[i];
+			MATSYS_CHECK(a.id == b.id && a.filePath == b.filePath && a.fileSize == b.fileSize);
+		}
+	}
+
+	std::string err;
+	MATSYS_CHECK(AssetManifest::Load(dir.GetName() + "/missing.pman", err) == nullptr && !err.empty());
+	dir.WriteFile("invalid.pman_b", "not a manifest");
+	MATSYS_CHECK(AssetManifest::Load(dir.GetName() + "/invalid.pman_b", err) == nullptr);
+}
+
+MATSYS_TEST(record_and_prefetch)
+{
+	test::TempDirectory dir {"asset_manifest_prefetch", get_material_root()};
+	std::vector<std::string> materials {"c", "a", "b"};
+	for(auto &name : materials)
+		dir.WriteFile(name + ".wmi", get_material_data(dir.GetName() + "/albedo_" + name));
+	auto getIdentifier = [&dir](pragma::material::MaterialManager &manager, const std::string &name) { return manager.ToCacheIdentifier(dir.GetName() + '/' + name); };
+
+	// Record
+	std::shared_ptr<AssetManifest> manifest = nullptr;
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		manager->BeginManifestRecording();
+		std::vector<std::shared_ptr<pragma::material::Material>> loaded;
+		for(auto &name : materials)
+			loaded.push_back(manager->LoadAsset(dir.GetName() + '/' + name));
+		// Loading a material again must not add a second entry
+		loaded.push_back(manager->LoadAsset(dir.GetName() + "/a"));
+		manifest = manager->EndManifestRecording();
+		MATSYS_REQUIRE(manifest != nullptr);
+		MATSYS_CHECK(!manager->IsRecordingManifest());
+
+		std::vector<std::string> recordedMaterials;
+		for(auto &entry : manifest->GetEntries()) {
+			if(entry.id.type == AssetDependencyGraph::AssetType::Material)
+				recordedMaterials.push_back(entry.id.name);
+		}
+		// Materials are recorded in the order in which they were requested
+		MATSYS_REQUIRE(recordedMaterials.size() == materials.size());
+		for(size_t i = 0; i < materials.size(); ++i)
+			MATSYS_CHECK(recordedMaterials[i] == getIdentifier(*manager, materials[i]));
+		for(auto &entry : manifest->GetEntries()) {
+			if(entry.id.type == AssetDependencyGraph::AssetType::Material)
+				MATSYS_CHECK(entry.fileSize == std::filesystem::file_size(std::filesystem::path {pragma::util::get_program_path()} / entry.filePath));
+		}
+	}
+
+	auto countCacheHits = [&](pragma::material::MaterialManager &manager) {
+		uint32_t numHits = 0;
+		for(auto &name : materials) {
+			if(manager.FindCachedAsset(getIdentifier(manager, name)))
+				++numHits;
+		}
+		return numHits;
+	};
+
+	// Without manifest, none of the materials are available before they're requested
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		MATSYS_CHECK(countCacheHits(*manager) == 0);
+	}
+
+	// With manifest, all of them are loaded by the time they're requested
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		uint32_t numStale = 0;
+		auto handle = manager->PrefetchManifest(*manifest, &numStale);
+		MATSYS_CHECK(numStale == 0);
+		MATSYS_REQUIRE(manager->WaitForLoad(handle, std::chrono::seconds {10}));
+		MATSYS_CHECK(handle.IsSuccessful());
+		MATSYS_CHECK(countCacheHits(*manager) == materials.size());
+	}
+
+	// Stale manifest: One file has been removed, another one has changed
+	std::filesystem::remove(dir.GetPath() / "c.wmi");
+	dir.WriteFile("a.wmi", get_material_data(dir.GetName() + "/albedo_changed"));
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		uint32_t numStale = 0;
+		auto handle = manager->PrefetchManifest(*manifest, &numStale);
+		MATSYS_CHECK(numStale == 2);
+		MATSYS_REQUIRE(manager->WaitForLoad(handle, std::chrono::seconds {10}));
+		// Changed files are loaded regardless, removed files are skipped
+		MATSYS_CHECK(handle.IsSuccessful());
+		MATSYS_CHECK(manager->FindCachedAsset(getIdentifier(*manager, "a")) != nullptr);
+		MATSYS_CHECK(manager->FindCachedAsset(getIdentifier(*manager, "b")) != nullptr);
+		MATSYS_CHECK(manager->FindCachedAsset(getIdentifier(*manager, "c")) == nullptr);
+	}
+}
+
+MATSYS_TEST_MAIN()
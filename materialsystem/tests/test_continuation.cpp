@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::CallbackThread;
+
+MATSYS_TEST(callbacks_added_after_completion_run_immediately)
+{
+	pragma::material::ContinuationList<int> list {};
+	std::vector<int> results;
+	list.Add([&results](int v) { results.push_back(v); });
+	MATSYS_CHECK(results.empty());
+	list.Complete(5);
+	list.Complete(6); // Ignored
+	list.Add([&results](int v) { results.push_back(v * 2); });
+	MATSYS_CHECK((results == std::vector<int> {5, 10}));
+
+	// After a reset, new callbacks wait for the next completion
+	list.Reset();
+	list.Add([&results](int v) { results.push_back(v); });
+	MATSYS_CHECK(results.size() == 2);
+	list.Complete(7);
+	MATSYS_CHECK(results.size() == 3 && results.back() == 7);
+}
+
+MATSYS_TEST(cancelled_callbacks_are_skipped)
+{
+	pragma::material::ContinuationList<> list {};
+	auto numCalls = 0;
+	auto handle = list.Add([&numCalls]() { ++numCalls; });
+	auto handleMain = list.Add([&numCalls]() { ++numCalls; }, CallbackThread::Main);
+	handle.Cancel();
+	MATSYS_CHECK(handle.IsCancelled() && !handle.IsValid());
+	list.Complete();
+	MATSYS_CHECK(numCalls == 0);
+	// Already queued for the main thread, but cancelled before the dispatch
+	handleMain.Cancel();
+	pragma::material::dispatch_main_thread_callbacks();
+	MATSYS_CHECK(numCalls == 0);
+}
+
+MATSYS_TEST(main_thread_callbacks_are_deferred)
+{
+	pragma::material::ContinuationList<int> list {};
+	auto mainThreadId = std::this_thread::get_id();
+	std::atomic<int> result = 0;
+	auto invokedOnMainThread = false;
+	list.Add(
+	  [&](int v) {
+		  result = v;
+		  invokedOnMainThread = (std::this_thread::get_id() == mainThreadId);
+	  },
+	  CallbackThread::Main);
+	std::thread {[&list]() { list.Complete(42); }}.join();
+	MATSYS_CHECK(result == 0);
+	pragma::material::dispatch_main_thread_callbacks();
+	MATSYS_CHECK(result == 42 && invokedOnMainThread);
+}
+
+MATSYS_TEST(callbacks_may_add_callbacks)
+{
+	pragma::material::ContinuationList<> list {};
+	auto numCalls = 0;
+	list.Add([&]() {
+		++numCalls;
+		list.Add([&numCalls]() { ++numCalls; });
+	});
+	list.Complete();
+	MATSYS_CHECK(numCalls == 2);
+
+	pragma::material::CallbackList<> callbacks {};
+	callbacks.Add([&]() { callbacks.Add([&numCalls]() { ++numCalls; }); });
+	callbacks.Invoke();
+	MATSYS_CHECK(numCalls == 2);
+	callbacks.Invoke();
+	MATSYS_CHECK(numCalls == 3);
+}
+
+// Registration and completion race each other, every callback has to be executed exactly once
+MATSYS_TEST(concurrent_add_and_complete)
+{
+	constexpr uint32_t NUM_ITERATIONS = 200;
+	constexpr uint32_t NUM_THREADS = 4;
+	constexpr uint32_t NUM_CALLBACKS_PER_THREAD = 100;
+	for(auto i = 0u; i < NUM_ITERATIONS; ++i) {
+		pragma::material::ContinuationList<uint32_t> list {};
+		std::vector<std::atomic<uint32_t>> calls(NUM_THREADS * NUM_CALLBACKS_PER_THREAD);
+		std::atomic<bool> wrongArgument = false;
+		std::atomic<bool> start = false;
+		std::vector<std::thread> threads;
+		for(auto t = 0u; t < NUM_THREADS; ++t) {
+			threads.emplace_back([&, t]() {
+				while(!start)
+					std::this_thread::yield();
+				for(auto j = 0u; j < NUM_CALLBACKS_PER_THREAD; ++j) {
+					auto idx = t * NUM_CALLBACKS_PER_THREAD + j;
+					list.Add([&calls, &wrongArgument, idx](uint32_t v) {
+						if(v != 123)
+							wrongArgument = true;
+						++calls[idx];
+					});
+				}
+			});
+		}
+		threads.emplace_back([&]() {
+			while(!start)
+				std::this_thread::yield();
+			list.Complete(123);
+		});
+		start = true;
+		for(auto &t : threads)
+			t.join();
+		MATSYS_REQUIRE(std::all_of(calls.begin(), calls.end(), [](const std::atomic<uint32_t> &n) { return n == 1; }));
+		MATSYS_REQUIRE(!wrongArgument);
+	}
+}
+
+MATSYS_TEST(concurrent_invoke_and_clear)
+{
+	pragma::material::CallbackList<int> callbacks {};
+	std::atomic<uint64_t> sum = 0;
+	std::atomic<bool> stop = false;
+	std::vector<std::thread> threads;
+	for(auto t = 0; t < 2; ++t) {
+		threads.emplace_back([&]() {
+			while(!stop)
+				callbacks.Invoke(1);
+		});
+	}
+	threads.emplace_back([&]() {
+		for(auto i = 0; i < 1'000; ++i) {
+			auto handle = callbacks.Add([&sum](int v) { sum += v; });
+			if(i % 2 == 0)
+				handle.Cancel();
+			if(i % 100 == 0)
+				callbacks.Clear();
+		}
+		stop = true;
+	});
+	for(auto &t : threads)
+		t.join();
+
+	// Only the remaining callbacks are invoked
+	callbacks.Clear();
+	auto sumBefore = sum.load();
+	callbacks.Invoke(1);
+	MATSYS_CHECK(sum == sumBefore);
+}
+
+// Callbacks registered through the legacy CallbackHandle overloads are tied to the handle, removing the handle has to remove the
+// callback from the list, otherwise lists of long-lived objects (e.g. shared textures) would grow with every registration
+MATSYS_TEST(removed_callback_handles_are_pruned)
+{
+	auto numCalls = 0;
+	auto addLegacyCallback = [&numCalls](auto &list) {
+		auto cb = FunctionCallback<void>::Create([&numCalls]() { ++numCalls; });
+		list.Add(
+		  [cb]() mutable {
+			  if(cb.IsValid())
+				  cb();
+		  },
+		  CallbackThread::Any, [cb]() { return !cb.IsValid(); });
+		return cb;
+	};
+
+	pragma::material::CallbackList<> list {};
+	std::vector<CallbackHandle> handles;
+	for(auto i = 0; i < 8; ++i)
+		handles.push_back(addLegacyCallback(list));
+	MATSYS_CHECK(list.GetSize() == 8);
+	list.Invoke();
+	MATSYS_CHECK(numCalls == 8);
+	for(auto i = 0; i < 6; ++i)
+		handles[i].Remove();
+	// Adding a callback removes the expired ones, even if the list is never invoked
+	handles.push_back(addLegacyCallback(list));
+	MATSYS_CHECK(list.GetSize() == 3);
+	for(auto &handle : handles)
+		handle.Remove();
+	list.Invoke();
+	MATSYS_CHECK(list.GetSize() == 0);
+	MATSYS_CHECK(numCalls == 8);
+
+	// Pending continuations are removed as well
+	pragma::material::ContinuationList<> continuations {};
+	for(auto i = 0; i < 4; ++i)
+		addLegacyCallback(continuations).Remove();
+	MATSYS_CHECK(continuations.GetPendingCount() == 1);
+	auto handle = addLegacyCallback(continuations);
+	MATSYS_CHECK(continuations.GetPendingCount() == 1);
+	continuations.Complete();
+	MATSYS_CHECK(numCalls == 9);
+}
+
+MATSYS_TEST_MAIN()
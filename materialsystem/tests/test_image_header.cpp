@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+#include "image_fixtures.hpp"
+
+using pragma::material::ImageHeaderInfo;
+using pragma::material::TextureType;
+namespace test = pragma::material::test;
+
+static bool parse(const std::vector<uint8_t> &data, TextureType type, ImageHeaderInfo &outInfo) { return pragma::material::parse_image_header(data.data(), std::min(data.size(), pragma::material::IMAGE_HEADER_PROBE_SIZE), type, outInfo); }
+
+MATSYS_TEST(png_header)
+{
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_png(37, 19), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::PNG);
+	MATSYS_CHECK(info.width == 37 && info.height == 19);
+	MATSYS_CHECK(info.format == (6 | (8 << 8))); // RGBA, 8 bit
+	MATSYS_CHECK(info.mipmapCount == 1 && info.layerCount == 1);
+}
+
+MATSYS_TEST(dds_header)
+{
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_dds(64, 32, 7), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::DDS);
+	MATSYS_CHECK(info.width == 64 && info.height == 32 && info.mipmapCount == 7);
+	MATSYS_CHECK(!info.cubemap && info.layerCount == 1);
+	MATSYS_CHECK(info.format == 32);
+
+	constexpr uint32_t DXGI_FORMAT_BC7_UNORM = 98;
+	MATSYS_REQUIRE(parse(test::create_dds(16, 16, 5, true, DXGI_FORMAT_BC7_UNORM), TextureType::Invalid, info));
+	MATSYS_CHECK(info.cubemap && info.layerCount == 6);
+	MATSYS_CHECK(info.format == DXGI_FORMAT_BC7_UNORM);
+
+	MATSYS_REQUIRE(parse(test::create_dds(16, 16, 1, false, DXGI_FORMAT_BC7_UNORM, 4), TextureType::Invalid, info));
+	MATSYS_CHECK(!info.cubemap && info.layerCount == 4);
+}
+
+MATSYS_TEST(ktx_header)
+{
+	constexpr uint32_t GL_RGBA8 = 0x8058;
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_ktx(128, 64, 8, GL_RGBA8, 6), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::KTX);
+	MATSYS_CHECK(info.width == 128 && info.height == 64 && info.mipmapCount == 8);
+	MATSYS_CHECK(info.cubemap && info.layerCount == 6 && info.format == GL_RGBA8);
+
+	constexpr uint32_t VK_FORMAT_R8G8B8A8_UNORM = 37;
+	MATSYS_REQUIRE(parse(test::create_ktx2(256, 256, 9, VK_FORMAT_R8G8B8A8_UNORM, 3), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::KTX);
+	MATSYS_CHECK(info.width == 256 && info.height == 256 && info.mipmapCount == 9);
+	MATSYS_CHECK(!info.cubemap && info.layerCount == 3 && info.format == VK_FORMAT_R8G8B8A8_UNORM);
+}
+
+#ifndef DISABLE_VTF_SUPPORT
+MATSYS_TEST(vtf_header)
+{
+	constexpr int32_t IMAGE_FORMAT_DXT5 = 15;
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_vtf_header(512, 256, 10, IMAGE_FORMAT_DXT5, true), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::VTF);
+	MATSYS_CHECK(info.width == 512 && info.height == 256 && info.mipmapCount == 10);
+	MATSYS_CHECK(info.cubemap && info.layerCount == 6 && info.format == IMAGE_FORMAT_DXT5);
+}
+#endif
+
+#ifndef DISABLE_VTEX_SUPPORT
+MATSYS_TEST(vtex_header)
+{
+	ImageHeaderInfo info;
+	auto vtex = test::create_vtex_header(1024, 512, 11, 4);
+	// No magic number, so the type hint is required
+	MATSYS_CHECK(!parse(vtex, TextureType::Invalid, info));
+	MATSYS_REQUIRE(parse(vtex, TextureType::VTex, info));
+	MATSYS_CHECK(info.type == TextureType::VTex);
+	MATSYS_CHECK(info.width == 1024 && info.height == 512 && info.mipmapCount == 11 && info.format == 4);
+}
+#endif
+
+MATSYS_TEST(tga_header)
+{
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_tga(48, 24), TextureType::TGA, info));
+	MATSYS_CHECK(info.type == TextureType::TGA);
+	MATSYS_CHECK(info.width == 48 && info.height == 24);
+	MATSYS_CHECK(info.format == (32 | (2 << 8)));
+}
+
+MATSYS_TEST(jpg_header)
+{
+	ImageHeaderInfo info;
+	MATSYS_REQUIRE(parse(test::create_jpg_header(640, 480), TextureType::Invalid, info));
+	MATSYS_CHECK(info.type == TextureType::JPG);
+	MATSYS_CHECK(info.width == 640 && info.height == 480);
+	MATSYS_CHECK(info.format == (3 | (8 << 8)));
+}
+
+MATSYS_TEST(truncated_headers_are_rejected)
+{
+	ImageHeaderInfo info;
+	std::vector<std::vector<uint8_t>> files {test::create_png(4, 4), test::create_dds(4, 4, 1), test::create_ktx(4, 4, 1, 0x8058), test::create_jpg_header(4, 4)};
+	for(auto &data : files) {
+		for(size_t size = 0; size < 24; ++size)
+			MATSYS_CHECK(!pragma::material::parse_image_header(data.data(), size, TextureType::Invalid, info));
+	}
+	std::vector<uint8_t> garbage(pragma::material::IMAGE_HEADER_PROBE_SIZE, 0xCD);
+	MATSYS_CHECK(!parse(garbage, TextureType::Invalid, info));
+}
+
+MATSYS_TEST(jpg_header_beyond_probe_buffer)
+{
+	// The start-of-frame segment is located after a large metadata segment, so it has to be read from the file
+	auto jpg = test::create_jpg_header(320, 200);
+	test::ByteWriter app1 {};
+	app1.Write<uint8_t>(0xFF).Write<uint8_t>(0xE1).Write<uint8_t>(0x10).Write<uint8_t>(0x00);
+	std::vector<uint8_t> exif(0x1000 - 2, 0);
+	app1.WriteBytes(exif.data(), exif.size());
+	jpg.insert(jpg.begin() + 2, app1.GetData().begin(), app1.GetData().end());
+
+	ImageHeaderInfo info;
+	MATSYS_CHECK(!parse(jpg, TextureType::Invalid, info));
+
+	test::TempDirectory dir {"image_header"};
+	dir.WriteFile("large_header.jpg", jpg);
+	std::shared_ptr<pragma::fs::VFilePtrInternal> f = pragma::fs::open_system_file(dir.GetFilePath("large_header.jpg"), pragma::fs::FileMode::Read | pragma::fs::FileMode::Binary);
+	MATSYS_REQUIRE(f != nullptr);
+	MATSYS_REQUIRE(pragma::material::probe_image_header(f, TextureType::JPG, info));
+	MATSYS_CHECK(info.width == 320 && info.height == 200);
+}
+
+MATSYS_TEST_MAIN()
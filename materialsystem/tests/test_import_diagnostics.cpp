@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::ImportDiagnostics;
+using pragma::material::ImportErrorClass;
+using pragma::material::ImportRecord;
+namespace test = pragma::material::test;
+
+namespace {
+	ImportRecord create_record(const std::string &sourceFile, ImportErrorClass errorClass, const std::string &data = "source data")
+	{
+		ImportRecord record {};
+		record.sourceFile = sourceFile;
+		record.outputPath = "output";
+		record.handler = "vmt";
+		record.errorClass = errorClass;
+		record.sourceSize = data.size();
+		record.sourceHash = ImportDiagnostics::CalcSourceHash(data.data(), data.size());
+		return record;
+	}
+	std::optional<ImportRecord> find_record(const ImportDiagnostics &diagnostics, const std::string &fileName)
+	{
+		for(auto &record : diagnostics.GetRecords()) {
+			if(record.sourceFile.ends_with(fileName))
+				return record;
+		}
+		return {};
+	}
+}
+
+// The import diagnostics and the other caches share the hash and path normalization, so their keys have to stay stable
+MATSYS_TEST(shared_cache_helpers)
+{
+	std::string data = "a";
+	MATSYS_CHECK(pragma::material::calc_fnv1a_hash(nullptr, 0) == pragma::material::FNV1A_OFFSET_BASIS);
+	MATSYS_CHECK(pragma::material::calc_fnv1a_hash(data.data(), data.size()) == 0xaf63dc4c8601ec8cull);
+	MATSYS_CHECK(ImportDiagnostics::CalcSourceHash(data.data(), data.size()) == pragma::material::calc_fnv1a_hash(data.data(), data.size()));
+	// Hashing in parts is the same as hashing everything at once
+	std::string data2 = "abc";
+	MATSYS_CHECK(pragma::material::calc_fnv1a_hash(data2.data() + 1, 2, pragma::material::calc_fnv1a_hash(data2.data(), 1)) == pragma::material::calc_fnv1a_hash(data2.data(), data2.size()));
+	MATSYS_CHECK(pragma::material::normalize_cache_path("Materials\\Models/Crate.VMT") == "materials/models/crate.vmt");
+}
+
+// Only failures caused by the source file are cached, everything else may be fixed without the source file changing
+MATSYS_TEST(cacheable_failures)
+{
+	ImportDiagnostics diagnostics {};
+	for(auto errorClass : {ImportErrorClass::ReadError, ImportErrorClass::ParseError, ImportErrorClass::InvalidData, ImportErrorClass::ConversionError, ImportErrorClass::SaveError}) {
+		auto record = create_record("materials/test.vmt", errorClass);
+		diagnostics.AddRecord(record);
+		auto cacheable = (errorClass == ImportErrorClass::ReadError || errorClass == ImportErrorClass::ParseError || errorClass == ImportErrorClass::InvalidData);
+		MATSYS_CHECK(ImportDiagnostics::IsCacheableFailure(errorClass) == cacheable);
+		MATSYS_CHECK(diagnostics.IsKnownFailure(record.sourceFile, record.sourceSize, record.sourceHash) == cacheable);
+		MATSYS_CHECK(diagnostics.FindRecord("Materials\\Test.vmt")->errorClass == errorClass);
+	}
+	MATSYS_CHECK(!ImportDiagnostics::IsCacheableFailure(ImportErrorClass::None));
+
+	// A cached failure is replaced by a later non-cacheable failure or a success
+	auto parseError = create_record("materials/test.vmt", ImportErrorClass::ParseError);
+	diagnostics.AddRecord(parseError);
+	MATSYS_CHECK(diagnostics.GetFailures().size() == 1);
+	diagnostics.AddRecord(create_record("materials/test.vmt", ImportErrorClass::SaveError));
+	MATSYS_CHECK(diagnostics.GetFailures().empty());
+	diagnostics.AddRecord(parseError);
+	diagnostics.AddRecord(create_record("materials/test.vmt", ImportErrorClass::None));
+	MATSYS_CHECK(diagnostics.GetFailures().empty());
+
+	// Failures without source hash can't be identified, so they're never cached
+	auto noHash = create_record("materials/other.vmt", ImportErrorClass::ParseError);
+	noHash.sourceHash = 0;
+	diagnostics.AddRecord(noHash);
+	MATSYS_CHECK(diagnostics.GetFailures().empty());
+}
+
+MATSYS_TEST(execute_skips_known_failures)
+{
+	ImportDiagnostics diagnostics {};
+	uint32_t numImports = 0;
+	auto import = [&numImports](ImportErrorClass result) {
+		return [&numImports, result]() {
+			++numImports;
+			return result;
+		};
+	};
+	std::string err;
+	MATSYS_CHECK(!diagnostics.Execute(create_record("materials/a.vmt", ImportErrorClass::None), err, import(ImportErrorClass::ParseError)));
+	MATSYS_CHECK(!diagnostics.Execute(create_record("materials/a.vmt", ImportErrorClass::None), err, import(ImportErrorClass::ParseError)));
+	MATSYS_CHECK(numImports == 1);
+	MATSYS_CHECK(diagnostics.GetSkippedImportCount() == 1);
+	MATSYS_CHECK(err.find("ParseError") != std::string::npos);
+
+	// The source file has changed
+	MATSYS_CHECK(diagnostics.Execute(create_record("materials/a.vmt", ImportErrorClass::None, "changed"), err, import(ImportErrorClass::None)));
+	MATSYS_CHECK(numImports == 2);
+
+	// Conversion errors are retried every time
+	for(auto i = 0; i < 2; ++i)
+		MATSYS_CHECK(!diagnostics.Execute(create_record("materials/b.vmt", ImportErrorClass::None), err, import(ImportErrorClass::ConversionError)));
+	MATSYS_CHECK(numImports == 4);
+	MATSYS_CHECK(diagnostics.GetSkippedImportCount() == 1);
+}
+
+MATSYS_TEST(failure_cache_round_trip)
+{
+	ImportDiagnostics diagnostics {};
+	diagnostics.AddRecord(create_record("materials/a.vmt", ImportErrorClass::ReadError));
+	diagnostics.AddRecord(create_record("materials/b.vmat_c", ImportErrorClass::InvalidData, "other data"));
+	diagnostics.AddRecord(create_record("materials/c.vmt", ImportErrorClass::ConversionError));
+
+	test::TempDirectory dir {"import_diagnostics", pragma::util::get_program_path()};
+	for(auto &ext : {ImportDiagnostics::FORMAT_FAILURE_CACHE_BINARY, ImportDiagnostics::FORMAT_FAILURE_CACHE_ASCII}) {
+		auto fileName = dir.GetName() + "/failures." + ext;
+		std::string err;
+		MATSYS_REQUIRE(diagnostics.SaveFailureCache(fileName, err));
+		ImportDiagnostics loaded {};
+		MATSYS_REQUIRE(loaded.LoadFailureCache(fileName, err));
+		MATSYS_CHECK(loaded.GetFailures().size() == 2);
+		for(auto &failure : diagnostics.GetFailures())
+			MATSYS_CHECK(loaded.IsKnownFailure(failure.sourceFile, failure.sourceSize, failure.sourceHash));
+	}
+
+	// Malformed cache files are rejected without affecting the current failures
+	std::string err;
+	dir.WriteFile("invalid.pifc_b", "not a failure cache");
+	MATSYS_CHECK(!diagnostics.LoadFailureCache(dir.GetName() + "/invalid.pifc_b", err));
+	dir.WriteFile("empty.pifc_b", std::vector<uint8_t> {});
+	MATSYS_CHECK(!diagnostics.LoadFailureCache(dir.GetName() + "/empty.pifc_b", err));
+	MATSYS_CHECK(!diagnostics.LoadFailureCache(dir.GetName() + "/missing.pifc_b", err));
+	MATSYS_CHECK(diagnostics.GetFailures().size() == 2);
+}
+
+#ifndef DISABLE_VMT_SUPPORT
+// Malformed source files are recorded with their error class and remembered across manager instances while they're unchanged
+MATSYS_TEST(malformed_vmt_fixtures)
+{
+	test::TempDirectory dir {"import_diagnostics_vmt", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	dir.WriteFile("empty.vmt", std::vector<uint8_t> {});
+	dir.WriteFile("broken.vmt", std::vector<uint8_t> {'"', 'V', 'e', 'r', 't', 'e', 'x', '{', 0, 0xFF, '{', '"', '$'});
+	test::TempDirectory cacheDir {"import_failure_cache", pragma::util::get_program_path()};
+	auto cacheFile = cacheDir.GetName() + "/import_failures.pifc_b";
+
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		auto &diagnostics = manager->GetImportDiagnostics();
+		MATSYS_CHECK(manager->LoadAsset(dir.GetName() + "/empty") == nullptr);
+		MATSYS_CHECK(manager->LoadAsset(dir.GetName() + "/broken") == nullptr);
+		auto emptyRecord = find_record(diagnostics, "empty.vmt");
+		auto brokenRecord = find_record(diagnostics, "broken.vmt");
+		MATSYS_REQUIRE(emptyRecord.has_value() && brokenRecord.has_value());
+		MATSYS_CHECK(emptyRecord->errorClass == ImportErrorClass::ReadError);
+		MATSYS_CHECK(brokenRecord->errorClass == ImportErrorClass::ParseError);
+		MATSYS_CHECK(diagnostics.GetFailures().size() == 2);
+		// Without a cache file the failures are not persisted
+		MATSYS_CHECK(manager->GetImportFailureCacheFile().empty());
+		MATSYS_CHECK(!manager->SaveImportFailureCache());
+		manager->SetImportFailureCacheFile(cacheFile);
+		MATSYS_CHECK(manager->SaveImportFailureCache());
+	}
+
+	// The failure cache is loaded by the next manager, so the import is skipped
+	MATSYS_CHECK(std::filesystem::exists(cacheDir.GetPath() / "import_failures.pifc_b"));
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		auto &diagnostics = manager->GetImportDiagnostics();
+		MATSYS_CHECK(diagnostics.GetFailures().empty());
+		manager->SetImportFailureCacheFile(cacheFile);
+		MATSYS_CHECK(diagnostics.GetFailures().size() == 2);
+		MATSYS_CHECK(manager->LoadAsset(dir.GetName() + "/broken") == nullptr);
+		MATSYS_CHECK(diagnostics.GetSkippedImportCount() == 1);
+	}
+
+	// A changed file is imported again
+	dir.WriteFile("broken.vmt", std::vector<uint8_t> {'{', '{', 0});
+	{
+		auto manager = pragma::material::MaterialManager::Create();
+		manager->SetImportFailureCacheFile(cacheFile);
+		auto &diagnostics = manager->GetImportDiagnostics();
+		MATSYS_CHECK(manager->LoadAsset(dir.GetName() + "/broken") == nullptr);
+		MATSYS_CHECK(diagnostics.GetSkippedImportCount() == 0);
+		MATSYS_CHECK(find_record(diagnostics, "broken.vmt").has_value());
+	}
+}
+#endif
+
+MATSYS_TEST_MAIN()
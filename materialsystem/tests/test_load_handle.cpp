@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::LoadHandle;
+using pragma::material::LoadPromise;
+using pragma::material::LoadState;
+
+MATSYS_TEST(promise_completion)
+{
+	LoadPromise promise {};
+	auto handle = promise.GetHandle();
+	MATSYS_CHECK(handle.IsValid() && !handle.IsReady());
+	std::optional<bool> result {};
+	handle.Then([&result](bool success) { result = success; });
+	promise.SetProgress(0.5f);
+	MATSYS_CHECK(handle.GetProgress() == 0.5f);
+	MATSYS_CHECK(!handle.Wait(std::chrono::milliseconds {1}));
+
+	promise.Complete(false);
+	promise.Complete(true); // Ignored
+	MATSYS_CHECK(handle.GetState() == LoadState::Failed);
+	MATSYS_CHECK(result.has_value() && *result == false);
+	MATSYS_CHECK(handle.GetProgress() == 1.f);
+	MATSYS_CHECK(handle.Wait(std::chrono::milliseconds {0}));
+
+	auto completed = LoadHandle::CreateCompleted(true);
+	MATSYS_CHECK(completed.IsSuccessful());
+	// Invalid handles behave like failed loads
+	LoadHandle invalid {};
+	MATSYS_CHECK(!invalid.IsValid() && invalid.IsReady() && !invalid.IsSuccessful());
+}
+
+MATSYS_TEST(wait_for_other_thread)
+{
+	LoadPromise promise {};
+	auto handle = promise.GetHandle();
+	std::thread t {[promise]() mutable {
+		std::this_thread::sleep_for(std::chrono::milliseconds {10});
+		promise.Complete(true);
+	}};
+	MATSYS_CHECK(handle.Wait(std::chrono::seconds {10}));
+	MATSYS_CHECK(handle.IsSuccessful());
+	t.join();
+}
+
+MATSYS_TEST(when_all)
+{
+	std::vector<LoadPromise> promises(4);
+	std::vector<LoadHandle> handles;
+	for(auto &promise : promises)
+		handles.push_back(promise.GetHandle());
+	auto hAll = pragma::material::when_all(handles);
+	promises[0].Complete(true);
+	promises[1].SetProgress(0.5f);
+	MATSYS_CHECK(std::abs(hAll.GetProgress() - 1.5f / 4.f) < 0.001f);
+	promises[1].Complete(true);
+	promises[2].Complete(false);
+	MATSYS_CHECK(!hAll.IsReady());
+	promises[3].Complete(true);
+	MATSYS_CHECK(hAll.GetState() == LoadState::Failed);
+
+	MATSYS_CHECK(pragma::material::when_all({}).IsSuccessful());
+	MATSYS_CHECK(pragma::material::when_all({LoadHandle::CreateCompleted(true), LoadHandle::CreateCompleted(true)}).IsSuccessful());
+}
+
+MATSYS_TEST(pending_load_registry)
+{
+	pragma::material::PendingLoadRegistry registry {};
+	auto [handle, isNewLoad] = registry.Add("a");
+	MATSYS_CHECK(isNewLoad && registry.IsPending("a"));
+	// The second request for the same asset shares the load
+	auto [handle2, isNewLoad2] = registry.Add("a");
+	MATSYS_CHECK(!isNewLoad2);
+
+	// Continuations may start new loads of the same asset
+	std::optional<bool> isNewLoadInContinuation {};
+	handle.Then([&registry, &isNewLoadInContinuation](bool success) { isNewLoadInContinuation = registry.Add("a").second; });
+	registry.Complete("a", false);
+	MATSYS_CHECK(handle.GetState() == LoadState::Failed && handle2.GetState() == LoadState::Failed);
+	MATSYS_CHECK(isNewLoadInContinuation.has_value() && *isNewLoadInContinuation);
+
+	registry.Add("b");
+	auto [handleC, isNewLoadC] = registry.Add("c");
+	registry.Clear();
+	MATSYS_CHECK(!registry.IsPending("a") && !registry.IsPending("b"));
+	MATSYS_CHECK(handleC.GetState() == LoadState::Failed);
+}
+
+MATSYS_TEST(concurrent_registry_access)
+{
+	pragma::material::PendingLoadRegistry registry {};
+	constexpr uint32_t NUM_THREADS = 4;
+	constexpr uint32_t NUM_IDENTIFIERS = 500;
+	std::atomic<uint32_t> numStarted = 0;
+	std::atomic<uint32_t> numCompleted = 0;
+	std::vector<std::thread> threads;
+	for(auto t = 0u; t < NUM_THREADS; ++t) {
+		threads.emplace_back([&]() {
+			for(auto i = 0u; i < NUM_IDENTIFIERS; ++i) {
+				auto [handle, isNewLoad] = registry.Add(std::to_string(i));
+				if(isNewLoad)
+					++numStarted;
+				handle.Then([&numCompleted](bool) { ++numCompleted; });
+				if(isNewLoad)
+					registry.Complete(std::to_string(i), true);
+			}
+		});
+	}
+	for(auto &t : threads)
+		t.join();
+	// Every request gets completed, no matter whether it started a load or joined one
+	MATSYS_CHECK(numCompleted == NUM_THREADS * NUM_IDENTIFIERS);
+	MATSYS_CHECK(numStarted >= NUM_IDENTIFIERS);
+}
+
+MATSYS_TEST(missing_material_fails_immediately)
+{
+	auto manager = pragma::material::MaterialManager::Create();
+	auto handle = manager->LoadAssetAsync("matsys_test_load_handle_missing/material");
+	// No load job could be started, so the handle has to be completed without polling the manager
+	MATSYS_CHECK(handle.IsReady() && !handle.IsSuccessful());
+	// A failed load must not block subsequent attempts
+	auto handle2 = manager->LoadAssetAsync("matsys_test_load_handle_missing/material");
+	MATSYS_CHECK(handle2.GetState() == LoadState::Failed);
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+
+namespace {
+	// Materials have to be located in the materials directory of the virtual file system
+	struct Fixture {
+		Fixture() : dir {"material_batch_load", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()}
+		{
+			for(uint32_t i = 0; i < 32; ++i) {
+				auto name = "mat_" + std::to_string(i);
+				// Materials share some of their textures, like the materials of an imported model usually do
+				dir.WriteFile(name + ".wmi", "\"test\"\n{\n\t$texture albedo_map \"" + GetPath(name + "_albedo") + "\"\n\t$texture normal_map \"" + GetPath("shared_normal_" + std::to_string(i % 4)) + "\"\n\t$float metalness_factor " + std::to_string(i % 2) + "\n}\n");
+				materials.push_back(GetPath(name));
+			}
+		}
+		std::string GetPath(const std::string &name) const { return dir.GetName() + '/' + name; }
+		test::TempDirectory dir;
+		std::vector<std::string> materials;
+	};
+	std::string get_texture(const pragma::material::Material &mat, const std::string &key)
+	{
+		auto *texInfo = mat.GetTextureInfo(key);
+		return texInfo ? texInfo->name : std::string {};
+	}
+}
+
+// Loading the materials as a batch has to produce the same materials as loading them one after another
+MATSYS_TEST(batch_matches_serial)
+{
+	Fixture fixture {};
+	auto serialManager = pragma::material::MaterialManager::Create();
+	std::vector<std::shared_ptr<pragma::material::Material>> serial;
+	for(auto &mat : fixture.materials)
+		serial.push_back(serialManager->LoadAsset(mat));
+
+	auto batchManager = pragma::material::MaterialManager::Create();
+	auto timedOut = true;
+	MATSYS_CHECK(batchManager->LoadAssetBatch(fixture.materials, std::chrono::seconds {30}, &timedOut) == fixture.materials.size());
+	MATSYS_CHECK(!timedOut);
+	for(size_t i = 0; i < fixture.materials.size(); ++i) {
+		MATSYS_REQUIRE(serial[i] != nullptr);
+		// The batch has already loaded the material, so this only retrieves it from the cache
+		MATSYS_REQUIRE(batchManager->FindCachedAsset(batchManager->ToCacheIdentifier(fixture.materials[i])) != nullptr);
+		auto batched = batchManager->LoadAsset(fixture.materials[i]);
+		MATSYS_REQUIRE(batched != nullptr);
+		MATSYS_CHECK(batched->GetShaderIdentifier() == serial[i]->GetShaderIdentifier());
+		MATSYS_CHECK(get_texture(*batched, "albedo_map") == get_texture(*serial[i], "albedo_map"));
+		MATSYS_CHECK(get_texture(*batched, "normal_map") == get_texture(*serial[i], "normal_map"));
+		MATSYS_CHECK(batched->GetProperty("metalness_factor", -1.f) == serial[i]->GetProperty("metalness_factor", -1.f));
+	}
+}
+
+// Materials that don't exist or can't be loaded must not stall the batch
+MATSYS_TEST(batch_with_failures_completes)
+{
+	Fixture fixture {};
+	fixture.dir.WriteFile("invalid.wmi", "\"test\"\n{\n\t$texture albedo_map");
+	auto materials = fixture.materials;
+	materials.insert(materials.begin() + 3, fixture.GetPath("missing"));
+	materials.push_back(fixture.GetPath("invalid"));
+
+	auto manager = pragma::material::MaterialManager::Create();
+	auto timedOut = true;
+	auto t = std::chrono::steady_clock::now();
+	MATSYS_CHECK(manager->LoadAssetBatch(materials, std::chrono::seconds {30}, &timedOut) == fixture.materials.size());
+	MATSYS_CHECK(!timedOut);
+	MATSYS_CHECK(std::chrono::steady_clock::now() - t < std::chrono::seconds {30});
+
+	timedOut = true;
+	MATSYS_CHECK(manager->LoadAssetBatch({fixture.GetPath("missing"), fixture.GetPath("missing_too")}, std::chrono::seconds {30}, &timedOut) == 0);
+	MATSYS_CHECK(!timedOut);
+	MATSYS_CHECK(manager->LoadAssetBatch({}, std::chrono::seconds {30}, &timedOut) == 0);
+	MATSYS_CHECK(!timedOut);
+}
+
+#ifndef DISABLE_VMT_SUPPORT
+namespace {
+	std::vector<uint8_t> read_file(const std::filesystem::path &path)
+	{
+		std::ifstream f {path, std::ios::binary};
+		return std::vector<uint8_t> {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> {}};
+	}
+	// Returns the converted files of all successful imports by their source file and removes them, otherwise the
+	// next manager would load them instead of importing the source files again
+	std::map<std::string, std::vector<uint8_t>> take_import_outputs(pragma::material::MaterialManager &manager)
+	{
+		std::map<std::string, std::vector<uint8_t>> outputs;
+		for(auto &record : manager.GetImportDiagnostics().GetRecords()) {
+			if(record.errorClass != pragma::material::ImportErrorClass::None)
+				continue;
+			auto path = std::filesystem::path {pragma::util::get_program_path()} / (record.outputPath + ".pmat");
+			outputs[record.sourceFile] = read_file(path);
+			std::error_code ec;
+			std::filesystem::remove(path, ec);
+		}
+		return outputs;
+	}
+}
+
+// Importing vmt files as a batch has to write the same materials as importing them one after another
+MATSYS_TEST(vmt_batch_import_matches_serial)
+{
+	test::TempDirectory dir {"material_batch_import_vmt", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	std::vector<std::string> materials;
+	for(uint32_t i = 0; i < 24; ++i) {
+		auto name = "mat_" + std::to_string(i);
+		std::stringstream vmt;
+		vmt << ((i % 2 == 0) ? "\"VertexLitGeneric\"" : "\"LightmappedGeneric\"") << "\n{\n";
+		vmt << "\t\"$basetexture\" \"" << dir.GetName() << "/" << name << "_color\"\n";
+		vmt << "\t\"$bumpmap\" \"" << dir.GetName() << "/shared_normal_" << (i % 4) << "\"\n";
+		vmt << "\t\"$surfaceprop\" \"" << ((i % 3 == 0) ? "metal" : "wood") << "\"\n";
+		if(i % 5 == 0)
+			vmt << "\t\"$alphatest\" \"1\"\n\t\"$alphatestreference\" \"0.5\"\n";
+		if(i % 4 == 1)
+			vmt << "\t\"$color\" \"[1 0.5 0.25]\"\n";
+		vmt << "}\n";
+		dir.WriteFile(name + ".vmt", vmt.str());
+		materials.push_back(dir.GetName() + '/' + name);
+	}
+
+	auto serialManager = pragma::material::MaterialManager::Create();
+	for(auto &mat : materials)
+		MATSYS_CHECK(serialManager->LoadAsset(mat) != nullptr);
+	auto serial = take_import_outputs(*serialManager);
+	MATSYS_REQUIRE(serial.size() == materials.size());
+
+	auto batchManager = pragma::material::MaterialManager::Create();
+	auto timedOut = true;
+	MATSYS_CHECK(batchManager->LoadAssetBatch(materials, std::chrono::seconds {30}, &timedOut) == materials.size());
+	MATSYS_CHECK(!timedOut);
+	auto batched = take_import_outputs(*batchManager);
+	MATSYS_REQUIRE(batched.size() == serial.size());
+	for(auto &[sourceFile, data] : serial) {
+		auto it = batched.find(sourceFile);
+		MATSYS_REQUIRE(it != batched.end());
+		MATSYS_CHECK(!data.empty());
+		MATSYS_CHECK(it->second == data);
+	}
+}
+#endif
+
+MATSYS_TEST_MAIN()
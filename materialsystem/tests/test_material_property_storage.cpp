@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Conformance tests, which every material property storage backend has to pass
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+using pragma::material::DataBlockPropertyStorage;
+using pragma::material::IMaterialPropertyStorage;
+using pragma::material::PropertyType;
+using pragma::material::UdmPropertyStorage;
+
+namespace {
+	std::shared_ptr<pragma::datasystem::Block> create_data_block() { return pragma::util::make_shared<pragma::datasystem::Block>(*pragma::material::get_shared_data_settings()); }
+	struct Backend {
+		const char *name;
+		std::function<std::unique_ptr<IMaterialPropertyStorage>()> create;
+	};
+	const std::vector<Backend> &get_backends()
+	{
+		static std::vector<Backend> backends {
+		  {"data block", []() -> std::unique_ptr<IMaterialPropertyStorage> { return std::make_unique<DataBlockPropertyStorage>(create_data_block()); }},
+		  {"udm", []() -> std::unique_ptr<IMaterialPropertyStorage> { return std::make_unique<UdmPropertyStorage>(); }},
+		};
+		return backends;
+	}
+	template<typename TFunc>
+	void for_each_backend(const TFunc &f)
+	{
+		for(auto &backend : get_backends()) {
+			std::cout << "  backend: " << backend.name << std::endl;
+			auto storage = backend.create();
+			f(*storage);
+		}
+	}
+	// Properties which cover all underlying property types, a texture and a nested block
+	void populate(IMaterialPropertyStorage &storage)
+	{
+		storage.SetProperty("int", int32_t {-7});
+		storage.SetProperty("float", 0.25f);
+		storage.SetProperty("bool", true);
+		storage.SetProperty("string", std::string {"value"});
+		storage.SetProperty("vector2", Vector2 {1.f, 2.f});
+		storage.SetProperty("vector3", Vector3 {1.f, 2.f, 3.f});
+		storage.SetProperty("vector4", Vector4 {1.f, 2.f, 3.f, 4.f});
+		storage.SetTextureProperty("albedo_map", "models/crate_albedo");
+		storage.AddBlock("sss");
+		storage.SetProperty("sss/factor", 0.5f);
+		storage.SetProperty("sss/color", Vector3 {1.f, 0.f, 0.f});
+	}
+	void check_populated(IMaterialPropertyStorage &storage)
+	{
+		MATSYS_CHECK(storage.GetProperty<int32_t>("int", 0) == -7);
+		MATSYS_CHECK(storage.GetProperty<float>("float", 0.f) == 0.25f);
+		MATSYS_CHECK(storage.GetProperty<bool>("bool", false) == true);
+		MATSYS_CHECK(storage.GetProperty<std::string>("string", "") == "value");
+		MATSYS_CHECK(storage.GetProperty<Vector2>("vector2", {}) == Vector2(1.f, 2.f));
+		MATSYS_CHECK(storage.GetProperty<Vector3>("vector3", {}) == Vector3(1.f, 2.f, 3.f));
+		MATSYS_CHECK(storage.GetProperty<Vector4>("vector4", {}) == Vector4(1.f, 2.f, 3.f, 4.f));
+		MATSYS_CHECK(storage.GetPropertyType("albedo_map") == PropertyType::Texture);
+		MATSYS_CHECK(storage.GetProperty<std::string>("albedo_map", "") == "models/crate_albedo");
+		MATSYS_CHECK(storage.GetPropertyType("sss") == PropertyType::Block);
+		MATSYS_CHECK(storage.GetProperty<float>("sss/factor", 0.f) == 0.5f);
+		MATSYS_CHECK(storage.GetProperty<Vector3>("sss/color", {}) == Vector3(1.f, 0.f, 0.f));
+	}
+}
+
+MATSYS_TEST(values_round_trip)
+{
+	for_each_backend([](IMaterialPropertyStorage &storage) {
+		populate(storage);
+		check_populated(storage);
+		MATSYS_CHECK(storage.GetPropertyType("int") == PropertyType::Value);
+		MATSYS_CHECK(storage.GetPropertyType("missing") == PropertyType::None);
+		int32_t value = 5;
+		MATSYS_CHECK(!storage.GetProperty<int32_t>("missing", &value) && value == 5);
+		MATSYS_CHECK(storage.GetProperty<float>("missing", 1.5f) == 1.5f);
+	});
+}
+
+MATSYS_TEST(values_are_normalized_and_converted)
+{
+	for_each_backend([](IMaterialPropertyStorage &storage) {
+		storage.SetProperty("uint8", uint8_t {200});
+		storage.SetProperty("double", 0.5);
+		storage.SetProperty("alpha_mode", AlphaMode::Blend);
+		MATSYS_CHECK(storage.GetProperty<uint8_t>("uint8", 0) == 200);
+		MATSYS_CHECK(storage.GetProperty<int32_t>("uint8", 0) == 200);
+		MATSYS_CHECK(storage.GetProperty<float>("uint8", 0.f) == 200.f);
+		MATSYS_CHECK(storage.GetProperty<double>("double", 0.0) == 0.5);
+		MATSYS_CHECK(storage.GetProperty<AlphaMode>("alpha_mode", AlphaMode::Opaque) == AlphaMode::Blend);
+
+		storage.SetProperty("value", 2.75f);
+		MATSYS_CHECK(storage.GetProperty<int32_t>("value", 0) == 2);
+		storage.SetProperty("value", true);
+		MATSYS_CHECK(storage.GetProperty<int32_t>("value", 0) == 1);
+		// A new value replaces the previous one, including its type
+		storage.SetProperty("value", 1.5f);
+		MATSYS_CHECK(storage.GetProperty<float>("value", 0.f) == 1.5f);
+		storage.SetProperty("value", std::string {"text"});
+		MATSYS_CHECK(storage.GetProperty<std::string>("value", "") == "text");
+	});
+}
+
+MATSYS_TEST(textures_and_values_share_keys)
+{
+	for_each_backend([](IMaterialPropertyStorage &storage) {
+		storage.SetTextureProperty("normal_map", "models/a");
+		storage.SetTextureProperty("normal_map", "models/b");
+		MATSYS_CHECK(storage.GetProperty<std::string>("normal_map", "") == "models/b");
+		storage.SetProperty("normal_map", 1);
+		MATSYS_CHECK(storage.GetPropertyType("normal_map") == PropertyType::Value);
+		storage.SetTextureProperty("normal_map", "models/c");
+		MATSYS_CHECK(storage.GetPropertyType("normal_map") == PropertyType::Texture);
+		MATSYS_CHECK(storage.GetProperty<std::string>("normal_map", "") == "models/c");
+		storage.ClearProperty("normal_map");
+		MATSYS_CHECK(storage.GetPropertyType("normal_map") == PropertyType::None);
+	});
+}
+
+MATSYS_TEST(nested_blocks)
+{
+	for_each_backend([](IMaterialPropertyStorage &storage) {
+		// Values can only be assigned to existing blocks
+		storage.SetProperty("block/value", 1);
+		MATSYS_CHECK(storage.GetPropertyType("block/value") == PropertyType::None);
+		MATSYS_CHECK(!storage.AddBlock("missing/block"));
+		MATSYS_CHECK(storage.AddBlock("block"));
+		MATSYS_CHECK(storage.AddBlock("block/child"));
+		storage.SetProperty("block/value", 1);
+		storage.SetProperty("block/child/value", 2);
+		MATSYS_CHECK(storage.GetPropertyType("block/child") == PropertyType::Block);
+		MATSYS_CHECK(storage.GetProperty<int32_t>("block/value", 0) == 1);
+		MATSYS_CHECK(storage.GetProperty<int32_t>("block/child/value", 0) == 2);
+		// Blocks are not values
+		int32_t value;
+		MATSYS_CHECK(!storage.GetProperty<int32_t>("block", &value));
+
+		storage.ClearProperty("block/child/value");
+		MATSYS_CHECK(storage.GetPropertyType("block/child/value") == PropertyType::None);
+		MATSYS_CHECK(storage.GetPropertyType("block/child") == PropertyType::Block);
+		storage.ClearProperty("block");
+		MATSYS_CHECK(storage.GetPropertyType("block") == PropertyType::None);
+		MATSYS_CHECK(storage.GetPropertyType("block/value") == PropertyType::None);
+	});
+}
+
+// Data saved by either backend has to be readable by both of them
+MATSYS_TEST(save_and_load)
+{
+	for_each_backend([](IMaterialPropertyStorage &storage) {
+		populate(storage);
+		auto udmData = udm::Data::Create();
+		auto udmRoot = udmData->GetAssetData().GetData();
+		storage.Save(udmRoot);
+
+		auto block = create_data_block();
+		MATSYS_REQUIRE(pragma::material::udm_to_data_block(udmRoot, *block));
+		DataBlockPropertyStorage dataBlockStorage {block};
+		check_populated(dataBlockStorage);
+
+		UdmPropertyStorage udmStorage {};
+		udmStorage.Load(udmRoot);
+		check_populated(udmStorage);
+		auto blockFromUdm = create_data_block();
+		MATSYS_REQUIRE(udmStorage.ToDataBlock(*blockFromUdm));
+		DataBlockPropertyStorage dataBlockStorageFromUdm {blockFromUdm};
+		check_populated(dataBlockStorageFromUdm);
+	});
+}
+
+// The data block backend is the storage of Material, so both have to agree
+MATSYS_TEST(material_properties_match_storage)
+{
+	auto manager = pragma::material::MaterialManager::Create();
+	auto block = create_data_block();
+	DataBlockPropertyStorage storage {block};
+	populate(storage);
+	auto mat = pragma::material::Material::Create(*manager, "pbr", block);
+	MATSYS_CHECK(mat->GetProperty<int32_t>("int", 0) == -7);
+	MATSYS_CHECK(mat->GetProperty<float>("sss/factor", 0.f) == 0.5f);
+	MATSYS_CHECK(mat->GetProperty<Vector4>("vector4", {}) == Vector4(1.f, 2.f, 3.f, 4.f));
+	MATSYS_CHECK(mat->GetPropertyType("albedo_map") == PropertyType::Texture);
+	MATSYS_CHECK(mat->GetPropertyType("sss") == PropertyType::Block);
+
+	mat->SetProperty("float", 4.f);
+	mat->SetProperty("sss/factor", 1);
+	MATSYS_CHECK(storage.GetProperty<float>("float", 0.f) == 4.f);
+	MATSYS_CHECK(storage.GetProperty<float>("sss/factor", 0.f) == 1.f);
+
+	// Material::Save writes the same data as the storage
+	auto udmData = udm::Data::Create();
+	std::string err;
+	MATSYS_REQUIRE(mat->Save(udmData->GetAssetData(), err));
+	UdmPropertyStorage udmStorage {};
+	udmStorage.Load(udmData->GetAssetData().GetData()["pbr"]);
+	MATSYS_CHECK(udmStorage.GetProperty<float>("float", 0.f) == 4.f);
+	MATSYS_CHECK(udmStorage.GetProperty<std::string>("albedo_map", "") == "models/crate_albedo");
+}
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+namespace test = pragma::material::test;
+
+namespace {
+	constexpr auto MATERIAL = "\"pbr\"\n{\n"
+	                          "\t$texture albedo_map \"models/crate_albedo\"\n"
+	                          "\t$texture normal_map \"models/crate_normal\"\n"
+	                          "\t$float metalness_factor 0.5\n"
+	                          "\t$int alpha_mode 2\n"
+	                          "\t$bool translucent 1\n"
+	                          "\t$string surface_material \"wood\"\n"
+	                          "\t$vector color_factor \"1 0.5 0.25\"\n"
+	                          "\t\"subsurface_scattering\"\n\t{\n\t\t$float factor 0.1\n\t\t$vector color \"1 0 0\"\n\t}\n"
+	                          "}\n";
+	std::string get_vfs_path(const test::TempDirectory &dir, const std::string &fileName) { return MaterialManager::GetRootMaterialLocation() + '/' + dir.GetName() + '/' + fileName; }
+	std::vector<uint8_t> read_file(const std::filesystem::path &path)
+	{
+		std::ifstream f {path, std::ios::binary};
+		return std::vector<uint8_t> {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> {}};
+	}
+	std::shared_ptr<udm::Data> load_udm(const std::string &vfsPath)
+	{
+		auto f = pragma::fs::open_file(vfsPath, pragma::fs::FileMode::Read | pragma::fs::FileMode::Binary);
+		if(!f)
+			return nullptr;
+		try {
+			return udm::Data::Load(std::make_unique<pragma::fs::File>(f));
+		}
+		catch(const udm::Exception &e) {
+			return nullptr;
+		}
+	}
+	bool save_udm(udm::Data &udmData, const std::string &vfsPath)
+	{
+		auto f = pragma::fs::open_file<pragma::fs::VFilePtrReal>(vfsPath, pragma::fs::FileMode::Write | pragma::fs::FileMode::Binary);
+		return f && udmData.Save(f);
+	}
+	std::shared_ptr<pragma::material::Material> load_material(pragma::material::MaterialManager &manager, const test::TempDirectory &dir)
+	{
+		dir.WriteFile("source.wmi", MATERIAL);
+		return manager.LoadAsset(dir.GetName() + "/source");
+	}
+}
+
+// The pmat_b file written by Material::Save has to be identical to what udm::Data writes when the file is loaded and saved again,
+// i.e. the material doesn't write anything the format doesn't preserve.
+MATSYS_TEST(pmat_b_matches_udm_reserialization)
+{
+	test::TempDirectory dir {"material_save", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	auto manager = pragma::material::MaterialManager::Create();
+	auto mat = load_material(*manager, dir);
+	MATSYS_REQUIRE(mat != nullptr);
+	std::string err;
+	MATSYS_REQUIRE(mat->Save(get_vfs_path(dir, "saved.pmat_b"), err, true));
+
+	auto udmData = load_udm(get_vfs_path(dir, "saved.pmat_b"));
+	MATSYS_REQUIRE(udmData != nullptr);
+	MATSYS_REQUIRE(save_udm(*udmData, get_vfs_path(dir, "resaved.pmat_b")));
+	auto saved = read_file(dir.GetPath() / "saved.pmat_b");
+	MATSYS_CHECK(!saved.empty());
+	MATSYS_CHECK(saved == read_file(dir.GetPath() / "resaved.pmat_b"));
+
+	// Saving the reloaded material again must not change the output either
+	auto reloaded = manager->LoadAsset(dir.GetName() + "/saved.pmat_b");
+	MATSYS_REQUIRE(reloaded != nullptr);
+	MATSYS_REQUIRE(reloaded->Save(get_vfs_path(dir, "saved_twice.pmat_b"), err, true));
+	MATSYS_CHECK(saved == read_file(dir.GetPath() / "saved_twice.pmat_b"));
+}
+
+// The UDM property storage keeps the UDM types of a loaded file, so it has to write the same bytes back
+MATSYS_TEST(udm_property_storage_round_trip)
+{
+	test::TempDirectory dir {"material_save_storage", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	auto manager = pragma::material::MaterialManager::Create();
+	auto mat = load_material(*manager, dir);
+	MATSYS_REQUIRE(mat != nullptr);
+	std::string err;
+	MATSYS_REQUIRE(mat->Save(get_vfs_path(dir, "saved.pmat_b"), err, true));
+	auto udmData = load_udm(get_vfs_path(dir, "saved.pmat_b"));
+	MATSYS_REQUIRE(udmData != nullptr);
+
+	pragma::material::UdmPropertyStorage storage {};
+	storage.Load(udmData->GetAssetData().GetData()[mat->GetShaderIdentifier()]);
+	MATSYS_CHECK(storage.GetProperty<float>("metalness_factor", 0.f) == 0.5f);
+	MATSYS_CHECK(storage.GetProperty<AlphaMode>("alpha_mode", AlphaMode::Opaque) == AlphaMode::Blend);
+	MATSYS_CHECK(storage.GetProperty<std::string>("albedo_map", "") == "models/crate_albedo");
+	MATSYS_CHECK(storage.GetProperty<Vector3>("subsurface_scattering/color", {}) == Vector3(1.f, 0.f, 0.f));
+
+	auto udmOut = udm::Data::Create();
+	auto assetData = udmOut->GetAssetData();
+	assetData.SetAssetType(pragma::material::ematerial::PMAT_IDENTIFIER);
+	assetData.SetAssetVersion(pragma::material::ematerial::PMAT_VERSION);
+	auto udmMat = assetData.GetData().Add(mat->GetShaderIdentifier());
+	storage.Save(udmMat);
+	MATSYS_REQUIRE(save_udm(*udmOut, get_vfs_path(dir, "storage.pmat_b")));
+	MATSYS_CHECK(read_file(dir.GetPath() / "saved.pmat_b") == read_file(dir.GetPath() / "storage.pmat_b"));
+}
+
+// The ascii format has to round trip as well, with the same property values as the source material
+MATSYS_TEST(pmat_round_trip)
+{
+	test::TempDirectory dir {"material_save_ascii", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()};
+	auto manager = pragma::material::MaterialManager::Create();
+	auto mat = load_material(*manager, dir);
+	MATSYS_REQUIRE(mat != nullptr);
+	std::string err;
+	MATSYS_REQUIRE(mat->Save(get_vfs_path(dir, "saved.pmat"), err, true));
+	auto reloaded = manager->LoadAsset(dir.GetName() + "/saved.pmat");
+	MATSYS_REQUIRE(reloaded != nullptr);
+	MATSYS_CHECK(reloaded->GetProperty<float>("metalness_factor", 0.f) == 0.5f);
+	MATSYS_CHECK(reloaded->GetProperty<int32_t>("alpha_mode", 0) == 2);
+	MATSYS_CHECK(reloaded->GetProperty<bool>("translucent", false) == true);
+	MATSYS_CHECK(reloaded->GetProperty<std::string>("surface_material", "") == "wood");
+	MATSYS_CHECK(reloaded->GetProperty<Vector3>("color_factor", {}) == Vector3(1.f, 0.5f, 0.25f));
+	MATSYS_CHECK(reloaded->GetProperty<float>("subsurface_scattering/factor", 0.f) == 0.1f);
+	MATSYS_CHECK(reloaded->GetPropertyType("normal_map") == pragma::material::PropertyType::Texture);
+}
+
+MATSYS_TEST_MAIN()
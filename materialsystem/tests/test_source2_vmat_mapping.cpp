@@ -0,0 +1,266 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+#include "vmat_fixtures.hpp"
+
+#ifndef DISABLE_VMAT_SUPPORT
+using pragma::material::Source2VmatImportReport;
+namespace test = pragma::material::test;
+namespace ematerial = pragma::material::ematerial;
+
+namespace {
+	// Captures everything that is written to std::cout while in scope
+	struct CoutCapture {
+		CoutCapture() : m_prevBuf {std::cout.rdbuf(m_stream.rdbuf())} {}
+		~CoutCapture() { std::cout.rdbuf(m_prevBuf); }
+		std::string GetOutput() const { return m_stream.str(); }
+	  private:
+		std::stringstream m_stream;
+		std::streambuf *m_prevBuf;
+	};
+	Source2VmatImportReport create_report()
+	{
+		Source2VmatImportReport report {};
+		report.fileName = "models/props/crate";
+		report.shader = "vr_standard.vfx";
+		report.unmappedParameters = {{Source2VmatImportReport::ParameterType::Int, "F_RENDER_BACKFACES", "1"}};
+		return report;
+	}
+
+	// Imports generated vmat_c files through the material manager and collects the import reports
+	struct VmatCorpus {
+		VmatCorpus() : dir {"vmat_corpus", std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation()}, manager {pragma::material::MaterialManager::Create()}
+		{
+			pragma::material::set_source2_vmat_import_report_callback([this](const Source2VmatImportReport &report) { reports.push_back(report); });
+		}
+		~VmatCorpus() { pragma::material::set_source2_vmat_import_report_callback(nullptr); }
+		std::shared_ptr<pragma::material::Material> Import(const std::string &name, const test::VmatDesc &desc)
+		{
+			dir.WriteFile(name + ".vmat_c", test::create_vmat_c(desc, "materials/" + name + ".vmat"));
+			return manager->LoadAsset(dir.GetName() + '/' + name);
+		}
+		const Source2VmatImportReport *FindReport(const std::string &name) const
+		{
+			auto it = std::find_if(reports.begin(), reports.end(), [&name](const Source2VmatImportReport &report) { return std::filesystem::path {report.fileName}.stem() == name; });
+			return (it != reports.end()) ? &*it : nullptr;
+		}
+		test::TempDirectory dir;
+		std::shared_ptr<pragma::material::MaterialManager> manager;
+		std::vector<Source2VmatImportReport> reports;
+	};
+	std::string get_texture(const pragma::material::Material &mat, const std::string &key)
+	{
+		auto *texInfo = mat.GetTextureInfo(key);
+		return texInfo ? texInfo->name : std::string {};
+	}
+	bool has_texture(const pragma::material::Material &mat, const std::string &key, const std::string &name) { return get_texture(mat, key).find(name) != std::string::npos; }
+	std::vector<std::string> get_unmapped_parameters(const Source2VmatImportReport *report)
+	{
+		std::vector<std::string> names;
+		if(report) {
+			for(auto &param : report->unmappedParameters)
+				names.push_back(param.name);
+		}
+		return names;
+	}
+}
+
+MATSYS_TEST(shader_mappings)
+{
+	auto *mapping = pragma::material::find_source2_vmat_shader_mapping("VR_Standard.vfx");
+	MATSYS_REQUIRE(mapping != nullptr);
+	MATSYS_CHECK(mapping->name == "steamvr_standard");
+	MATSYS_CHECK(mapping->origin == pragma::material::VMatOrigin::SteamVR);
+	MATSYS_CHECK(pragma::material::find_source2_vmat_shader_mapping("hero.vfx")->origin == pragma::material::VMatOrigin::Dota2);
+	MATSYS_CHECK(pragma::material::find_source2_vmat_shader_mapping("vr_simple_2way_blend.vfx")->materialShader == "pbr_blend");
+	MATSYS_CHECK(pragma::material::find_source2_vmat_shader_mapping("unknown_shader.vfx") == nullptr);
+
+	// Mapped textures and values, parameters handled elsewhere and the shared parameters are all known
+	MATSYS_CHECK(mapping->IsKnownParameter("g_tColor"));
+	MATSYS_CHECK(mapping->IsKnownParameter("G_FLMETALNESS"));
+	MATSYS_CHECK(mapping->IsKnownParameter("g_tMetalnessReflectance"));
+	MATSYS_CHECK(mapping->IsKnownParameter("F_ALPHA_TEST"));
+	MATSYS_CHECK(!mapping->IsKnownParameter("F_RENDER_BACKFACES"));
+	MATSYS_CHECK(!pragma::material::get_default_source2_vmat_shader_mapping().IsKnownParameter("g_tMasks1"));
+}
+
+// Unmapped parameters are only printed if enabled, since almost every material contains some
+MATSYS_TEST(report_warnings_are_opt_in)
+{
+	MATSYS_CHECK(!pragma::material::are_source2_vmat_import_report_warnings_enabled());
+	{
+		CoutCapture capture {};
+		pragma::material::report_source2_vmat_import(create_report());
+		MATSYS_CHECK(capture.GetOutput().empty());
+	}
+
+	pragma::material::set_source2_vmat_import_report_warnings_enabled(true);
+	{
+		CoutCapture capture {};
+		pragma::material::report_source2_vmat_import(create_report());
+		auto output = capture.GetOutput();
+		MATSYS_CHECK(output.find("models/props/crate") != std::string::npos);
+		MATSYS_CHECK(output.find("F_RENDER_BACKFACES=1") != std::string::npos);
+	}
+	{
+		// Reports without unmapped parameters are never printed
+		CoutCapture capture {};
+		Source2VmatImportReport report {};
+		report.fileName = "models/props/crate";
+		pragma::material::report_source2_vmat_import(report);
+		MATSYS_CHECK(capture.GetOutput().empty());
+	}
+	pragma::material::set_source2_vmat_import_report_warnings_enabled(false);
+}
+
+MATSYS_TEST(report_callback)
+{
+	std::vector<Source2VmatImportReport> reports;
+	pragma::material::set_source2_vmat_import_report_callback([&reports](const Source2VmatImportReport &report) { reports.push_back(report); });
+	pragma::material::set_source2_vmat_import_report_warnings_enabled(true);
+	{
+		CoutCapture capture {};
+		pragma::material::report_source2_vmat_import(create_report());
+		auto unknownShader = create_report();
+		unknownShader.unmappedParameters.clear();
+		unknownShader.unknownShader = true;
+		pragma::material::report_source2_vmat_import(unknownShader);
+		pragma::material::report_source2_vmat_import(Source2VmatImportReport {});
+		// The callback replaces the warning
+		MATSYS_CHECK(capture.GetOutput().empty());
+	}
+	pragma::material::set_source2_vmat_import_report_warnings_enabled(false);
+	pragma::material::set_source2_vmat_import_report_callback(nullptr);
+
+	MATSYS_REQUIRE(reports.size() == 2);
+	MATSYS_CHECK(reports[0].unmappedParameters.size() == 1 && reports[0].unmappedParameters.front().name == "F_RENDER_BACKFACES");
+	MATSYS_CHECK(reports[1].unknownShader);
+}
+
+// The vmat_c corpus covers every shader mapping, the textures are never imported since there is no texture manager
+MATSYS_TEST(vmat_corpus_vr_standard)
+{
+	VmatCorpus corpus {};
+	test::VmatDesc desc {};
+	desc.shader = "vr_standard.vfx";
+	desc.intParams = {{"F_RENDER_BACKFACES", 1}, {"F_ALPHA_TEST", 1}};
+	desc.floatParams = {{"g_flMetalness", 0.5f}};
+	desc.vectorParams = {{"TextureColor", {1.f, 1.f, 1.f, 0.f}}};
+	desc.textureParams = {{"g_tColor", "materials/models/crate/crate_color.vtex"}, {"g_tNormal", "materials/models/crate/crate_normal.vtex"}, {"g_tSelfIllumMask", "materials/models/crate/crate_selfillum.vtex"}};
+	auto mat = corpus.Import("crate", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetShaderIdentifier() == "pbr");
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP_IDENTIFIER, "models/crate/crate_color"));
+	MATSYS_CHECK(has_texture(*mat, ematerial::NORMAL_MAP_IDENTIFIER, "models/crate/crate_normal"));
+	MATSYS_CHECK(has_texture(*mat, ematerial::EMISSION_MAP_IDENTIFIER, "models/crate/crate_selfillum"));
+	MATSYS_CHECK(mat->GetProperty("metalness_factor", -1.f) == 0.5f);
+	auto *report = corpus.FindReport("crate");
+	MATSYS_REQUIRE(report != nullptr);
+	MATSYS_CHECK(report->shader == "vr_standard.vfx");
+	MATSYS_CHECK(!report->unknownShader);
+	MATSYS_CHECK(get_unmapped_parameters(report) == std::vector<std::string> {"F_RENDER_BACKFACES"});
+	MATSYS_CHECK(report->unmappedParameters.front().type == Source2VmatImportReport::ParameterType::Int && report->unmappedParameters.front().value == "1");
+
+	// The metalness is taken from the metalness-reflectance map instead of the constant
+	desc.textureParams.push_back({"g_tMetalnessReflectance", "materials/models/crate/crate_metalness.vtex"});
+	desc.intParams.clear();
+	mat = corpus.Import("crate_metal", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetProperty("metalness_factor", -1.f) == -1.f);
+	// Materials without unmapped parameters are not reported
+	MATSYS_CHECK(corpus.FindReport("crate_metal") == nullptr);
+}
+
+MATSYS_TEST(vmat_corpus_2way_blend)
+{
+	VmatCorpus corpus {};
+	test::VmatDesc desc {};
+	desc.shader = "vr_simple_2way_blend.vfx";
+	desc.floatParams = {{"g_flMetalnessA", 0.25f}, {"g_flMetalnessB", 1.f}, {"g_flBlendSoftness", 0.5f}};
+	desc.vectorParams = {{"TextureRoughnessA", {0.5f, 0.5f, 0.5f, 0.f}}, {"TextureRoughnessB", {0.75f, 0.75f, 0.75f, 0.f}}};
+	desc.textureParams = {{"g_tColorA", "materials/terrain/grass_color.vtex"}, {"g_tColorB", "materials/terrain/rock_color.vtex"}, {"g_tNormalA", "materials/terrain/grass_normal.vtex"}};
+	auto mat = corpus.Import("terrain", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetShaderIdentifier() == "pbr_blend");
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP_IDENTIFIER, "terrain/grass_color"));
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP2_IDENTIFIER, "terrain/rock_color"));
+	MATSYS_CHECK(has_texture(*mat, ematerial::NORMAL_MAP_IDENTIFIER, "terrain/grass_normal"));
+	MATSYS_CHECK(mat->GetTextureInfo("normal_map2") == nullptr);
+	MATSYS_CHECK(mat->GetProperty("metalness_factor", -1.f) == 0.25f);
+	MATSYS_CHECK(mat->GetProperty("metalness_factor2", -1.f) == 1.f);
+	// The roughness of the first layer is stored in its normal map
+	MATSYS_CHECK(mat->GetProperty("roughness_factor", -1.f) == -1.f);
+	MATSYS_CHECK(mat->GetProperty("roughness_factor2", -1.f) == 0.75f);
+	MATSYS_CHECK(get_unmapped_parameters(corpus.FindReport("terrain")) == std::vector<std::string> {"g_flBlendSoftness"});
+}
+
+MATSYS_TEST(vmat_corpus_cilia)
+{
+	VmatCorpus corpus {};
+	test::VmatDesc desc {};
+	desc.shader = "vr_cilia.vfx";
+	desc.floatParams = {{"g_flMetalnessA", 0.f}, {"g_flCiliaLength", 2.f}};
+	desc.vectorParams = {{"TextureRoughnessA", {0.5f, 0.5f, 0.5f, 0.f}}, {"TextureColorA", {1.f, 1.f, 1.f, 0.f}}};
+	desc.textureParams = {{"g_tColorA", "materials/models/carpet/carpet_color.vtex"}, {"g_tCiliaMask", "materials/models/carpet/carpet_mask.vtex"}};
+	auto mat = corpus.Import("carpet", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetShaderIdentifier() == "pbr");
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP_IDENTIFIER, "models/carpet/carpet_color"));
+	MATSYS_CHECK(mat->GetTextureInfo(ematerial::NORMAL_MAP_IDENTIFIER) == nullptr);
+	MATSYS_CHECK(mat->GetProperty("metalness_factor", -1.f) == 0.f);
+	MATSYS_CHECK(mat->GetProperty("roughness_factor", -1.f) == 0.5f);
+	auto *report = corpus.FindReport("carpet");
+	MATSYS_CHECK((get_unmapped_parameters(report) == std::vector<std::string> {"g_flCiliaLength", "g_tCiliaMask"}));
+	MATSYS_REQUIRE(report != nullptr && report->unmappedParameters.size() == 2);
+	MATSYS_CHECK(report->unmappedParameters[1].type == Source2VmatImportReport::ParameterType::Texture);
+	MATSYS_CHECK(report->unmappedParameters[1].value == "materials/models/carpet/carpet_mask.vtex");
+}
+
+MATSYS_TEST(vmat_corpus_hero)
+{
+	VmatCorpus corpus {};
+	test::VmatDesc desc {};
+	desc.shader = "hero.vfx";
+	desc.intParams = {{"F_MASKS_1", 1}};
+	desc.textureParams = {
+	  {"g_tColor", "materials/models/heroes/axe/axe_color.vtex"},
+	  {"g_tNormal", "materials/models/heroes/axe/axe_normal.vtex"},
+	  {"g_tMasks1", "materials/models/heroes/axe/axe_masks1.vtex"},
+	  {"g_tMasks2", "materials/models/heroes/axe/axe_masks2.vtex"},
+	};
+	auto mat = corpus.Import("axe", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetShaderIdentifier() == "pbr");
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP_IDENTIFIER, "models/heroes/axe/axe_color"));
+	MATSYS_CHECK(has_texture(*mat, ematerial::NORMAL_MAP_IDENTIFIER, "models/heroes/axe/axe_normal"));
+	// The mask textures are only converted by the client-side import
+	MATSYS_CHECK(mat->GetTextureInfo(ematerial::RMA_MAP_IDENTIFIER) == nullptr);
+	MATSYS_CHECK(get_unmapped_parameters(corpus.FindReport("axe")) == std::vector<std::string> {"F_MASKS_1"});
+}
+
+MATSYS_TEST(vmat_corpus_generic)
+{
+	VmatCorpus corpus {};
+	test::VmatDesc desc {};
+	desc.shader = "unknown_shader.vfx";
+	desc.floatParams = {{"g_flMetalness", 1.f}};
+	desc.vectorParams = {{"g_vTint", {1.f, 0.5f, 0.25f, 1.f}}};
+	desc.textureParams = {{"g_tColor2", "materials/props/barrel_color.vtex"}, {"g_tMasks1", "materials/props/barrel_masks1.vtex"}};
+	auto mat = corpus.Import("barrel", desc);
+	MATSYS_REQUIRE(mat != nullptr);
+	MATSYS_CHECK(mat->GetShaderIdentifier() == "pbr");
+	MATSYS_CHECK(has_texture(*mat, ematerial::ALBEDO_MAP_IDENTIFIER, "props/barrel_color"));
+	MATSYS_CHECK(mat->GetProperty("metalness_factor", -1.f) == 1.f);
+	auto *report = corpus.FindReport("barrel");
+	MATSYS_REQUIRE(report != nullptr);
+	MATSYS_CHECK(report->unknownShader);
+	MATSYS_CHECK(report->shader == "unknown_shader.vfx");
+	MATSYS_CHECK((get_unmapped_parameters(report) == std::vector<std::string> {"g_tMasks1", "g_vTint"}));
+	MATSYS_CHECK(report->unmappedParameters[1].value == "1 0.5 0.25 1");
+}
+#endif
+
+MATSYS_TEST_MAIN()
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+#include "image_fixtures.hpp"
+
+namespace test = pragma::material::test;
+
+// Texture files have to be located in the materials directory of the virtual file system
+static std::filesystem::path get_material_root() { return std::filesystem::path {pragma::util::get_program_path()} / MaterialManager::GetRootMaterialLocation(); }
+
+MATSYS_TEST(parsing_does_not_touch_file_system)
+{
+	test::TempDirectory dir {"texture_info", get_material_root()};
+	dir.WriteFile("diffuse.png", test::create_png(16, 8));
+	pragma::material::clear_image_header_cache();
+
+	auto settings = pragma::datasystem::create_data_settings({});
+	pragma::datasystem::Texture tex {*settings, dir.GetName() + "/diffuse"};
+	auto &texInfo = tex.GetValue();
+	MATSYS_CHECK(!texInfo.IsSizeResolved());
+	MATSYS_CHECK(texInfo.width == 0 && texInfo.height == 0);
+
+	// If the image header had been read (or cached) during the parse, the old size would be reported here
+	dir.WriteFile("diffuse.png", test::create_png(32, 64));
+	MATSYS_CHECK(texInfo.GetWidth() == 32);
+	MATSYS_CHECK(texInfo.GetHeight() == 64);
+	MATSYS_CHECK(texInfo.IsSizeResolved());
+}
+
+MATSYS_TEST(failed_lookup_can_be_filled_in_later)
+{
+	auto settings = pragma::datasystem::create_data_settings({});
+	pragma::datasystem::Texture tex {*settings, "matsys_test_texture_info_missing/diffuse"};
+	auto &texInfo = tex.GetValue();
+	MATSYS_CHECK(!texInfo.ResolveSize());
+	MATSYS_CHECK(texInfo.GetWidth() == 0 && texInfo.GetHeight() == 0);
+	// The size remains unresolved, so the texture manager can still provide it once the texture has been loaded
+	MATSYS_CHECK(!texInfo.IsSizeResolved());
+	MATSYS_CHECK(texInfo.sizeLookupFailed);
+
+	texInfo.SetSize(128, 256);
+	MATSYS_CHECK(texInfo.IsSizeResolved());
+	MATSYS_CHECK(texInfo.ResolveSize());
+	MATSYS_CHECK(texInfo.GetWidth() == 128 && texInfo.GetHeight() == 256);
+
+	// Copies keep the state
+	auto copy = std::unique_ptr<pragma::datasystem::Texture> {tex.Copy()};
+	MATSYS_CHECK(copy->GetValue().IsSizeResolved() && copy->GetValue().width == 128);
+}
+
+MATSYS_TEST(batch_resolve)
+{
+	test::TempDirectory dir {"texture_info_batch", get_material_root()};
+	dir.WriteFile("a.png", test::create_png(8, 4));
+	dir.WriteFile("b.tga", test::create_tga(2, 2));
+	pragma::material::clear_image_header_cache();
+
+	auto settings = pragma::datasystem::create_data_settings({});
+	std::vector<std::unique_ptr<pragma::datasystem::Texture>> textures;
+	for(auto &name : {"a", "b", "a", "missing"})
+		textures.push_back(std::make_unique<pragma::datasystem::Texture>(*settings, dir.GetName() + '/' + name));
+	std::vector<TextureInfo *> texInfos;
+	for(auto &tex : textures)
+		texInfos.push_back(&tex->GetValue());
+	pragma::material::resolve_texture_sizes(texInfos);
+
+	MATSYS_CHECK(texInfos[0]->IsSizeResolved() && texInfos[0]->width == 8 && texInfos[0]->height == 4);
+	MATSYS_CHECK(texInfos[1]->IsSizeResolved() && texInfos[1]->width == 2 && texInfos[1]->height == 2);
+	MATSYS_CHECK(texInfos[2]->IsSizeResolved() && texInfos[2]->width == 8);
+	MATSYS_CHECK(!texInfos[3]->IsSizeResolved() && texInfos[3]->sizeLookupFailed);
+}
+
+MATSYS_TEST_MAIN()
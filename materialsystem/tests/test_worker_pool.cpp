@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+import pragma.materialsystem;
+
+#include "test.hpp"
+
+MATSYS_TEST(parallel_for_visits_every_index_once)
+{
+	pragma::material::WorkerPool pool {4};
+	std::vector<std::atomic<uint32_t>> visits(10'000);
+	pool.ParallelFor(visits.size(), [&visits](size_t i) { ++visits[i]; });
+	for(auto &v : visits)
+		MATSYS_CHECK(v == 1);
+}
+
+MATSYS_TEST(nested_parallel_for_does_not_deadlock)
+{
+	// Every worker is busy with an outer index while the inner loops are executed
+	pragma::material::WorkerPool pool {2};
+	std::atomic<uint32_t> count = 0;
+	pool.ParallelFor(64, [&pool, &count](size_t) { pool.ParallelFor(64, [&count](size_t) { ++count; }); });
+	MATSYS_CHECK(count == 64 * 64);
+}
+
+MATSYS_TEST(parallel_for_rethrows_exceptions)
+{
+	pragma::material::WorkerPool pool {2};
+	std::atomic<uint32_t> count = 0;
+	auto thrown = false;
+	try {
+		pool.ParallelFor(100, [&count](size_t i) {
+			++count;
+			if(i == 50)
+				throw std::runtime_error {"error"};
+		});
+	}
+	catch(const std::runtime_error &) {
+		thrown = true;
+	}
+	MATSYS_CHECK(thrown);
+	MATSYS_CHECK(count == 100);
+}
+
+MATSYS_TEST(submit_returns_result)
+{
+	pragma::material::WorkerPool pool {1};
+	auto future = pool.Submit([]() { return 42; });
+	MATSYS_CHECK(future.get() == 42);
+}
+
+MATSYS_TEST(thread_count_is_bounded)
+{
+	// Concurrent callers must share the pool threads instead of creating their own
+	pragma::material::WorkerPool pool {3};
+	std::mutex mutex;
+	std::unordered_set<std::thread::id> threadIds;
+	std::vector<std::thread> callers;
+	for(auto i = 0; i < 8; ++i) {
+		callers.emplace_back([&]() {
+			pool.ParallelFor(256, [&](size_t) {
+				std::scoped_lock lock {mutex};
+				threadIds.insert(std::this_thread::get_id());
+			});
+		});
+	}
+	for(auto &t : callers)
+		t.join();
+	MATSYS_CHECK(threadIds.size() <= pool.GetThreadCount() + callers.size());
+}
+
+MATSYS_TEST_MAIN()
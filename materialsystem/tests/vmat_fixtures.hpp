@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Generator for compiled Source 2 materials (vmat_c) that are used as test fixtures. Has to be included after test.hpp.
+// The material data is stored as an introspected (NTRO) struct, like in the games the Source 2 mappings were written for.
+
+#pragma once
+
+namespace pragma::material::test {
+	struct VmatDesc {
+		std::string shader;
+		std::vector<std::pair<std::string, int32_t>> intParams;
+		std::vector<std::pair<std::string, float>> floatParams;
+		std::vector<std::pair<std::string, std::array<float, 4>>> vectorParams;
+		// Parameter name and referenced texture resource, e.g. "materials/models/crate_color.vtex"
+		std::vector<std::pair<std::string, std::string>> textureParams;
+	};
+
+	namespace vmat_c {
+		// Introspection data types, see ValveResourceFormat's DataType enum
+		enum class DataType : uint16_t { Struct = 1, ExternalReference = 3, Int32 = 14, Float = 18, Vector4D = 28, String = 31 };
+		constexpr uint8_t INDIRECTION_ARRAY = 4;
+
+		// All offsets within a resource block are relative to the position of the offset field itself
+		class BlockWriter {
+		  public:
+			size_t GetSize() const { return m_data.size(); }
+			template<typename T>
+			size_t Write(const T &value)
+			{
+				auto pos = m_data.size();
+				auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+				m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+				return pos;
+			}
+			size_t Reserve(size_t size)
+			{
+				auto pos = m_data.size();
+				m_data.resize(pos + size, 0);
+				return pos;
+			}
+			void Align(size_t alignment) { m_data.resize((m_data.size() + alignment - 1) / alignment * alignment, 0); }
+			template<typename T>
+			void Set(size_t pos, const T &value)
+			{
+				std::memcpy(m_data.data() + pos, &value, sizeof(T));
+			}
+			void SetOffset(size_t fieldPos, size_t targetPos) { Set<uint32_t>(fieldPos, static_cast<uint32_t>(targetPos - fieldPos)); }
+			// Strings are appended to the end of the block by Finalize
+			void SetString(size_t fieldPos, const std::string &str, bool offset64 = false) { m_strings.push_back({fieldPos, str, offset64}); }
+			std::vector<uint8_t> Finalize()
+			{
+				for(auto &str : m_strings) {
+					if(str.offset64)
+						Set<int64_t>(str.fieldPos, static_cast<int64_t>(m_data.size() - str.fieldPos));
+					else
+						SetOffset(str.fieldPos, m_data.size());
+					m_data.insert(m_data.end(), str.value.begin(), str.value.end());
+					m_data.push_back(0);
+				}
+				m_strings.clear();
+				Align(4);
+				return m_data;
+			}
+		  private:
+			struct String {
+				size_t fieldPos;
+				std::string value;
+				bool offset64;
+			};
+			std::vector<uint8_t> m_data;
+			std::vector<String> m_strings;
+		};
+
+		struct FieldDesc {
+			std::string name;
+			uint16_t diskOffset;
+			DataType type;
+			uint32_t structId = 0;
+			bool array = false;
+		};
+		struct StructDesc {
+			uint32_t id;
+			std::string name;
+			uint16_t diskSize;
+			uint16_t alignment;
+			std::vector<FieldDesc> fields;
+		};
+
+		constexpr uint32_t STRUCT_MATERIAL = 1;
+		constexpr uint32_t STRUCT_PARAM_INT = 2;
+		constexpr uint32_t STRUCT_PARAM_FLOAT = 3;
+		constexpr uint32_t STRUCT_PARAM_VECTOR = 4;
+		constexpr uint32_t STRUCT_PARAM_TEXTURE = 5;
+		constexpr uint16_t MATERIAL_SIZE = 112;
+		// Disk offsets of the parameter arrays in the material struct
+		constexpr uint16_t OFFSET_INT_PARAMS = 16;
+		constexpr uint16_t OFFSET_FLOAT_PARAMS = 24;
+		constexpr uint16_t OFFSET_VECTOR_PARAMS = 32;
+		constexpr uint16_t OFFSET_TEXTURE_PARAMS = 40;
+
+		// The data block is read as the first struct of the manifest
+		inline std::vector<StructDesc> get_material_structs()
+		{
+			using T = DataType;
+			std::vector<StructDesc> structs;
+			structs.push_back({STRUCT_MATERIAL, "MaterialResourceData_t", MATERIAL_SIZE, 8,
+			  {
+			    {"m_materialName", 0, T::String},
+			    {"m_shaderName", 8, T::String},
+			    {"m_intParams", OFFSET_INT_PARAMS, T::Struct, STRUCT_PARAM_INT, true},
+			    {"m_floatParams", OFFSET_FLOAT_PARAMS, T::Struct, STRUCT_PARAM_FLOAT, true},
+			    {"m_vectorParams", OFFSET_VECTOR_PARAMS, T::Struct, STRUCT_PARAM_VECTOR, true},
+			    {"m_textureParams", OFFSET_TEXTURE_PARAMS, T::Struct, STRUCT_PARAM_TEXTURE, true},
+			    {"m_dynamicParams", 48, T::Struct, STRUCT_PARAM_INT, true},
+			    {"m_dynamicTextureParams", 56, T::Struct, STRUCT_PARAM_INT, true},
+			    {"m_intAttributes", 64, T::Struct, STRUCT_PARAM_INT, true},
+			    {"m_floatAttributes", 72, T::Struct, STRUCT_PARAM_FLOAT, true},
+			    {"m_vectorAttributes", 80, T::Struct, STRUCT_PARAM_VECTOR, true},
+			    {"m_textureAttributes", 88, T::Struct, STRUCT_PARAM_TEXTURE, true},
+			    {"m_stringAttributes", 96, T::Struct, STRUCT_PARAM_TEXTURE, true},
+			    {"m_renderAttributesUsed", 104, T::String, 0, true},
+			  }});
+			structs.push_back({STRUCT_PARAM_INT, "MaterialParamInt_t", 16, 8, {{"m_name", 0, T::String}, {"m_nValue", 8, T::Int32}}});
+			structs.push_back({STRUCT_PARAM_FLOAT, "MaterialParamFloat_t", 16, 8, {{"m_name", 0, T::String}, {"m_flValue", 8, T::Float}}});
+			structs.push_back({STRUCT_PARAM_VECTOR, "MaterialParamVector_t", 32, 16, {{"m_name", 0, T::String}, {"m_value", 16, T::Vector4D}}});
+			structs.push_back({STRUCT_PARAM_TEXTURE, "MaterialParamTexture_t", 16, 8, {{"m_name", 0, T::String}, {"m_pValue", 8, T::ExternalReference}}});
+			return structs;
+		}
+
+		inline std::vector<uint8_t> write_ntro_block(const std::vector<StructDesc> &structs)
+		{
+			constexpr size_t STRUCT_ENTRY_SIZE = 40;
+			constexpr size_t FIELD_ENTRY_SIZE = 24;
+			BlockWriter w {};
+			w.Write<uint32_t>(4); // Introspection version
+			auto structsOffset = w.Write<uint32_t>(0);
+			w.Write<uint32_t>(static_cast<uint32_t>(structs.size()));
+			w.Write<uint32_t>(0); // Enums
+			w.Write<uint32_t>(0);
+
+			auto structsPos = w.Reserve(structs.size() * STRUCT_ENTRY_SIZE);
+			w.SetOffset(structsOffset, structsPos);
+			for(size_t i = 0; i < structs.size(); ++i) {
+				auto &desc = structs[i];
+				auto pos = structsPos + i * STRUCT_ENTRY_SIZE;
+				w.Set<uint32_t>(pos, 4);
+				w.Set<uint32_t>(pos + 4, desc.id);
+				w.SetString(pos + 8, desc.name);
+				w.Set<uint32_t>(pos + 12, 0);  // Disk CRC
+				w.Set<int32_t>(pos + 16, 0);   // User version
+				w.Set<uint16_t>(pos + 20, desc.diskSize);
+				w.Set<uint16_t>(pos + 22, desc.alignment);
+				w.Set<uint32_t>(pos + 24, 0);  // Base struct
+				w.Set<uint32_t>(pos + 32, static_cast<uint32_t>(desc.fields.size()));
+				auto fieldsPos = w.Reserve(desc.fields.size() * FIELD_ENTRY_SIZE);
+				w.SetOffset(pos + 28, fieldsPos);
+				for(size_t j = 0; j < desc.fields.size(); ++j) {
+					auto &field = desc.fields[j];
+					auto fieldPos = fieldsPos + j * FIELD_ENTRY_SIZE;
+					w.SetString(fieldPos, field.name);
+					w.Set<int16_t>(fieldPos + 4, 0); // Count
+					w.Set<int16_t>(fieldPos + 6, static_cast<int16_t>(field.diskOffset));
+					if(field.array) {
+						w.SetOffset(fieldPos + 8, w.Write(INDIRECTION_ARRAY));
+						w.Set<uint32_t>(fieldPos + 12, 1);
+						w.Align(4);
+					}
+					w.Set<uint32_t>(fieldPos + 16, field.structId);
+					w.Set<uint16_t>(fieldPos + 20, static_cast<uint16_t>(field.type));
+				}
+			}
+			return w.Finalize();
+		}
+
+		// Only the special dependencies are written, they identify the resource as a material
+		inline std::vector<uint8_t> write_redi_block()
+		{
+			constexpr uint32_t NUM_STRUCTS = 10;
+			constexpr uint32_t SPECIAL_DEPENDENCIES = 3;
+			BlockWriter w {};
+			auto headerPos = w.Reserve(NUM_STRUCTS * 8);
+			for(uint32_t i = 0; i < NUM_STRUCTS; ++i)
+				w.SetOffset(headerPos + i * 8, w.GetSize());
+			auto depPos = w.Reserve(16);
+			w.SetOffset(headerPos + SPECIAL_DEPENDENCIES * 8, depPos);
+			w.Set<uint32_t>(headerPos + SPECIAL_DEPENDENCIES * 8 + 4, 1);
+			w.SetString(depPos, "VMAT Compiler Version");
+			w.SetString(depPos + 4, "CompileMaterial");
+			return w.Finalize();
+		}
+
+		inline std::vector<uint8_t> write_rerl_block(const VmatDesc &desc)
+		{
+			BlockWriter w {};
+			auto offsetPos = w.Write<uint32_t>(0);
+			w.Write<uint32_t>(static_cast<uint32_t>(desc.textureParams.size()));
+			w.SetOffset(offsetPos, w.GetSize());
+			for(size_t i = 0; i < desc.textureParams.size(); ++i) {
+				w.Write<uint64_t>(i + 1);
+				w.SetString(w.Write<int64_t>(0), desc.textureParams[i].second, true);
+			}
+			return w.Finalize();
+		}
+
+		inline std::vector<uint8_t> write_data_block(const VmatDesc &desc, const std::string &materialName)
+		{
+			BlockWriter w {};
+			w.Reserve(MATERIAL_SIZE);
+			w.SetString(0, materialName);
+			w.SetString(8, desc.shader);
+			// All other arrays are empty, their offset points to the end of the material struct
+			for(uint16_t offset = 16; offset < MATERIAL_SIZE; offset += 8)
+				w.SetOffset(offset, MATERIAL_SIZE);
+			auto writeArray = [&w](uint16_t fieldOffset, const auto &params, size_t elementSize, size_t alignment, const auto &writeValue) {
+				if(params.empty())
+					return;
+				w.Align(alignment);
+				w.SetOffset(fieldOffset, w.GetSize());
+				w.Set<uint32_t>(fieldOffset + 4, static_cast<uint32_t>(params.size()));
+				for(size_t i = 0; i < params.size(); ++i) {
+					auto pos = w.Reserve(elementSize);
+					w.SetString(pos, params[i].first);
+					writeValue(pos, i, params[i].second);
+				}
+			};
+			writeArray(OFFSET_INT_PARAMS, desc.intParams, 16, 8, [&w](size_t pos, size_t, int32_t value) { w.Set(pos + 8, value); });
+			writeArray(OFFSET_FLOAT_PARAMS, desc.floatParams, 16, 8, [&w](size_t pos, size_t, float value) { w.Set(pos + 8, value); });
+			writeArray(OFFSET_VECTOR_PARAMS, desc.vectorParams, 32, 16, [&w](size_t pos, size_t, const std::array<float, 4> &value) { w.Set(pos + 16, value); });
+			// Textures are referenced by the id of their entry in the external reference list
+			writeArray(OFFSET_TEXTURE_PARAMS, desc.textureParams, 16, 8, [&w](size_t pos, size_t i, const std::string &) { w.Set<uint64_t>(pos + 8, i + 1); });
+			return w.Finalize();
+		}
+	}
+
+	inline std::vector<uint8_t> create_vmat_c(const VmatDesc &desc, const std::string &materialName = "materials/test.vmat")
+	{
+		std::vector<std::pair<std::string, std::vector<uint8_t>>> blocks = {
+		  {"RERL", vmat_c::write_rerl_block(desc)},
+		  {"REDI", vmat_c::write_redi_block()},
+		  {"NTRO", vmat_c::write_ntro_block(vmat_c::get_material_structs())},
+		  {"DATA", vmat_c::write_data_block(desc, materialName)},
+		};
+		constexpr size_t HEADER_SIZE = 16;
+		constexpr size_t BLOCK_ENTRY_SIZE = 12;
+		auto dataPos = HEADER_SIZE + blocks.size() * BLOCK_ENTRY_SIZE;
+		auto fileSize = dataPos;
+		for(auto &[type, data] : blocks)
+			fileSize += data.size();
+
+		ByteWriter writer {};
+		writer.Write<uint32_t>(static_cast<uint32_t>(fileSize));
+		writer.Write<uint16_t>(12); // Header version
+		writer.Write<uint16_t>(0);  // Resource version
+		writer.Write<uint32_t>(8);  // Offset to the block table, relative to this field
+		writer.Write<uint32_t>(static_cast<uint32_t>(blocks.size()));
+		for(size_t i = 0; i < blocks.size(); ++i) {
+			auto &[type, data] = blocks[i];
+			writer.WriteBytes(type.data(), 4);
+			auto fieldPos = HEADER_SIZE + i * BLOCK_ENTRY_SIZE + 4;
+			writer.Write<uint32_t>(static_cast<uint32_t>(dataPos - fieldPos));
+			writer.Write<uint32_t>(static_cast<uint32_t>(data.size()));
+			dataPos += data.size();
+		}
+		for(auto &[type, data] : blocks)
+			writer.WriteBytes(data.data(), data.size());
+		return writer.GetData();
+	}
+}